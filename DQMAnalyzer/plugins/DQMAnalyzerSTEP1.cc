@@ -20,6 +20,7 @@
 
 // system include files
 #include <memory>
+#include <algorithm>
 
 // user include files
 #include "FWCore/Framework/interface/Frameworkfwd.h"
@@ -85,6 +86,17 @@ using namespace edm;
 // class declaration
 //
 
+// a SimTrack-STA pair within the dR cut
+struct SimStaMatch
+{
+  SimTrackContainer::const_iterator simTrack;
+  unsigned sta;
+  double dR;
+  // fraction of the matched GEM SimHits in eta partitions with a GEM rechit of the STA
+  double sharedFraction;
+  unsigned nGEMSimHits;
+};
+
 class DQMAnalyzerSTEP1 : public edm::EDAnalyzer {
    public:
       explicit DQMAnalyzerSTEP1(const edm::ParameterSet&);
@@ -116,6 +128,13 @@ class DQMAnalyzerSTEP1 : public edm::EDAnalyzer {
       MonitorElement * hSimTrackMatch;
       MonitorElement * hDRMatchVsPt;
       MonitorElement * hMatchedSimHits;
+      MonitorElement * hSharedGEMHitFraction;
+
+      // efficiencies kept as pass (1) / fail (0) profiles: the bin entries are the totals
+      // and the bin means the pass fractions, so they merge by simple addition
+      MonitorElement * pEffSimPt;
+      MonitorElement * pEffSimEta;
+      MonitorElement * pChargeMisIDSimPt;
 
    private:
       virtual void beginJob() override;
@@ -142,47 +161,55 @@ class DQMAnalyzerSTEP1 : public edm::EDAnalyzer {
       std::string EffRootFileName_;
       DQMStore * dbe;
 
+      // per-event tables, kept as members to reuse their memory
+      // (trackId, index) of the GEM SimHits, sorted by trackId
+      std::vector<std::pair<unsigned, unsigned> > gemSimHitIndex_;
+      // (eta, index) of the STA tracks, sorted by eta
+      std::vector<std::pair<double, unsigned> > staByEta_;
+      // sorted GEM rechit detIds of each STA track
+      std::vector<std::vector<uint32_t> > staGEMDetIds_;
+      // GEM SimHits matched to the current SimTrack
+      std::vector<unsigned> selGEMSimHits_;
+      // SimTrack-STA association table
+      std::vector<SimStaMatch> matchTable_;
+
 };
 
-bool isSimMatched(SimTrackContainer::const_iterator simTrack, edm::PSimHitContainer::const_iterator itHit)
-{
+bool lessFirst(const std::pair<double, unsigned> & a, double b) { return a.first < b; }
 
-  bool result = false;
+// (trackId, hit index) table of the GEM SimHits
+void indexGEMSimHits(const edm::PSimHitContainer & hits, std::vector<std::pair<unsigned, unsigned> > & index)
+{
 
-  int trackId = simTrack->trackId();
-  int trackId_sim = itHit->trackId();
-  if(trackId == trackId_sim) result = true;
+  index.clear();
+  for (unsigned i = 0; i < hits.size(); ++i){
 
-  //std::cout<<"ID: "<<trackId<<" "<<trackId_sim<<" "<<result<<std::endl;
+	DetId id = DetId(hits[i].detUnitId());
+	if (!(id.subdetId() == MuonSubdetId::GEM)) continue;
+	index.push_back(std::make_pair(hits[i].trackId(), i));
 
-  return result;
+  }
+  std::sort(index.begin(), index.end());
 
 }
 
-edm::PSimHitContainer isTrackMatched(SimTrackContainer::const_iterator simTrack, const Event & event, const EventSetup& eventSetup)
+// indices of the GEM SimHits of the SimTrack
+void isTrackMatched(SimTrackContainer::const_iterator simTrack, const edm::PSimHitContainer & hits,
+		    const std::vector<std::pair<unsigned, unsigned> > & index, std::vector<unsigned> & selectedGEMHits)
 {
 
-  edm::PSimHitContainer selectedGEMHits;
+  selectedGEMHits.clear();
 
-  edm::Handle<edm::PSimHitContainer> GEMHits;
-  event.getByLabel(edm::InputTag("g4SimHits","MuonGEMHits"), GEMHits);
+  std::vector<std::pair<unsigned, unsigned> >::const_iterator itIdx =
+	std::lower_bound(index.begin(), index.end(), std::make_pair(simTrack->trackId(), 0u));
+  for (; itIdx != index.end() && itIdx->first == simTrack->trackId(); ++itIdx){
 
-  ESHandle<GlobalTrackingGeometry> theTrackingGeometry;
-  eventSetup.get<GlobalTrackingGeometryRecord>().get(theTrackingGeometry);
-
-  for (edm::PSimHitContainer::const_iterator itHit = GEMHits->begin(); itHit != GEMHits->end(); ++itHit){
-							 
-	DetId id = DetId(itHit->detUnitId());
-	if (!(id.subdetId() == MuonSubdetId::GEM)) continue;
-  	if(itHit->particleType() != (*simTrack).type()) continue;
-
-	bool result = isSimMatched(simTrack, itHit);
-	if(result) selectedGEMHits.push_back(*itHit);
+  	if(hits[itIdx->second].particleType() != (*simTrack).type()) continue;
+	selectedGEMHits.push_back(itIdx->second);
 
   }
 
   //std::cout<<"Size: "<<selectedGEMHits.size()<<std::endl;
-  return selectedGEMHits;
 
 }
 
@@ -239,6 +266,10 @@ DQMAnalyzerSTEP1::DQMAnalyzerSTEP1(const edm::ParameterSet& iConfig)
    hSimTrackMatch = dbe->book1D("SimTrackMatch", "SimTrackMatch",2,0.,2.);
    hDRMatchVsPt = dbe->book2D("DRMatchVsPt","DRMatchVsPt",261,-2.5,1302.5,10,0,10);
    hMatchedSimHits = dbe->book1D("MatchedSimHits","MatchedSimHits",6,-0.5,5.5);
+   pEffSimPt = dbe->bookProfile("EffSimPt","Efficiency vs. Sim p_{T}",261,-2.5,1302.5,2,-0.5,1.5,"");
+   pEffSimEta = dbe->bookProfile("EffSimEta","Efficiency vs. Sim #eta",100,-2.5,2.5,2,-0.5,1.5,"");
+   pChargeMisIDSimPt = dbe->bookProfile("ChargeMisIDSimPt","Charge Mis-ID vs. Sim p_{T}",261,-2.5,1302.5,2,-0.5,1.5,"");
+   hSharedGEMHitFraction = dbe->book1D("SharedGEMHitFraction","Fraction of GEM SimHits shared with the matched track",11,-0.05,1.05);
 
 }
 
@@ -287,15 +318,39 @@ DQMAnalyzerSTEP1::analyze(const edm::Event& iEvent, const edm::EventSetup& iSetu
   hNumSimTracks->Fill(simTracks->size());
   if(debug_) cout<<"Reconstructed tracks: " << staTracks->size() << endl;
 
-  reco::TrackCollection::const_iterator staTrack;
+  // per-event tables: GEM SimHits by trackId, STA tracks by eta with their GEM detIds
+  indexGEMSimHits(*GEMHits, gemSimHitIndex_);
+
+  staByEta_.clear();
+  staGEMDetIds_.resize(staTracks->size());
+  for (unsigned i = 0; i < staTracks->size(); ++i){
+
+	const reco::Track & staTrack = (*staTracks)[i];
+	staByEta_.push_back(std::make_pair(staTrack.momentum().eta(), i));
+
+	staGEMDetIds_[i].clear();
+	for(trackingRecHit_iterator recHit = staTrack.recHitsBegin(); recHit != staTrack.recHitsEnd(); ++recHit){
+
+		if (!((*recHit)->geographicalId().det() == DetId::Muon)) continue;
+		if (!((*recHit)->geographicalId().subdetId() == MuonSubdetId::GEM)) continue;
+		staGEMDetIds_[i].push_back((*recHit)->geographicalId().rawId());
+
+	}
+	std::sort(staGEMDetIds_[i].begin(), staGEMDetIds_[i].end());
+
+  }
+  std::sort(staByEta_.begin(), staByEta_.end());
+
+  // SimTrack-STA association table; dR > |deta|, so only the STA tracks in the eta window are tried
+  const double maxDR = 0.1;
+  matchTable_.clear();
+
   SimTrackContainer::const_iterator simTrack;
 
   int simCount = 0;
 
   for (simTrack = simTracks->begin(); simTrack != simTracks->end(); ++simTrack){
 
-		int countMatching = 0;
-
 	      	if (abs((*simTrack).type()) != 13) continue;
   		if ((*simTrack).noVertex()) continue;
   		if ((*simTrack).noGenpart()) continue;
@@ -309,32 +364,64 @@ DQMAnalyzerSTEP1::analyze(const edm::Event& iEvent, const edm::EventSetup& iSetu
 
 		if(debug_) std::cout<<"SimEta "<<simEta<<" SimPhi "<<simPhi<<std::endl;
 
-		edm::PSimHitContainer selGEMSimHits = isTrackMatched(simTrack, iEvent, iSetup);
-		int size = selGEMSimHits.size();
+		isTrackMatched(simTrack, *GEMHits, gemSimHitIndex_, selGEMSimHits_);
+		int size = selGEMSimHits_.size();
 		hMatchedSimHits->Fill(size);
 		hSimTrackMatch->Fill(size > 0 ? 1 : 0);
 		if(size == 0 && noGEMCase_) continue;
 
-		for (staTrack = staTracks->begin(); staTrack != staTracks->end(); ++staTrack){
+		size_t firstMatch = matchTable_.size();
+		std::vector<std::pair<double, unsigned> >::const_iterator itSta =
+			std::lower_bound(staByEta_.begin(), staByEta_.end(), simEta - maxDR, lessFirst);
+		for (; itSta != staByEta_.end() && itSta->first <= simEta + maxDR; ++itSta){
 
-			double recEta = staTrack->momentum().eta();
-			double recPhi = staTrack->momentum().phi();
-			if(debug_) cout<<"RecEta "<<recEta<<" recPhi "<<recPhi<<std::endl;
+			const reco::Track & staTrack = (*staTracks)[itSta->second];
+			double recEta = staTrack.momentum().eta();
+			double recPhi = staTrack.momentum().phi();
 			double dR = sqrt(pow((simEta-recEta),2) + pow((simPhi-recPhi),2));
+			if(dR > maxDR) continue;
+
+			const std::vector<uint32_t> & staDetIds = staGEMDetIds_[itSta->second];
+			int shared = 0;
+			for (unsigned i = 0; i < selGEMSimHits_.size(); ++i)
+				if (std::binary_search(staDetIds.begin(), staDetIds.end(), (*GEMHits)[selGEMSimHits_[i]].detUnitId())) shared++;
+
+			SimStaMatch match = {simTrack, itSta->second, dR, size > 0 ? double(shared)/size : 0., (unsigned)size};
+			matchTable_.push_back(match);
+
+		}
+
+		// the STA tracks of a SimTrack in the collection order
+		std::sort(matchTable_.begin() + firstMatch, matchTable_.end(),
+			  [](const SimStaMatch & a, const SimStaMatch & b){ return a.sta < b.sta; });
+
+		hDRMatchVsPt->Fill(simPt, matchTable_.size() - firstMatch);
+
+  }
+
+  hNumMuonSimTracks->Fill(simCount);
+
+  for (std::vector<SimStaMatch>::const_iterator match = matchTable_.begin(); match != matchTable_.end(); ++match){
+
+			simTrack = match->simTrack;
+			const reco::Track & staTrack = (*staTracks)[match->sta];
+
+			double simEta = (*simTrack).momentum().eta();
+			double simPhi = (*simTrack).momentum().phi();
+			double simPt = (*simTrack).momentum().pt();
+			double recEta = staTrack.momentum().eta();
+			double recPhi = staTrack.momentum().phi();
+			double dR = match->dR;
+			if(debug_) cout<<"RecEta "<<recEta<<" recPhi "<<recPhi<<std::endl;
 			if(debug_) cout<<"dR "<<dR<<std::endl;
 
-			if(dR > 0.1) continue;
-			countMatching++;
-		    
-			double recPt = staTrack->pt();
+			double recPt = staTrack.pt();
 		    	//cout<<" chi2: "<<track.chi2()<<endl;
-	    
-		    	if(abs(simEta) > 2.1 || abs(simEta) < 1.64) continue;
 
 			double phi_02pi_sim = simPhi < 0 ? simPhi + TMath::Pi() : simPhi;
 			double phiDegSim = phi_02pi_sim * 180/ TMath::Pi();
-			bool hasGemRecHits = false;
-			int numGEMRecHits = 0;
+			int numGEMRecHits = staGEMDetIds_[match->sta].size();
+			bool hasGemRecHits = numGEMRecHits > 0;
 			int numGEMSimHits = 0;
 
 			hDenSimPt->Fill(simPt);
@@ -343,26 +430,20 @@ DQMAnalyzerSTEP1::analyze(const edm::Event& iEvent, const edm::EventSetup& iSetu
 			if(simEta > 0) hDenSimPhiPlus->Fill(phiDegSim);
 			else if(simEta < 0) hDenSimPhiMinus->Fill(phiDegSim);
 
-			for(trackingRecHit_iterator recHit = staTrack->recHitsBegin(); recHit != staTrack->recHitsEnd(); ++recHit){
-
-				if (!((*recHit)->geographicalId().det() == DetId::Muon)) continue;
-				if (!((*recHit)->geographicalId().subdetId() == MuonSubdetId::GEM)) continue;
-
-				numGEMRecHits++;
-				hasGemRecHits = true;
-
-		      	}
-
 			hNumGEMRecHits->Fill(numGEMRecHits);
 			hNumGEMSimHits->Fill(numGEMSimHits);
+			if(match->nGEMSimHits > 0) hSharedGEMHitFraction->Fill(match->sharedFraction);
 
 			if(noGEMCase_) hasGemRecHits = true;
+			pEffSimPt->Fill(simPt, hasGemRecHits ? 1 : 0);
+			pEffSimEta->Fill(simEta, hasGemRecHits ? 1 : 0);
 			if(!hasGemRecHits) continue;
 
 			int qGen = simTrack->charge();
-			int qRec = staTrack->charge();
+			int qRec = staTrack.charge();
 
 			hDeltaCharge->Fill(simPt, qGen-qRec);
+			pChargeMisIDSimPt->Fill(simPt, qGen != qRec ? 1 : 0);
 
 			if(debug_) {
 
@@ -384,15 +465,9 @@ DQMAnalyzerSTEP1::analyze(const edm::Event& iEvent, const edm::EventSetup& iSetu
 
 			if(simEta > 0) hNumSimPhiPlus->Fill(phiDegSim);
 			else if(simEta < 0) hNumSimPhiMinus->Fill(phiDegSim);
-    
-  		}
-
-	hDRMatchVsPt->Fill(simPt, countMatching);
 
   }
 
-  hNumMuonSimTracks->Fill(simCount);
-
 }
 
 
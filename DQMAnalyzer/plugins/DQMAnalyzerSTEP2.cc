@@ -36,8 +36,12 @@
 
 #include <memory>
 #include <string>
+#include <cmath>
 
 #include "TEfficiency.h"
+#include "TProfile.h"
+
+#include "ResolutionEstimator.h"
 
 //
 // class declaration
@@ -54,9 +58,13 @@ class DQMAnalyzerSTEP2 : public edm::EDAnalyzer {
       MonitorElement * EfficiencyVsPt;
       MonitorElement * InvPtResVsPt;
       MonitorElement * RmsVsPt;
+      MonitorElement * TruncRmsVsPt;
+      MonitorElement * IqrSigmaVsPt;
       MonitorElement * EfficiencyVsEta[7];
       MonitorElement * InvPtResVsEta[7];
       MonitorElement * RmsVsEta[7];
+      MonitorElement * TruncRmsVsEta[7];
+      MonitorElement * IqrSigmaVsEta[7];
 
    private:
       virtual void beginJob() override;
@@ -78,6 +86,12 @@ class DQMAnalyzerSTEP2 : public edm::EDAnalyzer {
       std::string NameFile_;
       DQMStore* dbe_;
 
+      ResolutionEstimator resolution_;
+
+      bool fillEfficiency(const std::string & profileName, MonitorElement * eff);
+      void fillResolution(MonitorElement * me, MonitorElement * sigma, MonitorElement * rms,
+			  MonitorElement * truncRms, MonitorElement * iqrSigma);
+
 };
 
 TEfficiency * calcEff(TH1F * h1, TH1F * h2){
@@ -133,55 +147,6 @@ TH1F * convertTEff(TEfficiency * histo){
 
 }
 
-std::vector<TH1D*> produceQoPPlots(TH2F * histo){
-
-	std::vector<TH1D*> tmp;
-	tmp.clear();
-     	//std::cout<<histo->GetEntries()<<std::endl;
-
-	TH2F * histoClone = (TH2F*)histo->Clone();
-	TH1D * projX = histoClone->ProjectionX("projX",1,1);
-	TH1D * plotRms = (TH1D*)projX->Clone();
-	//std::cout<<projX->GetSize()<<" "<<plotRms->GetSize()<<std::endl;
-
-	for(int i=1; i<histo->GetNbinsX(); i++){
-
-  		TH1D * projY = histoClone->ProjectionY("projY",i,i);
-		if((projY->GetEntries()) == 0) continue;
-
-		double mean = projY->GetMean();
-		double rms = projY->GetRMS();
-
-        	TF1 *myfitFR = new TF1("myfitFR","gaus", -10, +10);
-        	projY->Fit("myfitFR");
-        	TF1 *myfit = new TF1("myfit","gaus", mean-2*rms, mean+2*rms);
-        	projY->Fit("myfit", "R");
-
-		double sigma = myfit->GetParameter(2);
-		double sigmaErr = myfit->GetParError(2);
-		double sigmaFR = myfitFR->GetParameter(2);
-		//double sigmaErrFR = myfitFR->GetParError(2);
-		double delta = abs(sigma - sigmaFR);
-		double DeltaSigma = sqrt(delta*delta + sigmaErr*sigmaErr);
-
-		projX->SetBinContent(i,sigma);
-		projX->SetBinError(i,DeltaSigma);
-
-		plotRms->SetBinContent(i,rms);
-
-		//std::cout<<i<<" "<<projX->GetBinContent(i)<<" "<<projX->GetBinError(i)<<" "<<plotRms->GetBinContent(i)<<std::endl;
-		//std::cout<<i<<" "<<sigma<<" "<<DeltaSigma<<" "<<rms<<std::endl;
-
-	}
-
-	//std::cout<<projX->GetEntries()<<std::endl;
-	//std::cout<<plotRms->GetEntries()<<std::endl;
-	tmp.push_back(projX);
-	tmp.push_back(plotRms);
-	return tmp;
-
-}
-
 //
 // constants, enums and typedefs
 //
@@ -193,8 +158,11 @@ std::vector<TH1D*> produceQoPPlots(TH2F * histo){
 //
 // constructors and destructor
 //
-DQMAnalyzerSTEP2::DQMAnalyzerSTEP2(const edm::ParameterSet& iConfig)
-
+DQMAnalyzerSTEP2::DQMAnalyzerSTEP2(const edm::ParameterSet& iConfig):
+  resolution_(iConfig.getUntrackedParameter<double>("TruncatedRmsFraction", 0.95),
+	      iConfig.getUntrackedParameter<double>("GausFitRange", 2.),
+	      ResolutionEstimator::fitMode(iConfig.getUntrackedParameter<std::string>("ResolutionFit", "gausLSQ")),
+	      iConfig.getUntrackedParameter<bool>("ParallelSlices", true))
 {
    //now do what ever initialization is needed
 
@@ -254,11 +222,15 @@ DQMAnalyzerSTEP2::beginRun(edm::Run const&, edm::EventSetup const&)
   EfficiencyVsPt = dbe_->book1D("EfficiencyVsPt","Efficiency vs. p_{T}",261,-2.5,1302.5);
   InvPtResVsPt = dbe_->book1D("InvPtResVsPt","q/p core width vs. p_{T}",261,-2.5,1302.5);
   RmsVsPt = dbe_->book1D("RmsVsPt","q/p RMS vs. p_{T}",261,-2.5,1302.5);
+  TruncRmsVsPt = dbe_->book1D("TruncRmsVsPt","q/p truncated RMS vs. p_{T}",261,-2.5,1302.5);
+  IqrSigmaVsPt = dbe_->book1D("IqrSigmaVsPt","q/p IQR/1.349 vs. p_{T}",261,-2.5,1302.5);
 
   ChargeMisIDVsPt->setAxisTitle("p_{T}^{Sim} [GeV/c]");
   EfficiencyVsPt->setAxisTitle("p_{T}^{Sim} [GeV/c]");
   InvPtResVsPt->setAxisTitle("p_{T}^{Sim} [GeV/c]");
   RmsVsPt->setAxisTitle("p_{T}^{Sim} [GeV/c]");
+  TruncRmsVsPt->setAxisTitle("p_{T}^{Sim} [GeV/c]");
+  IqrSigmaVsPt->setAxisTitle("p_{T}^{Sim} [GeV/c]");
 
   for(int i = 0; i < (int)localFolder_.size(); i++){
 
@@ -285,6 +257,20 @@ DQMAnalyzerSTEP2::beginRun(edm::Run const&, edm::EventSetup const&)
   	RmsVsEta[i] = dbe_->book1D(meName.str(),meTitle.str(),100,-2.5,+2.5);
 	RmsVsEta[i]->setAxisTitle("#eta^{Sim}");
 
+    	meName.str("");
+    	meTitle.str("");
+    	meName<<"TruncRmsVsEta_"<<localFolder_[i];
+    	meTitle<<"q/p truncated RMS vs. #eta ("<<localFolder_[i]<<")";
+  	TruncRmsVsEta[i] = dbe_->book1D(meName.str(),meTitle.str(),100,-2.5,+2.5);
+	TruncRmsVsEta[i]->setAxisTitle("#eta^{Sim}");
+
+    	meName.str("");
+    	meTitle.str("");
+    	meName<<"IqrSigmaVsEta_"<<localFolder_[i];
+    	meTitle<<"q/p IQR/1.349 vs. #eta ("<<localFolder_[i]<<")";
+  	IqrSigmaVsEta[i] = dbe_->book1D(meName.str(),meTitle.str(),100,-2.5,+2.5);
+	IqrSigmaVsEta[i]->setAxisTitle("#eta^{Sim}");
+
   }
 
 }
@@ -298,7 +284,10 @@ DQMAnalyzerSTEP2::endRun(edm::Run const&, edm::EventSetup const&)
 
    for(int i = 0; i < (int)localFolder_.size(); i++){
 
-	   //Efficiency vs. SimPt
+	   //Efficiency vs. SimPt: from the pass/total profile, or from the numerator and denominator
+
+	   std::string folder = globalFolder_ + "SingleMu" + localFolder_[i] + "/";
+	   bool effVsPtDone = fillEfficiency(folder + "EffSimPt", EfficiencyVsPt);
 
 	   std::stringstream meName1;
 	   MonitorElement * myMe1;
@@ -314,8 +303,8 @@ DQMAnalyzerSTEP2::endRun(edm::Run const&, edm::EventSetup const&)
 
 	   std::cout<<meName1.str()<<" "<<meName2.str()<<std::endl;
 
-	   myMe1 = dbe_->get(meName1.str());
-	   myMe2 = dbe_->get(meName2.str());
+	   myMe1 = effVsPtDone ? 0 : dbe_->get(meName1.str());
+	   myMe2 = effVsPtDone ? 0 : dbe_->get(meName2.str());
 
 	   if(myMe1 && myMe2){
 
@@ -345,7 +334,7 @@ DQMAnalyzerSTEP2::endRun(edm::Run const&, edm::EventSetup const&)
 	   meName3.str("");
 	   meName3<<globalFolder_<<"SingleMu"<<localFolder_[i]<<"/DeltaCharge";
 
-	   myMe3 = dbe_->get(meName3.str());
+	   myMe3 = fillEfficiency(folder + "ChargeMisIDSimPt", ChargeMisIDVsPt) ? 0 : dbe_->get(meName3.str());
 
     	   if(myMe3){
 
@@ -376,28 +365,7 @@ DQMAnalyzerSTEP2::endRun(edm::Run const&, edm::EventSetup const&)
 
 	   myMe4 = dbe_->get(meName4.str());
 
-    	   if(myMe4){
-
-	   	std::vector<TH1D*> result;
-		result.clear();
-		TH2F * histo4 = myMe4->getTH2F();
-		//std::cout<<histo4->GetEntries()<<std::endl;
-
-		result = produceQoPPlots(histo4);
-
-		for(int j=1; j<result[0]->GetSize(); j++){
-
-			double sigmaVal = result[0]->GetBinContent(j);
-			double sigmaErrVal = result[0]->GetBinError(j);
-			double rmsVal = result[1]->GetBinContent(j);
-			if(sigmaVal == 0) continue;
-			InvPtResVsPt->setBinContent(j,sigmaVal);
-			InvPtResVsPt->setBinError(j,sigmaErrVal);
-			RmsVsPt->setBinContent(j,rmsVal);
-
-		}
-
-	   }
+    	   if(myMe4) fillResolution(myMe4, InvPtResVsPt, RmsVsPt, TruncRmsVsPt, IqrSigmaVsPt);
 
 	   //Efficiency vs. SimEta
 
@@ -413,8 +381,9 @@ DQMAnalyzerSTEP2::endRun(edm::Run const&, edm::EventSetup const&)
 	   meName6.str("");
 	   meName6<<globalFolder_<<"SingleMu"<<localFolder_[i]<<"/DenSimEta";
 
-	   myMe5 = dbe_->get(meName5.str());
-	   myMe6 = dbe_->get(meName6.str());
+	   bool effVsEtaDone = fillEfficiency(folder + "EffSimEta", EfficiencyVsEta[i]);
+	   myMe5 = effVsEtaDone ? 0 : dbe_->get(meName5.str());
+	   myMe6 = effVsEtaDone ? 0 : dbe_->get(meName6.str());
 
 	   if(myMe5 && myMe6){
 
@@ -446,33 +415,62 @@ DQMAnalyzerSTEP2::endRun(edm::Run const&, edm::EventSetup const&)
 
 	   myMe7 = dbe_->get(meName7.str());
 
-    	   if(myMe7){
+    	   if(myMe7) fillResolution(myMe7, InvPtResVsEta[i], RmsVsEta[i], TruncRmsVsEta[i], IqrSigmaVsEta[i]);
 
-	   	std::vector<TH1D*> result;
-		TH2F * histo7 = myMe7->getTH2F();
-		//std::cout<<histo7->GetEntries()<<std::endl;
+   }
 
-		result = produceQoPPlots(histo7);
+   if(SaveFile_) dbe_->save(NameFile_);
 
-		//std::cout<<result[0]->GetEntries()<<" "<<result[1]->GetEntries()<<" "<<result.size()<<std::endl;
+}
 
-		for(int j=1; j<result[0]->GetSize(); j++){
+// ------------ efficiency from a pass/total profile, converted once at harvesting  ------------
 
-			double sigmaVal = result[0]->GetBinContent(j);
-			double sigmaErrVal = result[0]->GetBinError(j);
-			double rmsVal = result[1]->GetBinContent(j);
-			if(sigmaVal == 0) continue;
-			InvPtResVsEta[i]->setBinContent(j,sigmaVal);
-			InvPtResVsEta[i]->setBinError(j,sigmaErrVal);
-			RmsVsEta[i]->setBinContent(j,rmsVal);
+bool
+DQMAnalyzerSTEP2::fillEfficiency(const std::string & profileName, MonitorElement * eff)
+{
 
-		}
+	MonitorElement * me = dbe_->get(profileName);
+	if(me == 0 || me->kind() != MonitorElement::DQM_KIND_TPROFILE) return false;
 
-	   }
+	TProfile * profile = me->getTProfile();
+	for(int j=1; j<=profile->GetNbinsX(); j++){
 
-   }
+		double total = profile->GetBinEntries(j);
+		if(total == 0) continue;
+		// the bin mean is the pass fraction; a bin without passes keeps
+		// the Clopper-Pearson upper error (the lower bound is then 0)
+		double pass = floor(profile->GetBinContent(j)*total + 0.5);
 
-   if(SaveFile_) dbe_->save(NameFile_);
+		double low = TEfficiency::ClopperPearson(total, pass, 0.682689492137, false);
+		double up = TEfficiency::ClopperPearson(total, pass, 0.682689492137, true);
+		eff->setBinContent(j,pass/total);
+		eff->setBinError(j,(up-low)/2);
+
+	}
+	return true;
+
+}
+
+// ------------ q/p core width and robust widths in the slices of a resolution plot  ------------
+
+void
+DQMAnalyzerSTEP2::fillResolution(MonitorElement * me, MonitorElement * sigma, MonitorElement * rms,
+				 MonitorElement * truncRms, MonitorElement * iqrSigma)
+{
+
+	std::vector<SliceResolution> result = resolution_.estimateSlices(*me->getTH2F());
+
+	for(int j=1; j<=(int)result.size(); j++){
+
+		const SliceResolution & res = result[j-1];
+		if(res.entries == 0 || res.sigma == 0) continue;
+		sigma->setBinContent(j,res.sigma);
+		sigma->setBinError(j,res.sigmaErr);
+		rms->setBinContent(j,res.rms);
+		truncRms->setBinContent(j,res.truncRms);
+		iqrSigma->setBinContent(j,res.iqrSigma);
+
+	}
 
 }
 
@@ -0,0 +1,205 @@
+#include "ResolutionEstimator.h"
+
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include "TH1D.h"
+#include "TF1.h"
+
+#include "tbb/parallel_for.h"
+
+#include <algorithm>
+#include <cmath>
+
+ResolutionEstimator::ResolutionEstimator(double truncatedFraction, double fitRange, FitMode fitMode, bool parallel)
+: truncatedFraction_(truncatedFraction), fitRange_(fitRange), fitMode_(fitMode), parallel_(parallel)
+{}
+
+
+ResolutionEstimator::FitMode ResolutionEstimator::fitMode(const std::string & name)
+{
+  if (name == "gausLSQ") return GAUS_LSQ;
+  if (name == "gausTF1") return GAUS_TF1;
+  throw cms::Exception("Configuration") << "ResolutionEstimator: unknown fit mode " << name << "\n";
+}
+
+
+SliceResolution ResolutionEstimator::estimate(const std::vector<double> & edges, const std::vector<double> & contents) const
+{
+  SliceResolution res;
+  estimateRobust(edges, contents, res);
+  if (res.entries <= 0.) return res;
+  if (fitMode_ == GAUS_LSQ) refineLSQ(edges, contents, res);
+  else refineTF1(edges, contents, res);
+  return res;
+}
+
+
+std::vector<SliceResolution> ResolutionEstimator::estimateSlices(const TH2 & histo) const
+{
+  const int nx = histo.GetNbinsX();
+  const int ny = histo.GetNbinsY();
+
+  std::vector<double> edges(ny + 1);
+  for (int j = 1; j <= ny + 1; ++j) edges[j-1] = histo.GetYaxis()->GetBinLowEdge(j);
+
+  // copy the slices out of the histogram first, so that the parallel part does not touch ROOT
+  std::vector<std::vector<double> > contents(nx, std::vector<double>(ny));
+  for (int i = 1; i <= nx; ++i)
+    for (int j = 1; j <= ny; ++j) contents[i-1][j-1] = histo.GetBinContent(i, j);
+
+  std::vector<SliceResolution> result(nx);
+  auto process = [&](size_t i) {
+    estimateRobust(edges, contents[i], result[i]);
+    if (result[i].entries > 0. && fitMode_ == GAUS_LSQ) refineLSQ(edges, contents[i], result[i]);
+  };
+  if (parallel_) tbb::parallel_for(size_t(0), size_t(nx), process);
+  else for (size_t i = 0; i < size_t(nx); ++i) process(i);
+
+  if (fitMode_ == GAUS_TF1)
+    for (int i = 0; i < nx; ++i)
+      if (result[i].entries > 0.) refineTF1(edges, contents[i], result[i]);
+
+  return result;
+}
+
+
+double ResolutionEstimator::quantile(const std::vector<double> & edges, const std::vector<double> & cumulative, double p)
+{
+  const double target = p * cumulative.back();
+  size_t j = std::lower_bound(cumulative.begin() + 1, cumulative.end(), target) - cumulative.begin() - 1;
+  if (j + 1 >= cumulative.size()) return edges.back();
+  const double w = cumulative[j+1] - cumulative[j];
+  if (w <= 0.) return edges[j];
+  return edges[j] + (target - cumulative[j]) / w * (edges[j+1] - edges[j]);
+}
+
+
+void ResolutionEstimator::estimateRobust(const std::vector<double> & edges, const std::vector<double> & contents,
+                                         SliceResolution & res) const
+{
+  const size_t n = contents.size();
+  std::vector<double> cumulative(n + 1, 0.);
+  double sw = 0., swx = 0., swxx = 0.;
+  for (size_t j = 0; j < n; ++j)
+  {
+    const double w = std::max(contents[j], 0.);
+    const double x = 0.5 * (edges[j] + edges[j+1]);
+    cumulative[j+1] = cumulative[j] + w;
+    sw += w;
+    swx += w * x;
+    swxx += w * x * x;
+  }
+  res.entries = sw;
+  if (sw <= 0.) return;
+
+  res.mean = swx / sw;
+  res.rms = std::sqrt(std::max(swxx / sw - res.mean * res.mean, 0.));
+
+  res.iqrSigma = (quantile(edges, cumulative, 0.75) - quantile(edges, cumulative, 0.25)) / 1.349;
+
+  // RMS of the central fraction of the weight; the bins at the edges count with their overlap
+  const double lo = quantile(edges, cumulative, 0.5 * (1. - truncatedFraction_));
+  const double hi = quantile(edges, cumulative, 0.5 * (1. + truncatedFraction_));
+  double tw = 0., twx = 0., twxx = 0.;
+  for (size_t j = 0; j < n; ++j)
+  {
+    const double a = std::max(edges[j], lo);
+    const double b = std::min(edges[j+1], hi);
+    if (b <= a) continue;
+    const double w = std::max(contents[j], 0.) * (b - a) / (edges[j+1] - edges[j]);
+    const double x = 0.5 * (a + b);
+    tw += w;
+    twx += w * x;
+    twxx += w * x * x;
+  }
+  if (tw > 0.)
+  {
+    const double tmean = twx / tw;
+    res.truncRms = std::sqrt(std::max(twxx / tw - tmean * tmean, 0.));
+  }
+
+  // until refined
+  res.sigma = res.iqrSigma;
+  res.sigmaErr = res.iqrSigma / std::sqrt(2. * sw);
+}
+
+
+void ResolutionEstimator::refineLSQ(const std::vector<double> & edges, const std::vector<double> & contents,
+                                    SliceResolution & res) const
+{
+  double m = res.mean;
+  double s = res.iqrSigma > 0. ? res.iqrSigma : res.truncRms;
+  if (s <= 0.) return;
+
+  // log of a Gaussian is a parabola: ln y = a + b*x + c*x^2, with x relative to the current mean;
+  // the variance of ln y is ~1/y, so the bins are weighted with their contents
+  const int iterations = 3;
+  double core = 0.;
+  for (int it = 0; it < iterations; ++it)
+  {
+    const double lo = m - fitRange_ * s;
+    const double hi = m + fitRange_ * s;
+    double S[5] = {0., 0., 0., 0., 0.};
+    double T[3] = {0., 0., 0.};
+    int nbins = 0;
+    core = 0.;
+    for (size_t j = 0; j < contents.size(); ++j)
+    {
+      const double xc = 0.5 * (edges[j] + edges[j+1]);
+      if (xc < lo || xc > hi || contents[j] <= 0.) continue;
+      const double x = xc - m;
+      const double w = contents[j];
+      const double y = std::log(contents[j] / (edges[j+1] - edges[j]));
+      double xk = w;
+      for (int k = 0; k < 5; ++k) { S[k] += xk; if (k < 3) T[k] += xk * y; xk *= x; }
+      core += w;
+      ++nbins;
+    }
+    if (nbins < 3) return;
+
+    // normal equations by Cramer's rule
+    const double det = S[0]*(S[2]*S[4]-S[3]*S[3]) - S[1]*(S[1]*S[4]-S[3]*S[2]) + S[2]*(S[1]*S[3]-S[2]*S[2]);
+    if (det == 0.) return;
+    const double b = (S[0]*(T[1]*S[4]-S[3]*T[2]) - T[0]*(S[1]*S[4]-S[3]*S[2]) + S[2]*(S[1]*T[2]-T[1]*S[2])) / det;
+    const double c = (S[0]*(S[2]*T[2]-T[1]*S[3]) - S[1]*(S[1]*T[2]-T[1]*S[2]) + T[0]*(S[1]*S[3]-S[2]*S[2])) / det;
+    if (c >= 0.) return;
+
+    const double m_new = m - b / (2. * c);
+    const double s_new = std::sqrt(-1. / (2. * c));
+    if (m_new < lo || m_new > hi) return;
+    m = m_new;
+    s = s_new;
+  }
+
+  res.sigma = s;
+  const double delta = res.sigma - res.iqrSigma;
+  res.sigmaErr = std::sqrt(delta * delta + res.sigma * res.sigma / (2. * core));
+  res.fitted = true;
+}
+
+
+void ResolutionEstimator::refineTF1(const std::vector<double> & edges, const std::vector<double> & contents,
+                                    SliceResolution & res) const
+{
+  const double s = res.iqrSigma > 0. ? res.iqrSigma : res.truncRms;
+  if (s <= 0.) return;
+
+  TH1D slice("ResolutionEstimatorSlice", "", contents.size(), &edges[0]);
+  slice.SetDirectory(0);
+  double ymax = 0.;
+  for (size_t j = 0; j < contents.size(); ++j)
+  {
+    slice.SetBinContent(j + 1, contents[j]);
+    ymax = std::max(ymax, contents[j]);
+  }
+
+  TF1 gaus("ResolutionEstimatorGaus", "gaus", res.mean - fitRange_ * s, res.mean + fitRange_ * s);
+  gaus.SetParameters(ymax, res.mean, s);
+  // quiet, in the range, not stored in the histogram, not drawn
+  if (slice.Fit(&gaus, "QNR0") != 0) return;
+
+  res.sigma = std::fabs(gaus.GetParameter(2));
+  const double delta = res.sigma - res.iqrSigma;
+  res.sigmaErr = std::sqrt(delta * delta + gaus.GetParError(2) * gaus.GetParError(2));
+  res.fitted = true;
+}
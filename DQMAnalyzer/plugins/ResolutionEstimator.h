@@ -0,0 +1,77 @@
+#ifndef DQMAnalyzer_ResolutionEstimator_h
+#define DQMAnalyzer_ResolutionEstimator_h
+
+/**\class ResolutionEstimator
+
+ Width estimates of the Y distributions in the X slices of a 2D histogram
+ (e.g., the q/p resolution in bins of the simulated pT or eta).
+
+ The robust estimates are computed analytically from the bin contents of a slice:
+  - the RMS,
+  - the truncated RMS, i.e., the RMS of the central truncatedFraction of the entries,
+  - the interquartile-based sigma, IQR/1.349.
+ They seed a Gaussian refinement in mean +- fitRange*sigma, either
+  - GAUS_LSQ: an iterated weighted least squares fit of a parabola to the log of
+    the bin contents, which involves no ROOT objects, or
+  - GAUS_TF1: a ROOT fit with a stack-allocated TF1 (serial, since the ROOT fitting is not thread safe).
+
+ The slices are independent and each one is always summed in the same order,
+ so the results do not depend on whether (and with how many threads) they are processed in parallel.
+*/
+
+#include "TH2.h"
+
+#include <string>
+#include <vector>
+
+struct SliceResolution
+{
+  SliceResolution(): entries(0.), mean(0.), rms(0.), truncRms(0.), iqrSigma(0.), sigma(0.), sigmaErr(0.), fitted(false) {}
+
+  double entries;
+  double mean;
+  double rms;
+  double truncRms;
+  double iqrSigma;
+  // refined core width and its uncertainty (statistical and the difference from the IQR sigma)
+  double sigma;
+  double sigmaErr;
+  // false if the Gaussian refinement failed and sigma is the IQR sigma
+  bool fitted;
+};
+
+
+class ResolutionEstimator
+{
+public:
+
+  enum FitMode {GAUS_LSQ = 0, GAUS_TF1};
+
+  ResolutionEstimator(double truncatedFraction = 0.95, double fitRange = 2., FitMode fitMode = GAUS_LSQ, bool parallel = true);
+
+  /// "gausLSQ" or "gausTF1"; throws on anything else
+  static FitMode fitMode(const std::string & name);
+
+  /// estimates for the Y distribution with the given bin edges (size n+1) and contents (size n)
+  SliceResolution estimate(const std::vector<double> & edges, const std::vector<double> & contents) const;
+
+  /// estimates for all X slices (index 0 is X bin 1); slices without entries are left default
+  std::vector<SliceResolution> estimateSlices(const TH2 & histo) const;
+
+private:
+
+  // value below which the fraction p of the weight lies, linear within the bins
+  static double quantile(const std::vector<double> & edges, const std::vector<double> & cumulative, double p);
+
+  // robust estimates and the analytic Gaussian refinement
+  void estimateRobust(const std::vector<double> & edges, const std::vector<double> & contents, SliceResolution & res) const;
+  void refineLSQ(const std::vector<double> & edges, const std::vector<double> & contents, SliceResolution & res) const;
+  void refineTF1(const std::vector<double> & edges, const std::vector<double> & contents, SliceResolution & res) const;
+
+  double truncatedFraction_;
+  double fitRange_;
+  FitMode fitMode_;
+  bool parallel_;
+};
+
+#endif
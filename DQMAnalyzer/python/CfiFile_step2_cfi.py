@@ -5,5 +5,11 @@ DQMGEMSecondStep = cms.EDAnalyzer('DQMAnalyzerSTEP2',
   	#LocalFolder = cms.untracked.vstring("5GeV","10GeV","50GeV","100GeV","200GeV","500GeV","1000GeV"),
   	LocalFolder = cms.untracked.vstring("200GeV"),
   	SaveFile  = cms.untracked.bool(True),
-  	NameFile  = cms.untracked.string("GEMPlots.root")
+  	NameFile  = cms.untracked.string("GEMPlots.root"),
+  	## q/p resolution slices: RMS of the central fraction, Gaussian core fit in +-GausFitRange robust sigmas
+  	TruncatedRmsFraction = cms.untracked.double(0.95),
+  	GausFitRange = cms.untracked.double(2.),
+  	## "gausLSQ" (analytic, parallel slices) or "gausTF1" (ROOT fit, serial)
+  	ResolutionFit = cms.untracked.string("gausLSQ"),
+  	ParallelSlices = cms.untracked.bool(True)
 )
@@ -16,6 +16,7 @@
 #include "FWCore/Framework/interface/ESHandle.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/ServiceRegistry/interface/Service.h"
+#include "FWCore/Utilities/interface/Exception.h"
 #include "CommonTools/UtilAlgos/interface/TFileService.h"
 
 #include "DataFormats/MuonDetId/interface/CSCDetId.h"
@@ -30,9 +31,13 @@
 #include "Geometry/GEMGeometry/interface/GEMGeometry.h"
 
 #include "GEMCode/GEMValidation/src/SimTrackMatchManager.h"
+#include "GEMCode/GEMValidation/src/TreeBatchWriting.h"
+#include "GEMCode/GEMValidation/src/SimTrackMatchSidecar.h"
 
 #include "TTree.h"
 
+#include "tbb/parallel_for.h"
+
 #include <iomanip>
 #include <sstream>
 #include <memory>
@@ -44,6 +49,10 @@ using namespace matching;
 // "signed" LCT bend pattern
 const int LCT_BEND_PATTERN[11] = { -99,  -5,  4, -4,  3, -3,  2, -2,  1, -1,  0};
 
+// version of the SimTrack matching and of the ntuple rows made from it:
+// to be increased with any change of them, so that older match sidecars are not used
+const char * const MATCHING_CODE_VERSION = "GEMCSCAnalyzer-1";
+
 
 struct MyTrackChamberDelta
 {
@@ -77,10 +86,22 @@ struct MyTrackChamberDelta
 };
 
 
+// groups of MyTrackEff fields that can be switched off;
+// the core (kinematics and has_* efficiency flags) is always filled
+enum TrackEffFields
+{
+  EFF_LCT = 1,         // LCT bend, bx, halfstrip, position, dphi and quality
+  EFF_GEM_SH = 1 << 1, // GEM simhits mean eta and strip
+  EFF_GEM_DG = 1 << 2, // GEM digis median strip
+  EFF_GEM_PAD = 1 << 3, // best pad bx and position, and its deltas to LCT
+  EFF_ALL = EFF_LCT | EFF_GEM_SH | EFF_GEM_DG | EFF_GEM_PAD
+};
+
+
 struct MyTrackEff
 {
   void init(); // initialize to default values
-  TTree* book(TTree *t, const std::string & name = "trk_eff");
+  TTree* book(TTree *t, const std::string & name = "trk_eff", int fields = EFF_ALL);
 
   Float_t pt, eta, phi;
   Char_t charge;
@@ -199,7 +220,7 @@ void MyTrackEff::init()
 }
 
 
-TTree* MyTrackEff::book(TTree *t, const std::string & name)
+TTree* MyTrackEff::book(TTree *t, const std::string & name, int fields)
 {
   edm::Service< TFileService > fs;
   t = fs->make<TTree>(name.c_str(), name.c_str());
@@ -211,26 +232,32 @@ TTree* MyTrackEff::book(TTree *t, const std::string & name)
   t->Branch("endcap", &endcap);
   t->Branch("chamber_odd", &chamber_odd);
   t->Branch("chamber_even", &chamber_even);
-  t->Branch("quality_odd", &quality_odd);
-  t->Branch("quality_even", &quality_even);
+  if (fields & EFF_LCT)
+  {
+    t->Branch("quality_odd", &quality_odd);
+    t->Branch("quality_even", &quality_even);
+  }
   t->Branch("has_csc_sh", &has_csc_sh);
   t->Branch("has_csc_strips", &has_csc_strips);
   t->Branch("has_csc_wires", &has_csc_wires);
   t->Branch("has_clct", &has_clct);
   t->Branch("has_alct", &has_alct);
   t->Branch("has_lct", &has_lct);
-  t->Branch("bend_lct_odd", &bend_lct_odd);
-  t->Branch("bend_lct_even", &bend_lct_even);
-  t->Branch("bx_lct_odd", &bx_lct_odd);
-  t->Branch("bx_lct_even", &bx_lct_even);
-  t->Branch("hs_lct_odd", &hs_lct_odd);
-  t->Branch("hs_lct_even", &hs_lct_even);
-  t->Branch("phi_lct_odd", &phi_lct_odd);
-  t->Branch("phi_lct_even", &phi_lct_even);
-  t->Branch("eta_lct_odd", &eta_lct_odd);
-  t->Branch("eta_lct_even", &eta_lct_even);
-  t->Branch("dphi_lct_odd", &dphi_lct_odd);
-  t->Branch("dphi_lct_even", &dphi_lct_even);
+  if (fields & EFF_LCT)
+  {
+    t->Branch("bend_lct_odd", &bend_lct_odd);
+    t->Branch("bend_lct_even", &bend_lct_even);
+    t->Branch("bx_lct_odd", &bx_lct_odd);
+    t->Branch("bx_lct_even", &bx_lct_even);
+    t->Branch("hs_lct_odd", &hs_lct_odd);
+    t->Branch("hs_lct_even", &hs_lct_even);
+    t->Branch("phi_lct_odd", &phi_lct_odd);
+    t->Branch("phi_lct_even", &phi_lct_even);
+    t->Branch("eta_lct_odd", &eta_lct_odd);
+    t->Branch("eta_lct_even", &eta_lct_even);
+    t->Branch("dphi_lct_odd", &dphi_lct_odd);
+    t->Branch("dphi_lct_even", &dphi_lct_even);
+  }
 
   t->Branch("has_gem_sh", &has_gem_sh);
   t->Branch("has_gem_sh2", &has_gem_sh2);
@@ -239,23 +266,32 @@ TTree* MyTrackEff::book(TTree *t, const std::string & name)
   t->Branch("has_gem_pad", &has_gem_pad);
   t->Branch("has_gem_pad2", &has_gem_pad2);
   t->Branch("has_gem_copad", &has_gem_copad);
-  t->Branch("strip_gemsh_odd", &strip_gemsh_odd);
-  t->Branch("strip_gemsh_even", &strip_gemsh_even);
-  t->Branch("eta_gemsh_odd", &eta_gemsh_odd);
-  t->Branch("eta_gemsh_even", &eta_gemsh_even);
-  t->Branch("strip_gemdg_odd", &strip_gemdg_odd);
-  t->Branch("strip_gemdg_even", &strip_gemdg_even);
-
-  t->Branch("bx_pad_odd", &bx_pad_odd);
-  t->Branch("bx_pad_even", &bx_pad_even);
-  t->Branch("phi_pad_odd", &phi_pad_odd);
-  t->Branch("phi_pad_even", &phi_pad_even);
-  t->Branch("eta_pad_odd", &eta_pad_odd);
-  t->Branch("eta_pad_even", &eta_pad_even);
-  t->Branch("dphi_pad_odd", &dphi_pad_odd);
-  t->Branch("dphi_pad_even", &dphi_pad_even);
-  t->Branch("deta_pad_odd", &deta_pad_odd);
-  t->Branch("deta_pad_even", &deta_pad_even);
+  if (fields & EFF_GEM_SH)
+  {
+    t->Branch("strip_gemsh_odd", &strip_gemsh_odd);
+    t->Branch("strip_gemsh_even", &strip_gemsh_even);
+    t->Branch("eta_gemsh_odd", &eta_gemsh_odd);
+    t->Branch("eta_gemsh_even", &eta_gemsh_even);
+  }
+  if (fields & EFF_GEM_DG)
+  {
+    t->Branch("strip_gemdg_odd", &strip_gemdg_odd);
+    t->Branch("strip_gemdg_even", &strip_gemdg_even);
+  }
+
+  if (fields & EFF_GEM_PAD)
+  {
+    t->Branch("bx_pad_odd", &bx_pad_odd);
+    t->Branch("bx_pad_even", &bx_pad_even);
+    t->Branch("phi_pad_odd", &phi_pad_odd);
+    t->Branch("phi_pad_even", &phi_pad_even);
+    t->Branch("eta_pad_odd", &eta_pad_odd);
+    t->Branch("eta_pad_even", &eta_pad_even);
+    t->Branch("dphi_pad_odd", &dphi_pad_odd);
+    t->Branch("dphi_pad_even", &dphi_pad_even);
+    t->Branch("deta_pad_odd", &deta_pad_odd);
+    t->Branch("deta_pad_even", &deta_pad_even);
+  }
 
   //t->Branch("", &);
   
@@ -276,17 +312,32 @@ public:
 
   virtual void analyze(const edm::Event&, const edm::EventSetup&);
 
+  virtual void endJob();
+
   static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
   
 private:
   
   void bookSimTracksDeltaTree();
 
-  void analyzeTrackChamberDeltas(SimTrackMatchManager& match, int trk_no);
-  void analyzeTrackEff(SimTrackMatchManager& match, int trk_no);
+  // ntuple rows made for one SimTrack
+  struct TrackRecords
+  {
+    MyTrackEff etrk[5];
+    std::vector<MyTrackChamberDelta> deltas;
+  };
+
+  void analyzeTrackChamberDeltas(SimTrackMatchManager& match, int trk_no, TrackRecords& rec);
+  void analyzeTrackEff(SimTrackMatchManager& match, int trk_no, TrackRecords& rec);
+
+  // fills the ntuples with the rows of a track
+  void fillTrees(const TrackRecords& rec);
 
   bool isSimTrackGood(const SimTrack &t);
 
+  // mask of TrackEffFields from the names of the field groups
+  static int trackEffFieldsMask(const std::vector<std::string>& names);
+
   edm::ParameterSet cfg_;
   std::string simInputLabel_;
   float minPt_;
@@ -295,10 +346,17 @@ private:
   int verbose_;
   bool ntupleTrackChamberDelta_;
   bool ntupleTrackEff_;
+  int trackEffFields_;
+  bool parallelTrackMatching_;
+  unsigned ntupleBatchSize_;
+  int ntupleCompression_;
   std::set<int> stations_to_use_;
 
   TTree *tree_eff_[5]; // for up to 4 stations
   TTree *tree_delta_;
+
+  // persisted matching results of the selected SimTracks
+  SimTrackMatchSidecar sidecar_;
   
   MyTrackEff  etrk_[5];
   MyTrackChamberDelta dtrk_;
@@ -314,6 +372,11 @@ GEMCSCAnalyzer::GEMCSCAnalyzer(const edm::ParameterSet& ps)
 , verbose_(ps.getUntrackedParameter<int>("verbose", 0))
 , ntupleTrackChamberDelta_(ps.getUntrackedParameter<bool>("ntupleTrackChamberDelta", true))
 , ntupleTrackEff_(ps.getUntrackedParameter<bool>("ntupleTrackEff", true))
+, trackEffFields_(trackEffFieldsMask(ps.getUntrackedParameter<std::vector<std::string> >("trackEffFields",
+      {"lct", "gemSimHits", "gemDigis", "gemPads"})))
+, parallelTrackMatching_(ps.getUntrackedParameter<bool>("parallelTrackMatching", false))
+, ntupleBatchSize_(ps.getUntrackedParameter<unsigned>("ntupleBatchSize", 0))
+, ntupleCompression_(ps.getUntrackedParameter<int>("ntupleCompression", -1))
 {
   if (ntupleTrackChamberDelta_) bookSimTracksDeltaTree();
   if (ntupleTrackEff_)
@@ -324,9 +387,26 @@ GEMCSCAnalyzer::GEMCSCAnalyzer(const edm::ParameterSet& ps)
     {
       stringstream ss;
       ss << "trk_eff_st"<< s;
-      tree_eff_[s] = etrk_[s].book(tree_eff_[s], ss.str());
+      tree_eff_[s] = etrk_[s].book(tree_eff_[s], ss.str(), trackEffFields_);
+      setTreeBatchWriting(tree_eff_[s], ntupleBatchSize_, ntupleCompression_);
     }
   }
+
+  // the sidecar rows depend on everything that affects the matching and the ntuple contents
+  std::ostringstream cfg_summary;
+  cfg_summary << simInputLabel_ << " " << minPt_ << " " << minEta_ << " " << maxEta_
+              << " " << ntupleTrackChamberDelta_ << " " << ntupleTrackEff_ << " " << trackEffFields_ << " st";
+  for (auto s: stations_to_use_) cfg_summary << " " << s;
+  const std::string hash = SimTrackMatchSidecar::configHash(MATCHING_CODE_VERSION, cfg_, {cfg_summary.str()});
+
+  const std::string sidecar_in = ps.getUntrackedParameter<std::string>("matchSidecarInput", "");
+  const std::string sidecar_out = ps.getUntrackedParameter<std::string>("matchSidecarOutput", "");
+  if (!sidecar_in.empty()) sidecar_.openForReading(sidecar_in, hash);
+  else if (!sidecar_out.empty()) sidecar_.openForWriting(sidecar_out, hash);
+
+  // a failed registration leaves the sidecar unused, and the following ones are no-ops
+  if (ntupleTrackChamberDelta_) sidecar_.addTree(tree_delta_);
+  if (ntupleTrackEff_) for (auto s: stations_to_use_) sidecar_.addTree(tree_eff_[s]);
 }
 
 
@@ -336,6 +416,23 @@ void GEMCSCAnalyzer::beginRun(const edm::Run &iRun, const edm::EventSetup &iSetu
 }
 
 
+int GEMCSCAnalyzer::trackEffFieldsMask(const std::vector<std::string>& names)
+{
+  int mask = 0;
+  for (auto& n: names)
+  {
+    if      (n == "lct") mask |= EFF_LCT;
+    else if (n == "gemSimHits") mask |= EFF_GEM_SH;
+    else if (n == "gemDigis") mask |= EFF_GEM_DG;
+    else if (n == "gemPads") mask |= EFF_GEM_PAD;
+    else throw cms::Exception("Configuration")
+      << "GEMCSCAnalyzer: unknown trackEffFields group '" << n
+      << "'; the known ones are: lct gemSimHits gemDigis gemPads\n";
+  }
+  return mask;
+}
+
+
 bool GEMCSCAnalyzer::isSimTrackGood(const SimTrack &t)
 {
   // SimTrack selection
@@ -400,24 +497,78 @@ void GEMCSCAnalyzer::analyze(const edm::Event& ev, const edm::EventSetup& es)
         <<endl;
   }
   */
-  int trk_no=0;
+  if (sidecar_.get(ev, *sim_tracks.product()))
+  {
+    // the matching was done in a previous job with the same configuration and input
+    if (ntupleTrackChamberDelta_) sidecar_.replay(tree_delta_);
+    if (ntupleTrackEff_) for (auto s: stations_to_use_) sidecar_.replay(tree_eff_[s]);
+    return;
+  }
+
+  std::vector<const SimTrack*> good_tracks;
   for (auto& t: *sim_tracks.product())
   {
-    if (!isSimTrackGood(t)) continue;
+    if (isSimTrackGood(t)) good_tracks.push_back(&t);
+  }
+
+  // every track fills only its own slot, so the tracks can be matched in any order
+  std::vector<TrackRecords> slots(good_tracks.size());
+  auto process = [&](size_t trk_no)
+  {
+    const SimTrack& t = *good_tracks[trk_no];
 
     // match hits and digis to this SimTrack
     SimTrackMatchManager match(t, sim_vert[t.vertIndex()], cfg_, ev, es);
 
-    if (ntupleTrackChamberDelta_) analyzeTrackChamberDeltas(match, trk_no);
-    if (ntupleTrackEff_) analyzeTrackEff(match, trk_no);
+    if (ntupleTrackChamberDelta_) analyzeTrackChamberDeltas(match, trk_no, slots[trk_no]);
+    if (ntupleTrackEff_) analyzeTrackEff(match, trk_no, slots[trk_no]);
+  };
+
+  // the printouts would get interleaved, so debugging is always serial
+  if (parallelTrackMatching_ && verbose_ == 0 && slots.size() > 1)
+  {
+    // the 1st track reads in all the event products the matchers need,
+    // so that the concurrent tracks only access already loaded data
+    process(0);
+    tbb::parallel_for(size_t(1), slots.size(), process);
+  }
+  else
+  {
+    for (size_t trk_no = 0; trk_no < slots.size(); ++trk_no) process(trk_no);
+  }
+
+  // the rows are stored in the SimTracks order, as in the serial matching
+  for (auto& rec: slots) fillTrees(rec);
+
+  sidecar_.put(ev, *sim_tracks.product());
+}
+
 
-    trk_no++;
+void GEMCSCAnalyzer::fillTrees(const TrackRecords& rec)
+{
+  if (ntupleTrackChamberDelta_)
+  {
+    for (auto& d: rec.deltas)
+    {
+      dtrk_ = d;
+      tree_delta_->Fill();
+      sidecar_.fill(tree_delta_);
+    }
+  }
+  if (ntupleTrackEff_)
+  {
+    for (auto s: stations_to_use_)
+    {
+      etrk_[s] = rec.etrk[s];
+      tree_eff_[s]->Fill();
+      sidecar_.fill(tree_eff_[s]);
+    }
   }
 }
 
 
 
-void GEMCSCAnalyzer::analyzeTrackEff(SimTrackMatchManager& match, int trk_no)
+void GEMCSCAnalyzer::analyzeTrackEff(SimTrackMatchManager& match, int trk_no, TrackRecords& rec)
 {
   const SimHitMatcher& match_sh = match.simhits();
   const GEMDigiMatcher& match_gd = match.gemDigis();
@@ -425,16 +576,18 @@ void GEMCSCAnalyzer::analyzeTrackEff(SimTrackMatchManager& match, int trk_no)
   const CSCStubMatcher& match_lct = match.cscStubs();
   const SimTrack &t = match_sh.trk();
 
+  const bool do_lct = trackEffFields_ & EFF_LCT;
+  const bool do_pad = trackEffFields_ & EFF_GEM_PAD;
 
   for (auto s: stations_to_use_)
   {
-    etrk_[s].init();
+    rec.etrk[s].init();
 
-    etrk_[s].pt = t.momentum().pt();
-    etrk_[s].phi = t.momentum().phi();
-    etrk_[s].eta = t.momentum().eta();
-    etrk_[s].charge = t.charge();
-    etrk_[s].endcap = (etrk_[s].eta > 0.) ? 1 : -1;
+    rec.etrk[s].pt = t.momentum().pt();
+    rec.etrk[s].phi = t.momentum().phi();
+    rec.etrk[s].eta = t.momentum().eta();
+    rec.etrk[s].charge = t.charge();
+    rec.etrk[s].endcap = (rec.etrk[s].eta > 0.) ? 1 : -1;
   }
 
   // SimHits
@@ -448,8 +601,8 @@ void GEMCSCAnalyzer::analyzeTrackEff(SimTrackMatchManager& match, int trk_no)
     int nlayers = match_sh.nLayersWithHitsInSuperChamber(d);
     if (nlayers < 4) continue;
 
-    if (id.chamber() & 1) etrk_[st].has_csc_sh |= 1;
-    else etrk_[st].has_csc_sh |= 2;
+    if (id.chamber() & 1) rec.etrk[st].has_csc_sh |= 1;
+    else rec.etrk[st].has_csc_sh |= 2;
 
     //const auto& hits = match_sh.hitsInChamber(d);
     //auto gp = match_sh.simHitsMeanPosition(hits);
@@ -468,8 +621,8 @@ void GEMCSCAnalyzer::analyzeTrackEff(SimTrackMatchManager& match, int trk_no)
     int nlayers = match_cd.nLayersWithStripInChamber(d);
     if (nlayers < 4) continue;
 
-    if (id.chamber() & 1) etrk_[st].has_csc_strips |= 1;
-    else etrk_[st].has_csc_strips |= 2;
+    if (id.chamber() & 1) rec.etrk[st].has_csc_strips |= 1;
+    else rec.etrk[st].has_csc_strips |= 2;
   }
 
   // CSC wire digis
@@ -483,8 +636,8 @@ void GEMCSCAnalyzer::analyzeTrackEff(SimTrackMatchManager& match, int trk_no)
     int nlayers = match_cd.nLayersWithWireInChamber(d);
     if (nlayers < 4) continue;
 
-    if (id.chamber() & 1) etrk_[st].has_csc_wires |= 1;
-    else etrk_[st].has_csc_wires |= 2;
+    if (id.chamber() & 1) rec.etrk[st].has_csc_wires |= 1;
+    else rec.etrk[st].has_csc_wires |= 2;
   }
 
   // CSC CLCTs
@@ -498,8 +651,8 @@ void GEMCSCAnalyzer::analyzeTrackEff(SimTrackMatchManager& match, int trk_no)
 
     bool odd = id.chamber() & 1;
 
-    if (odd) etrk_[st].has_clct |= 1;
-    else etrk_[st].has_clct |= 2;
+    if (odd) rec.etrk[st].has_clct |= 1;
+    else rec.etrk[st].has_clct |= 2;
   }
 
   // CSC ALCTs
@@ -513,8 +666,8 @@ void GEMCSCAnalyzer::analyzeTrackEff(SimTrackMatchManager& match, int trk_no)
 
     bool odd = id.chamber() & 1;
 
-    if (odd) etrk_[st].has_alct |= 1;
-    else etrk_[st].has_alct |= 2;
+    if (odd) rec.etrk[st].has_alct |= 1;
+    else rec.etrk[st].has_alct |= 2;
   }
 
   // holders for track's LCTs
@@ -539,12 +692,16 @@ void GEMCSCAnalyzer::analyzeTrackEff(SimTrackMatchManager& match, int trk_no)
 
     bool odd = id.chamber() & 1;
 
-    if (odd) etrk_[st].has_lct |= 1;
-    else etrk_[st].has_lct |= 2;
+    if (odd) rec.etrk[st].has_lct |= 1;
+    else rec.etrk[st].has_lct |= 2;
 
-    auto lct = match_lct.lctInChamber(d);
+    if (odd) rec.etrk[st].chamber_odd |= 2;
+    else rec.etrk[st].chamber_even |= 2;
 
-    int bend = LCT_BEND_PATTERN[digi_pattern(lct)];
+    // the LCT position is needed for its own fields or to find the closest pad
+    if (!do_lct && !do_pad) continue;
+
+    auto lct = match_lct.lctInChamber(d);
     auto gp = match_lct.digiPosition(lct);
     //cout<<"DBGCSC "<<id.endcap()<<" "<<id.chamber()<<" "<<gp.eta()<<endl;
     //if(std::abs(gp.phi())<0.0001)
@@ -556,27 +713,34 @@ void GEMCSCAnalyzer::analyzeTrackEff(SimTrackMatchManager& match, int trk_no)
     {
       lct_odd[st] = lct;
       gp_lct_odd[st] = gp;
-      etrk_[st].bend_lct_odd = bend;
-      etrk_[st].phi_lct_odd = gp.phi();
-      etrk_[st].eta_lct_odd = gp.eta();
-      etrk_[st].dphi_lct_odd = digi_dphi(lct);
-      etrk_[st].bx_lct_odd = digi_bx(lct);
-      etrk_[st].hs_lct_odd = digi_channel(lct);
-      etrk_[st].chamber_odd |= 2;
-      etrk_[st].quality_odd = digi_quality(lct);
     }
     else
     {
       lct_even[st] = lct;
       gp_lct_even[st] = gp;
-      etrk_[st].bend_lct_even = bend;
-      etrk_[st].phi_lct_even = gp.phi();
-      etrk_[st].eta_lct_even = gp.eta();
-      etrk_[st].dphi_lct_even = digi_dphi(lct);
-      etrk_[st].bx_lct_even = digi_bx(lct);
-      etrk_[st].hs_lct_even = digi_channel(lct);
-      etrk_[st].chamber_even |= 2;
-      etrk_[st].quality_even = digi_quality(lct);
+    }
+    if (!do_lct) continue;
+
+    int bend = LCT_BEND_PATTERN[digi_pattern(lct)];
+    if (odd)
+    {
+      rec.etrk[st].bend_lct_odd = bend;
+      rec.etrk[st].phi_lct_odd = gp.phi();
+      rec.etrk[st].eta_lct_odd = gp.eta();
+      rec.etrk[st].dphi_lct_odd = digi_dphi(lct);
+      rec.etrk[st].bx_lct_odd = digi_bx(lct);
+      rec.etrk[st].hs_lct_odd = digi_channel(lct);
+      rec.etrk[st].quality_odd = digi_quality(lct);
+    }
+    else
+    {
+      rec.etrk[st].bend_lct_even = bend;
+      rec.etrk[st].phi_lct_even = gp.phi();
+      rec.etrk[st].eta_lct_even = gp.eta();
+      rec.etrk[st].dphi_lct_even = digi_dphi(lct);
+      rec.etrk[st].bx_lct_even = digi_bx(lct);
+      rec.etrk[st].hs_lct_even = digi_channel(lct);
+      rec.etrk[st].quality_even = digi_quality(lct);
     }
   }
 
@@ -592,22 +756,25 @@ void GEMCSCAnalyzer::analyzeTrackEff(SimTrackMatchManager& match, int trk_no)
 
     if (match_sh.hitsInSuperChamber(d).size() > 0)
     {
-      if (odd) etrk_[st].has_gem_sh |= 1;
-      else     etrk_[st].has_gem_sh |= 2;
+      if (odd) rec.etrk[st].has_gem_sh |= 1;
+      else     rec.etrk[st].has_gem_sh |= 2;
+    }
 
+    if ((trackEffFields_ & EFF_GEM_SH) && match_sh.hitsInSuperChamber(d).size() > 0)
+    {
       auto sh_gp = match_sh.simHitsMeanPosition(match_sh.hitsInSuperChamber(d));
-      if (odd) etrk_[st].eta_gemsh_odd = sh_gp.eta();
-      else     etrk_[st].eta_gemsh_even = sh_gp.eta();
+      if (odd) rec.etrk[st].eta_gemsh_odd = sh_gp.eta();
+      else     rec.etrk[st].eta_gemsh_even = sh_gp.eta();
 
       float mean_strip = match_sh.simHitsMeanStrip(match_sh.hitsInSuperChamber(d));
-      if (odd) etrk_[st].strip_gemsh_odd = mean_strip;
-      else     etrk_[st].strip_gemsh_even = mean_strip;
+      if (odd) rec.etrk[st].strip_gemsh_odd = mean_strip;
+      else     rec.etrk[st].strip_gemsh_even = mean_strip;
     }
 
     if (match_sh.nLayersWithHitsInSuperChamber(d) > 1)
     {
-      if (odd) etrk_[st].has_gem_sh2 |= 1;
-      else     etrk_[st].has_gem_sh2 |= 2;
+      if (odd) rec.etrk[st].has_gem_sh2 |= 1;
+      else     rec.etrk[st].has_gem_sh2 |= 2;
     }
   }
 
@@ -627,59 +794,62 @@ void GEMCSCAnalyzer::analyzeTrackEff(SimTrackMatchManager& match, int trk_no)
 
     if (match_gd.nLayersWithDigisInSuperChamber(d) > 1)
     {
-      if (odd) etrk_[st].has_gem_dg2 |= 1;
-      else     etrk_[st].has_gem_dg2 |= 2;
+      if (odd) rec.etrk[st].has_gem_dg2 |= 1;
+      else     rec.etrk[st].has_gem_dg2 |= 2;
     }
 
     auto digis = match_gd.digisInSuperChamber(d);
-    int median_strip = match_gd.median(digis);
-    if (odd && digis.size() > 0)
+    if (digis.size() > 0)
     {
-      etrk_[st].has_gem_dg |= 1;
-      etrk_[st].strip_gemdg_odd = median_strip;
+      if (odd) rec.etrk[st].has_gem_dg |= 1;
+      else     rec.etrk[st].has_gem_dg |= 2;
     }
-    else if (digis.size() > 0)
+    if ((trackEffFields_ & EFF_GEM_DG) && digis.size() > 0)
     {
-      etrk_[st].has_gem_dg |= 2;
-      etrk_[st].strip_gemdg_even = median_strip;
+      int median_strip = match_gd.median(digis);
+      if (odd) rec.etrk[st].strip_gemdg_odd = median_strip;
+      else     rec.etrk[st].strip_gemdg_even = median_strip;
     }
 
     if (match_gd.nLayersWithPadsInSuperChamber(d) > 1)
     {
-      if (odd) etrk_[st].has_gem_pad2 |= 1;
-      else     etrk_[st].has_gem_pad2 |= 2;
+      if (odd) rec.etrk[st].has_gem_pad2 |= 1;
+      else     rec.etrk[st].has_gem_pad2 |= 2;
     }
 
     auto pads = match_gd.padsInSuperChamber(d);
     if(pads.size() == 0) continue;
     if (odd)
     {
-      etrk_[st].has_gem_pad |= 1;
-      etrk_[st].chamber_odd |= 1;
-      if (is_valid(lct_odd[st]))
+      rec.etrk[st].has_gem_pad |= 1;
+      rec.etrk[st].chamber_odd |= 1;
+      if (do_pad && is_valid(lct_odd[st]))
       {
         auto gem_dg_and_gp = match_gd.digiInGEMClosestToCSC(pads, gp_lct_odd[st]);
         best_pad_odd[st] = gem_dg_and_gp.second;
-        etrk_[st].bx_pad_odd = digi_bx(gem_dg_and_gp.first);
-        etrk_[st].phi_pad_odd = best_pad_odd[st].phi();
-        etrk_[st].eta_pad_odd = best_pad_odd[st].eta();
-        etrk_[st].dphi_pad_odd = deltaPhi(etrk_[st].phi_lct_odd, etrk_[st].phi_pad_odd);
-        etrk_[st].deta_pad_odd = etrk_[st].eta_lct_odd - etrk_[st].eta_pad_odd;
+        rec.etrk[st].bx_pad_odd = digi_bx(gem_dg_and_gp.first);
+        rec.etrk[st].phi_pad_odd = best_pad_odd[st].phi();
+        rec.etrk[st].eta_pad_odd = best_pad_odd[st].eta();
+        // the LCT fields might not be filled
+        const Float_t phi_lct = gp_lct_odd[st].phi(), eta_lct = gp_lct_odd[st].eta();
+        rec.etrk[st].dphi_pad_odd = deltaPhi(phi_lct, rec.etrk[st].phi_pad_odd);
+        rec.etrk[st].deta_pad_odd = eta_lct - rec.etrk[st].eta_pad_odd;
       }
     }
     else
     {
-      etrk_[st].has_gem_pad |= 2;
-      etrk_[st].chamber_even |= 1;
-      if (is_valid(lct_even[st]))
+      rec.etrk[st].has_gem_pad |= 2;
+      rec.etrk[st].chamber_even |= 1;
+      if (do_pad && is_valid(lct_even[st]))
       {
         auto gem_dg_and_gp = match_gd.digiInGEMClosestToCSC(pads, gp_lct_even[st]);
         best_pad_even[st] = gem_dg_and_gp.second;
-        etrk_[st].bx_pad_even = digi_bx(gem_dg_and_gp.first);
-        etrk_[st].phi_pad_even = best_pad_even[st].phi();
-        etrk_[st].eta_pad_even = best_pad_even[st].eta();
-        etrk_[st].dphi_pad_even = deltaPhi(etrk_[st].phi_lct_even, etrk_[st].phi_pad_even);
-        etrk_[st].deta_pad_even = etrk_[st].eta_lct_even - etrk_[st].eta_pad_even;
+        rec.etrk[st].bx_pad_even = digi_bx(gem_dg_and_gp.first);
+        rec.etrk[st].phi_pad_even = best_pad_even[st].phi();
+        rec.etrk[st].eta_pad_even = best_pad_even[st].eta();
+        const Float_t phi_lct = gp_lct_even[st].phi(), eta_lct = gp_lct_even[st].eta();
+        rec.etrk[st].dphi_pad_even = deltaPhi(phi_lct, rec.etrk[st].phi_pad_even);
+        rec.etrk[st].deta_pad_even = eta_lct - rec.etrk[st].eta_pad_even;
       }
     }
   }
@@ -692,20 +862,17 @@ void GEMCSCAnalyzer::analyzeTrackEff(SimTrackMatchManager& match, int trk_no)
     if (stations_to_use_.count(st) == 0) continue;
 
     bool odd = id.chamber() & 1;
-    if (odd) etrk_[st].has_gem_copad |= 1;
-    else     etrk_[st].has_gem_copad |= 2;
+    if (odd) rec.etrk[st].has_gem_copad |= 1;
+    else     rec.etrk[st].has_gem_copad |= 2;
   }
 
-  for (auto s: stations_to_use_)
-  {
-    tree_eff_[s]->Fill();
-  }
 }
 
 
 
-void GEMCSCAnalyzer::analyzeTrackChamberDeltas(SimTrackMatchManager& match, int trk_no)
+void GEMCSCAnalyzer::analyzeTrackChamberDeltas(SimTrackMatchManager& match, int trk_no, TrackRecords& rec)
 {
+  MyTrackChamberDelta dtrk;
   const SimHitMatcher& match_sh = match.simhits();
   const GEMDigiMatcher& match_gd = match.gemDigis();
   const CSCDigiMatcher& match_cd = match.cscDigis();
@@ -838,10 +1005,10 @@ void GEMCSCAnalyzer::analyzeTrackChamberDeltas(SimTrackMatchManager& match, int
        match_cd.nCoincidenceStripChambers(4) > 0 &&
        match_cd.nCoincidenceWireChambers(4) > 0 )
   {
-    dtrk_.pt = t.momentum().pt();
-    dtrk_.phi = t.momentum().phi();
-    dtrk_.eta = t.momentum().eta();
-    dtrk_.charge = t.charge();
+    dtrk.pt = t.momentum().pt();
+    dtrk.phi = t.momentum().phi();
+    dtrk.eta = t.momentum().eta();
+    dtrk.charge = t.charge();
 
     auto csc_sd_ch_ids = match_cd.chamberIdsStrip();
     auto gem_d_sch_ids = match_gd.superChamberIds();
@@ -916,41 +1083,41 @@ void GEMCSCAnalyzer::analyzeTrackChamberDeltas(SimTrackMatchManager& match, int
         */
         GEMDetId id_of_best_gem(digi_id(best_gem_pad));
 
-        dtrk_.odd = is_odd;
-        dtrk_.chamber = csc_id.chamber();
-        dtrk_.endcap = csc_id.endcap();
-        dtrk_.roll = id_of_best_gem.roll();
-        dtrk_.csc_sh_phi = csc_sh_gp.phi();
-        dtrk_.csc_dg_phi = csc_dg_gp.phi();
-        dtrk_.gem_sh_phi = gem_sh_gp.phi();
-        dtrk_.gem_dg_phi = gem_dg_gp.phi();
-        dtrk_.gem_pad_phi = gem_pad_gp.phi();
-        dtrk_.dphi_sh = deltaPhi(csc_sh_gp.phi(), gem_sh_gp.phi());
-        dtrk_.dphi_dg = deltaPhi(csc_dg_gp.phi(), gem_dg_gp.phi());
-        dtrk_.dphi_pad = deltaPhi(csc_dg_gp.phi(), gem_pad_gp.phi());
-        dtrk_.csc_sh_eta = csc_sh_gp.eta();
-        dtrk_.csc_dg_eta = csc_dg_gp.eta();
-        dtrk_.gem_sh_eta = gem_sh_gp.eta();
-        dtrk_.gem_dg_eta = gem_dg_gp.eta();
-        dtrk_.gem_pad_eta = gem_pad_gp.eta();
-        dtrk_.deta_sh = csc_sh_gp.eta() - gem_sh_gp.eta();
-        dtrk_.deta_dg = csc_dg_gp.eta() - gem_dg_gp.eta();
-        dtrk_.deta_pad = csc_dg_gp.eta() - gem_pad_gp.eta();
-        dtrk_.bend = -99;
-        dtrk_.csc_lct_phi = -99.;
-        dtrk_.dphi_lct_pad = -99.;
-        dtrk_.csc_lct_eta = -99.;
-        dtrk_.deta_lct_pad = -99.;
+        dtrk.odd = is_odd;
+        dtrk.chamber = csc_id.chamber();
+        dtrk.endcap = csc_id.endcap();
+        dtrk.roll = id_of_best_gem.roll();
+        dtrk.csc_sh_phi = csc_sh_gp.phi();
+        dtrk.csc_dg_phi = csc_dg_gp.phi();
+        dtrk.gem_sh_phi = gem_sh_gp.phi();
+        dtrk.gem_dg_phi = gem_dg_gp.phi();
+        dtrk.gem_pad_phi = gem_pad_gp.phi();
+        dtrk.dphi_sh = deltaPhi(csc_sh_gp.phi(), gem_sh_gp.phi());
+        dtrk.dphi_dg = deltaPhi(csc_dg_gp.phi(), gem_dg_gp.phi());
+        dtrk.dphi_pad = deltaPhi(csc_dg_gp.phi(), gem_pad_gp.phi());
+        dtrk.csc_sh_eta = csc_sh_gp.eta();
+        dtrk.csc_dg_eta = csc_dg_gp.eta();
+        dtrk.gem_sh_eta = gem_sh_gp.eta();
+        dtrk.gem_dg_eta = gem_dg_gp.eta();
+        dtrk.gem_pad_eta = gem_pad_gp.eta();
+        dtrk.deta_sh = csc_sh_gp.eta() - gem_sh_gp.eta();
+        dtrk.deta_dg = csc_dg_gp.eta() - gem_dg_gp.eta();
+        dtrk.deta_pad = csc_dg_gp.eta() - gem_pad_gp.eta();
+        dtrk.bend = -99;
+        dtrk.csc_lct_phi = -99.;
+        dtrk.dphi_lct_pad = -99.;
+        dtrk.csc_lct_eta = -99.;
+        dtrk.deta_lct_pad = -99.;
         if (std::abs(csc_lct_gp.z()) > 0.001)
         {
-          dtrk_.bend = LCT_BEND_PATTERN[digi_pattern(lct_digi)];
-          dtrk_.csc_lct_phi = csc_lct_gp.phi();
-          dtrk_.dphi_lct_pad = deltaPhi(csc_lct_gp.phi(), gem_pad_gp.phi());
-          dtrk_.csc_lct_eta = csc_lct_gp.eta();
-          dtrk_.deta_lct_pad = csc_lct_gp.eta() - gem_pad_gp.eta();
+          dtrk.bend = LCT_BEND_PATTERN[digi_pattern(lct_digi)];
+          dtrk.csc_lct_phi = csc_lct_gp.phi();
+          dtrk.dphi_lct_pad = deltaPhi(csc_lct_gp.phi(), gem_pad_gp.phi());
+          dtrk.csc_lct_eta = csc_lct_gp.eta();
+          dtrk.deta_lct_pad = csc_lct_gp.eta() - gem_pad_gp.eta();
         }
 
-        tree_delta_->Fill();
+        rec.deltas.push_back(dtrk);
 
         /*
         if (csc_id.endcap()==1)
@@ -969,9 +1136,9 @@ void GEMCSCAnalyzer::analyzeTrackChamberDeltas(SimTrackMatchManager& match, int
           cout<<"got match "<<csc_id<<"  "<<gem_id<<endl;
           cout<<"matchdphis "<<is_odd<<" "<<csc_id.chamber()<<" "
               <<csc_sh_gp.phi()<<" "<<csc_dg_gp.phi()<<" "<<gem_sh_gp.phi()<<" "<<gem_dg_gp.phi()<<" "<<gem_pad_gp.phi()<<" "
-              <<dtrk_.dphi_sh<<" "<<dtrk_.dphi_dg<<" "<<dtrk_.dphi_pad<<"   "
+              <<dtrk.dphi_sh<<" "<<dtrk.dphi_dg<<" "<<dtrk.dphi_pad<<"   "
               <<csc_sh_gp.eta()<<" "<<csc_dg_gp.eta()<<" "<<gem_sh_gp.eta()<<" "<<gem_dg_gp.eta()<<" "<<gem_pad_gp.eta()<<" "
-              <<dtrk_.deta_sh<<" "<<dtrk_.deta_dg<<" "<<dtrk_.deta_pad<<endl;
+              <<dtrk.deta_sh<<" "<<dtrk.deta_dg<<" "<<dtrk.deta_pad<<endl;
         }
       }
     }
@@ -1013,6 +1180,14 @@ void GEMCSCAnalyzer::bookSimTracksDeltaTree()
   tree_delta_->Branch("csc_lct_eta", &dtrk_.csc_lct_eta);
   tree_delta_->Branch("deta_lct_pad", &dtrk_.deta_lct_pad);
   //tree_delta_->Branch("", &dtrk_.);
+
+  setTreeBatchWriting(tree_delta_, ntupleBatchSize_, ntupleCompression_);
+}
+
+
+void GEMCSCAnalyzer::endJob()
+{
+  sidecar_.close();
 }
 
 
@@ -5,6 +5,7 @@
 #include <sstream>
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
 
 // root include files
 #include "TTree.h"
@@ -109,7 +110,7 @@ private:
   void bookGEMSimHitsTree();
   void bookSimTracksTree();
   bool isSimTrackGood(const SimTrack &);
-  MyGEMSimHit isGEMRecHitMatched(MyGEMRecHit gem_recHit_, const edm::Event& iEvent);
+  MyGEMSimHit isGEMRecHitMatched(const MyGEMRecHit& gem_recHit, const GEMDetId& id);
   void analyzeGEM(const edm::Event& iEvent);
   void analyzeTracks(edm::ParameterSet, const edm::Event&, const edm::EventSetup&);
   void buildLUT();
@@ -140,6 +141,19 @@ private:
 
   std::pair<std::vector<float>,std::vector<int> > positiveLUT_;
   std::pair<std::vector<float>,std::vector<int> > negativeLUT_;
+
+  // muon SimHits of the event, with their global positions computed once,
+  // and their (eta partition, local x) keys sorted for the rechit matching
+  struct SimHitKey
+  {
+    uint32_t detId;
+    float x;
+    unsigned index;
+    bool operator<(const SimHitKey& o) const { return detId < o.detId || (detId == o.detId && x < o.x); }
+  };
+  std::vector<MyGEMSimHit> gem_sh_event_;
+  std::vector<SimHitKey> gem_sh_keys_;
+  float simHitMatchDR_;
 };
 
 //
@@ -150,6 +164,7 @@ GEMRecHitAnalyzer::GEMRecHitAnalyzer(const edm::ParameterSet& iConfig)
   , simInputLabel_(iConfig.getUntrackedParameter<std::string>("simInputLabel", "g4SimHits"))
   , minPt_(iConfig.getUntrackedParameter<double>("minPt", 5.))
   , verbose_(iConfig.getUntrackedParameter<int>("verbose", 0))
+  , simHitMatchDR_(iConfig.getUntrackedParameter<double>("simHitMatchDR", 0.1))
 {
   bookGEMRecHitTree();
   bookGEMSimHitsTree();
@@ -296,73 +311,38 @@ void GEMRecHitAnalyzer::bookSimTracksTree()
   track_tree_->Branch("has_gem_rh_l2",&track_.has_gem_rh_l2);
 }
 
-MyGEMSimHit GEMRecHitAnalyzer::isGEMRecHitMatched(MyGEMRecHit gem_recHit_, const edm::Event& iEvent)
+MyGEMSimHit GEMRecHitAnalyzer::isGEMRecHitMatched(const MyGEMRecHit& gem_recHit, const GEMDetId& id)
 {
+  MyGEMSimHit result = MyGEMSimHit();
 
-  MyGEMSimHit result;
-  MyGEMSimHit gem_sh_temp;
-
-  Float_t gem_region = gem_recHit_.region;
-  Float_t gem_layer = gem_recHit_.layer;
+  Float_t recPhi = gem_recHit.globalPhi;
+  Float_t recEta = gem_recHit.globalEta;
 
-  Float_t recPhi = gem_recHit_.globalPhi;
-  Float_t recEta = gem_recHit_.globalEta;
+  // the partitions of a chamber share the direction and the origin of the local x, and
+  // dR < simHitMatchDR implies |dphi| < simHitMatchDR, i.e., roughly |dx| < simHitMatchDR*R;
+  // the window is twice as wide to cover the radius difference of the neighbouring partitions
+  const float x_window = 2. * simHitMatchDR_ * gem_recHit.globalR;
+  const int nPartitions = gem_geometry_->chamber(id)->nEtaPartitions();
 
-  for (edm::PSimHitContainer::const_iterator itHit = GEMHits->begin(); itHit != GEMHits->end(); ++itHit)
+  // the last matching SimHit in the container order, as in the old all-pairs loop
+  int matched = -1;
+  for (int roll = id.roll() - 1; roll <= id.roll() + 1; ++roll)
   {
-
-   if(abs(itHit->particleType()) != 13) continue;
-
-   gem_sh_temp.eventNumber = iEvent.id().event();
-   gem_sh_temp.detUnitId = itHit->detUnitId();
-   gem_sh_temp.particleType = itHit->particleType();
-   gem_sh_temp.x = itHit->localPosition().x();
-   gem_sh_temp.y = itHit->localPosition().y();
-   gem_sh_temp.energyLoss = itHit->energyLoss();
-   gem_sh_temp.pabs = itHit->pabs();
-   gem_sh_temp.timeOfFlight = itHit->timeOfFlight();
-   
-   const GEMDetId idSim(itHit->detUnitId());
-   
-   gem_sh_temp.region = idSim.region();
-   gem_sh_temp.ring = idSim.ring();
-   gem_sh_temp.station = idSim.station();
-   gem_sh_temp.layer = idSim.layer();
-   gem_sh_temp.chamber = idSim.chamber();
-   gem_sh_temp.roll = idSim.roll();
-
-   const LocalPoint p0(0., 0., 0.);
-   const GlobalPoint Gp0(gem_geometry_->idToDet(itHit->detUnitId())->surface().toGlobal(p0));
-
-   gem_sh_temp.Phi_0 = Gp0.phi();
-   gem_sh_temp.R_0 = Gp0.perp();
-   gem_sh_temp.DeltaPhi = atan(-1*idSim.region()*pow(-1,idSim.chamber())*itHit->localPosition().x()/(Gp0.perp() + itHit->localPosition().y()));
-	 
-   const LocalPoint hitLPSim(itHit->localPosition());
-   const GlobalPoint hitGPSim(gem_geometry_->idToDet(itHit->detUnitId())->surface().toGlobal(hitLPSim));
-   gem_sh_temp.globalR = hitGPSim.perp();
-   gem_sh_temp.globalEta = hitGPSim.eta();
-   gem_sh_temp.globalPhi = hitGPSim.phi();
-   gem_sh_temp.globalX = hitGPSim.x();
-   gem_sh_temp.globalY = hitGPSim.y();
-   gem_sh_temp.globalZ = hitGPSim.z();
-
-   //  Now filling strip info using entry point rather than local position to be
-   //  consistent with digi strips. To change back, just switch the comments - WHF
-   //  gem_sh_temp.strip=gem_geometry_->etaPartition(itHit->detUnitId())->strip(hitLP);
-   const LocalPoint hitEP(itHit->entryPoint());
-   gem_sh_temp.strip=gem_geometry_->etaPartition(itHit->detUnitId())->strip(hitEP);
-
-   Float_t gem_sh_region = gem_sh_temp.region;
-   Float_t gem_sh_layer = gem_sh_temp.layer;
-
-   Float_t simPhi = gem_sh_temp.globalPhi;
-   Float_t simEta = gem_sh_temp.globalEta;
-   Float_t dR = deltaR(simEta, simPhi, recEta, recPhi);
-
-   if(gem_sh_region == gem_region && gem_sh_layer == gem_layer && dR < 0.1) result = gem_sh_temp;
-
+    if (roll < 1 || roll > nPartitions) continue;
+    const GEMDetId partition(id.region(), id.ring(), id.station(), id.layer(), id.chamber(), roll);
+
+    SimHitKey lo = {partition.rawId(), gem_recHit.x - x_window, 0};
+    SimHitKey hi = {partition.rawId(), gem_recHit.x + x_window, 0};
+    auto first = std::lower_bound(gem_sh_keys_.begin(), gem_sh_keys_.end(), lo);
+    auto last = std::upper_bound(first, gem_sh_keys_.end(), hi);
+    for (auto key = first; key != last; ++key)
+    {
+      const MyGEMSimHit& sh = gem_sh_event_[key->index];
+      Float_t dR = deltaR(sh.globalEta, sh.globalPhi, recEta, recPhi);
+      if (dR < simHitMatchDR_ && (int)key->index > matched) matched = key->index;
+    }
   }
+  if (matched >= 0) result = gem_sh_event_[matched];
 
   return result;
 
@@ -371,6 +351,8 @@ MyGEMSimHit GEMRecHitAnalyzer::isGEMRecHitMatched(MyGEMRecHit gem_recHit_, const
 // ======= GEM RecHits =======
 void GEMRecHitAnalyzer::analyzeGEM(const edm::Event& iEvent)
 {
+  gem_sh_event_.clear();
+  gem_sh_keys_.clear();
 
   for (edm::PSimHitContainer::const_iterator itHit = GEMHits->begin(); itHit != GEMHits->end(); ++itHit)
   {
@@ -419,7 +401,12 @@ void GEMRecHitAnalyzer::analyzeGEM(const edm::Event& iEvent)
    
    gem_sh_tree_->Fill();
 
+   SimHitKey key = {itHit->detUnitId(), gem_sh.x, (unsigned)gem_sh_event_.size()};
+   gem_sh_keys_.push_back(key);
+   gem_sh_event_.push_back(gem_sh);
+
   }
+  std::sort(gem_sh_keys_.begin(), gem_sh_keys_.end());
 
   for (GEMRecHitCollection::const_iterator recHit = gemRecHits_->begin(); recHit != gemRecHits_->end(); ++recHit) 
   {
@@ -451,7 +438,7 @@ void GEMRecHitAnalyzer::analyzeGEM(const edm::Event& iEvent)
    gem_recHit_.globalY = hitGP.y();
    gem_recHit_.globalZ = hitGP.z();
 
-   MyGEMSimHit gem_sh_temp = isGEMRecHitMatched(gem_recHit_, iEvent);
+   MyGEMSimHit gem_sh_temp = isGEMRecHitMatched(gem_recHit_, id);
 
 	gem_recHit_.x_sim = gem_sh_temp.x;
 	gem_recHit_.y_sim = gem_sh_temp.y;
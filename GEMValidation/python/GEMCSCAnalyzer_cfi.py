@@ -12,6 +12,21 @@ GEMCSCAnalyzer = cms.EDAnalyzer("GEMCSCAnalyzer",
     maxEta = cms.untracked.double(2.18),
     ntupleTrackChamberDelta = cms.untracked.bool(True),
     ntupleTrackEff = cms.untracked.bool(True),
+    ## optional groups of the trk_eff fields, on top of the efficiency flags:
+    ## lct gemSimHits gemDigis gemPads
+    trackEffFields = cms.untracked.vstring("lct", "gemSimHits", "gemDigis", "gemPads"),
+    ## match the SimTracks of an event concurrently (same output as the serial matching)
+    ## (the propagation through the volume based magnetic field is not thread safe and stays serialized)
+    parallelTrackMatching = cms.untracked.bool(False),
+    ## write the ntuples in batches of this many entries per basket (0: ROOT defaults)
+    ntupleBatchSize = cms.untracked.uint32(0),
+    ## 100*algorithm + level, e.g., 101 for zlib-1, 208 for LZMA-8 (-1: as the output file)
+    ntupleCompression = cms.untracked.int32(-1),
+    ## sidecar file with the matching results: written by a job with matchSidecarOutput,
+    ## used instead of the matching by a job with the same configuration and matchSidecarInput
+    ## (events with another process history or other SimTracks than in the sidecar are matched)
+    matchSidecarInput = cms.untracked.string(""),
+    matchSidecarOutput = cms.untracked.string(""),
     stationsToUse = cms.vint32(1,),
     simTrackMatching = stm
 )
@@ -7,5 +7,7 @@ GEMRecHitAnalyzer = cms.EDAnalyzer("GEMRecHitAnalyzer",
     inputTagGEM = cms.untracked.InputTag("simMuonGEMDigis"),
     simInputLabel = cms.untracked.string("g4SimHits"),
     minPt = cms.untracked.double(5.),
+    ## dR of the rechit-simhit match, searched in the same and the neighbouring eta partitions
+    simHitMatchDR = cms.untracked.double(0.1),
     simTrackMatching = SimTrackMatching
 )
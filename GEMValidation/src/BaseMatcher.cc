@@ -20,6 +20,8 @@ BaseMatcher::BaseMatcher(const SimTrack& t, const SimVertex& v,
   // empty list means use all the chamber types
   if (csc_types.empty()) useCSCChamberTypes_[CSC_ALL] = 1;
 
+  std::lock_guard<std::mutex> lock(frameworkMutex());
+
   // Get the magnetic field
   es.get< IdealMagneticFieldRecord >().get(magfield_);
 
@@ -34,6 +36,13 @@ BaseMatcher::~BaseMatcher()
 }
 
 
+std::mutex& BaseMatcher::frameworkMutex()
+{
+  static std::mutex m;
+  return m;
+}
+
+
 bool BaseMatcher::useCSCChamberType(int csc_type)
 {
   if (csc_type < 0 || csc_type > CSC_ME42) return false;
@@ -48,6 +57,10 @@ BaseMatcher::propagateToZ(GlobalPoint &inner_point, GlobalVector &inner_vec, flo
   Plane::RotationType rot;
   Plane::PlanePointer my_plane(Plane::build(pos, rot));
 
+  // the SteppingHelix propagators and the volume based magnetic field (its last volume cache)
+  // keep unsynchronized state between the calls, so concurrent matchers propagate one at a time
+  std::lock_guard<std::mutex> lock(frameworkMutex());
+
   FreeTrajectoryState state_start(inner_point, inner_vec, trk_.charge(), &*magfield_);
 
   TrajectoryStateOnSurface tsos(propagator_->propagate(state_start, *my_plane));
@@ -21,6 +21,8 @@
 #include "MagneticField/Engine/interface/MagneticField.h"
 #include "TrackingTools/GeomPropagators/interface/Propagator.h"
 
+#include <mutex>
+
 //static const float AVERAGE_GEM_Z(587.5); // [cm]
 static const float AVERAGE_GEM_Z(568.6); // [cm]
 
@@ -51,6 +53,22 @@ public:
   const edm::Event& event() const {return ev_;}
   const edm::EventSetup& eventSetup() const {return es_;}
 
+  /// event products and conditions access that can be used by matchers of different
+  /// SimTracks running concurrently: the framework calls are serialized
+  template <class Tag, class T>
+  void getByLabel(const Tag& tag, edm::Handle<T>& handle) const
+  {
+    std::lock_guard<std::mutex> lock(frameworkMutex());
+    event().getByLabel(tag, handle);
+  }
+
+  template <class Record, class T>
+  void getFromSetup(edm::ESHandle<T>& handle) const
+  {
+    std::lock_guard<std::mutex> lock(frameworkMutex());
+    eventSetup().get<Record>().get(handle);
+  }
+
   /// check if CSC chamber type is in the used list
   bool useCSCChamberType(int csc_type);
   
@@ -66,6 +84,11 @@ public:
   /// propagate the track to average GEM z-position                                                                            
   GlobalPoint propagatedPositionGEM() const;
 
+protected:
+
+  /// guards the framework calls and the (stateful) propagators and magnetic field
+  static std::mutex& frameworkMutex();
+
 private:
 
   const SimTrack& trk_;
@@ -40,10 +40,10 @@ CSCDigiMatcher::~CSCDigiMatcher() {}
 void CSCDigiMatcher::init()
 {
   edm::Handle<CSCComparatorDigiCollection> comp_digis;
-  event().getByLabel(cscComparatorDigiInput_, comp_digis);
+  getByLabel(cscComparatorDigiInput_, comp_digis);
 
   edm::Handle<CSCWireDigiCollection> wire_digis;
-  event().getByLabel(cscWireDigiInput_, wire_digis);
+  getByLabel(cscWireDigiInput_, wire_digis);
 
   matchTriggerDigisToSimTrack(*comp_digis.product(), *wire_digis.product());
 }
@@ -46,16 +46,16 @@ CSCStubMatcher::~CSCStubMatcher() {}
 void CSCStubMatcher::init()
 {
   edm::Handle<CSCCLCTDigiCollection> clcts;
-  event().getByLabel(clctInput_, clcts);
+  getByLabel(clctInput_, clcts);
 
   edm::Handle<CSCALCTDigiCollection> alcts;
-  event().getByLabel(alctInput_, alcts);
+  getByLabel(alctInput_, alcts);
 
   edm::Handle<CSCCorrelatedLCTDigiCollection> lcts;
-  event().getByLabel(lctInput_, lcts);
+  getByLabel(lctInput_, lcts);
 
   edm::Handle<CSCCorrelatedLCTDigiCollection> mplcts;
-  event().getByLabel(mplctInput_, mplcts);
+  getByLabel(mplctInput_, mplcts);
 
   matchCLCTsToSimTrack(*clcts.product());
   matchALCTsToSimTrack(*alcts.product());
@@ -40,15 +40,15 @@ void
 GEMDigiMatcher::init()
 {
   edm::Handle<GEMDigiCollection> gem_digis;
-  event().getByLabel(gemDigiInput_, gem_digis);
+  getByLabel(gemDigiInput_, gem_digis);
   matchDigisToSimTrack(*gem_digis.product());
 
   edm::Handle<GEMCSCPadDigiCollection> gem_pads;
-  event().getByLabel(gemPadDigiInput_, gem_pads);
+  getByLabel(gemPadDigiInput_, gem_pads);
   matchPadsToSimTrack(*gem_pads.product());
 
   edm::Handle<GEMCSCPadDigiCollection> gem_co_pads;
-  event().getByLabel(gemPadDigiInput_, gem_co_pads);
+  getByLabel(gemPadDigiInput_, gem_co_pads);
   matchCoPadsToSimTrack(*gem_co_pads.product());
 }
 
@@ -37,11 +37,11 @@ void
 GEMRecHitMatcher::init()
 {
   edm::Handle<GEMRecHitCollection> gem_rechits;
-  event().getByLabel(gemRecHitInput_, gem_rechits);
+  getByLabel(gemRecHitInput_, gem_rechits);
   matchRecHitsToSimTrack(*gem_rechits.product());
 
   edm::ESHandle<GEMGeometry> gem_g;
-  eventSetup().get<MuonGeometryRecord>().get(gem_g);
+  getFromSetup<MuonGeometryRecord>(gem_g);
   gem_geo_ = &*gem_g;
 }
 
@@ -56,11 +56,11 @@ void
 SimHitMatcher::init()
 {
   edm::ESHandle<CSCGeometry> csc_g;
-  eventSetup().get<MuonGeometryRecord>().get(csc_g);
+  getFromSetup<MuonGeometryRecord>(csc_g);
   csc_geo_ = &*csc_g;
 
   edm::ESHandle<GEMGeometry> gem_g;
-  eventSetup().get<MuonGeometryRecord>().get(gem_g);
+  getFromSetup<MuonGeometryRecord>(gem_g);
   gem_geo_ = &*gem_g;
 
   edm::Handle<edm::PSimHitContainer> csc_hits;
@@ -68,10 +68,10 @@ SimHitMatcher::init()
   edm::Handle<edm::SimTrackContainer> sim_tracks;
   edm::Handle<edm::SimVertexContainer> sim_vertices;
 
-  event().getByLabel(simInputLabel_, sim_tracks);
-  event().getByLabel(simInputLabel_, sim_vertices);
-  event().getByLabel(edm::InputTag(simInputLabel_,"MuonCSCHits"), csc_hits);
-  event().getByLabel(edm::InputTag(simInputLabel_,"MuonGEMHits"), gem_hits);
+  getByLabel(simInputLabel_, sim_tracks);
+  getByLabel(simInputLabel_, sim_vertices);
+  getByLabel(edm::InputTag(simInputLabel_,"MuonCSCHits"), csc_hits);
+  getByLabel(edm::InputTag(simInputLabel_,"MuonGEMHits"), gem_hits);
 
   // fill trkId2Index associoation:
   int no = 0;
@@ -0,0 +1,293 @@
+#include "GEMCode/GEMValidation/src/SimTrackMatchSidecar.h"
+
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/Utilities/interface/Digest.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include "TDirectory.h"
+#include "TNamed.h"
+
+#include <sstream>
+
+
+namespace {
+const char * const TREE_NAME = "simTrackMatches";
+const char * const HASH_NAME = "configHash";
+const char * const HISTORIES_NAME = "processHistories";
+// to be increased with any change of the file layout
+const char * const FORMAT_VERSION = "SimTrackMatchSidecar-3";
+}
+
+
+SimTrackMatchSidecar::SimTrackMatchSidecar()
+: file_(0), tree_(0), writing_(false), reading_(false)
+, run_(0), lumi_(0), event_(0), nsimtrk_(0), simtrk_checksum_(0)
+, last_history_known_(false), n_mismatches_(0)
+{}
+
+
+SimTrackMatchSidecar::~SimTrackMatchSidecar()
+{
+  close();
+}
+
+
+std::string SimTrackMatchSidecar::configHash(const std::string& code_version, const edm::ParameterSet& matching,
+    const std::vector<std::string>& extra)
+{
+  cms::Digest md5(FORMAT_VERSION);
+  md5.append("|");
+  md5.append(code_version);
+  md5.append("|");
+  md5.append(matching.toString());
+  for (auto& e: extra)
+  {
+    md5.append("|");
+    md5.append(e);
+  }
+  return md5.digest().toString();
+}
+
+
+void SimTrackMatchSidecar::openForWriting(const std::string& file_name, const std::string& hash)
+{
+  // keep the current directory (e.g., of the TFileService) untouched
+  TDirectory::TContext context(gDirectory);
+
+  file_ = TFile::Open(file_name.c_str(), "RECREATE");
+  if (file_ == 0 || file_->IsZombie())
+    throw cms::Exception("Configuration") << "SimTrackMatchSidecar: cannot create "<< file_name <<"\n";
+
+  TNamed(HASH_NAME, hash.c_str()).Write();
+
+  tree_ = new TTree(TREE_NAME, TREE_NAME);
+  tree_->Branch("run", &run_, "run/i");
+  tree_->Branch("lumi", &lumi_, "lumi/i");
+  tree_->Branch("event", &event_, "event/i");
+  tree_->Branch("nsimtrk", &nsimtrk_, "nsimtrk/i");
+  tree_->Branch("simtrk_checksum", &simtrk_checksum_, "simtrk_checksum/l");
+  writing_ = true;
+}
+
+
+bool SimTrackMatchSidecar::openForReading(const std::string& file_name, const std::string& hash)
+{
+  TDirectory::TContext context(gDirectory);
+
+  file_ = TFile::Open(file_name.c_str(), "READ");
+  if (file_ == 0 || file_->IsZombie())
+  {
+    edm::LogWarning("SimTrackMatchSidecar") << "cannot open " << file_name << "; the SimTracks will be matched";
+    delete file_;
+    file_ = 0;
+    return false;
+  }
+
+  TNamed *stored_hash = dynamic_cast<TNamed*>(file_->Get(HASH_NAME));
+  TNamed *histories = dynamic_cast<TNamed*>(file_->Get(HISTORIES_NAME));
+  tree_ = dynamic_cast<TTree*>(file_->Get(TREE_NAME));
+  if (stored_hash == 0 || histories == 0 || tree_ == 0 || hash != stored_hash->GetTitle())
+  {
+    edm::LogWarning("SimTrackMatchSidecar") << file_name << " was made with a different configuration; the SimTracks will be matched";
+    close();
+    return false;
+  }
+
+  std::istringstream history_list(histories->GetTitle());
+  std::string h;
+  while (history_list >> h) histories_.insert(h);
+
+  tree_->SetBranchAddress("run", &run_);
+  tree_->SetBranchAddress("lumi", &lumi_);
+  tree_->SetBranchAddress("event", &event_);
+  tree_->SetBranchAddress("nsimtrk", &nsimtrk_);
+  tree_->SetBranchAddress("simtrk_checksum", &simtrk_checksum_);
+  tree_->SetBranchStatus("*", 0);
+  tree_->SetBranchStatus("run", 1);
+  tree_->SetBranchStatus("lumi", 1);
+  tree_->SetBranchStatus("event", 1);
+  for (Long64_t i = 0; i < tree_->GetEntries(); ++i)
+  {
+    tree_->GetEntry(i);
+    index_[edm::EventID(run_, lumi_, event_)] = i;
+  }
+  tree_->SetBranchStatus("*", 1);
+
+  reading_ = true;
+  return true;
+}
+
+
+bool SimTrackMatchSidecar::addTree(TTree *ntuple)
+{
+  if (!writing_ && !reading_) return false;
+
+  std::unique_ptr<Rows> r(new Rows());
+  r->ntuple = ntuple;
+  r->tree = 0;
+  r->first = 0;
+  r->n = 0;
+
+  const std::string name = ntuple->GetName();
+  if (writing_)
+  {
+    // same named branches, reading from the ntuple's buffers
+    TDirectory::TContext context(gDirectory, file_);
+    r->tree = ntuple->CloneTree(0);
+    r->tree->SetDirectory(file_);
+    tree_->Branch(("first_" + name).c_str(), &r->first, ("first_" + name + "/L").c_str());
+    tree_->Branch(("n_" + name).c_str(), &r->n, ("n_" + name + "/I").c_str());
+  }
+  else
+  {
+    r->tree = dynamic_cast<TTree*>(file_->Get(name.c_str()));
+    if (r->tree == 0 || tree_->GetBranch(("n_" + name).c_str()) == 0)
+    {
+      edm::LogWarning("SimTrackMatchSidecar") << file_->GetName() << " has no " << name << " rows; the SimTracks will be matched";
+      close();
+      return false;
+    }
+    // the stored branches are read into the ntuple's buffers, by name
+    ntuple->CopyAddresses(r->tree);
+    tree_->SetBranchAddress(("first_" + name).c_str(), &r->first);
+    tree_->SetBranchAddress(("n_" + name).c_str(), &r->n);
+  }
+  rows_.push_back(std::move(r));
+  return true;
+}
+
+
+SimTrackMatchSidecar::Rows * SimTrackMatchSidecar::rows(TTree *ntuple)
+{
+  for (auto& r: rows_) if (r->ntuple == ntuple) return r.get();
+  throw cms::Exception("LogicError") << "SimTrackMatchSidecar: " << ntuple->GetName() << " was not registered\n";
+}
+
+
+void SimTrackMatchSidecar::fill(TTree *ntuple)
+{
+  if (!writing_) return;
+  Rows *r = rows(ntuple);
+  r->tree->Fill();
+  ++r->n;
+}
+
+
+ULong64_t SimTrackMatchSidecar::simTrackChecksum(const edm::SimTrackContainer& sim_tracks)
+{
+  // 64-bit FNV-1a over the bytes of the track properties
+  ULong64_t h = 14695981039346656037ULL;
+  auto add = [&h](const void *data, size_t n)
+  {
+    const unsigned char *c = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < n; ++i)
+    {
+      h ^= c[i];
+      h *= 1099511628211ULL;
+    }
+  };
+  for (auto& t: sim_tracks)
+  {
+    const unsigned int id = t.trackId();
+    const int type = t.type();
+    const double p[4] = {t.momentum().px(), t.momentum().py(), t.momentum().pz(), t.momentum().e()};
+    add(&id, sizeof(id));
+    add(&type, sizeof(type));
+    add(p, sizeof(p));
+  }
+  return h;
+}
+
+
+bool SimTrackMatchSidecar::knownHistory(const edm::ProcessHistoryID& id)
+{
+  // consecutive events mostly have the same history
+  if (id == last_history_) return last_history_known_;
+
+  last_history_ = id;
+  std::ostringstream hex;
+  hex << id;
+  if (writing_) histories_.insert(hex.str());
+  last_history_known_ = histories_.count(hex.str()) > 0;
+  return last_history_known_;
+}
+
+
+void SimTrackMatchSidecar::put(const edm::Event& ev, const edm::SimTrackContainer& sim_tracks)
+{
+  if (!writing_) return;
+
+  const edm::EventID& id = ev.id();
+  run_ = id.run();
+  lumi_ = id.luminosityBlock();
+  event_ = id.event();
+  nsimtrk_ = sim_tracks.size();
+  simtrk_checksum_ = simTrackChecksum(sim_tracks);
+  knownHistory(ev.processHistoryID());
+  for (auto& r: rows_) r->first = r->tree->GetEntries() - r->n;
+  tree_->Fill();
+  for (auto& r: rows_) r->n = 0;
+}
+
+
+bool SimTrackMatchSidecar::get(const edm::Event& ev, const edm::SimTrackContainer& sim_tracks)
+{
+  if (!reading_) return false;
+
+  auto entry = index_.find(ev.id());
+  if (entry == index_.end()) return false;
+
+  tree_->GetEntry(entry->second);
+
+  // the same event id in another sample (e.g., run 1 of another MC production)
+  if (!knownHistory(ev.processHistoryID()) || nsimtrk_ != sim_tracks.size()
+      || simtrk_checksum_ != simTrackChecksum(sim_tracks))
+  {
+    ++n_mismatches_;
+    return false;
+  }
+  return true;
+}
+
+
+void SimTrackMatchSidecar::replay(TTree *ntuple)
+{
+  if (!reading_) return;
+  Rows *r = rows(ntuple);
+  for (Int_t i = 0; i < r->n; ++i)
+  {
+    r->tree->GetEntry(r->first + i);
+    ntuple->Fill();
+  }
+}
+
+
+void SimTrackMatchSidecar::close()
+{
+  if (file_ == 0) return;
+  if (writing_)
+  {
+    TDirectory::TContext context(gDirectory, file_);
+    std::string histories;
+    for (auto& h: histories_) histories += h + " ";
+    TNamed(HISTORIES_NAME, histories.c_str()).Write();
+    tree_->Write();
+    for (auto& r: rows_) r->tree->Write();
+  }
+  if (reading_ && n_mismatches_ > 0)
+  {
+    edm::LogWarning("SimTrackMatchSidecar") << n_mismatches_ << " events of " << file_->GetName()
+        << " had a different input (process history or SimTracks); their SimTracks were matched";
+  }
+  file_->Close();
+  delete file_;
+  file_ = 0;
+  tree_ = 0;
+  writing_ = reading_ = false;
+  rows_.clear();
+  index_.clear();
+  histories_.clear();
+  last_history_ = edm::ProcessHistoryID();
+  last_history_known_ = false;
+  n_mismatches_ = 0;
+}
@@ -0,0 +1,127 @@
+#ifndef GEMValidation_SimTrackMatchSidecar_h
+#define GEMValidation_SimTrackMatchSidecar_h
+
+/**\class SimTrackMatchSidecar
+
+  Sidecar ROOT file with the per-SimTrack matching results of an analyzer,
+  so that a rerun over the same sample can skip the SimTrack matching.
+
+  The sidecar keeps a copy of the rows of the analyzer's ntuples (registered with addTree):
+  each ntuple has a sidecar tree with the same named branches, so that the rows do not depend
+  on the memory layout of the analyzer's row structures. An index tree gives for every event
+  the range of its rows in each sidecar tree.
+  The file is labeled with a hash of everything the rows depend on
+  (the format and code versions, the matching PSet, input tags, selection cuts, ...):
+  a sidecar whose hash differs from the current one is not used.
+  The hash does not cover the input, so the sidecar also keeps the process histories
+  of the events it was made from, and for every event the number of its SimTracks
+  and a checksum of their ids, types and momenta: an event is taken from the sidecar
+  only if all of them match, otherwise its SimTracks are matched as usual.
+
+  A sidecar is either written or read in a job, not both.
+*/
+
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "DataFormats/Provenance/interface/ProcessHistoryID.h"
+#include "SimDataFormats/Track/interface/SimTrackContainer.h"
+
+#include "TFile.h"
+#include "TTree.h"
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+class SimTrackMatchSidecar
+{
+public:
+
+  SimTrackMatchSidecar();
+  ~SimTrackMatchSidecar();
+
+  /// MD5 of the sidecar format version, of the analyzer's code version,
+  /// of the matching configuration and of the extra analyzer-specific parts
+  static std::string configHash(const std::string& code_version, const edm::ParameterSet& matching,
+      const std::vector<std::string>& extra);
+
+  /// creates the sidecar file
+  void openForWriting(const std::string& file_name, const std::string& hash);
+
+  /// opens an existing sidecar; returns false (and the sidecar stays unused)
+  /// if it cannot be read or was made with a different configuration hash
+  bool openForReading(const std::string& file_name, const std::string& hash);
+
+  /// registers an ntuple with all its branches booked: when writing, its rows get copied
+  /// into the sidecar; when reading, the stored rows are read into the ntuple's buffers.
+  /// Returns false (and the sidecar stays unused) if a read sidecar does not have the ntuple.
+  bool addTree(TTree *ntuple);
+
+  bool writing() const { return writing_; }
+  bool reading() const { return reading_; }
+
+  /// writing: copies the current row of a registered ntuple, to be called after each ntuple Fill
+  void fill(TTree *ntuple);
+
+  /// writing: closes the rows of an event, labeled with the identity of its input
+  void put(const edm::Event& ev, const edm::SimTrackContainer& sim_tracks);
+
+  /// reading: selects an event; false if the event is not in the sidecar
+  /// or if its input differs from the one the sidecar was made from
+  bool get(const edm::Event& ev, const edm::SimTrackContainer& sim_tracks);
+
+  /// reading: fills a registered ntuple with the stored rows of the selected event
+  void replay(TTree *ntuple);
+
+  /// writes and closes the file
+  void close();
+
+private:
+
+  SimTrackMatchSidecar(const SimTrackMatchSidecar&);
+  SimTrackMatchSidecar& operator=(const SimTrackMatchSidecar&);
+
+  // sidecar copy of an ntuple and its rows range in the current event
+  struct Rows
+  {
+    TTree *ntuple;
+    TTree *tree;
+    Long64_t first;
+    Int_t n;
+  };
+
+  Rows * rows(TTree *ntuple);
+
+  // checksum of the ids, types and momenta of the SimTracks of an event
+  static ULong64_t simTrackChecksum(const edm::SimTrackContainer& sim_tracks);
+
+  // whether the events of a process history are in the sidecar (reading) / registers it (writing)
+  bool knownHistory(const edm::ProcessHistoryID& id);
+
+  TFile *file_;
+  TTree *tree_;
+  bool writing_;
+  bool reading_;
+
+  // index tree buffers
+  UInt_t run_, lumi_, event_;
+  UInt_t nsimtrk_;
+  ULong64_t simtrk_checksum_;
+
+  // process histories of the events, in their hex form
+  std::set<std::string> histories_;
+  edm::ProcessHistoryID last_history_;
+  bool last_history_known_;
+
+  // #events found in a read sidecar, but with a different input
+  unsigned n_mismatches_;
+
+  std::vector<std::unique_ptr<Rows> > rows_;
+
+  // (run, lumi, event) -> index tree entry
+  std::map<edm::EventID, Long64_t> index_;
+};
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef GEMValidation_TreeBatchWriting_h
+#define GEMValidation_TreeBatchWriting_h
+
+/**\fn setTreeBatchWriting
+
+  Makes a TTree be written in batches of n entries: the basket of every branch is
+  sized to hold a whole batch of its entries and the tree is auto-flushed after each
+  batch, so that each column of a batch is compressed as one block. Mostly constant
+  columns (e.g., the default values of unmatched objects) then compress to almost nothing.
+
+  Has to be called after all the branches are booked and before the first Fill.
+  compression = 100*algorithm + level as in ROOT::CompressionSettings (-1: as the output file)
+*/
+
+#include "TTree.h"
+#include "TBranch.h"
+#include "TLeaf.h"
+#include "TObjArray.h"
+
+#include <algorithm>
+
+inline void setTreeBatchWriting(TTree *tree, unsigned n, int compression = -1)
+{
+  if (tree == 0 || n == 0) return;
+
+  TObjArray *branches = tree->GetListOfBranches();
+  for (int i = 0; i < branches->GetEntriesFast(); ++i)
+  {
+    TBranch *b = static_cast<TBranch*>(branches->UncheckedAt(i));
+    // bytes per entry of the branch
+    int entry_size = 0;
+    TObjArray *leaves = b->GetListOfLeaves();
+    for (int j = 0; j < leaves->GetEntriesFast(); ++j)
+    {
+      TLeaf *l = static_cast<TLeaf*>(leaves->UncheckedAt(j));
+      entry_size += l->GetLenType() * l->GetLen();
+    }
+    // some room for the basket header
+    b->SetBasketSize(std::max<int>(entry_size * n + 512, 1024));
+    if (compression >= 0) b->SetCompressionSettings(compression);
+  }
+  tree->SetAutoFlush(n);
+}
+
+#endif
@@ -20,6 +20,7 @@
 #include "CLHEP/Random/RandFlat.h"
 
 #include "GEMCode/GEMValidation/src/SimHitMatcher.h"
+#include "GEMCode/SimMuL1/interface/GEMCSCDPhiLUT.h"
 
 #include "TLinearFitter.h"
 
@@ -33,6 +34,52 @@
 class CSCGeometry;
 
 
+/// Closed-form least squares fit of a straight line v(z) = p0 + p1*z.
+/// Only the running sums are kept; z is taken relative to the first point
+/// to avoid the loss of precision in the normal equations for z far from 0.
+class LineFitZ
+{
+public:
+
+  LineFitZ() { clear(); }
+
+  void clear() { n_ = 0; z_ref_ = sz_ = szz_ = sv_ = svz_ = 0.; p0_ = p1_ = 0.; }
+
+  void addPoint(double z, double v)
+  {
+    if (n_ == 0) z_ref_ = z;
+    z -= z_ref_;
+    ++n_;
+    sz_ += z;
+    szz_ += z*z;
+    sv_ += v;
+    svz_ += v*z;
+  }
+
+  /// solves the 2x2 normal equations; false if there are not enough distinct z's
+  bool eval()
+  {
+    double det = n_ * szz_ - sz_ * sz_;
+    if (n_ < 2 || det <= 0.) return false;
+    double a1 = (n_ * svz_ - sz_ * sv_) / det;
+    double a0 = (sv_ - a1 * sz_) / n_;
+    p1_ = a1;
+    p0_ = a0 - a1 * z_ref_;
+    return true;
+  }
+
+  int nPoints() const { return n_; }
+  double p0() const { return p0_; }
+  double p1() const { return p1_; }
+
+private:
+
+  int n_;
+  double z_ref_, sz_, szz_, sv_, svz_;
+  double p0_, p1_;
+};
+
+
 /// just an organizational data structure to encapsulate modeled stub information
 struct SimStub
 {
@@ -58,13 +105,20 @@ struct SimStub
   // unit direction vector: available after setFitParameters
   GlobalVector direction() const { return direction_; }
 
+  // sums of squared residuals of the x(z) and y(z) fits (-1 if not computed)
+  double fitChi2X() const { return chi2_x_; }
+  double fitChi2Y() const { return chi2_y_; }
+
   bool isValid() const { return min_hs_ <= max_hs_ && min_wg_ <= max_wg_; }
   bool hasHalfStrip(int hs) const { return hs >= min_hs_ && hs <= max_hs_; }
   bool hasWireGroup(int wg) const { return wg >= min_wg_ && wg <= max_wg_; }
+  int minHalfStrip() const { return min_hs_; }
+  int maxHalfStrip() const { return max_hs_; }
 
   // ----- modifiers -----
 
   void setFitParameters(double x0, double x1, double y0, double y1);
+  void setFitChi2(double chi2x, double chi2y) { chi2_x_ = chi2x; chi2_y_ = chi2y; }
 
   void setCSC(GlobalPoint &gp) { gp_csc_ = gp; }
 
@@ -80,6 +134,7 @@ struct SimStub
 private:
 
   double x0_, x1_, y0_, y1_;
+  double chi2_x_, chi2_y_;
   double z_gem_;
 
   GlobalVector direction_;
@@ -101,12 +156,17 @@ public:
 
   explicit FastGEMCSCBuilder(const edm::ParameterSet&, CLHEP::HepRandomEngine& eng);
 
-  ~FastGEMCSCBuilder() {}
+  ~FastGEMCSCBuilder();
 
   void setCSCGeometry(const CSCGeometry* g) { csc_geo_ = g; }
 
   void build(const SimHitMatcher& match_sh);
 
+  // reads the bending angle table (for the "lut" and "validate" dphiLUTMode)
+  void beginJob();
+  // writes the bending angle table (in the "calibrate" dphiLUTMode) and the validation summary
+  void endJob();
+
   std::vector<unsigned int> getChamberIds();
   std::vector<SimStub>& getStubs(unsigned int det_id) {return stubs_map_[det_id];}
 
@@ -119,9 +179,37 @@ private:
   std::vector<double> phiSmearCSC_;
   std::vector<double> phiSmearGEM_;
 
+  // stub line fits: the closed-form LineFitZ, TLinearFitter,
+  // or both with TLinearFitter validating the closed-form results
+  enum FitMode {FIT_CLOSED_FORM = 0, FIT_TLINEARFITTER, FIT_VALIDATE};
+  FitMode fit_mode_;
+  bool fit_chi2_;
+
+  LineFitZ fitXZ_;
+  LineFitZ fitYZ_;
   std::unique_ptr<TLinearFitter> fitterXZ_;
   std::unique_ptr<TLinearFitter> fitterYZ_;
 
+  // the fitted points, kept for the residuals pass
+  std::vector<GlobalPoint> fit_points_;
+
+  unsigned n_fit_checks_;
+  unsigned n_fit_mismatches_;
+  // chambers skipped because their hits did not define a line
+  unsigned n_fit_failures_;
+
+  // the GEM dphi of the propagated stubs from a table:
+  // off: always propagate; lut: table lookup, propagate only for the empty table bins;
+  // validate: propagate and compare with the table; calibrate: propagate and fill the table
+  enum LUTMode {LUT_OFF = 0, LUT_USE, LUT_VALIDATE, LUT_CALIBRATE};
+  LUTMode lut_mode_;
+  std::string lut_file_;
+  std::unique_ptr<GEMCSCDPhiLUT> dphi_lut_;
+
+  // LUT usage and LUT - propagation residuals
+  unsigned n_lut_found_, n_lut_missing_;
+  double lut_res_sum_, lut_res_sum2_, lut_res_max_;
+
   std::unique_ptr<CLHEP::RandFlat> flat_;
 
   const CSCGeometry* csc_geo_;
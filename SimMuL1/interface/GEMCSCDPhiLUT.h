@@ -0,0 +1,52 @@
+#ifndef SimMuL1_GEMCSCDPhiLUT_h
+#define SimMuL1_GEMCSCDPhiLUT_h
+
+// Table of the GEM-CSC bending angles, to be used instead of the propagation
+// of the fast stubs from the CSC key layer to the GEM z plane.
+//
+// The table is indexed by the CSC chamber type, the chamber parity (the GEM z differs
+// between odd and even chambers), the key half-strip and wiregroup of the stub position,
+// and the signed q/pt of the SimTrack; half-strips and wiregroups are grouped into coarser bins.
+// Each bin keeps the sum and the number of the propagated dphi's, so the same class
+// accumulates the table in a calibration run and provides the mean dphi's when used.
+// The dphi changes quickly with q/pt at high pt, so when used, the mean dphi's are
+// interpolated linearly in q/pt between the centres of the neighbouring q/pt bins.
+//
+// Text file format: a header line with the binning, then one line per filled bin:
+//   chamber_type odd hs_bin wg_bin qpt_bin mean_dphi entries
+
+#include <string>
+#include <vector>
+
+class GEMCSCDPhiLUT
+{
+public:
+
+  GEMCSCDPhiLUT(int half_strips_per_bin, int wire_groups_per_bin, int qpt_bins, double max_qpt);
+
+  // -1 if outside of the table
+  int index(int ch_type, bool odd, int hs, int wg, double qpt) const;
+
+  // dphi at the q/pt the index was made for; false if the bin is empty
+  bool get(int index, double qpt, double &dphi) const;
+
+  void fill(int index, double dphi);
+
+  // reads the table written with the same binning; throws if it cannot
+  void read(const std::string &file_name);
+  void write(const std::string &file_name) const;
+
+private:
+
+  // half-strips and wiregroups start from 1
+  enum {CH_TYPES = 11, MAX_HALF_STRIPS = 224, MAX_WIRE_GROUPS = 112};
+
+  int hs_per_bin_, wg_per_bin_, qpt_bins_;
+  double max_qpt_;
+  int hs_bins_, wg_bins_;
+
+  std::vector<double> sum_;
+  std::vector<unsigned> n_;
+};
+
+#endif
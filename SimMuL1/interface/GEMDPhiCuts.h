@@ -0,0 +1,46 @@
+#ifndef SimMuL1_GEMDPhiCuts_h
+#define SimMuL1_GEMDPhiCuts_h
+
+// GEM-CSC bending angle (dphi) cuts of a working point.
+//
+// A working point is a table of dphi cuts for odd and even chambers versus the track finder pt,
+// given by the gemPTs, gemDPhisOdd and gemDPhisEven parameters: the cut used for a track
+// is the one of the largest gemPTs entry that is not above the track's pt.
+//
+// Several working points can be evaluated in one pass over the events: passMask() returns
+// a bitmask with bit i set when working point i is passed.
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+
+#include <string>
+#include <vector>
+
+class GEMDPhiCuts
+{
+public:
+
+  GEMDPhiCuts() {}
+
+  // gemPTs, gemDPhisOdd, gemDPhisEven and an optional untracked label from the PSet
+  explicit GEMDPhiCuts(const edm::ParameterSet & ps, const std::string & default_label = "");
+
+  // all the working points from the untracked VPSet "gemDPhiWorkingPoints" (none by default)
+  static std::vector<GEMDPhiCuts> workingPoints(const edm::ParameterSet & ps);
+
+  const std::string & label() const { return label_; }
+
+  // the dphi of -99 is the default/don't-care value (passes); +99 means no matching GEM (fails)
+  bool isGood(double dphi, double tfpt, bool is_odd) const;
+
+  static unsigned passMask(const std::vector<GEMDPhiCuts> & wps, double dphi, double tfpt, bool is_odd);
+
+  // the mask with all the working points set
+  static unsigned allMask(const std::vector<GEMDPhiCuts> & wps) { return (1u << wps.size()) - 1u; }
+
+private:
+
+  std::string label_;
+  std::vector<double> pts_, dphis_odd_, dphis_even_;
+};
+
+#endif
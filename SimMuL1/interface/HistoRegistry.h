@@ -0,0 +1,108 @@
+#ifndef SimMuL1_HistoRegistry_h
+#define SimMuL1_HistoRegistry_h
+
+// Registry of lazily booked histograms.
+//
+// Histograms are declared with their name, title and binning, and the registry hands out
+// a LazyHisto proxy for each. The actual TH1D/TH2D is made through the TFileService only
+// at the first fill (or the first explicit get()), so histograms that the enabled options
+// never fill take neither memory nor space in the output file.
+// Declarations can be filtered by lists of include/exclude name patterns
+// (shell-like wildcards, e.g., "h_pt_*", "*_gem1b*"); filtered out histograms are never booked
+// and their fills are no-ops.
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+
+#include "TH1D.h"
+#include "TH2D.h"
+
+#include <string>
+#include <vector>
+
+// binning and labels of a declared histogram; ny == 0 for a 1D histogram
+struct HistoSpec
+{
+  std::string name;
+  std::string title;
+  int nx;
+  double xlo, xhi;
+  int ny;
+  double ylo, yhi;
+};
+
+template <class T>
+class LazyHisto
+{
+public:
+  LazyHisto(const HistoSpec &spec, bool enabled): spec_(spec), enabled_(enabled), h_(0) {}
+  ~LazyHisto() { if (!enabled_) delete h_; }
+
+  void Fill(double x) { if (enabled_) get()->Fill(x); }
+  void Fill(double x, double y) { if (enabled_) get()->Fill(x, y); }
+  void Fill(double x, double y, double w) { if (enabled_) get()->Fill(x, y, w); }
+
+  // books the histogram if it was not yet booked;
+  // a filtered out histogram is made detached from the output file
+  T * get();
+
+  bool enabled() const { return enabled_; }
+  bool booked() const { return h_ != 0; }
+  const HistoSpec & spec() const { return spec_; }
+
+private:
+  HistoSpec spec_;
+  bool enabled_;
+  T * h_;
+};
+
+typedef LazyHisto<TH1D> LazyTH1D;
+typedef LazyHisto<TH2D> LazyTH2D;
+
+
+class HistoRegistry
+{
+public:
+  HistoRegistry();
+  ~HistoRegistry();
+
+  // reads the untracked vstrings "histogramsInclude" (default: everything)
+  // and "histogramsExclude" (default: nothing)
+  void configure(const edm::ParameterSet & cfg);
+
+  LazyTH1D * book1D(const std::string & name, const std::string & title, int nx, double xlo, double xhi);
+  LazyTH2D * book2D(const std::string & name, const std::string & title,
+                    int nx, double xlo, double xhi, int ny, double ylo, double yhi);
+
+  // whether a histogram of this name passes the include/exclude patterns
+  bool selected(const std::string & name) const;
+
+  // books the remaining enabled histograms, e.g., to get the full set of (empty) histograms in the output
+  void bookAll();
+
+  unsigned nDeclared() const { return h1_.size() + h2_.size(); }
+  unsigned nBooked() const;
+
+private:
+  HistoRegistry(const HistoRegistry &);
+  HistoRegistry & operator=(const HistoRegistry &);
+
+  std::vector<std::string> include_;
+  std::vector<std::string> exclude_;
+
+  std::vector<LazyTH1D *> h1_;
+  std::vector<LazyTH2D *> h2_;
+};
+
+
+// makes the histogram in the TFileService directory of the current module
+TH1D * makeHisto(const HistoSpec & spec, TH1D *, bool detached);
+TH2D * makeHisto(const HistoSpec & spec, TH2D *, bool detached);
+
+template <class T>
+T * LazyHisto<T>::get()
+{
+  if (h_ == 0) h_ = makeHisto(spec_, h_, !enabled_);
+  return h_;
+}
+
+#endif
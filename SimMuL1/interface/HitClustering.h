@@ -0,0 +1,152 @@
+#ifndef SimMuL1_HitClustering_h
+#define SimMuL1_HitClustering_h
+
+// Sort-and-sweep clustering of hits in a detector layer (or eta partition, or roll).
+//
+// The hits are sorted with their operator<, whose primary key has to be the integer
+// returned by the key function (e.g., the wire group or the strip). Two hits can only be
+// adjacent if their keys differ by no more than maxKeyDistance, so for each hit only the
+// following hits within that key window have to be compared, instead of all the other hits.
+//
+// Two clustering modes are supported:
+//  - SEEDED: the first not yet clustered hit seeds a cluster that takes all the other
+//    not yet clustered hits adjacent to the seed. This is exactly what the recursive
+//    neighbour search of MuSimHitOccupancy does.
+//  - CONNECTED: clusters are the connected components of the adjacency graph,
+//    i.e., chains of adjacent hits are merged (resolved with union-find).
+//
+// The result is a list of hit indices grouped by cluster (index spans), with
+// the hits of a cluster and the clusters themselves in the sorted hits order.
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+namespace hitclustering {
+
+enum Mode {SEEDED = 0, CONNECTED};
+
+struct Clusters
+{
+  // indices into the sorted hits; cluster k is index[begin[k]] ... index[begin[k+1]-1]
+  std::vector<unsigned> index;
+  std::vector<unsigned> begin;
+
+  size_t size() const { return begin.empty() ? 0 : begin.size() - 1; }
+  size_t clusterSize(size_t k) const { return begin[k+1] - begin[k]; }
+
+  void clear() { index.clear(); begin.assign(1, 0); }
+};
+
+
+// disjoint sets over 0..n-1 with path halving and union by index
+class UnionFind
+{
+public:
+  explicit UnionFind(size_t n): parent_(n)
+  {
+    for (size_t i = 0; i < n; ++i) parent_[i] = i;
+  }
+
+  unsigned find(unsigned i)
+  {
+    while (parent_[i] != i)
+    {
+      parent_[i] = parent_[parent_[i]];
+      i = parent_[i];
+    }
+    return i;
+  }
+
+  // the smaller index becomes the root, so a root is the first hit of its set
+  void unite(unsigned i, unsigned j)
+  {
+    i = find(i);
+    j = find(j);
+    if (i == j) return;
+    if (i < j) parent_[j] = i;
+    else parent_[i] = j;
+  }
+
+private:
+  std::vector<unsigned> parent_;
+};
+
+
+// sorts the hits and clusters them
+template <class Hit, class Key, class Adjacent>
+void cluster(std::vector<Hit> &hits, Key key, int maxKeyDistance, Adjacent adjacent, Mode mode, Clusters &result)
+{
+  result.clear();
+  const size_t n = hits.size();
+  if (n == 0) return;
+
+  std::sort(hits.begin(), hits.end());
+
+  if (mode == SEEDED)
+  {
+    std::vector<bool> taken(n, false);
+    for (size_t seed = 0; seed < n; ++seed)
+    {
+      if (taken[seed]) continue;
+      taken[seed] = true;
+      result.index.push_back(seed);
+      const int seed_key = key(hits[seed]);
+      for (size_t i = seed + 1; i < n && key(hits[i]) - seed_key <= maxKeyDistance; ++i)
+      {
+        if (taken[i] || !adjacent(hits[seed], hits[i])) continue;
+        taken[i] = true;
+        result.index.push_back(i);
+      }
+      result.begin.push_back(result.index.size());
+    }
+    return;
+  }
+
+  // CONNECTED
+  UnionFind sets(n);
+  for (size_t i = 0; i < n; ++i)
+  {
+    const int key_i = key(hits[i]);
+    for (size_t j = i + 1; j < n && key(hits[j]) - key_i <= maxKeyDistance; ++j)
+    {
+      if (adjacent(hits[i], hits[j])) sets.unite(i, j);
+    }
+  }
+
+  // group by root; the roots are the first hits of their clusters, thus in increasing order
+  std::vector<unsigned> root(n), cluster_of(n), count;
+  for (size_t i = 0; i < n; ++i)
+  {
+    root[i] = sets.find(i);
+    if (root[i] == i)
+    {
+      cluster_of[i] = count.size();
+      count.push_back(0);
+    }
+    ++count[cluster_of[root[i]]];
+  }
+  for (size_t k = 0; k < count.size(); ++k) result.begin.push_back(result.begin.back() + count[k]);
+
+  std::vector<unsigned> fill(result.begin.begin(), result.begin.end() - 1);
+  result.index.resize(n);
+  for (size_t i = 0; i < n; ++i) result.index[fill[cluster_of[root[i]]]++] = i;
+}
+
+
+// copies the hits of the clusters
+template <class Hit>
+std::vector<std::vector<Hit> > clusterHits(const std::vector<Hit> &hits, const Clusters &clusters)
+{
+  std::vector<std::vector<Hit> > result(clusters.size());
+  for (size_t k = 0; k < clusters.size(); ++k)
+  {
+    result[k].reserve(clusters.clusterSize(k));
+    for (unsigned i = clusters.begin[k]; i < clusters.begin[k+1]; ++i) result[k].push_back(hits[clusters.index[i]]);
+  }
+  return result;
+}
+
+} // namespace hitclustering
+
+#endif
@@ -59,6 +59,8 @@
 #include <CondFormats/L1TObjects/interface/L1MuTriggerScales.h>
 #include <CondFormats/L1TObjects/interface/L1MuTriggerPtScale.h>
 
+#include "GEMCode/SimMuL1/interface/PSimHitPool.h"
+
 
 //
 // class decleration
@@ -69,7 +71,11 @@ class CSCGeometry;
 class MatchCSCMuL1 
 {
 public:
-  MatchCSCMuL1(const SimTrack  *s, const SimVertex *v, const CSCGeometry* g);
+  typedef SimHitAnalysis::PSimHitPool::Index HitIndex;
+  typedef SimHitAnalysis::PSimHitPool::Indices HitIndices;
+  typedef SimHitAnalysis::PSimHitPool::IndexRange HitIndexRange;
+
+  MatchCSCMuL1(const SimTrack  *s, const SimVertex *v, const CSCGeometry* g, const SimHitAnalysis::PSimHitPool *p);
   ~MatchCSCMuL1(){};
   
   // SimTrack itself
@@ -77,6 +83,10 @@ public:
   const SimVertex *svtx;
 
   const CSCGeometry* cscGeometry;
+
+  // event-level pool that all the simhit indices below refer to
+  const SimHitAnalysis::PSimHitPool *hitPool;
+  const PSimHit & simHit(HitIndex i) const { return (*hitPool)[i]; }
   
   // positions extrapolated to different stations
   math::XYZVectorD pME11;
@@ -93,20 +103,23 @@ public:
   // strk's ID is first element, followed by IDs of its children SimTracks
   std::vector<unsigned> familyIds;
   
-  // matching SimHits of muon strk and (if !doSimpleSimHitToTrackMatch_) its children 
-  void addSimHit( PSimHit & h );
-  std::vector<PSimHit> simHits;
-  std::map<int, std::vector<PSimHit> > hitsMapLayer;
-  std::map<int, std::vector<PSimHit> > hitsMapChamber;
-
-  // if( muOnly == true ) only hits with |particleType|==13 are considered
+  // matching SimHits of muon strk and (if !doSimpleSimHitToTrackMatch_) its children,
+  // stored as indices into hitPool
+  void addSimHit( HitIndex h );
+  HitIndices simHits;
+  std::map<int, HitIndices > hitsMapLayer;
+  std::map<int, HitIndices > hitsMapChamber;
+
+  // if( muOnly == true ) only hits with |particleType|==13 are considered;
+  // muOnly has to be set before any addSimHit call, as the layer and chamber
+  // maps only index the hits that pass it
   
   int nSimHits();
   std::vector<int> detsWithHits();
   std::vector<int> chambersWithHits(int station=0, int ring=0, unsigned minNHits=4);
-  std::vector<PSimHit> layerHits( int detId );
-  std::vector<PSimHit> chamberHits( int detId );
-  std::vector<PSimHit> allSimHits();
+  HitIndexRange layerHits( int detId );
+  HitIndexRange chamberHits( int detId );
+  HitIndices allSimHits();
   int numberOfLayersWithHitsInChamber( int detId );
   std::pair<int,int> wireGroupAndStripInChamber( int detId );
 
@@ -135,7 +148,7 @@ public:
 
     const CSCALCTDigi * trgdigi;
     std::vector<CSCAnodeLayerInfo> layerInfo;
-    std::vector<PSimHit> simHits;
+    HitIndices simHits; // indices into match->hitPool
     CSCDetId id; // chamber id
     
     int nHitsShared; // # simhits shared with simtrack
@@ -177,7 +190,7 @@ public:
 
     const CSCCLCTDigi * trgdigi;
     std::vector<CSCCathodeLayerInfo> layerInfo;
-    std::vector<PSimHit> simHits;
+    HitIndices simHits; // indices into match->hitPool
     CSCDetId id; // chamber id
 
     int nHitsShared; // # simhits shared with simtrack
@@ -407,6 +420,8 @@ public:
 
 private:
 
+  // backs the empty index ranges
+  HitIndices noHits;
 };
 
 #endif
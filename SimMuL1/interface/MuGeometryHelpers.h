@@ -15,6 +15,8 @@
 
 #include <vector>
 #include <cmath>
+#include <string>
+#include <iosfwd>
 
 class CSCGeometry;
 class GEMGeometry;
@@ -94,13 +96,28 @@ const double dt_n_superlayers[DT_TYPES+1]   = {1, 3, 3, 3, 3, 3, 3, 3, 3, 3, 2,
 class MuGeometryAreas
 {
 public:
-  //MuGeometryAreas();
+  MuGeometryAreas();
 
   void calculateCSCDetectorAreas(const CSCGeometry* g);
   void calculateGEMDetectorAreas(const GEMGeometry* g);
   void calculateDTDetectorAreas(const DTGeometry* g);
   void calculateRPCDetectorAreas(const RPCGeometry* g);
 
+  // fingerprints of the geometries: MD5 of the IDs, positions, bounds and topology parameters
+  // of the detectors (layers, partitions, rolls) the areas are calculated from
+  static std::string fingerprint(const CSCGeometry* g);
+  static std::string fingerprint(const GEMGeometry* g);
+  static std::string fingerprint(const DTGeometry* g);
+  static std::string fingerprint(const RPCGeometry* g);
+
+  // binary cache of the area tables (with the radial segmentation tables they were made with);
+  // load returns false if the file is missing or was made for another fingerprint or segmentation
+  bool load(const std::string &file_name, const std::string &fingerprint);
+  void save(const std::string &file_name, const std::string &fingerprint) const;
+
+  // text dump of the area tables
+  void print(std::ostream &o) const;
+
   float csc_total_areas_cm2[CSC_TYPES+1];
   float gem_total_areas_cm2[GEM_TYPES+1];
   float dt_total_areas_cm2[DT_TYPES+1];
@@ -117,6 +134,10 @@ public:
   // half-spans of CSC stations in r
   static const float csc_ch_halfheight[CSC_TYPES+1];
 
+  // fraction of a CSC chamber type area within r1 < r < r2:
+  // chambers are taken as trapezoids spanning csc_ch_radius +- csc_ch_halfheight, so the area grows as r*dr
+  static float cscAreaFractionInRadius(int t, float r1, float r2);
+
 
   // centers of MB chamber types in |z|
   // Note: normally, wheel 0 chamber is centered at 0, but as we are looking at "half-detector"
@@ -38,7 +38,7 @@ struct MyCSCDetId
 
 struct MyCSCSimHit
 {
-  void init(PSimHit &sh, const CSCGeometry* csc_g, const ParticleDataTable * pdt);
+  void init(const PSimHit &sh, const CSCGeometry* csc_g, const ParticleDataTable * pdt);
   void book(TTree* t)
   {
     t->Branch("sh", &x,"x/F:y:z:r:eta:phi:gx:gy:gz:e:p:m:t:trid/I:pdg:w:s");
@@ -136,7 +136,7 @@ struct MyGEMDetId
 
 struct MyGEMSimHit
 {
-  void init(PSimHit &sh, const GEMGeometry* gem_g, const ParticleDataTable * pdt);
+  void init(const PSimHit &sh, const GEMGeometry* gem_g, const ParticleDataTable * pdt);
   void book(TTree* t)
   {
     t->Branch("sh", &x,"x/F:y:z:r:eta:phi:gx:gy:gz:e:p:m:t:trid/I:pdg:s");
@@ -236,7 +236,7 @@ struct MyRPCDetId
 
 struct MyRPCSimHit
 {
-  void init(PSimHit &sh, const RPCGeometry* rpc_g, const ParticleDataTable * pdt);
+  void init(const PSimHit &sh, const RPCGeometry* rpc_g, const ParticleDataTable * pdt);
   void book(TTree* t)
   {
     t->Branch("sh", &x,"x/F:y:z:r:eta:phi:gx:gy:gz:e:p:m:t:trid/I:pdg:s");
@@ -336,7 +336,7 @@ struct MyDTDetId
 
 struct MyDTSimHit
 {
-  void init(PSimHit &sh, const DTGeometry* dt_g, const ParticleDataTable * pdt);
+  void init(const PSimHit &sh, const DTGeometry* dt_g, const ParticleDataTable * pdt);
   void book(TTree* t)
   {
     t->Branch("sh", &x,"x/F:y:z:r:eta:phi:gx:gy:gz:e:p:m:t:trid/I:pdg");
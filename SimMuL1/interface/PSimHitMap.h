@@ -3,11 +3,25 @@
 
 // Modified from the original 1_6_12 version of #include "SimMuon/MCTruth/interface/PSimHitMap.h"
 // -- V. Khotilovich
+//
+// Three filling modes:
+//  - map mode (default): the hits are copied into per-detId PSimHitContainers
+//  - zero-copy mode (setZeroCopy(true)): the event's PSimHitContainer is kept as is
+//    (through a PSimHitPool), the hits are reached through an index permutation
+//    sorted by detId, and a flat (detId, begin, end) table gives the per-detId spans.
+//  - CrossingFrame mode (setUseCrossingFrame(true)): the signal and pileup hits are
+//    iterated once through the MixCollection, within the BX window (setBXWindow), and
+//    only pointers to them are kept, sorted by (detId, bx), together with the (bx, source)
+//    origin of each hit. A BX sub-window of a detId is thus a sub-span of its range.
+// detHits(detId) returns a HitRange view in all modes, while hits(detId)
+// is only available in the map mode.
 
 
 #include "FWCore/Utilities/interface/InputTag.h"
 #include "FWCore/Framework/interface/Event.h"
 #include "SimDataFormats/TrackingHit/interface/PSimHitContainer.h"
+#include "GEMCode/SimMuL1/interface/PSimHitPool.h"
+#include <iterator>
 #include <map>
 
 namespace SimHitAnalysis {
@@ -15,9 +29,84 @@ namespace SimHitAnalysis {
 class PSimHitMap
 {
 public:
+  typedef PSimHitPool::Index Index;
+
+  // where a hit comes from: its bunch crossing and its source
+  // (signal, or the CrossingFrame source type of the pileup: 0 for the minimum bias, ...)
+  struct HitOrigin
+  {
+    enum {SIGNAL = -1};
+    HitOrigin(): bx(0), source(SIGNAL) {}
+    HitOrigin(int b, int s): bx(b), source(s) {}
+    short bx;
+    short source;
+  };
+
+  // view of the hits of a detId: a contiguous run of hits (map mode),
+  // hits reached through a run of pool indices (zero-copy mode),
+  // or a run of hit pointers with their origins (CrossingFrame mode)
+  class HitRange
+  {
+  public:
+    struct Span
+    {
+      Span(): hits(0), index(0), ptrs(0), origins(0) {}
+      const PSimHit & hit(unsigned i) const { return ptrs ? *ptrs[i] : hits[index ? index[i] : i]; }
+      HitOrigin origin(unsigned i) const { return origins ? origins[i] : HitOrigin(); }
+      const PSimHit *hits;
+      const Index *index;
+      const PSimHit * const *ptrs;
+      const HitOrigin *origins;
+    };
+
+    class const_iterator: public std::iterator<std::random_access_iterator_tag, const PSimHit>
+    {
+    public:
+      const_iterator(): i(0) {}
+      const_iterator(const Span &s, unsigned n): theSpan(s), i(n) {}
+      const PSimHit & operator*() const { return theSpan.hit(i); }
+      const PSimHit * operator->() const { return &theSpan.hit(i); }
+      const PSimHit & operator[](int n) const { return theSpan.hit(i + n); }
+      HitOrigin origin() const { return theSpan.origin(i); }
+      const_iterator & operator++() { ++i; return *this; }
+      const_iterator operator++(int) { const_iterator r(*this); ++i; return r; }
+      const_iterator & operator--() { --i; return *this; }
+      const_iterator operator--(int) { const_iterator r(*this); --i; return r; }
+      const_iterator & operator+=(int n) { i += n; return *this; }
+      const_iterator & operator-=(int n) { i -= n; return *this; }
+      const_iterator operator+(int n) const { return const_iterator(theSpan, i + n); }
+      const_iterator operator-(int n) const { return const_iterator(theSpan, i - n); }
+      difference_type operator-(const const_iterator &o) const { return (difference_type)i - (difference_type)o.i; }
+      bool operator==(const const_iterator &o) const { return i == o.i; }
+      bool operator!=(const const_iterator &o) const { return i != o.i; }
+      bool operator<(const const_iterator &o) const { return i < o.i; }
+      bool operator>(const const_iterator &o) const { return i > o.i; }
+      bool operator<=(const const_iterator &o) const { return i <= o.i; }
+      bool operator>=(const const_iterator &o) const { return i >= o.i; }
+    private:
+      Span theSpan;
+      unsigned i;
+    };
+
+    HitRange(): theSize(0) {}
+    HitRange(const Span &s, unsigned n): theSpan(s), theSize(n) {}
+    const_iterator begin() const { return const_iterator(theSpan, 0); }
+    const_iterator end() const { return const_iterator(theSpan, theSize); }
+    unsigned size() const { return theSize; }
+    bool empty() const { return theSize == 0; }
+    const PSimHit & operator[](unsigned i) const { return theSpan.hit(i); }
+    HitOrigin origin(unsigned i) const { return theSpan.origin(i); }
+  private:
+    Span theSpan;
+    unsigned theSize;
+  };
+
   // defaults to "g4SimHits", "MuonCSCHits" and hits from PSimHitContainer
   PSimHitMap():
     useCrossingFrame(false),
+    zeroCopy(false),
+    theBXMin(-9999),
+    theBXMax(9999),
     theModuleName("g4SimHits"),
     theCollectionName("MuonCSCHits"),
     theMap(),
@@ -26,7 +115,10 @@ public:
   // for filling from CrssingFrame only
   PSimHitMap(std::string & collectionName):
     useCrossingFrame(true),
-    theModuleName(""),
+    zeroCopy(false),
+    theBXMin(-9999),
+    theBXMax(9999),
+    theModuleName("mix"),
     theCollectionName(collectionName),
     theMap(),
     theEmptyContainer() {}
@@ -34,6 +126,9 @@ public:
   // for filling from PSimHitContainer only
   PSimHitMap(std::string & collectionName, std::string & moduleName):
     useCrossingFrame(false),
+    zeroCopy(false),
+    theBXMin(-9999),
+    theBXMax(9999),
     theModuleName(moduleName),
     theCollectionName(collectionName),
     theMap(),
@@ -41,23 +136,60 @@ public:
 
   // customization 
   void setUseCrossingFrame(bool useCF) { useCrossingFrame = useCF;}
+  void setZeroCopy(bool zc) { zeroCopy = zc;}
+  // bunch crossings of the CrossingFrame hits to take at fill
+  void setBXWindow(int bxMin, int bxMax) { theBXMin = bxMin; theBXMax = bxMax;}
   void setCollectionName(std::string & collectionName) {theCollectionName = collectionName;}
   void setModuleName(std::string & moduleName) {theModuleName=moduleName;}
   void setInputTag(edm::InputTag &t);
 
   void fill(const edm::Event & e);
 
+  // map mode only
   const edm::PSimHitContainer & hits(int detId) const;
 
-  std::vector<int> detsWithHits() const;
+  // all modes; the view is valid until the next fill
+  HitRange detHits(int detId) const;
+
+  // hits of a detId within [bxMin, bxMax]; all the hits are in BX 0 unless from a CrossingFrame
+  HitRange detHits(int detId, int bxMin, int bxMax) const;
+
+  // sorted detIds, precomputed at fill
+  const std::vector<int> & detsWithHits() const { return theDets; }
+
+  // the pool behind the zero-copy mode, e.g., to refer to the hits by index
+  const PSimHitPool & pool() const { return thePool; }
 
 protected:
+  struct DetRange
+  {
+    int detId;
+    Index begin;
+    Index end;
+    bool operator<(int d) const { return detId < d; }
+  };
+
+  void fillFromCrossingFrame(const edm::Event & e);
+
   bool useCrossingFrame;
+  bool zeroCopy;
+  int theBXMin;
+  int theBXMax;
   std::string theModuleName;
   std::string theCollectionName;
   std::map<int, edm::PSimHitContainer> theMap;
   edm::PSimHitContainer theEmptyContainer;
   std::vector<int> theEmptyVector;
+
+  // zero-copy mode
+  PSimHitPool thePool;
+  std::vector<DetRange> theDetRanges;
+
+  // CrossingFrame mode, sorted by (detId, bx)
+  std::vector<const PSimHit *> theCFHits;
+  std::vector<HitOrigin> theCFOrigins;
+
+  std::vector<int> theDets;
 };
 
 }// namespace SimHitAnalysis
@@ -5,16 +5,19 @@
 
 namespace SimHitAnalysis {
 
+// The chambers with hits and their layers with hits are precomputed at fill
+// from the sorted layer detIds (the layers of a chamber are adjacent in the rawId order).
 class PSimHitMapCSC: public PSimHitMap
 {
 public:
   void fill(const edm::Event & e);
 
-  std::vector<int> chambersWithHits() const;
-  std::vector<int> chamberLayersWithHits(int detId) const;
+  const std::vector<int> & chambersWithHits() const { return theChambers; }
+  const std::vector<int> & chamberLayersWithHits(int detId) const;
 
 private:
-  std::map<int, std::vector<int> > theChLayers;
+  std::vector<int> theChambers;
+  std::vector<std::vector<int> > theChLayers;
 };
 
 } // namespace SimHitAnalysis
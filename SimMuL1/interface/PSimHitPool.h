@@ -0,0 +1,117 @@
+#ifndef SimMuL1_PSimHitPool_h
+#define SimMuL1_PSimHitPool_h
+
+// Event-level immutable pool of PSimHits.
+//
+// The pool does not copy the hits: it keeps the event's PSimHitContainer alive
+// through its handle and refers to the hits by 32-bit indices into it.
+// An index permutation sorted by detUnitId (stable w.r.t. the container order)
+// provides per-detId index ranges, so that matching objects (e.g., MatchCSCMuL1
+// and its ALCT/CLCT records) can store indices instead of PSimHit copies.
+//
+// With setUseCrossingFrame(true) the module and collection names refer to a
+// CrossingFrame<PSimHit> (e.g., "mix" and "g4SimHitsMuonCSCHits"). The signal and
+// pileup hits of a MixCollection are not contiguous, so in this mode the pool keeps
+// pointers to them instead (as the CrossingFrame mode of PSimHitMap does), valid
+// while the event holds the CrossingFrame, and the indices refer to the pointers.
+// The hits are then not one array: &pool[0] + i is only meaningful without it.
+
+#include "FWCore/Utilities/interface/InputTag.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "DataFormats/Common/interface/Handle.h"
+#include "SimDataFormats/TrackingHit/interface/PSimHitContainer.h"
+
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <stdint.h>
+
+namespace SimHitAnalysis {
+
+class PSimHitPool
+{
+public:
+  typedef uint32_t Index;
+  typedef std::vector<Index> Indices;
+
+  // lightweight view of a contiguous run of indices
+  class IndexRange
+  {
+  public:
+    typedef Indices::const_iterator const_iterator;
+    IndexRange(): theBegin(), theEnd() {}
+    IndexRange(const_iterator b, const_iterator e): theBegin(b), theEnd(e) {}
+    IndexRange(const std::pair<const_iterator, const_iterator> & r): theBegin(r.first), theEnd(r.second) {}
+    const_iterator begin() const { return theBegin; }
+    const_iterator end() const { return theEnd; }
+    unsigned size() const { return theEnd - theBegin; }
+    bool empty() const { return theBegin == theEnd; }
+    Index operator[](unsigned i) const { return *(theBegin + i); }
+    bool contains(Index i) const { return std::find(theBegin, theEnd, i) != theEnd; }
+  private:
+    const_iterator theBegin;
+    const_iterator theEnd;
+  };
+
+  static const Index invalidIndex = 0xFFFFFFFF;
+
+  // defaults to "g4SimHits" and "MuonCSCHits"
+  PSimHitPool():
+    theModuleName("g4SimHits"),
+    theCollectionName("MuonCSCHits"),
+    useCrossingFrame(false),
+    theHits(0),
+    theSize(0) {}
+
+  // customization
+  void setCollectionName(std::string & collectionName) {theCollectionName = collectionName;}
+  void setModuleName(std::string & moduleName) {theModuleName = moduleName;}
+  void setInputTag(edm::InputTag &t);
+  void setUseCrossingFrame(bool useCF) { useCrossingFrame = useCF; }
+
+  // (re)build the pool for a new event
+  void fill(const edm::Event & e);
+
+  unsigned size() const { return theSize; }
+  const PSimHit & operator[](Index i) const { return hit(i); }
+  const PSimHit & hit(Index i) const { return theHits ? (*theHits)[i] : *theCFHits[i]; }
+
+  // all hit indices in the pool, sorted by detUnitId
+  IndexRange all() const { return IndexRange(theSorted.begin(), theSorted.end()); }
+
+  // indices of hits in detUnit detId, in the original container order
+  IndexRange detHits(int detId) const;
+
+  std::vector<int> detsWithHits() const;
+
+  // index of the pool hit identical to h (e.g., a copy held by a layer info object)
+  // returns invalidIndex if there is no such hit in the pool
+  Index find(const PSimHit & h) const;
+
+  static bool sameHit(const PSimHit & sh1, const PSimHit & sh2);
+
+private:
+  struct LessDetId
+  {
+    LessDetId(const PSimHitPool * p): pool(p) {}
+    bool operator()(Index a, Index b) const { return (int)pool->hit(a).detUnitId() < (int)pool->hit(b).detUnitId(); }
+    bool operator()(Index a, int d) const { return (int)pool->hit(a).detUnitId() < d; }
+    bool operator()(int d, Index b) const { return d < (int)pool->hit(b).detUnitId(); }
+    const PSimHitPool * pool;
+  };
+
+  std::string theModuleName;
+  std::string theCollectionName;
+  bool useCrossingFrame;
+  edm::Handle< edm::PSimHitContainer > theHandle;
+  // the event's container, or 0 in the CrossingFrame mode
+  const edm::PSimHitContainer * theHits;
+  // CrossingFrame mode: the signal and pileup hits in the MixCollection order
+  std::vector<const PSimHit *> theCFHits;
+  unsigned theSize;
+  Indices theSorted;
+};
+
+} // namespace SimHitAnalysis
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef SimMuL1_ThresholdEfficiency_h
+#define SimMuL1_ThresholdEfficiency_h
+
+// Cumulative multi-threshold efficiency accumulator.
+//
+// For every denominator track one fill stores, in the bin of the track's x (e.g., simtrack pt or eta),
+// the index of the highest threshold passed by the matched trigger pt (or "none").
+// The efficiency curves for all thresholds are derived once at the end of the job
+// from the cumulative sums of these counts, and are written as TEfficiency objects.
+
+#include "CommonTools/UtilAlgos/interface/TFileService.h"
+
+#include <string>
+#include <vector>
+
+class TEfficiency;
+
+class ThresholdEfficiency
+{
+public:
+
+  ThresholdEfficiency();
+  // thresholds need not be sorted; x binning is uniform as in TH1
+  ThresholdEfficiency(const std::string & name, const std::string & title,
+                      int nbins, double xmin, double xmax,
+                      const double * thresholds, int nthresholds);
+
+  void init(const std::string & name, const std::string & title,
+            int nbins, double xmin, double xmax,
+            const double * thresholds, int nthresholds);
+
+  // index of the highest threshold such that pt >= threshold; -1 if none
+  int passIndex(double pt) const;
+
+  // one fill per denominator track: x of the track and the pt of its trigger match
+  void fill(double x, double pt) { fillIndex(x, passIndex(pt)); }
+  // denominator track without a trigger match
+  void fillFailed(double x) { fillIndex(x, -1); }
+
+  // builds "<name>_pt<threshold>" TEfficiency curves for all thresholds
+  std::vector<TEfficiency*> book(TFileService & fs) const;
+
+  int nThresholds() const { return thresholds_.size(); }
+  double threshold(int i) const { return thresholds_[i]; }
+
+  // number of tracks in bin (with under/overflow as in TH1) and the number passing threshold i
+  double total(int bin) const { return total_[bin]; }
+  double passed(int bin, int i) const;
+
+private:
+
+  int findBin(double x) const;
+  void fillIndex(double x, int ipass);
+
+  std::string name_;
+  std::string title_;
+  int nbins_;
+  double xmin_, xmax_;
+  std::vector<double> thresholds_;
+
+  // total_[bin] and counts_[bin*nthr + i] = number of tracks whose highest passed threshold is i
+  std::vector<double> total_;
+  std::vector<double> counts_;
+};
+
+#endif
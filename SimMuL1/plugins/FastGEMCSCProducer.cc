@@ -19,6 +19,7 @@
 #include "FWCore/Utilities/interface/InputTag.h"
 #include "FWCore/ServiceRegistry/interface/Service.h"
 #include "FWCore/Utilities/interface/RandomNumberGenerator.h"
+#include "FWCore/Utilities/interface/Digest.h"
 
 #include "DataFormats/MuonDetId/interface/CSCDetId.h"
 //#include "DataFormats/MuonDetId/interface/GEMDetId.h"
@@ -38,9 +39,12 @@
 #include "GEMCode/SimMuL1/interface/FastGEMCSCBuilder.h"
 
 #include "CLHEP/Random/RandomEngine.h"
+#include "CLHEP/Random/JamesRandom.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <memory>
+#include <sstream>
 #include <tuple>
 
 using namespace std;
@@ -64,14 +68,51 @@ public:
   
 private:
   
+  virtual void beginJob();
+
   virtual void beginRun(edm::Run&, edm::EventSetup const&);
 
+  virtual void endJob();
+
   virtual void produce(edm::Event&, const edm::EventSetup&);
 
-  void processStubs4SimTrack(map<unsigned int, vector<CSCCorrelatedLCTDigi> >& stubs, SimTrackMatchManager& match);
+  // new GEM dphi for the index-th LCT in a chamber
+  struct LCTPatch
+  {
+    unsigned int det_id;
+    unsigned int index;
+    float dphi;
+    bool operator<(const LCTPatch &rhs) const
+    {
+      return det_id < rhs.det_id || (det_id == rhs.det_id && index < rhs.index);
+    }
+  };
+
+  // the LCTs of a chamber sorted by their half-strips:
+  // the LCTs within a SimStub's half-strip range are found with a binary search
+  struct LCTIndex
+  {
+    vector<int> hs;
+    vector<int> wg;
+    vector<unsigned int> index; // in the chamber's range
+  };
+
+  const LCTIndex& lctIndex(const CSCCorrelatedLCTDigiCollection::Range& range, unsigned int det_id);
+
+  // indices of the LCTs inside the SimStub's half-strip and wiregroup ranges, in increasing order
+  void lctCandidates(const LCTIndex& lcts, const SimStub& model_stub, vector<unsigned int>& result);
+
+  void processStubs4SimTrack(const CSCCorrelatedLCTDigiCollection& stubs, vector<LCTPatch>& patches, SimTrackMatchManager& match);
+
+  // copy of the input LCTs with the patches applied
+  void applyPatches(const CSCCorrelatedLCTDigiCollection& stubs, vector<LCTPatch>& patches,
+                    CSCCorrelatedLCTDigiCollection& new_stubs);
 
   bool isSimTrackGood(const SimTrack &t);
 
+  // seed of the smearing engine for an event
+  long eventSeed(const edm::EventID &id) const;
+
   edm::ParameterSet cfg_;
   std::string simInputLabel_;
   edm::InputTag lctInput_;
@@ -82,9 +123,25 @@ private:
   bool useLCTPosition_;
   int verbose_;
 
+  // The smearing engine is reseeded in every event from (module seed, run, lumi, event, module label),
+  // so that the output does not depend on the order (or concurrency) of the event processing.
+  // Otherwise, the engine of the RandomNumberGeneratorService is used as a single sequence.
+  bool eventSeededSmearing_;
+  std::string moduleLabel_;
+  unsigned int moduleSeed_;
+  std::unique_ptr<CLHEP::HepRandomEngine> eventEngine_;
+
   const CSCGeometry* csc_geo_;
 
   std::unique_ptr<FastGEMCSCBuilder> builder_;
+
+  vector<LCTPatch> patches_;
+  vector<CSCCorrelatedLCTDigi> patched_lcts_;
+
+  // built on demand, for the chambers with SimStubs in the current event
+  map<unsigned int, LCTIndex> lct_index_;
+  vector<pair<int, unsigned int> > hs_order_;
+  vector<unsigned int> candidates_;
 };
 
 
@@ -99,6 +156,8 @@ FastGEMCSCProducer::FastGEMCSCProducer(const edm::ParameterSet& ps)
 , usePropagatedDPhi_(ps.getParameter<bool>("usePropagatedDPhi"))
 , useLCTPosition_(ps.getParameter<bool>("useLCTPosition"))
 , verbose_(ps.getUntrackedParameter<int>("verbose", 0))
+, eventSeededSmearing_(ps.getUntrackedParameter<bool>("eventSeededSmearing", true))
+, moduleLabel_(ps.getParameter<string>("@module_label"))
 {
   edm::Service<edm::RandomNumberGenerator> rng;
   if ( ! rng.isAvailable())
@@ -107,7 +166,9 @@ FastGEMCSCProducer::FastGEMCSCProducer(const edm::ParameterSet& ps)
      << "FastGEMCSCProducer::FastGEMCSCProducer() - RandomNumberGeneratorService is not present in configuration file.\n"
      << "Add the service in the configuration file or remove the modules that require it.";
   }
-  CLHEP::HepRandomEngine& engine = rng->getEngine();
+  moduleSeed_ = rng->mySeed();
+  if (eventSeededSmearing_) eventEngine_.reset(new CLHEP::HepJamesRandom(moduleSeed_ % 900000000));
+  CLHEP::HepRandomEngine& engine = eventSeededSmearing_ ? *eventEngine_ : rng->getEngine();
 
   builder_.reset(new FastGEMCSCBuilder(ps, engine));
 
@@ -115,12 +176,36 @@ FastGEMCSCProducer::FastGEMCSCProducer(const edm::ParameterSet& ps)
 }
 
 
+void FastGEMCSCProducer::beginJob()
+{
+  builder_->beginJob();
+}
+
+
 void FastGEMCSCProducer::beginRun(edm::Run &iRun, edm::EventSetup const &iSetup)
 {
   //
 }
 
 
+void FastGEMCSCProducer::endJob()
+{
+  builder_->endJob();
+}
+
+
+long FastGEMCSCProducer::eventSeed(const edm::EventID &id) const
+{
+  std::ostringstream key;
+  key << moduleSeed_ <<" "<< id.run() <<" "<< id.luminosityBlock() <<" "<< id.event() <<" "<< moduleLabel_;
+  cms::MD5Result md5 = cms::Digest(key.str()).digest();
+  unsigned long seed = 0;
+  for (int i = 0; i < 4; ++i) seed = (seed << 8) | md5.bytes[i];
+  // the valid range of the HepJamesRandom seeds
+  return seed % 900000000;
+}
+
+
 bool FastGEMCSCProducer::isSimTrackGood(const SimTrack &t)
 {
   // SimTrack selection
@@ -136,6 +221,8 @@ bool FastGEMCSCProducer::isSimTrackGood(const SimTrack &t)
 
 void FastGEMCSCProducer::produce(edm::Event& ev, const edm::EventSetup& es)
 {
+  if (eventSeededSmearing_) eventEngine_->setSeed(eventSeed(ev.id()), 0);
+
   edm::ESHandle<CSCGeometry> csc_g;
   es.get<MuonGeometryRecord>().get(csc_g);
   csc_geo_ = &*csc_g;
@@ -148,22 +235,12 @@ void FastGEMCSCProducer::produce(edm::Event& ev, const edm::EventSetup& es)
   ev.getByLabel(simInputLabel_, sim_vertices);
   const edm::SimVertexContainer & sim_vert = *sim_vertices.product();
 
-  // pick up the stubs from event and store them into a new mutable collection
+  // the stubs from event are only read; their modifications are collected as patches
   edm::Handle<CSCCorrelatedLCTDigiCollection> ev_stubs;
   ev.getByLabel(lctInput_, ev_stubs);
 
-  map<unsigned int, vector<CSCCorrelatedLCTDigi> > mutable_stubs;
-  for(auto detIt = ev_stubs->begin() ; detIt != ev_stubs->end(); ++detIt)
-  {
-    unsigned int d = (*detIt).first.rawId();
-    mutable_stubs[d] = vector<CSCCorrelatedLCTDigi>();
-    const auto& range = (*detIt).second;
-    for (auto stubIt = range.first; stubIt != range.second; ++stubIt)
-    {
-      mutable_stubs[d].push_back(*stubIt);
-    }
-  }
-
+  patches_.clear();
+  lct_index_.clear();
   for (auto& t: *sim_tracks.product())
   {
     if (!isSimTrackGood(t)) continue;
@@ -171,21 +248,90 @@ void FastGEMCSCProducer::produce(edm::Event& ev, const edm::EventSetup& es)
     // match hits, digis and LCTs to this SimTrack
     SimTrackMatchManager match(t, sim_vert[t.vertIndex()], cfg_, ev, es);
 
-    processStubs4SimTrack(mutable_stubs, match);
+    processStubs4SimTrack(*ev_stubs, patches_, match);
   }
 
-  // pack modified stubs into a CSCCorrelatedLCTDigiCollection and store it in event 
+  // copy the stubs with the patches applied into a new collection and store it in event
   std::auto_ptr<CSCCorrelatedLCTDigiCollection> new_stubs(new CSCCorrelatedLCTDigiCollection);
-  for (auto dstubs: mutable_stubs)
+  applyPatches(*ev_stubs, patches_, *new_stubs);
+  ev.put(new_stubs, productInstanceName_);
+}
+
+
+void FastGEMCSCProducer::applyPatches(const CSCCorrelatedLCTDigiCollection& stubs, vector<LCTPatch>& patches,
+                                      CSCCorrelatedLCTDigiCollection& new_stubs)
+{
+  // stable sort: for a stub patched several times, the last patch wins as it is applied last
+  std::stable_sort(patches.begin(), patches.end());
+
+  // one pass over the chambers, which are in the detId order
+  auto patch = patches.begin();
+  for (auto detIt = stubs.begin(); detIt != stubs.end(); ++detIt)
   {
-    CSCDetId id(dstubs.first);
-    new_stubs->put(make_pair(dstubs.second.begin(), dstubs.second.end()), id);
+    const CSCDetId& id = (*detIt).first;
+    const auto& range = (*detIt).second;
+
+    while (patch != patches.end() && patch->det_id < id.rawId()) ++patch;
+    if (patch == patches.end() || patch->det_id != id.rawId())
+    {
+      // unmodified chamber: straight copy of its range
+      new_stubs.put(range, id);
+      continue;
+    }
+
+    patched_lcts_.assign(range.first, range.second);
+    for (; patch != patches.end() && patch->det_id == id.rawId(); ++patch)
+    {
+      patched_lcts_[patch->index].setGEMDPhi(patch->dphi);
+    }
+    new_stubs.put(make_pair(patched_lcts_.cbegin(), patched_lcts_.cend()), id);
   }
-  ev.put(new_stubs, productInstanceName_);
 }
 
 
-void FastGEMCSCProducer::processStubs4SimTrack(map<unsigned int, vector<CSCCorrelatedLCTDigi> >& stubs, SimTrackMatchManager& match)
+const FastGEMCSCProducer::LCTIndex&
+FastGEMCSCProducer::lctIndex(const CSCCorrelatedLCTDigiCollection::Range& range, unsigned int det_id)
+{
+  auto found = lct_index_.find(det_id);
+  if (found != lct_index_.end()) return found->second;
+
+  hs_order_.clear();
+  for (auto stubIt = range.first; stubIt != range.second; ++stubIt)
+  {
+    // LCT halfstrip and wiregoup numbers start from 0
+    hs_order_.push_back(make_pair(1 + stubIt->getStrip(), unsigned(stubIt - range.first)));
+  }
+  std::sort(hs_order_.begin(), hs_order_.end());
+
+  LCTIndex &lcts = lct_index_[det_id];
+  lcts.hs.reserve(hs_order_.size());
+  lcts.wg.reserve(hs_order_.size());
+  lcts.index.reserve(hs_order_.size());
+  for (auto &p: hs_order_)
+  {
+    lcts.hs.push_back(p.first);
+    lcts.wg.push_back(1 + (range.first + p.second)->getKeyWG());
+    lcts.index.push_back(p.second);
+  }
+  return lcts;
+}
+
+
+void FastGEMCSCProducer::lctCandidates(const LCTIndex& lcts, const SimStub& model_stub, vector<unsigned int>& result)
+{
+  result.clear();
+  auto first = std::lower_bound(lcts.hs.begin(), lcts.hs.end(), model_stub.minHalfStrip());
+  for (size_t i = first - lcts.hs.begin(); i < lcts.hs.size() && lcts.hs[i] <= model_stub.maxHalfStrip(); ++i)
+  {
+    if (model_stub.hasWireGroup(lcts.wg[i])) result.push_back(lcts.index[i]);
+  }
+  // keep the LCTs order of the chamber
+  std::sort(result.begin(), result.end());
+}
+
+
+void FastGEMCSCProducer::processStubs4SimTrack(const CSCCorrelatedLCTDigiCollection& stubs, vector<LCTPatch>& patches,
+                                               SimTrackMatchManager& match)
 {
   const SimHitMatcher& match_sh = match.simhits();
 
@@ -200,23 +346,26 @@ void FastGEMCSCProducer::processStubs4SimTrack(map<unsigned int, vector<CSCCorre
     //if (s2) cout<<"model in "<<id<<endl;
 
     // was there any actual LCT in this detid?
-    auto dstubs = stubs.find(d);
-    if (dstubs == stubs.end()) {/*if (s2) cout<<"  --not in stubs"<<endl;*/ continue;}
+    auto dstubs = stubs.get(id);
+    if (dstubs.first == dstubs.second) {/*if (s2) cout<<"  --not in stubs"<<endl;*/ continue;}
 
     auto &model_stubs = builder_->getStubs(d);
-    //if (s2) cout<<"  ++in stubs: mod "<<model_stubs.size()<<" lct "<<dstubs->second.size()<<endl;
+    //if (s2) cout<<"  ++in stubs: mod "<<model_stubs.size()<<" lct "<<dstubs.second - dstubs.first<<endl;
+
+    const LCTIndex& lcts = lctIndex(dstubs, d);
 
     for (auto &model_stub: model_stubs)
     {
       //cout<<"  mstub "<<model_stub<<endl;
-      for (auto& stub: dstubs->second)
+      // only the LCTs within the model_stub's half-strip and wiregroup ranges
+      lctCandidates(lcts, model_stub, candidates_);
+      for (auto i: candidates_)
       {
+        const auto& stub = *(dstubs.first + i);
         int wg = 1 + stub.getKeyWG(); // LCT halfstrip and wiregoup numbers start from 0
         int hs = 1 + stub.getStrip();
         //if (s2) cout<<"  wg hs "<<wg<<" "<<hs<<" ->  "<< model_stub.hasWireGroup(wg)<<" "<<model_stub.hasHalfStrip(hs) <<endl;
 
-        if ( ! (model_stub.hasHalfStrip(hs) && model_stub.hasWireGroup(wg)) ) continue;
-
         if (useLCTPosition_)
         {
           // replace model_stub's CSC position with that of the matched LCT
@@ -241,7 +390,8 @@ void FastGEMCSCProducer::processStubs4SimTrack(map<unsigned int, vector<CSCCorre
         float dphi = model_stub.dPhiGEMCSCLinear();
         if (usePropagatedDPhi_) dphi = model_stub.dPhiGEMCSCPropagator();
         //if (s2) cout<<"     setting dphi "<<dphi<<" # "<<model_stub.dPhiGEMCSCLinear()<<endl;
-        stub.setGEMDPhi(dphi);
+        LCTPatch p = {d, i, dphi};
+        patches.push_back(p);
       }
     }
   }
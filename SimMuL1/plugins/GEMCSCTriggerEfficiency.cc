@@ -92,14 +92,14 @@ const double GEMCSCTriggerEfficiency::PT_THRESHOLDS_FOR_ETA[N_PT_THRESHOLDS] = {
 GEMCSCTriggerEfficiency::GEMCSCTriggerEfficiency(const edm::ParameterSet& iConfig):
   //  theCSCSimHitMap("MuonCSCHits"), theDTSimHitMap("MuonDTHits"), theRPCSimHitMap("MuonRPCHits")
   ptLUT(0),
-  theCSCSimHitMap()
+  theCSCSimHitPool()
 {
   simHitsFromCrossingFrame_ = iConfig.getUntrackedParameter<bool>("SimHitsFromCrossingFrame", false);
   simHitsModuleName_        = iConfig.getUntrackedParameter<std::string>("SimHitsModuleName",    "g4SimHits");
   simHitsCollectionName_    = iConfig.getUntrackedParameter<std::string>("SimHitsCollectionName","MuonCSCHits");
-  theCSCSimHitMap.setUseCrossingFrame(simHitsFromCrossingFrame_);
-  theCSCSimHitMap.setModuleName(simHitsModuleName_);
-  theCSCSimHitMap.setCollectionName(simHitsCollectionName_);
+  theCSCSimHitPool.setUseCrossingFrame(simHitsFromCrossingFrame_);
+  theCSCSimHitPool.setModuleName(simHitsModuleName_);
+  theCSCSimHitPool.setCollectionName(simHitsCollectionName_);
 
   doStrictSimHitToTrackMatch_ = iConfig.getUntrackedParameter<bool>("doStrictSimHitToTrackMatch", false);
   matchAllTrigPrimitivesInChamber_ = iConfig.getUntrackedParameter<bool>("matchAllTrigPrimitivesInChamber", false);
@@ -163,6 +163,10 @@ GEMCSCTriggerEfficiency::GEMCSCTriggerEfficiency(const edm::ParameterSet& iConfi
   // no GMT and L1Extra processing
   lightRun = iConfig.getUntrackedParameter<bool>("lightRun", true);
 
+  // all histograms are written unless the job opts in to booking them at their first fill
+  lazyHistogramBooking_ = iConfig.getUntrackedParameter<bool>("lazyHistogramBooking", false);
+  histos_.configure(iConfig);
+
   // special treatment of matching in ME1a for the case of the default emulator
   defaultME1a = iConfig.getUntrackedParameter<bool>("defaultME1a", false);
 
@@ -215,12 +219,8 @@ GEMCSCTriggerEfficiency::GEMCSCTriggerEfficiency(const edm::ParameterSet& iConfi
   nevt = 0;
 
   gemMatchCfg_ = iConfig.getParameterSet("simTrackMatching");
-  gemPTs_ = iConfig.getParameter<std::vector<double> >("gemPTs");
-  gemDPhisOdd_ = iConfig.getParameter<std::vector<double> >("gemDPhisOdd");
-  gemDPhisEven_ = iConfig.getParameter<std::vector<double> >("gemDPhisEven");
-
-  assert(std::is_sorted(gemPTs_.begin(), gemPTs_.end()));
-  assert(gemPTs_.size() == gemDPhisOdd_.size() && gemPTs_.size() == gemDPhisEven_.size());
+  gemDPhiCuts_ = GEMDPhiCuts(iConfig);
+  gemDPhiWPs_ = GEMDPhiCuts::workingPoints(iConfig);
 
 
 
@@ -239,17 +239,17 @@ GEMCSCTriggerEfficiency::GEMCSCTriggerEfficiency(const edm::ParameterSet& iConfi
 //   double ETA_START_DT = 0.;
 //   double ETA_END_DT   = 1.2;
 
-  h_N_mctr  = fs->make<TH1D>("h_N_mctr","No of MC muons",16,-0.5,15.5);
-  h_N_simtr = fs->make<TH1D>("h_N_simtr","No of SimTrack muons",16,-0.5,15.5);
+  h_N_mctr  = histos_.book1D("h_N_mctr","No of MC muons",16,-0.5,15.5);
+  h_N_simtr = histos_.book1D("h_N_simtr","No of SimTrack muons",16,-0.5,15.5);
 
-  h_pt_mctr  = fs->make<TH1D>("h_pt_mctr","p_{T} of MC muons",50, 0.,100.);
-  h_eta_mctr  = fs->make<TH1D>("h_eta_mctr","#eta of MC muons",N_ETA_BINS, ETA_START, ETA_END);
-  h_phi_mctr  = fs->make<TH1D>("h_phi_mctr","#phi of MC muons",100, -M_PI,M_PI);
+  h_pt_mctr  = histos_.book1D("h_pt_mctr","p_{T} of MC muons",50, 0.,100.);
+  h_eta_mctr  = histos_.book1D("h_eta_mctr","#eta of MC muons",N_ETA_BINS, ETA_START, ETA_END);
+  h_phi_mctr  = histos_.book1D("h_phi_mctr","#phi of MC muons",100, -M_PI,M_PI);
 
-  h_DR_mctr_simtr    = fs->make<TH1D>("h_DR_mctr_simtr","#Delta R(MC trk, SimTrack)",300,0.,M_PI); 
-  h_MinDR_mctr_simtr = fs->make<TH1D>("h_MinDR_mctr_simtr","min #Delta R(MC trk, SimTrack)",300,0.,M_PI); 
+  h_DR_mctr_simtr    = histos_.book1D("h_DR_mctr_simtr","#Delta R(MC trk, SimTrack)",300,0.,M_PI); 
+  h_MinDR_mctr_simtr = histos_.book1D("h_MinDR_mctr_simtr","min #Delta R(MC trk, SimTrack)",300,0.,M_PI); 
 
-  h_DR_2SimTr        = fs->make<TH1D>("h_DR_2SimTr","#Delta R(SimTr 1, SimTr 2)",270,0.,M_PI*3/2); 
+  h_DR_2SimTr        = histos_.book1D("h_DR_2SimTr","#Delta R(SimTr 1, SimTr 2)",270,0.,M_PI*3/2); 
 
 
   // debug
@@ -267,542 +267,550 @@ GEMCSCTriggerEfficiency::GEMCSCTriggerEfficiency(const edm::ParameterSet& iConfi
     if (me==3 && !doME1a_) continue; // ME1/a
     
     sprintf(label,"h_bx__alct_cscdet_%s",csc_type_[me].c_str());
-    h_bx__alct_cscdet[me]  = fs->make<TH1D>(label, label, 13,-6.5, 6.5);
+    h_bx__alct_cscdet[me]  = histos_.book1D(label, label, 13,-6.5, 6.5);
     
     sprintf(label,"h_bx_min__alct_cscdet_%s",csc_type_[me].c_str());
-    h_bx_min__alct_cscdet[me]  = fs->make<TH1D>(label, label, 13,-6.5, 6.5);
+    h_bx_min__alct_cscdet[me]  = histos_.book1D(label, label, 13,-6.5, 6.5);
 
     sprintf(label,"h_bx__alctOk_cscdet_%s",csc_type_[me].c_str());
-    h_bx__alctOk_cscdet[me]  = fs->make<TH1D>(label, label, 13,-6.5, 6.5);
+    h_bx__alctOk_cscdet[me]  = histos_.book1D(label, label, 13,-6.5, 6.5);
 
     sprintf(label,"h_bx__alctOkBest_cscdet_%s",csc_type_[me].c_str());
-    h_bx__alctOkBest_cscdet[me]  = fs->make<TH1D>(label, label, 13,-6.5, 6.5);
+    h_bx__alctOkBest_cscdet[me]  = histos_.book1D(label, label, 13,-6.5, 6.5);
     
     sprintf(label,"h_bx__clctOkBest_cscdet_%s",csc_type_[me].c_str());
-    h_bx__clctOkBest_cscdet[me]  = fs->make<TH1D>(label, label, 13,-6.5, 6.5);
+    h_bx__clctOkBest_cscdet[me]  = histos_.book1D(label, label, 13,-6.5, 6.5);
     
     sprintf(label,"h_wg_vs_bx__alctOkBest_cscdet_%s",csc_type_[me].c_str());
-    h_wg_vs_bx__alctOkBest_cscdet[me]  = fs->make<TH2D>(label, label, 51, -1, 50, 13,-6.5, 6.5);
+    h_wg_vs_bx__alctOkBest_cscdet[me]  = histos_.book2D(label, label, 51, -1, 50, 13,-6.5, 6.5);
     
     sprintf(label,"h_bxf__alct_cscdet_%s",csc_type_[me].c_str());
-    h_bxf__alct_cscdet[me]  = fs->make<TH1D>(label, label, 13,-6.5, 6.5);
+    h_bxf__alct_cscdet[me]  = histos_.book1D(label, label, 13,-6.5, 6.5);
     
     sprintf(label,"h_bxf__alctOk_cscdet_%s",csc_type_[me].c_str());
-    h_bxf__alctOk_cscdet[me]  = fs->make<TH1D>(label, label, 13,-6.5, 6.5);
+    h_bxf__alctOk_cscdet[me]  = histos_.book1D(label, label, 13,-6.5, 6.5);
     
     sprintf(label,"h_dbxbxf__alct_cscdet_%s",csc_type_[me].c_str());
-    h_dbxbxf__alct_cscdet[me]  = fs->make<TH1D>(label, label, 13,-6.5, 6.5);
+    h_dbxbxf__alct_cscdet[me]  = histos_.book1D(label, label, 13,-6.5, 6.5);
     
     sprintf(label,"h_tf_stub_bx_cscdet_%s",csc_type_[me].c_str());
-    h_tf_stub_bx_cscdet[me] = fs->make<TH1D>(label, label, 15,-7.5, 7.5);
+    h_tf_stub_bx_cscdet[me] = histos_.book1D(label, label, 15,-7.5, 7.5);
       
     sprintf(label,"h_tf_stub_qu_cscdet_%s",csc_type_[me].c_str());
-    h_tf_stub_qu_cscdet[me] = fs->make<TH1D>(label, label, 17,-0.5, 16.5);
+    h_tf_stub_qu_cscdet[me] = histos_.book1D(label, label, 17,-0.5, 16.5);
   }//for (int me=0; me<CSC_TYPES; me++) 
 
-  h_tf_stub_bx = fs->make<TH1D>("h_tf_stub_bx","h_tf_stub_bx",15,-7.5, 7.5);
-  h_tf_stub_qu = fs->make<TH1D>("h_tf_stub_qu","h_tf_stub_qu",17,-0.5, 16.5);
-  h_tf_stub_qu_vs_bx = fs->make<TH2D>("h_tf_stub_qu_vs_bx","h_tf_stub_qu_vs_bx",17,-0.5, 16.5,15,-7.5, 7.5);
+  h_tf_stub_bx = histos_.book1D("h_tf_stub_bx","h_tf_stub_bx",15,-7.5, 7.5);
+  h_tf_stub_qu = histos_.book1D("h_tf_stub_qu","h_tf_stub_qu",17,-0.5, 16.5);
+  h_tf_stub_qu_vs_bx = histos_.book2D("h_tf_stub_qu_vs_bx","h_tf_stub_qu_vs_bx",17,-0.5, 16.5,15,-7.5, 7.5);
   
   //  h_bx_me1_aclct_ok_lct_no__bx_alct_vs_dbx_ACLCT = fs->make<TH2D>("h_bx_me1_aclct_ok_lct_no__bx_alct_vs_dbx_ACLCT","h_bx_me1_aclct_ok_lct_no__bx_alct_vs_dbx_ACLCT",13,-0.5,12.5, 13, -6.5,6.5);
 
-  h_tf_stub_csctype = fs->make<TH1D>("h_tf_stub_csctype", "CSC type of TF track stubs", 10, -0.5,  9.5);
-  for (int i=1; i<=h_tf_stub_csctype->GetXaxis()->GetNbins();i++)
-    h_tf_stub_csctype->GetXaxis()->SetBinLabel(i,csc_type[i-1].c_str());
+  h_tf_stub_csctype = histos_.book1D("h_tf_stub_csctype", "CSC type of TF track stubs", 10, -0.5,  9.5);
+  for (int i=1; i<=h_tf_stub_csctype->get()->GetXaxis()->GetNbins();i++)
+    h_tf_stub_csctype->get()->GetXaxis()->SetBinLabel(i,csc_type[i-1].c_str());
 
-  h_strip_v_wireg_me1a = fs->make<TH2D>("h_strip_v_wireg_me1a","h_strip_v_wireg_me1a",97,-0.5, 96.5, 20,-0.5,19.5);
-  h_strip_v_wireg_me1b = fs->make<TH2D>("h_strip_v_wireg_me1b","h_strip_v_wireg_me1b",129,-0.5, 128.5, 40, 8.5,48.5);
+  h_strip_v_wireg_me1a = histos_.book2D("h_strip_v_wireg_me1a","h_strip_v_wireg_me1a",97,-0.5, 96.5, 20,-0.5,19.5);
+  h_strip_v_wireg_me1b = histos_.book2D("h_strip_v_wireg_me1b","h_strip_v_wireg_me1b",129,-0.5, 128.5, 40, 8.5,48.5);
 
-  h_tfqu_pt10 = fs->make<TH1D>("h_tfqu_pt10","h_tfqu_pt10",5,-0.5, 4.5);
-  h_tfqu_pt10_no = fs->make<TH1D>("h_tfqu_pt10_no","h_tfqu_pt10_no",5,-0.5, 4.5);
+  h_tfqu_pt10 = histos_.book1D("h_tfqu_pt10","h_tfqu_pt10",5,-0.5, 4.5);
+  h_tfqu_pt10_no = histos_.book1D("h_tfqu_pt10_no","h_tfqu_pt10_no",5,-0.5, 4.5);
 
-  h_nMplct_vs_nDigiMplct = fs->make<TH2D>("h_nMplct_vs_nDigiMplct","h_nMplct_vs_nDigiMplct",9,-.5, 8.5,9,-.5, 8.5);
-  h_qu_vs_nDigiMplct = fs->make<TH2D>("h_qu_vs_nDigiMplct","h_qu_vs_nDigiMplct",5,-0.5, 4.5,9,-.5, 8.5);
+  h_nMplct_vs_nDigiMplct = histos_.book2D("h_nMplct_vs_nDigiMplct","h_nMplct_vs_nDigiMplct",9,-.5, 8.5,9,-.5, 8.5);
+  h_qu_vs_nDigiMplct = histos_.book2D("h_qu_vs_nDigiMplct","h_qu_vs_nDigiMplct",5,-0.5, 4.5,9,-.5, 8.5);
   
-  h_ntftrackall_vs_ntftrack = fs->make<TH2D>("h_ntftrackall_vs_ntftrack","h_ntftrackall_vs_ntftrack",6,-0.5,5.5,6,-0.5,5.5);
-  h_ntfcandall_vs_ntfcand = fs->make<TH2D>("h_ntfcandall_vs_ntfcand","h_ntfcandall_vs_ntfcand",6,-0.5,5.5,6,-0.5,5.5);
-
-  h_pt_vs_ntfcand = fs->make<TH2D>("h_pt_vs_ntfcand","h_pt_vs_ntfcand",50, 0.,100.,6,-0.5,5.5);
-  h_eta_vs_ntfcand = fs->make<TH2D>("h_eta_vs_ntfcand","h_eta_vs_ntfcand",N_ETA_BINS, ETA_START, ETA_END,4,-0.5,3.5); 
-
-  h_pt_vs_qu = fs->make<TH2D>("h_pt_vs_qu","h_pt_vs_qu",100, 0.,100.,5,-0.5, 4.5);
-  h_eta_vs_qu = fs->make<TH2D>("h_eta_vs_qu","h_eta_vs_qu",N_ETA_BINS, ETA_START, ETA_END,5,-0.5, 4.5);
-
-  h_cscdet_of_chamber = fs->make<TH1D>("h_cscdet_of_chamber","h_cscdet_of_chamber",10, -0.5,  9.5);
-  h_cscdet_of_chamber_w_alct = fs->make<TH1D>("h_cscdet_of_chamber_w_alct","h_cscdet_of_chamber_w_alct",10, -0.5,  9.5);
-  h_cscdet_of_chamber_w_clct = fs->make<TH1D>("h_cscdet_of_chamber_w_clct","h_cscdet_of_chamber_w_clct",10, -0.5,  9.5);
-  h_cscdet_of_chamber_w_mplct = fs->make<TH1D>("h_cscdet_of_chamber_w_mplct","h_cscdet_of_chamber_w_mplct",10, -0.5,  9.5);
-  for (int i=1; i<=h_cscdet_of_chamber->GetXaxis()->GetNbins();i++) {
-    h_cscdet_of_chamber->GetXaxis()->SetBinLabel(i,csc_type[i-1].c_str());
-    h_cscdet_of_chamber_w_alct->GetXaxis()->SetBinLabel(i,csc_type[i-1].c_str());
-    h_cscdet_of_chamber_w_clct->GetXaxis()->SetBinLabel(i,csc_type[i-1].c_str());
-    h_cscdet_of_chamber_w_mplct->GetXaxis()->SetBinLabel(i,csc_type[i-1].c_str());
+  h_ntftrackall_vs_ntftrack = histos_.book2D("h_ntftrackall_vs_ntftrack","h_ntftrackall_vs_ntftrack",6,-0.5,5.5,6,-0.5,5.5);
+  h_ntfcandall_vs_ntfcand = histos_.book2D("h_ntfcandall_vs_ntfcand","h_ntfcandall_vs_ntfcand",6,-0.5,5.5,6,-0.5,5.5);
+
+  h_pt_vs_ntfcand = histos_.book2D("h_pt_vs_ntfcand","h_pt_vs_ntfcand",50, 0.,100.,6,-0.5,5.5);
+  h_eta_vs_ntfcand = histos_.book2D("h_eta_vs_ntfcand","h_eta_vs_ntfcand",N_ETA_BINS, ETA_START, ETA_END,4,-0.5,3.5); 
+
+  h_pt_vs_qu = histos_.book2D("h_pt_vs_qu","h_pt_vs_qu",100, 0.,100.,5,-0.5, 4.5);
+  h_eta_vs_qu = histos_.book2D("h_eta_vs_qu","h_eta_vs_qu",N_ETA_BINS, ETA_START, ETA_END,5,-0.5, 4.5);
+
+  h_cscdet_of_chamber = histos_.book1D("h_cscdet_of_chamber","h_cscdet_of_chamber",10, -0.5,  9.5);
+  h_cscdet_of_chamber_w_alct = histos_.book1D("h_cscdet_of_chamber_w_alct","h_cscdet_of_chamber_w_alct",10, -0.5,  9.5);
+  h_cscdet_of_chamber_w_clct = histos_.book1D("h_cscdet_of_chamber_w_clct","h_cscdet_of_chamber_w_clct",10, -0.5,  9.5);
+  h_cscdet_of_chamber_w_mplct = histos_.book1D("h_cscdet_of_chamber_w_mplct","h_cscdet_of_chamber_w_mplct",10, -0.5,  9.5);
+  for (int i=1; i<=h_cscdet_of_chamber->get()->GetXaxis()->GetNbins();i++) {
+    h_cscdet_of_chamber->get()->GetXaxis()->SetBinLabel(i,csc_type[i-1].c_str());
+    h_cscdet_of_chamber_w_alct->get()->GetXaxis()->SetBinLabel(i,csc_type[i-1].c_str());
+    h_cscdet_of_chamber_w_clct->get()->GetXaxis()->SetBinLabel(i,csc_type[i-1].c_str());
+    h_cscdet_of_chamber_w_mplct->get()->GetXaxis()->SetBinLabel(i,csc_type[i-1].c_str());
   }
   
   int N_PT_BINS=100;
   double PT_START = 0.;
   double PT_END = 100.;
 
-  h_pt_initial0 = fs->make<TH1D>("h_pt_initial0","h_pt_initial0",N_PT_BINS, PT_START, PT_END);
-  h_pt_initial = fs->make<TH1D>("h_pt_initial","h_pt_initial",N_PT_BINS, PT_START, PT_END);
-  h_pt_initial_1b = fs->make<TH1D>("h_pt_initial_1b","h_pt_initial_1b",N_PT_BINS, PT_START, PT_END);
-  h_pt_initial_gem_1b = fs->make<TH1D>("h_pt_initial_gem_1b","h_pt_initial_gem_1b",N_PT_BINS, PT_START, PT_END);
+  h_pt_initial0 = histos_.book1D("h_pt_initial0","h_pt_initial0",N_PT_BINS, PT_START, PT_END);
+  h_pt_initial = histos_.book1D("h_pt_initial","h_pt_initial",N_PT_BINS, PT_START, PT_END);
+  h_pt_initial_1b = histos_.book1D("h_pt_initial_1b","h_pt_initial_1b",N_PT_BINS, PT_START, PT_END);
+  h_pt_initial_gem_1b = histos_.book1D("h_pt_initial_gem_1b","h_pt_initial_gem_1b",N_PT_BINS, PT_START, PT_END);
 
-  h_pt_me1_initial = fs->make<TH1D>("h_pt_me1_initial","h_pt_me1_initial",N_PT_BINS, PT_START, PT_END);
-  h_pt_me2_initial = fs->make<TH1D>("h_pt_me2_initial","h_pt_me2_initial",N_PT_BINS, PT_START, PT_END);
-  h_pt_me3_initial = fs->make<TH1D>("h_pt_me3_initial","h_pt_me3_initial",N_PT_BINS, PT_START, PT_END);
-  h_pt_me4_initial = fs->make<TH1D>("h_pt_me4_initial","h_pt_me4_initial",N_PT_BINS, PT_START, PT_END);
+  h_pt_me1_initial = histos_.book1D("h_pt_me1_initial","h_pt_me1_initial",N_PT_BINS, PT_START, PT_END);
+  h_pt_me2_initial = histos_.book1D("h_pt_me2_initial","h_pt_me2_initial",N_PT_BINS, PT_START, PT_END);
+  h_pt_me3_initial = histos_.book1D("h_pt_me3_initial","h_pt_me3_initial",N_PT_BINS, PT_START, PT_END);
+  h_pt_me4_initial = histos_.book1D("h_pt_me4_initial","h_pt_me4_initial",N_PT_BINS, PT_START, PT_END);
 
-  h_pt_initial_1st = fs->make<TH1D>("h_pt_initial_1st","h_pt_initial_1st",N_PT_BINS, PT_START, PT_END);
-  h_pt_initial_2st = fs->make<TH1D>("h_pt_initial_2st","h_pt_initial_2st",N_PT_BINS, PT_START, PT_END);
-  h_pt_initial_3st = fs->make<TH1D>("h_pt_initial_3st","h_pt_initial_3st",N_PT_BINS, PT_START, PT_END);
+  h_pt_initial_1st = histos_.book1D("h_pt_initial_1st","h_pt_initial_1st",N_PT_BINS, PT_START, PT_END);
+  h_pt_initial_2st = histos_.book1D("h_pt_initial_2st","h_pt_initial_2st",N_PT_BINS, PT_START, PT_END);
+  h_pt_initial_3st = histos_.book1D("h_pt_initial_3st","h_pt_initial_3st",N_PT_BINS, PT_START, PT_END);
 
-  h_pt_me1_initial_2st = fs->make<TH1D>("h_pt_me1_initial_2st","h_pt_me1_initial_2st",N_PT_BINS, PT_START, PT_END);
-  h_pt_me1_initial_3st = fs->make<TH1D>("h_pt_me1_initial_3st","h_pt_me1_initial_3st",N_PT_BINS, PT_START, PT_END);
+  h_pt_me1_initial_2st = histos_.book1D("h_pt_me1_initial_2st","h_pt_me1_initial_2st",N_PT_BINS, PT_START, PT_END);
+  h_pt_me1_initial_3st = histos_.book1D("h_pt_me1_initial_3st","h_pt_me1_initial_3st",N_PT_BINS, PT_START, PT_END);
 
 
-  h_pt_gem_1b = fs->make<TH1D>("h_pt_gem_1b","h_pt_gem_1b",N_PT_BINS, PT_START, PT_END);
-  h_pt_lctgem_1b = fs->make<TH1D>("h_pt_lctgem_1b","h_pt_lctgem_1b",N_PT_BINS, PT_START, PT_END);
+  h_pt_gem_1b = histos_.book1D("h_pt_gem_1b","h_pt_gem_1b",N_PT_BINS, PT_START, PT_END);
+  h_pt_lctgem_1b = histos_.book1D("h_pt_lctgem_1b","h_pt_lctgem_1b",N_PT_BINS, PT_START, PT_END);
 
-  h_pt_me1_mpc = fs->make<TH1D>("h_pt_me1_mpc","h_pt_me1_mpc",N_PT_BINS, PT_START, PT_END);
-  h_pt_me2_mpc = fs->make<TH1D>("h_pt_me2_mpc","h_pt_me2_mpc",N_PT_BINS, PT_START, PT_END);
-  h_pt_me3_mpc = fs->make<TH1D>("h_pt_me3_mpc","h_pt_me3_mpc",N_PT_BINS, PT_START, PT_END);
-  h_pt_me4_mpc = fs->make<TH1D>("h_pt_me4_mpc","h_pt_me4_mpc",N_PT_BINS, PT_START, PT_END);
+  h_pt_me1_mpc = histos_.book1D("h_pt_me1_mpc","h_pt_me1_mpc",N_PT_BINS, PT_START, PT_END);
+  h_pt_me2_mpc = histos_.book1D("h_pt_me2_mpc","h_pt_me2_mpc",N_PT_BINS, PT_START, PT_END);
+  h_pt_me3_mpc = histos_.book1D("h_pt_me3_mpc","h_pt_me3_mpc",N_PT_BINS, PT_START, PT_END);
+  h_pt_me4_mpc = histos_.book1D("h_pt_me4_mpc","h_pt_me4_mpc",N_PT_BINS, PT_START, PT_END);
 
-  h_pt_mpc_1st = fs->make<TH1D>("h_pt_mpc_1st","h_pt_mpc_1st",N_PT_BINS, PT_START, PT_END);
-  h_pt_mpc_2st = fs->make<TH1D>("h_pt_mpc_2st","h_pt_mpc_2st",N_PT_BINS, PT_START, PT_END);
-  h_pt_mpc_3st = fs->make<TH1D>("h_pt_mpc_3st","h_pt_mpc_3st",N_PT_BINS, PT_START, PT_END);
+  h_pt_mpc_1st = histos_.book1D("h_pt_mpc_1st","h_pt_mpc_1st",N_PT_BINS, PT_START, PT_END);
+  h_pt_mpc_2st = histos_.book1D("h_pt_mpc_2st","h_pt_mpc_2st",N_PT_BINS, PT_START, PT_END);
+  h_pt_mpc_3st = histos_.book1D("h_pt_mpc_3st","h_pt_mpc_3st",N_PT_BINS, PT_START, PT_END);
 
-  h_pt_me1_mpc_2st = fs->make<TH1D>("h_pt_me1_mpc_2st","h_pt_me1_mpc_2st",N_PT_BINS, PT_START, PT_END);
-  h_pt_me1_mpc_3st = fs->make<TH1D>("h_pt_me1_mpc_3st","h_pt_me1_mpc_3st",N_PT_BINS, PT_START, PT_END);
+  h_pt_me1_mpc_2st = histos_.book1D("h_pt_me1_mpc_2st","h_pt_me1_mpc_2st",N_PT_BINS, PT_START, PT_END);
+  h_pt_me1_mpc_3st = histos_.book1D("h_pt_me1_mpc_3st","h_pt_me1_mpc_3st",N_PT_BINS, PT_START, PT_END);
 
 
-  h_eta_initial0 = fs->make<TH1D>("h_eta_initial0","h_eta_initial0",N_ETA_BINS, ETA_START, ETA_END);
- h_eta_initial = fs->make<TH1D>("h_eta_initial","h_eta_initial",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_initial0 = histos_.book1D("h_eta_initial0","h_eta_initial0",N_ETA_BINS, ETA_START, ETA_END);
+ h_eta_initial = histos_.book1D("h_eta_initial","h_eta_initial",N_ETA_BINS, ETA_START, ETA_END);
 
-  h_eta_me1_initial = fs->make<TH1D>("h_eta_me1_initial","h_eta_me1_initial",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_me2_initial = fs->make<TH1D>("h_eta_me2_initial","h_eta_me2_initial",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_me3_initial = fs->make<TH1D>("h_eta_me3_initial","h_eta_me3_initial",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_me4_initial = fs->make<TH1D>("h_eta_me4_initial","h_eta_me4_initial",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_me1_initial = histos_.book1D("h_eta_me1_initial","h_eta_me1_initial",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_me2_initial = histos_.book1D("h_eta_me2_initial","h_eta_me2_initial",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_me3_initial = histos_.book1D("h_eta_me3_initial","h_eta_me3_initial",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_me4_initial = histos_.book1D("h_eta_me4_initial","h_eta_me4_initial",N_ETA_BINS, ETA_START, ETA_END);
 
-  h_eta_initial_1st = fs->make<TH1D>("h_eta_initial_1st","h_eta_initial_1st",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_initial_2st = fs->make<TH1D>("h_eta_initial_2st","h_eta_initial_2st",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_initial_3st = fs->make<TH1D>("h_eta_initial_3st","h_eta_initial_3st",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_initial_1st = histos_.book1D("h_eta_initial_1st","h_eta_initial_1st",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_initial_2st = histos_.book1D("h_eta_initial_2st","h_eta_initial_2st",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_initial_3st = histos_.book1D("h_eta_initial_3st","h_eta_initial_3st",N_ETA_BINS, ETA_START, ETA_END);
 
-  h_eta_me1_initial_2st = fs->make<TH1D>("h_eta_me1_initial_2st","h_eta_me1_initial_2st",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_me1_initial_3st = fs->make<TH1D>("h_eta_me1_initial_3st","h_eta_me1_initial_3st",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_me1_initial_2st = histos_.book1D("h_eta_me1_initial_2st","h_eta_me1_initial_2st",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_me1_initial_3st = histos_.book1D("h_eta_me1_initial_3st","h_eta_me1_initial_3st",N_ETA_BINS, ETA_START, ETA_END);
 
 
-  h_eta_me1_mpc = fs->make<TH1D>("h_eta_me1_mpc","h_eta_me1_mpc",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_me2_mpc = fs->make<TH1D>("h_eta_me2_mpc","h_eta_me2_mpc",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_me3_mpc = fs->make<TH1D>("h_eta_me3_mpc","h_eta_me3_mpc",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_me4_mpc = fs->make<TH1D>("h_eta_me4_mpc","h_eta_me4_mpc",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_me1_mpc = histos_.book1D("h_eta_me1_mpc","h_eta_me1_mpc",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_me2_mpc = histos_.book1D("h_eta_me2_mpc","h_eta_me2_mpc",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_me3_mpc = histos_.book1D("h_eta_me3_mpc","h_eta_me3_mpc",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_me4_mpc = histos_.book1D("h_eta_me4_mpc","h_eta_me4_mpc",N_ETA_BINS, ETA_START, ETA_END);
 
-  h_eta_mpc_1st = fs->make<TH1D>("h_eta_mpc_1st","h_eta_mpc_1st",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_mpc_2st = fs->make<TH1D>("h_eta_mpc_2st","h_eta_mpc_2st",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_mpc_3st = fs->make<TH1D>("h_eta_mpc_3st","h_eta_mpc_3st",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_mpc_1st = histos_.book1D("h_eta_mpc_1st","h_eta_mpc_1st",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_mpc_2st = histos_.book1D("h_eta_mpc_2st","h_eta_mpc_2st",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_mpc_3st = histos_.book1D("h_eta_mpc_3st","h_eta_mpc_3st",N_ETA_BINS, ETA_START, ETA_END);
 
-  h_eta_me1_mpc_2st = fs->make<TH1D>("h_eta_me1_mpc_2st","h_eta_me1_mpc_2st",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_me1_mpc_3st = fs->make<TH1D>("h_eta_me1_mpc_3st","h_eta_me1_mpc_3st",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_me1_mpc_2st = histos_.book1D("h_eta_me1_mpc_2st","h_eta_me1_mpc_2st",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_me1_mpc_3st = histos_.book1D("h_eta_me1_mpc_3st","h_eta_me1_mpc_3st",N_ETA_BINS, ETA_START, ETA_END);
 
 
-  h_eta_vs_nalct = fs->make<TH2D>("h_eta_vs_nalct","h_eta_vs_nalct",N_ETA_BINS, ETA_START, ETA_END,13,-0.5,12.5); 
-  h_eta_vs_nclct = fs->make<TH2D>("h_eta_vs_nclct","h_eta_vs_nclct",N_ETA_BINS, ETA_START, ETA_END,13,-0.5,12.5); 
-  h_eta_vs_nlct  = fs->make<TH2D>("h_eta_vs_nlct","h_eta_vs_nlct",N_ETA_BINS, ETA_START, ETA_END,13,-0.5,12.5); 
-  h_eta_vs_nmplct  = fs->make<TH2D>("h_eta_vs_nmplct","h_eta_vs_nmplct",N_ETA_BINS, ETA_START, ETA_END,13,-0.5,12.5); 
+  h_eta_vs_nalct = histos_.book2D("h_eta_vs_nalct","h_eta_vs_nalct",N_ETA_BINS, ETA_START, ETA_END,13,-0.5,12.5); 
+  h_eta_vs_nclct = histos_.book2D("h_eta_vs_nclct","h_eta_vs_nclct",N_ETA_BINS, ETA_START, ETA_END,13,-0.5,12.5); 
+  h_eta_vs_nlct  = histos_.book2D("h_eta_vs_nlct","h_eta_vs_nlct",N_ETA_BINS, ETA_START, ETA_END,13,-0.5,12.5); 
+  h_eta_vs_nmplct  = histos_.book2D("h_eta_vs_nmplct","h_eta_vs_nmplct",N_ETA_BINS, ETA_START, ETA_END,13,-0.5,12.5); 
   
-  h_pt_vs_nalct = fs->make<TH2D>("h_pt_vs_nalct","h_pt_vs_nalct",50, 0.,100.,13,-0.5,12.5);
-  h_pt_vs_nclct = fs->make<TH2D>("h_pt_vs_nclct","h_pt_vs_nclct",50, 0.,100.,13,-0.5,12.5);
-  h_pt_vs_nlct = fs->make<TH2D>("h_pt_vs_nlct","h_pt_vs_nlct",50, 0.,100.,13,-0.5,12.5);
-  h_pt_vs_nmplct = fs->make<TH2D>("h_pt_vs_nmplct","h_pt_vs_nmplct",50, 0.,100.,13,-0.5,12.5);
-
-
-  h_pt_after_alct = fs->make<TH1D>("h_pt_after_alct","h_pt_after_alct",N_PT_BINS, PT_START, PT_END);
-  h_pt_after_clct = fs->make<TH1D>("h_pt_after_clct","h_pt_after_clct",N_PT_BINS, PT_START, PT_END);
-  h_pt_after_lct = fs->make<TH1D>("h_pt_after_lct","h_pt_after_lct",N_PT_BINS, PT_START, PT_END);
-  h_pt_after_mpc = fs->make<TH1D>("h_pt_after_mpc","h_pt_after_mpc",N_PT_BINS, PT_START, PT_END);
-  h_pt_after_mpc_ok_plus = fs->make<TH1D>("h_pt_after_mpc_ok_plus","h_pt_after_mpc_ok_plus",N_PT_BINS, PT_START, PT_END);
-  h_pt_me1_after_mpc_ok_plus = fs->make<TH1D>("h_pt_after_mpc_me1_plus","h_pt_me1_after_mpc_ok_plus",N_PT_BINS, PT_START, PT_END);
-  h_pt_after_tftrack = fs->make<TH1D>("h_pt_after_tftrack","h_pt_after_tftrack",N_PT_BINS, PT_START, PT_END);
-
-  h_pt_after_tfcand = fs->make<TH1D>("h_pt_after_tfcand","h_pt_after_tfcand",N_PT_BINS, PT_START, PT_END);
-  h_pt_after_tfcand_pt10 = fs->make<TH1D>("h_pt_after_tfcand_pt10","h_pt_after_tfcand_pt10",N_PT_BINS, PT_START, PT_END);
-  h_pt_after_tfcand_pt20 = fs->make<TH1D>("h_pt_after_tfcand_pt20","h_pt_after_tfcand_pt20",N_PT_BINS, PT_START, PT_END);
-  h_pt_after_tfcand_pt40 = fs->make<TH1D>("h_pt_after_tfcand_pt40","h_pt_after_tfcand_pt40",N_PT_BINS, PT_START, PT_END);
-  h_pt_after_tfcand_pt60 = fs->make<TH1D>("h_pt_after_tfcand_pt60","h_pt_after_tfcand_pt60",N_PT_BINS, PT_START, PT_END);
+  h_pt_vs_nalct = histos_.book2D("h_pt_vs_nalct","h_pt_vs_nalct",50, 0.,100.,13,-0.5,12.5);
+  h_pt_vs_nclct = histos_.book2D("h_pt_vs_nclct","h_pt_vs_nclct",50, 0.,100.,13,-0.5,12.5);
+  h_pt_vs_nlct = histos_.book2D("h_pt_vs_nlct","h_pt_vs_nlct",50, 0.,100.,13,-0.5,12.5);
+  h_pt_vs_nmplct = histos_.book2D("h_pt_vs_nmplct","h_pt_vs_nmplct",50, 0.,100.,13,-0.5,12.5);
+
+
+  h_pt_after_alct = histos_.book1D("h_pt_after_alct","h_pt_after_alct",N_PT_BINS, PT_START, PT_END);
+  h_pt_after_clct = histos_.book1D("h_pt_after_clct","h_pt_after_clct",N_PT_BINS, PT_START, PT_END);
+  h_pt_after_lct = histos_.book1D("h_pt_after_lct","h_pt_after_lct",N_PT_BINS, PT_START, PT_END);
+  h_pt_after_mpc = histos_.book1D("h_pt_after_mpc","h_pt_after_mpc",N_PT_BINS, PT_START, PT_END);
+  h_pt_after_mpc_ok_plus = histos_.book1D("h_pt_after_mpc_ok_plus","h_pt_after_mpc_ok_plus",N_PT_BINS, PT_START, PT_END);
+  h_pt_me1_after_mpc_ok_plus = histos_.book1D("h_pt_after_mpc_me1_plus","h_pt_me1_after_mpc_ok_plus",N_PT_BINS, PT_START, PT_END);
+  h_pt_after_tftrack = histos_.book1D("h_pt_after_tftrack","h_pt_after_tftrack",N_PT_BINS, PT_START, PT_END);
+
+  h_pt_after_tfcand = histos_.book1D("h_pt_after_tfcand","h_pt_after_tfcand",N_PT_BINS, PT_START, PT_END);
+  h_pt_after_tfcand_pt10 = histos_.book1D("h_pt_after_tfcand_pt10","h_pt_after_tfcand_pt10",N_PT_BINS, PT_START, PT_END);
+  h_pt_after_tfcand_pt20 = histos_.book1D("h_pt_after_tfcand_pt20","h_pt_after_tfcand_pt20",N_PT_BINS, PT_START, PT_END);
+  h_pt_after_tfcand_pt40 = histos_.book1D("h_pt_after_tfcand_pt40","h_pt_after_tfcand_pt40",N_PT_BINS, PT_START, PT_END);
+  h_pt_after_tfcand_pt60 = histos_.book1D("h_pt_after_tfcand_pt60","h_pt_after_tfcand_pt60",N_PT_BINS, PT_START, PT_END);
 
   //h_pt_after_tftrack_ok = fs->make<TH1D>("h_pt_after_tftrack_ok","h_pt_after_tftrack_ok",N_PT_BINS, PT_START, PT_END);
-  h_pt_after_tfcand_ok = fs->make<TH1D>("h_pt_after_tfcand_ok","h_pt_after_tfcand_ok",N_PT_BINS, PT_START, PT_END);
-  h_pt_after_tfcand_pt10_ok = fs->make<TH1D>("h_pt_after_tfcand_pt10_ok","h_pt_after_tfcand_pt10_ok",N_PT_BINS, PT_START, PT_END);
-  h_pt_after_tfcand_pt20_ok = fs->make<TH1D>("h_pt_after_tfcand_pt20_ok","h_pt_after_tfcand_pt20_ok",N_PT_BINS, PT_START, PT_END);
-  h_pt_after_tfcand_pt40_ok = fs->make<TH1D>("h_pt_after_tfcand_pt40_ok","h_pt_after_tfcand_pt40_ok",N_PT_BINS, PT_START, PT_END);
-  h_pt_after_tfcand_pt60_ok = fs->make<TH1D>("h_pt_after_tfcand_pt60_ok","h_pt_after_tfcand_pt60_ok",N_PT_BINS, PT_START, PT_END);
+  h_pt_after_tfcand_ok = histos_.book1D("h_pt_after_tfcand_ok","h_pt_after_tfcand_ok",N_PT_BINS, PT_START, PT_END);
+  h_pt_after_tfcand_pt10_ok = histos_.book1D("h_pt_after_tfcand_pt10_ok","h_pt_after_tfcand_pt10_ok",N_PT_BINS, PT_START, PT_END);
+  h_pt_after_tfcand_pt20_ok = histos_.book1D("h_pt_after_tfcand_pt20_ok","h_pt_after_tfcand_pt20_ok",N_PT_BINS, PT_START, PT_END);
+  h_pt_after_tfcand_pt40_ok = histos_.book1D("h_pt_after_tfcand_pt40_ok","h_pt_after_tfcand_pt40_ok",N_PT_BINS, PT_START, PT_END);
+  h_pt_after_tfcand_pt60_ok = histos_.book1D("h_pt_after_tfcand_pt60_ok","h_pt_after_tfcand_pt60_ok",N_PT_BINS, PT_START, PT_END);
 
   const int Nthr = 7;
   std::string str_pts[Nthr] = {"", "_pt10", "_pt15", "_pt20", "_pt25", "_pt30","_pt40"};
   for (int i = 0; i < Nthr; ++i) {
     std::string prefix = "h_pt_after_tfcand_eta1b_";
-    h_pt_after_tfcand_eta1b_2s[i] = fs->make<TH1D>((prefix + "2s" + str_pts[i]).c_str(), (prefix + "2s" + str_pts[i]).c_str(), N_PT_BINS, PT_START, PT_END);
-    h_pt_after_tfcand_eta1b_2s1b[i] = fs->make<TH1D>((prefix + "2s1b" + str_pts[i]).c_str(), (prefix + "2s1b" + str_pts[i]).c_str(), N_PT_BINS, PT_START, PT_END);
-    h_pt_after_tfcand_eta1b_2s123[i] = fs->make<TH1D>((prefix + "2s123" + str_pts[i]).c_str(), (prefix + "2s123" + str_pts[i]).c_str(), N_PT_BINS, PT_START, PT_END);
-    h_pt_after_tfcand_eta1b_2s13[i] = fs->make<TH1D>((prefix + "2s13" + str_pts[i]).c_str(), (prefix + "2s13" + str_pts[i]).c_str(), N_PT_BINS, PT_START, PT_END);
-    h_pt_after_tfcand_eta1b_3s[i] = fs->make<TH1D>((prefix + "3s" + str_pts[i]).c_str(), (prefix + "3s" + str_pts[i]).c_str(), N_PT_BINS, PT_START, PT_END);
-    h_pt_after_tfcand_eta1b_3s1b[i] = fs->make<TH1D>((prefix + "3s1b" + str_pts[i]).c_str(), (prefix + "3s1b" + str_pts[i]).c_str(),N_PT_BINS, PT_START, PT_END);
+    h_pt_after_tfcand_eta1b_2s[i] = histos_.book1D((prefix + "2s" + str_pts[i]).c_str(), (prefix + "2s" + str_pts[i]).c_str(), N_PT_BINS, PT_START, PT_END);
+    h_pt_after_tfcand_eta1b_2s1b[i] = histos_.book1D((prefix + "2s1b" + str_pts[i]).c_str(), (prefix + "2s1b" + str_pts[i]).c_str(), N_PT_BINS, PT_START, PT_END);
+    h_pt_after_tfcand_eta1b_2s123[i] = histos_.book1D((prefix + "2s123" + str_pts[i]).c_str(), (prefix + "2s123" + str_pts[i]).c_str(), N_PT_BINS, PT_START, PT_END);
+    h_pt_after_tfcand_eta1b_2s13[i] = histos_.book1D((prefix + "2s13" + str_pts[i]).c_str(), (prefix + "2s13" + str_pts[i]).c_str(), N_PT_BINS, PT_START, PT_END);
+    h_pt_after_tfcand_eta1b_3s[i] = histos_.book1D((prefix + "3s" + str_pts[i]).c_str(), (prefix + "3s" + str_pts[i]).c_str(), N_PT_BINS, PT_START, PT_END);
+    h_pt_after_tfcand_eta1b_3s1b[i] = histos_.book1D((prefix + "3s1b" + str_pts[i]).c_str(), (prefix + "3s1b" + str_pts[i]).c_str(),N_PT_BINS, PT_START, PT_END);
     prefix = "h_pt_after_tfcand_gem1b_";
-    h_pt_after_tfcand_gem1b_2s1b[i] = fs->make<TH1D>((prefix + "2s1b" + str_pts[i]).c_str(), (prefix + "2s1b" + str_pts[i]).c_str(), N_PT_BINS, PT_START, PT_END);
-    h_pt_after_tfcand_gem1b_2s123[i] = fs->make<TH1D>((prefix + "2s123" + str_pts[i]).c_str(), (prefix + "2s123" + str_pts[i]).c_str(), N_PT_BINS, PT_START, PT_END);
-    h_pt_after_tfcand_gem1b_2s13[i] = fs->make<TH1D>((prefix + "2s13" + str_pts[i]).c_str(), (prefix + "2s13" + str_pts[i]).c_str(), N_PT_BINS, PT_START, PT_END);
-    h_pt_after_tfcand_gem1b_3s1b[i] = fs->make<TH1D>((prefix + "3s1b" + str_pts[i]).c_str(), (prefix + "3s1b" + str_pts[i]).c_str(),N_PT_BINS, PT_START, PT_END);
+    h_pt_after_tfcand_gem1b_2s1b[i] = histos_.book1D((prefix + "2s1b" + str_pts[i]).c_str(), (prefix + "2s1b" + str_pts[i]).c_str(), N_PT_BINS, PT_START, PT_END);
+    h_pt_after_tfcand_gem1b_2s123[i] = histos_.book1D((prefix + "2s123" + str_pts[i]).c_str(), (prefix + "2s123" + str_pts[i]).c_str(), N_PT_BINS, PT_START, PT_END);
+    h_pt_after_tfcand_gem1b_2s13[i] = histos_.book1D((prefix + "2s13" + str_pts[i]).c_str(), (prefix + "2s13" + str_pts[i]).c_str(), N_PT_BINS, PT_START, PT_END);
+    h_pt_after_tfcand_gem1b_3s1b[i] = histos_.book1D((prefix + "3s1b" + str_pts[i]).c_str(), (prefix + "3s1b" + str_pts[i]).c_str(),N_PT_BINS, PT_START, PT_END);
     prefix = "h_pt_after_tfcand_dphigem1b_";
-    h_pt_after_tfcand_dphigem1b_2s1b[i] = fs->make<TH1D>((prefix + "2s1b" + str_pts[i]).c_str(), (prefix + "2s1b" + str_pts[i]).c_str(), N_PT_BINS, PT_START, PT_END);
-    h_pt_after_tfcand_dphigem1b_2s123[i] = fs->make<TH1D>((prefix + "2s123" + str_pts[i]).c_str(), (prefix + "2s123" + str_pts[i]).c_str(), N_PT_BINS, PT_START, PT_END);
-    h_pt_after_tfcand_dphigem1b_2s13[i] = fs->make<TH1D>((prefix + "2s13" + str_pts[i]).c_str(), (prefix + "2s13" + str_pts[i]).c_str(), N_PT_BINS, PT_START, PT_END);
-    h_pt_after_tfcand_dphigem1b_3s1b[i] = fs->make<TH1D>((prefix + "3s1b" + str_pts[i]).c_str(), (prefix + "3s1b" + str_pts[i]).c_str(),N_PT_BINS, PT_START, PT_END);
+    h_pt_after_tfcand_dphigem1b_2s1b[i] = histos_.book1D((prefix + "2s1b" + str_pts[i]).c_str(), (prefix + "2s1b" + str_pts[i]).c_str(), N_PT_BINS, PT_START, PT_END);
+    h_pt_after_tfcand_dphigem1b_2s123[i] = histos_.book1D((prefix + "2s123" + str_pts[i]).c_str(), (prefix + "2s123" + str_pts[i]).c_str(), N_PT_BINS, PT_START, PT_END);
+    h_pt_after_tfcand_dphigem1b_2s13[i] = histos_.book1D((prefix + "2s13" + str_pts[i]).c_str(), (prefix + "2s13" + str_pts[i]).c_str(), N_PT_BINS, PT_START, PT_END);
+    h_pt_after_tfcand_dphigem1b_3s1b[i] = histos_.book1D((prefix + "3s1b" + str_pts[i]).c_str(), (prefix + "3s1b" + str_pts[i]).c_str(),N_PT_BINS, PT_START, PT_END);
+    for (auto &wp: gemDPhiWPs_) {
+      std::string suffix = str_pts[i] + "_" + wp.label();
+      h_pt_after_tfcand_dphigem1b_2s1b_wp[i].push_back(histos_.book1D((prefix + "2s1b" + suffix).c_str(), (prefix + "2s1b" + suffix).c_str(), N_PT_BINS, PT_START, PT_END));
+      h_pt_after_tfcand_dphigem1b_2s123_wp[i].push_back(histos_.book1D((prefix + "2s123" + suffix).c_str(), (prefix + "2s123" + suffix).c_str(), N_PT_BINS, PT_START, PT_END));
+      h_pt_after_tfcand_dphigem1b_2s13_wp[i].push_back(histos_.book1D((prefix + "2s13" + suffix).c_str(), (prefix + "2s13" + suffix).c_str(), N_PT_BINS, PT_START, PT_END));
+      h_pt_after_tfcand_dphigem1b_3s1b_wp[i].push_back(histos_.book1D((prefix + "3s1b" + suffix).c_str(), (prefix + "3s1b" + suffix).c_str(), N_PT_BINS, PT_START, PT_END));
+    }
 
     prefix = "h_mode_tfcand_gem1b_2s1b_1b_";
-    h_mode_tfcand_gem1b_2s1b_1b[i] = fs->make<TH1D>((prefix + str_pts[i]).c_str(), (prefix + str_pts[i]).c_str(), 16, -0.5, 15.5);
-    setupTFModeHisto(h_mode_tfcand_gem1b_2s1b_1b[i]);
+    h_mode_tfcand_gem1b_2s1b_1b[i] = histos_.book1D((prefix + str_pts[i]).c_str(), (prefix + str_pts[i]).c_str(), 16, -0.5, 15.5);
+    setupTFModeHisto(h_mode_tfcand_gem1b_2s1b_1b[i]->get());
   }
 
-  h_pt_after_tfcand_ok_plus = fs->make<TH1D>("h_pt_after_tfcand_ok_plus","h_pt_after_tfcand_ok_plus",N_PT_BINS, PT_START, PT_END);
-  h_pt_after_tfcand_ok_plus_pt10 = fs->make<TH1D>("h_pt_after_tfcand_ok_plus_pt10","h_pt_after_tfcand_ok_plus_pt10",N_PT_BINS, PT_START, PT_END);
-  h_pt_after_tfcand_ok_plus_q[0] = fs->make<TH1D>("h_pt_after_tfcand_ok_plus_q1","h_pt_after_tfcand_ok_plus_q1",N_PT_BINS, PT_START, PT_END);
-  h_pt_after_tfcand_ok_plus_q[1] = fs->make<TH1D>("h_pt_after_tfcand_ok_plus_q2","h_pt_after_tfcand_ok_plus_q2",N_PT_BINS, PT_START, PT_END);
-  h_pt_after_tfcand_ok_plus_q[2] = fs->make<TH1D>("h_pt_after_tfcand_ok_plus_q3","h_pt_after_tfcand_ok_plus_q3",N_PT_BINS, PT_START, PT_END);
-  h_pt_after_tfcand_ok_plus_pt10_q[0] = fs->make<TH1D>("h_pt_after_tfcand_ok_plus_pt10_q1","h_pt_after_tfcand_ok_plus_pt10_q1",N_PT_BINS, PT_START, PT_END);
-  h_pt_after_tfcand_ok_plus_pt10_q[1] = fs->make<TH1D>("h_pt_after_tfcand_ok_plus_pt10_q2","h_pt_after_tfcand_ok_plus_pt10_q2",N_PT_BINS, PT_START, PT_END);
-  h_pt_after_tfcand_ok_plus_pt10_q[2] = fs->make<TH1D>("h_pt_after_tfcand_ok_plus_pt10_q3","h_pt_after_tfcand_ok_plus_pt10_q3",N_PT_BINS, PT_START, PT_END);
-
-  h_pt_after_tfcand_all = fs->make<TH1D>("h_pt_after_tfcand_all","h_pt_after_tfcand_all",N_PT_BINS, PT_START, PT_END);
-  h_pt_after_tfcand_all_ok = fs->make<TH1D>("h_pt_after_tfcand_all_ok","h_pt_after_tfcand_all_ok",N_PT_BINS, PT_START, PT_END);
-  h_pt_after_tfcand_all_pt10_ok = fs->make<TH1D>("h_pt_after_tfcand_all_pt10_ok","h_pt_after_tfcand_all_pt10_ok",N_PT_BINS, PT_START, PT_END);
-  h_pt_after_tfcand_all_pt20_ok = fs->make<TH1D>("h_pt_after_tfcand_all_pt20_ok","h_pt_after_tfcand_all_pt20_ok",N_PT_BINS, PT_START, PT_END);
-  h_pt_after_tfcand_all_pt40_ok = fs->make<TH1D>("h_pt_after_tfcand_all_pt40_ok","h_pt_after_tfcand_all_pt40_ok",N_PT_BINS, PT_START, PT_END);
-  h_pt_after_tfcand_all_pt60_ok = fs->make<TH1D>("h_pt_after_tfcand_all_pt60_ok","h_pt_after_tfcand_all_pt60_ok",N_PT_BINS, PT_START, PT_END);
-
-  h_pt_after_gmtreg = fs->make<TH1D>("h_pt_after_gmtreg","h_pt_after_gmtreg",N_PT_BINS, PT_START, PT_END);
-  h_pt_after_gmtreg_all = fs->make<TH1D>("h_pt_after_gmtreg_all","h_pt_after_gmtreg_all",N_PT_BINS, PT_START, PT_END);
-  h_pt_after_gmtreg_dr = fs->make<TH1D>("h_pt_after_gmtreg_dr","h_pt_after_gmtreg_dr",N_PT_BINS, PT_START, PT_END);
-  h_pt_after_gmt = fs->make<TH1D>("h_pt_after_gmt","h_pt_after_gmt",N_PT_BINS, PT_START, PT_END);
-  h_pt_after_gmt_all = fs->make<TH1D>("h_pt_after_gmt_all","h_pt_after_gmt_all",N_PT_BINS, PT_START, PT_END);
-  h_pt_after_gmt_dr = fs->make<TH1D>("h_pt_after_gmt_dr","h_pt_after_gmt_dr",N_PT_BINS, PT_START, PT_END);
-  h_pt_after_gmt_dr_nocsc = fs->make<TH1D>("h_pt_after_gmt_dr_nocsc","h_pt_after_gmt_dr_nocsc",N_PT_BINS, PT_START, PT_END);
-
-  h_pt_after_gmtreg_pt10 = fs->make<TH1D>("h_pt_after_gmtreg_pt10","h_pt_after_gmtreg_pt10",N_PT_BINS, PT_START, PT_END);
-  h_pt_after_gmtreg_all_pt10 = fs->make<TH1D>("h_pt_after_gmtreg_all_pt10","h_pt_after_gmtreg_all_pt10",N_PT_BINS, PT_START, PT_END);
-  h_pt_after_gmtreg_dr_pt10 = fs->make<TH1D>("h_pt_after_gmtreg_dr_pt10","h_pt_after_gmtreg_dr_pt10",N_PT_BINS, PT_START, PT_END);
-  h_pt_after_gmt_pt10 = fs->make<TH1D>("h_pt_after_gmt_pt10","h_pt_after_gmt_pt10",N_PT_BINS, PT_START, PT_END);
-  h_pt_after_gmt_all_pt10 = fs->make<TH1D>("h_pt_after_gmt_all_pt10","h_pt_after_gmt_all_pt10",N_PT_BINS, PT_START, PT_END);
-  h_pt_after_gmt_dr_pt10 = fs->make<TH1D>("h_pt_after_gmt_dr_pt10","h_pt_after_gmt_dr_pt10",N_PT_BINS, PT_START, PT_END);
-  h_pt_after_gmt_dr_nocsc_pt10 = fs->make<TH1D>("h_pt_after_gmt_dr_nocsc_pt10","h_pt_after_gmt_dr_nocsc_pt10",N_PT_BINS, PT_START, PT_END);
+  h_pt_after_tfcand_ok_plus = histos_.book1D("h_pt_after_tfcand_ok_plus","h_pt_after_tfcand_ok_plus",N_PT_BINS, PT_START, PT_END);
+  h_pt_after_tfcand_ok_plus_pt10 = histos_.book1D("h_pt_after_tfcand_ok_plus_pt10","h_pt_after_tfcand_ok_plus_pt10",N_PT_BINS, PT_START, PT_END);
+  h_pt_after_tfcand_ok_plus_q[0] = histos_.book1D("h_pt_after_tfcand_ok_plus_q1","h_pt_after_tfcand_ok_plus_q1",N_PT_BINS, PT_START, PT_END);
+  h_pt_after_tfcand_ok_plus_q[1] = histos_.book1D("h_pt_after_tfcand_ok_plus_q2","h_pt_after_tfcand_ok_plus_q2",N_PT_BINS, PT_START, PT_END);
+  h_pt_after_tfcand_ok_plus_q[2] = histos_.book1D("h_pt_after_tfcand_ok_plus_q3","h_pt_after_tfcand_ok_plus_q3",N_PT_BINS, PT_START, PT_END);
+  h_pt_after_tfcand_ok_plus_pt10_q[0] = histos_.book1D("h_pt_after_tfcand_ok_plus_pt10_q1","h_pt_after_tfcand_ok_plus_pt10_q1",N_PT_BINS, PT_START, PT_END);
+  h_pt_after_tfcand_ok_plus_pt10_q[1] = histos_.book1D("h_pt_after_tfcand_ok_plus_pt10_q2","h_pt_after_tfcand_ok_plus_pt10_q2",N_PT_BINS, PT_START, PT_END);
+  h_pt_after_tfcand_ok_plus_pt10_q[2] = histos_.book1D("h_pt_after_tfcand_ok_plus_pt10_q3","h_pt_after_tfcand_ok_plus_pt10_q3",N_PT_BINS, PT_START, PT_END);
+
+  h_pt_after_tfcand_all = histos_.book1D("h_pt_after_tfcand_all","h_pt_after_tfcand_all",N_PT_BINS, PT_START, PT_END);
+  h_pt_after_tfcand_all_ok = histos_.book1D("h_pt_after_tfcand_all_ok","h_pt_after_tfcand_all_ok",N_PT_BINS, PT_START, PT_END);
+  h_pt_after_tfcand_all_pt10_ok = histos_.book1D("h_pt_after_tfcand_all_pt10_ok","h_pt_after_tfcand_all_pt10_ok",N_PT_BINS, PT_START, PT_END);
+  h_pt_after_tfcand_all_pt20_ok = histos_.book1D("h_pt_after_tfcand_all_pt20_ok","h_pt_after_tfcand_all_pt20_ok",N_PT_BINS, PT_START, PT_END);
+  h_pt_after_tfcand_all_pt40_ok = histos_.book1D("h_pt_after_tfcand_all_pt40_ok","h_pt_after_tfcand_all_pt40_ok",N_PT_BINS, PT_START, PT_END);
+  h_pt_after_tfcand_all_pt60_ok = histos_.book1D("h_pt_after_tfcand_all_pt60_ok","h_pt_after_tfcand_all_pt60_ok",N_PT_BINS, PT_START, PT_END);
+
+  h_pt_after_gmtreg = histos_.book1D("h_pt_after_gmtreg","h_pt_after_gmtreg",N_PT_BINS, PT_START, PT_END);
+  h_pt_after_gmtreg_all = histos_.book1D("h_pt_after_gmtreg_all","h_pt_after_gmtreg_all",N_PT_BINS, PT_START, PT_END);
+  h_pt_after_gmtreg_dr = histos_.book1D("h_pt_after_gmtreg_dr","h_pt_after_gmtreg_dr",N_PT_BINS, PT_START, PT_END);
+  h_pt_after_gmt = histos_.book1D("h_pt_after_gmt","h_pt_after_gmt",N_PT_BINS, PT_START, PT_END);
+  h_pt_after_gmt_all = histos_.book1D("h_pt_after_gmt_all","h_pt_after_gmt_all",N_PT_BINS, PT_START, PT_END);
+  h_pt_after_gmt_dr = histos_.book1D("h_pt_after_gmt_dr","h_pt_after_gmt_dr",N_PT_BINS, PT_START, PT_END);
+  h_pt_after_gmt_dr_nocsc = histos_.book1D("h_pt_after_gmt_dr_nocsc","h_pt_after_gmt_dr_nocsc",N_PT_BINS, PT_START, PT_END);
+
+  h_pt_after_gmtreg_pt10 = histos_.book1D("h_pt_after_gmtreg_pt10","h_pt_after_gmtreg_pt10",N_PT_BINS, PT_START, PT_END);
+  h_pt_after_gmtreg_all_pt10 = histos_.book1D("h_pt_after_gmtreg_all_pt10","h_pt_after_gmtreg_all_pt10",N_PT_BINS, PT_START, PT_END);
+  h_pt_after_gmtreg_dr_pt10 = histos_.book1D("h_pt_after_gmtreg_dr_pt10","h_pt_after_gmtreg_dr_pt10",N_PT_BINS, PT_START, PT_END);
+  h_pt_after_gmt_pt10 = histos_.book1D("h_pt_after_gmt_pt10","h_pt_after_gmt_pt10",N_PT_BINS, PT_START, PT_END);
+  h_pt_after_gmt_all_pt10 = histos_.book1D("h_pt_after_gmt_all_pt10","h_pt_after_gmt_all_pt10",N_PT_BINS, PT_START, PT_END);
+  h_pt_after_gmt_dr_pt10 = histos_.book1D("h_pt_after_gmt_dr_pt10","h_pt_after_gmt_dr_pt10",N_PT_BINS, PT_START, PT_END);
+  h_pt_after_gmt_dr_nocsc_pt10 = histos_.book1D("h_pt_after_gmt_dr_nocsc_pt10","h_pt_after_gmt_dr_nocsc_pt10",N_PT_BINS, PT_START, PT_END);
 
   for (int i = 0; i < Nthr; ++i) {
     std::string prefix = "h_pt_after_gmt_eta1b_";
-    h_pt_after_gmt_eta1b_1mu[i] = fs->make<TH1D>((prefix + "1mu" + str_pts[i]).c_str(), (prefix + "1mu" + str_pts[i]).c_str(), N_PT_BINS, PT_START, PT_END);
+    h_pt_after_gmt_eta1b_1mu[i] = histos_.book1D((prefix + "1mu" + str_pts[i]).c_str(), (prefix + "1mu" + str_pts[i]).c_str(), N_PT_BINS, PT_START, PT_END);
     prefix = "h_pt_after_gmt_gem1b_";
-    h_pt_after_gmt_gem1b_1mu[i] = fs->make<TH1D>((prefix + "1mu" + str_pts[i]).c_str(), (prefix + "1mu" + str_pts[i]).c_str(), N_PT_BINS, PT_START, PT_END);
+    h_pt_after_gmt_gem1b_1mu[i] = histos_.book1D((prefix + "1mu" + str_pts[i]).c_str(), (prefix + "1mu" + str_pts[i]).c_str(), N_PT_BINS, PT_START, PT_END);
     prefix = "h_pt_after_gmt_dphigem1b_";
-    h_pt_after_gmt_dphigem1b_1mu[i] = fs->make<TH1D>((prefix + "1mu" + str_pts[i]).c_str(), (prefix + "1mu" + str_pts[i]).c_str(), N_PT_BINS, PT_START, PT_END);
+    h_pt_after_gmt_dphigem1b_1mu[i] = histos_.book1D((prefix + "1mu" + str_pts[i]).c_str(), (prefix + "1mu" + str_pts[i]).c_str(), N_PT_BINS, PT_START, PT_END);
+    for (auto &wp: gemDPhiWPs_) {
+      std::string suffix = str_pts[i] + "_" + wp.label();
+      h_pt_after_gmt_dphigem1b_1mu_wp[i].push_back(histos_.book1D((prefix + "1mu" + suffix).c_str(), (prefix + "1mu" + suffix).c_str(), N_PT_BINS, PT_START, PT_END));
+    }
   }
 
 
 
-  h_pt_me1_after_tf_ok_plus = fs->make<TH1D>("h_pt_me1_after_tf_ok_plus","h_pt_me1_after_tf_ok_plus",N_PT_BINS, PT_START, PT_END);
-  h_pt_me1_after_tf_ok_plus_pt10 = fs->make<TH1D>("h_pt_me1_after_tf_ok_plus_pt10","h_pt_me1_after_tf_ok_plus_pt10",N_PT_BINS, PT_START, PT_END);
-  h_pt_me1_after_tf_ok_plus_q[0] = fs->make<TH1D>("h_pt_me1_after_tf_ok_plus_q1","h_pt_me1_after_tf_ok_plus_q1",N_PT_BINS, PT_START, PT_END);
-  h_pt_me1_after_tf_ok_plus_q[1] = fs->make<TH1D>("h_pt_me1_after_tf_ok_plus_q2","h_pt_me1_after_tf_ok_plus_q2",N_PT_BINS, PT_START, PT_END);
-  h_pt_me1_after_tf_ok_plus_q[2] = fs->make<TH1D>("h_pt_me1_after_tf_ok_plus_q3","h_pt_me1_after_tf_ok_plus_q3",N_PT_BINS, PT_START, PT_END);
-  h_pt_me1_after_tf_ok_plus_pt10_q[0] = fs->make<TH1D>("h_pt_me1_after_tf_ok_plus_pt10_q1","h_pt_me1_after_tf_ok_plus_pt10_q1",N_PT_BINS, PT_START, PT_END);
-  h_pt_me1_after_tf_ok_plus_pt10_q[1] = fs->make<TH1D>("h_pt_me1_after_tf_ok_plus_pt10_q2","h_pt_me1_after_tf_ok_plus_pt10_q2",N_PT_BINS, PT_START, PT_END);
-  h_pt_me1_after_tf_ok_plus_pt10_q[2] = fs->make<TH1D>("h_pt_me1_after_tf_ok_plus_pt10_q3","h_pt_me1_after_tf_ok_plus_pt10_q3",N_PT_BINS, PT_START, PT_END);
+  h_pt_me1_after_tf_ok_plus = histos_.book1D("h_pt_me1_after_tf_ok_plus","h_pt_me1_after_tf_ok_plus",N_PT_BINS, PT_START, PT_END);
+  h_pt_me1_after_tf_ok_plus_pt10 = histos_.book1D("h_pt_me1_after_tf_ok_plus_pt10","h_pt_me1_after_tf_ok_plus_pt10",N_PT_BINS, PT_START, PT_END);
+  h_pt_me1_after_tf_ok_plus_q[0] = histos_.book1D("h_pt_me1_after_tf_ok_plus_q1","h_pt_me1_after_tf_ok_plus_q1",N_PT_BINS, PT_START, PT_END);
+  h_pt_me1_after_tf_ok_plus_q[1] = histos_.book1D("h_pt_me1_after_tf_ok_plus_q2","h_pt_me1_after_tf_ok_plus_q2",N_PT_BINS, PT_START, PT_END);
+  h_pt_me1_after_tf_ok_plus_q[2] = histos_.book1D("h_pt_me1_after_tf_ok_plus_q3","h_pt_me1_after_tf_ok_plus_q3",N_PT_BINS, PT_START, PT_END);
+  h_pt_me1_after_tf_ok_plus_pt10_q[0] = histos_.book1D("h_pt_me1_after_tf_ok_plus_pt10_q1","h_pt_me1_after_tf_ok_plus_pt10_q1",N_PT_BINS, PT_START, PT_END);
+  h_pt_me1_after_tf_ok_plus_pt10_q[1] = histos_.book1D("h_pt_me1_after_tf_ok_plus_pt10_q2","h_pt_me1_after_tf_ok_plus_pt10_q2",N_PT_BINS, PT_START, PT_END);
+  h_pt_me1_after_tf_ok_plus_pt10_q[2] = histos_.book1D("h_pt_me1_after_tf_ok_plus_pt10_q3","h_pt_me1_after_tf_ok_plus_pt10_q3",N_PT_BINS, PT_START, PT_END);
 
 
   // high eta
-  h_pth_initial = fs->make<TH1D>("h_pth_initial","h_pth_initial",N_PT_BINS, PT_START, PT_END);
-  h_pth_after_mpc = fs->make<TH1D>("h_pth_after_mpc","h_pth_after_mpc",N_PT_BINS, PT_START, PT_END);
-  h_pth_after_mpc_ok_plus = fs->make<TH1D>("h_pth_after_mpc_ok_plus","h_pth_after_mpc_ok_plus",N_PT_BINS, PT_START, PT_END);
-
-  h_pth_after_tfcand = fs->make<TH1D>("h_pth_after_tfcand","h_pth_after_tfcand",N_PT_BINS, PT_START, PT_END);
-  h_pth_after_tfcand_pt10 = fs->make<TH1D>("h_pth_after_tfcand_pt10","h_pth_after_tfcand_pt10",N_PT_BINS, PT_START, PT_END);
-
-  h_pth_after_tfcand_ok = fs->make<TH1D>("h_pth_after_tfcand_ok","h_pth_after_tfcand_ok",N_PT_BINS, PT_START, PT_END);
-  h_pth_after_tfcand_pt10_ok = fs->make<TH1D>("h_pth_after_tfcand_pt10_ok","h_pth_after_tfcand_pt10_ok",N_PT_BINS, PT_START, PT_END);
-
-  h_pth_after_tfcand_ok_plus = fs->make<TH1D>("h_pth_after_tfcand_ok_plus","h_pth_after_tfcand_ok_plus",N_PT_BINS, PT_START, PT_END);
-  h_pth_after_tfcand_ok_plus_pt10 = fs->make<TH1D>("h_pth_after_tfcand_ok_plus_pt10","h_pth_after_tfcand_ok_plus_pt10",N_PT_BINS, PT_START, PT_END);
-  h_pth_after_tfcand_ok_plus_q[0] = fs->make<TH1D>("h_pth_after_tfcand_ok_plus_q1","h_pth_after_tfcand_ok_plus_q1",N_PT_BINS, PT_START, PT_END);
-  h_pth_after_tfcand_ok_plus_q[1] = fs->make<TH1D>("h_pth_after_tfcand_ok_plus_q2","h_pth_after_tfcand_ok_plus_q2",N_PT_BINS, PT_START, PT_END);
-  h_pth_after_tfcand_ok_plus_q[2] = fs->make<TH1D>("h_pth_after_tfcand_ok_plus_q3","h_pth_after_tfcand_ok_plus_q3",N_PT_BINS, PT_START, PT_END);
-  h_pth_after_tfcand_ok_plus_pt10_q[0] = fs->make<TH1D>("h_pth_after_tfcand_ok_plus_pt10_q1","h_pth_after_tfcand_ok_plus_pt10_q1",N_PT_BINS, PT_START, PT_END);
-  h_pth_after_tfcand_ok_plus_pt10_q[1] = fs->make<TH1D>("h_pth_after_tfcand_ok_plus_pt10_q2","h_pth_after_tfcand_ok_plus_pt10_q2",N_PT_BINS, PT_START, PT_END);
-  h_pth_after_tfcand_ok_plus_pt10_q[2] = fs->make<TH1D>("h_pth_after_tfcand_ok_plus_pt10_q3","h_pth_after_tfcand_ok_plus_pt10_q3",N_PT_BINS, PT_START, PT_END);
-
-  h_pth_me1_after_mpc_ok_plus = fs->make<TH1D>("h_pth_after_mpc_me1_plus","h_pth_me1_after_mpc_ok_plus",N_PT_BINS, PT_START, PT_END);
-  h_pth_me1_after_tf_ok_plus = fs->make<TH1D>("h_pth_me1_after_tf_ok_plus","h_pth_me1_after_tf_ok_plus",N_PT_BINS, PT_START, PT_END);
-  h_pth_me1_after_tf_ok_plus_pt10 = fs->make<TH1D>("h_pth_me1_after_tf_ok_plus_pt10","h_pth_me1_after_tf_ok_plus_pt10",N_PT_BINS, PT_START, PT_END);
-  h_pth_me1_after_tf_ok_plus_q[0] = fs->make<TH1D>("h_pth_me1_after_tf_ok_plus_q1","h_pth_me1_after_tf_ok_plus_q1",N_PT_BINS, PT_START, PT_END);
-  h_pth_me1_after_tf_ok_plus_q[1] = fs->make<TH1D>("h_pth_me1_after_tf_ok_plus_q2","h_pth_me1_after_tf_ok_plus_q2",N_PT_BINS, PT_START, PT_END);
-  h_pth_me1_after_tf_ok_plus_q[2] = fs->make<TH1D>("h_pth_me1_after_tf_ok_plus_q3","h_pth_me1_after_tf_ok_plus_q3",N_PT_BINS, PT_START, PT_END);
-  h_pth_me1_after_tf_ok_plus_pt10_q[0] = fs->make<TH1D>("h_pth_me1_after_tf_ok_plus_pt10_q1","h_pth_me1_after_tf_ok_plus_pt10_q1",N_PT_BINS, PT_START, PT_END);
-  h_pth_me1_after_tf_ok_plus_pt10_q[1] = fs->make<TH1D>("h_pth_me1_after_tf_ok_plus_pt10_q2","h_pth_me1_after_tf_ok_plus_pt10_q2",N_PT_BINS, PT_START, PT_END);
-  h_pth_me1_after_tf_ok_plus_pt10_q[2] = fs->make<TH1D>("h_pth_me1_after_tf_ok_plus_pt10_q3","h_pth_me1_after_tf_ok_plus_pt10_q3",N_PT_BINS, PT_START, PT_END);
-
-  h_pth_over_tfpt_resol = fs->make<TH1D>("h_pth_over_pttf_resol","h_pth_over_pttf_resol",300, -1.5,1.5);
-  h_pth_over_tfpt_resol_vs_pt = fs->make<TH2D>("h_pth_over_pttf_resol_vs_pt","h_pth_over_pttf_resol_vs_pt",150, -1.5,1.5,N_PT_BINS, PT_START, PT_END);
-
-
-  h_pth_after_tfcand_ok_plus_3st1a = fs->make<TH1D>("h_pth_after_tfcand_ok_plus_3st1a","h_pth_after_tfcand_ok_plus_3st1a",N_PT_BINS, PT_START, PT_END);
-  h_pth_after_tfcand_ok_plus_pt10_3st1a = fs->make<TH1D>("h_pth_after_tfcand_ok_plus_pt10_3st1a","h_pth_after_tfcand_ok_plus_pt10_3st1a",N_PT_BINS, PT_START, PT_END);
-  h_pth_me1_after_tf_ok_plus_3st1a = fs->make<TH1D>("h_pth_me1_after_tf_ok_plus_3st1a","h_pth_me1_after_tf_ok_plus_3st1a",N_PT_BINS, PT_START, PT_END);
-  h_pth_me1_after_tf_ok_plus_pt10_3st1a = fs->make<TH1D>("h_pth_me1_after_tf_ok_plus_pt10_3st1a","h_pth_me1_after_tf_ok_plus_pt10_3st1a",N_PT_BINS, PT_START, PT_END);
-
-
-
-
-  for (int i=0; i<N_PT_THRESHOLDS; i++)
-    {
-      int tfpt = (int)PT_THRESHOLDS[i];
-      sprintf(label,"h_eta_tf_initial0_tfpt%d",tfpt);
-      h_eta_tf_initial0_tfpt[i]  = fs->make<TH1D>(label, label, N_ETA_BINS, ETA_START, ETA_END);
-      sprintf(label,"h_eta_tf_initial_tfpt%d",tfpt);
-      h_eta_tf_initial_tfpt[i]  = fs->make<TH1D>(label, label, N_ETA_BINS, ETA_START, ETA_END);
-      sprintf(label,"h_eta_tf_stubs222_tfpt%d",tfpt);
-      h_eta_tf_stubs222_tfpt[i]  = fs->make<TH1D>(label, label, N_ETA_BINS, ETA_START, ETA_END);
-      sprintf(label,"h_eta_tf_stubs223_tfpt%d",tfpt);
-      h_eta_tf_stubs223_tfpt[i]  = fs->make<TH1D>(label, label, N_ETA_BINS, ETA_START, ETA_END);
-      sprintf(label,"h_eta_tf_stubs233_tfpt%d",tfpt);
-      h_eta_tf_stubs233_tfpt[i]  = fs->make<TH1D>(label, label, N_ETA_BINS, ETA_START, ETA_END);
-    }
-
-
-  h_eta_after_alct = fs->make<TH1D>("h_eta_after_alct","h_eta_after_alct",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_after_clct = fs->make<TH1D>("h_eta_after_clct","h_eta_after_clct",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_after_lct = fs->make<TH1D>("h_eta_after_lct","h_eta_after_lct",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_after_mpc = fs->make<TH1D>("h_eta_after_mpc","h_eta_after_mpc",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_after_mpc_ok = fs->make<TH1D>("h_eta_after_mpc_ok","h_eta_after_mpc_ok",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_after_mpc_ok_plus = fs->make<TH1D>("h_eta_after_mpc_ok_plus","h_eta_after_mpc_ok_plus",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_after_mpc_ok_plus_3st = fs->make<TH1D>("h_eta_after_mpc_ok_plus_3st","h_eta_after_mpc_ok_plus_3st",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_after_mpc_st1 = fs->make<TH1D>("h_eta_after_mpc_st1","h_eta_after_mpc_st1",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_after_mpc_st1_good = fs->make<TH1D>("h_eta_after_mpc_st1_good","h_eta_after_mpc_st1_good",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_after_tftrack = fs->make<TH1D>("h_eta_after_tftrack","h_eta_after_tftrack",N_ETA_BINS, ETA_START, ETA_END);
+  h_pth_initial = histos_.book1D("h_pth_initial","h_pth_initial",N_PT_BINS, PT_START, PT_END);
+  h_pth_after_mpc = histos_.book1D("h_pth_after_mpc","h_pth_after_mpc",N_PT_BINS, PT_START, PT_END);
+  h_pth_after_mpc_ok_plus = histos_.book1D("h_pth_after_mpc_ok_plus","h_pth_after_mpc_ok_plus",N_PT_BINS, PT_START, PT_END);
+
+  h_pth_after_tfcand = histos_.book1D("h_pth_after_tfcand","h_pth_after_tfcand",N_PT_BINS, PT_START, PT_END);
+  h_pth_after_tfcand_pt10 = histos_.book1D("h_pth_after_tfcand_pt10","h_pth_after_tfcand_pt10",N_PT_BINS, PT_START, PT_END);
+
+  h_pth_after_tfcand_ok = histos_.book1D("h_pth_after_tfcand_ok","h_pth_after_tfcand_ok",N_PT_BINS, PT_START, PT_END);
+  h_pth_after_tfcand_pt10_ok = histos_.book1D("h_pth_after_tfcand_pt10_ok","h_pth_after_tfcand_pt10_ok",N_PT_BINS, PT_START, PT_END);
+
+  h_pth_after_tfcand_ok_plus = histos_.book1D("h_pth_after_tfcand_ok_plus","h_pth_after_tfcand_ok_plus",N_PT_BINS, PT_START, PT_END);
+  h_pth_after_tfcand_ok_plus_pt10 = histos_.book1D("h_pth_after_tfcand_ok_plus_pt10","h_pth_after_tfcand_ok_plus_pt10",N_PT_BINS, PT_START, PT_END);
+  h_pth_after_tfcand_ok_plus_q[0] = histos_.book1D("h_pth_after_tfcand_ok_plus_q1","h_pth_after_tfcand_ok_plus_q1",N_PT_BINS, PT_START, PT_END);
+  h_pth_after_tfcand_ok_plus_q[1] = histos_.book1D("h_pth_after_tfcand_ok_plus_q2","h_pth_after_tfcand_ok_plus_q2",N_PT_BINS, PT_START, PT_END);
+  h_pth_after_tfcand_ok_plus_q[2] = histos_.book1D("h_pth_after_tfcand_ok_plus_q3","h_pth_after_tfcand_ok_plus_q3",N_PT_BINS, PT_START, PT_END);
+  h_pth_after_tfcand_ok_plus_pt10_q[0] = histos_.book1D("h_pth_after_tfcand_ok_plus_pt10_q1","h_pth_after_tfcand_ok_plus_pt10_q1",N_PT_BINS, PT_START, PT_END);
+  h_pth_after_tfcand_ok_plus_pt10_q[1] = histos_.book1D("h_pth_after_tfcand_ok_plus_pt10_q2","h_pth_after_tfcand_ok_plus_pt10_q2",N_PT_BINS, PT_START, PT_END);
+  h_pth_after_tfcand_ok_plus_pt10_q[2] = histos_.book1D("h_pth_after_tfcand_ok_plus_pt10_q3","h_pth_after_tfcand_ok_plus_pt10_q3",N_PT_BINS, PT_START, PT_END);
+
+  h_pth_me1_after_mpc_ok_plus = histos_.book1D("h_pth_after_mpc_me1_plus","h_pth_me1_after_mpc_ok_plus",N_PT_BINS, PT_START, PT_END);
+  h_pth_me1_after_tf_ok_plus = histos_.book1D("h_pth_me1_after_tf_ok_plus","h_pth_me1_after_tf_ok_plus",N_PT_BINS, PT_START, PT_END);
+  h_pth_me1_after_tf_ok_plus_pt10 = histos_.book1D("h_pth_me1_after_tf_ok_plus_pt10","h_pth_me1_after_tf_ok_plus_pt10",N_PT_BINS, PT_START, PT_END);
+  h_pth_me1_after_tf_ok_plus_q[0] = histos_.book1D("h_pth_me1_after_tf_ok_plus_q1","h_pth_me1_after_tf_ok_plus_q1",N_PT_BINS, PT_START, PT_END);
+  h_pth_me1_after_tf_ok_plus_q[1] = histos_.book1D("h_pth_me1_after_tf_ok_plus_q2","h_pth_me1_after_tf_ok_plus_q2",N_PT_BINS, PT_START, PT_END);
+  h_pth_me1_after_tf_ok_plus_q[2] = histos_.book1D("h_pth_me1_after_tf_ok_plus_q3","h_pth_me1_after_tf_ok_plus_q3",N_PT_BINS, PT_START, PT_END);
+  h_pth_me1_after_tf_ok_plus_pt10_q[0] = histos_.book1D("h_pth_me1_after_tf_ok_plus_pt10_q1","h_pth_me1_after_tf_ok_plus_pt10_q1",N_PT_BINS, PT_START, PT_END);
+  h_pth_me1_after_tf_ok_plus_pt10_q[1] = histos_.book1D("h_pth_me1_after_tf_ok_plus_pt10_q2","h_pth_me1_after_tf_ok_plus_pt10_q2",N_PT_BINS, PT_START, PT_END);
+  h_pth_me1_after_tf_ok_plus_pt10_q[2] = histos_.book1D("h_pth_me1_after_tf_ok_plus_pt10_q3","h_pth_me1_after_tf_ok_plus_pt10_q3",N_PT_BINS, PT_START, PT_END);
+
+  h_pth_over_tfpt_resol = histos_.book1D("h_pth_over_pttf_resol","h_pth_over_pttf_resol",300, -1.5,1.5);
+  h_pth_over_tfpt_resol_vs_pt = histos_.book2D("h_pth_over_pttf_resol_vs_pt","h_pth_over_pttf_resol_vs_pt",150, -1.5,1.5,N_PT_BINS, PT_START, PT_END);
+
+
+  h_pth_after_tfcand_ok_plus_3st1a = histos_.book1D("h_pth_after_tfcand_ok_plus_3st1a","h_pth_after_tfcand_ok_plus_3st1a",N_PT_BINS, PT_START, PT_END);
+  h_pth_after_tfcand_ok_plus_pt10_3st1a = histos_.book1D("h_pth_after_tfcand_ok_plus_pt10_3st1a","h_pth_after_tfcand_ok_plus_pt10_3st1a",N_PT_BINS, PT_START, PT_END);
+  h_pth_me1_after_tf_ok_plus_3st1a = histos_.book1D("h_pth_me1_after_tf_ok_plus_3st1a","h_pth_me1_after_tf_ok_plus_3st1a",N_PT_BINS, PT_START, PT_END);
+  h_pth_me1_after_tf_ok_plus_pt10_3st1a = histos_.book1D("h_pth_me1_after_tf_ok_plus_pt10_3st1a","h_pth_me1_after_tf_ok_plus_pt10_3st1a",N_PT_BINS, PT_START, PT_END);
+
+
+
+
+  // threshold scans: one fill per track, the TEfficiency curves are made in endJob
+  eff_pt_tfcand_tfpt.init("eff_pt_tfcand", "TF cand. efficiency vs. p_{T}",
+                          N_PT_BINS, PT_START, PT_END, PT_THRESHOLDS, N_PT_THRESHOLDS);
+  eff_pt_tfcand_ok_tfpt.init("eff_pt_tfcand_ok", "TF cand. (quality>1) efficiency vs. p_{T}",
+                             N_PT_BINS, PT_START, PT_END, PT_THRESHOLDS, N_PT_THRESHOLDS);
+  eff_pt_tfcand_all_ok_tfpt.init("eff_pt_tfcand_all_ok", "all TF cand. (quality>1) efficiency vs. p_{T}",
+                                 N_PT_BINS, PT_START, PT_END, PT_THRESHOLDS, N_PT_THRESHOLDS);
+  eff_eta_tfcand_tfpt.init("eff_eta_tfcand", "TF cand. efficiency vs. #eta",
+                           N_ETA_BINS, ETA_START, ETA_END, PT_THRESHOLDS_FOR_ETA, N_PT_THRESHOLDS);
+  eff_eta_tfcand_ok_plus_tfpt.init("eff_eta_tfcand_ok_plus", "TF cand. (2+ stubs) efficiency vs. #eta",
+                                   N_ETA_BINS, ETA_START, ETA_END, PT_THRESHOLDS_FOR_ETA, N_PT_THRESHOLDS);
+
+
+  h_eta_after_alct = histos_.book1D("h_eta_after_alct","h_eta_after_alct",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_after_clct = histos_.book1D("h_eta_after_clct","h_eta_after_clct",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_after_lct = histos_.book1D("h_eta_after_lct","h_eta_after_lct",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_after_mpc = histos_.book1D("h_eta_after_mpc","h_eta_after_mpc",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_after_mpc_ok = histos_.book1D("h_eta_after_mpc_ok","h_eta_after_mpc_ok",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_after_mpc_ok_plus = histos_.book1D("h_eta_after_mpc_ok_plus","h_eta_after_mpc_ok_plus",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_after_mpc_ok_plus_3st = histos_.book1D("h_eta_after_mpc_ok_plus_3st","h_eta_after_mpc_ok_plus_3st",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_after_mpc_st1 = histos_.book1D("h_eta_after_mpc_st1","h_eta_after_mpc_st1",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_after_mpc_st1_good = histos_.book1D("h_eta_after_mpc_st1_good","h_eta_after_mpc_st1_good",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_after_tftrack = histos_.book1D("h_eta_after_tftrack","h_eta_after_tftrack",N_ETA_BINS, ETA_START, ETA_END);
   //h_eta_after_tftrack_q[0] = fs->make<TH1D>("h_eta_after_tftrack_q1","h_eta_after_tftrack_q1",N_ETA_BINS, ETA_START, ETA_END);
   //h_eta_after_tftrack_q[1] = fs->make<TH1D>("h_eta_after_tftrack_q2","h_eta_after_tftrack_q2",N_ETA_BINS, ETA_START, ETA_END);
   //h_eta_after_tftrack_q[2] = fs->make<TH1D>("h_eta_after_tftrack_q3","h_eta_after_tftrack_q3",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_after_tfcand = fs->make<TH1D>("h_eta_after_tfcand","h_eta_after_tfcand",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_after_tfcand_q[0] = fs->make<TH1D>("h_eta_after_tfcand_q1","h_eta_after_tfcand_q1",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_after_tfcand_q[1] = fs->make<TH1D>("h_eta_after_tfcand_q2","h_eta_after_tfcand_q2",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_after_tfcand_q[2] = fs->make<TH1D>("h_eta_after_tfcand_q3","h_eta_after_tfcand_q3",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_after_tfcand_ok = fs->make<TH1D>("h_eta_after_tfcand_ok","h_eta_after_tfcand_ok",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_after_tfcand_ok_plus = fs->make<TH1D>("h_eta_after_tfcand_ok_plus","h_eta_after_tfcand_ok_plus",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_after_tfcand_ok_pt10 = fs->make<TH1D>("h_eta_after_tfcand_ok_pt10","h_eta_after_tfcand_ok_pt10",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_after_tfcand_ok_plus_pt10 = fs->make<TH1D>("h_eta_after_tfcand_ok_plus_pt10","h_eta_after_tfcand_ok_plus_pt10",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_after_tfcand_ok_plus_q[0] = fs->make<TH1D>("h_eta_after_tfcand_ok_plus_q1","h_eta_after_tfcand_ok_plus_q1",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_after_tfcand_ok_plus_q[1] = fs->make<TH1D>("h_eta_after_tfcand_ok_plus_q2","h_eta_after_tfcand_ok_plus_q2",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_after_tfcand_ok_plus_q[2] = fs->make<TH1D>("h_eta_after_tfcand_ok_plus_q3","h_eta_after_tfcand_ok_plus_q3",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_after_tfcand_ok_plus_pt10_q[0] = fs->make<TH1D>("h_eta_after_tfcand_ok_plus_pt10_q1","h_eta_after_tfcand_ok_plus_pt10_q1",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_after_tfcand_ok_plus_pt10_q[1] = fs->make<TH1D>("h_eta_after_tfcand_ok_plus_pt10_q2","h_eta_after_tfcand_ok_plus_pt10_q2",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_after_tfcand_ok_plus_pt10_q[2] = fs->make<TH1D>("h_eta_after_tfcand_ok_plus_pt10_q3","h_eta_after_tfcand_ok_plus_pt10_q3",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_after_tfcand_all = fs->make<TH1D>("h_eta_after_tfcand_all","h_eta_after_tfcand_all",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_after_tfcand_pt10 = fs->make<TH1D>("h_eta_after_tfcand_pt10","h_eta_after_tfcand_pt10",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_after_tfcand_all_pt10 = fs->make<TH1D>("h_eta_after_tfcand_all_pt10","h_eta_after_tfcand_all_pt10",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_after_tfcand_my_st1 = fs->make<TH1D>("h_eta_after_tfcand_my_st1","h_eta_after_tfcand_my_st1",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_after_tfcand_org_st1 = fs->make<TH1D>("h_eta_after_tfcand_org_st1","h_eta_after_tfcand_org_st1",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_after_tfcand_comm_st1 = fs->make<TH1D>("h_eta_after_tfcand_comm_st1","h_eta_after_tfcand_comm_st1",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_after_tfcand_my_st1_pt10 = fs->make<TH1D>("h_eta_after_tfcand_my_st1_pt10","h_eta_after_tfcand_my_st1_pt10",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_after_tfcand = histos_.book1D("h_eta_after_tfcand","h_eta_after_tfcand",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_after_tfcand_q[0] = histos_.book1D("h_eta_after_tfcand_q1","h_eta_after_tfcand_q1",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_after_tfcand_q[1] = histos_.book1D("h_eta_after_tfcand_q2","h_eta_after_tfcand_q2",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_after_tfcand_q[2] = histos_.book1D("h_eta_after_tfcand_q3","h_eta_after_tfcand_q3",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_after_tfcand_ok = histos_.book1D("h_eta_after_tfcand_ok","h_eta_after_tfcand_ok",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_after_tfcand_ok_plus = histos_.book1D("h_eta_after_tfcand_ok_plus","h_eta_after_tfcand_ok_plus",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_after_tfcand_ok_pt10 = histos_.book1D("h_eta_after_tfcand_ok_pt10","h_eta_after_tfcand_ok_pt10",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_after_tfcand_ok_plus_pt10 = histos_.book1D("h_eta_after_tfcand_ok_plus_pt10","h_eta_after_tfcand_ok_plus_pt10",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_after_tfcand_ok_plus_q[0] = histos_.book1D("h_eta_after_tfcand_ok_plus_q1","h_eta_after_tfcand_ok_plus_q1",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_after_tfcand_ok_plus_q[1] = histos_.book1D("h_eta_after_tfcand_ok_plus_q2","h_eta_after_tfcand_ok_plus_q2",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_after_tfcand_ok_plus_q[2] = histos_.book1D("h_eta_after_tfcand_ok_plus_q3","h_eta_after_tfcand_ok_plus_q3",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_after_tfcand_ok_plus_pt10_q[0] = histos_.book1D("h_eta_after_tfcand_ok_plus_pt10_q1","h_eta_after_tfcand_ok_plus_pt10_q1",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_after_tfcand_ok_plus_pt10_q[1] = histos_.book1D("h_eta_after_tfcand_ok_plus_pt10_q2","h_eta_after_tfcand_ok_plus_pt10_q2",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_after_tfcand_ok_plus_pt10_q[2] = histos_.book1D("h_eta_after_tfcand_ok_plus_pt10_q3","h_eta_after_tfcand_ok_plus_pt10_q3",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_after_tfcand_all = histos_.book1D("h_eta_after_tfcand_all","h_eta_after_tfcand_all",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_after_tfcand_pt10 = histos_.book1D("h_eta_after_tfcand_pt10","h_eta_after_tfcand_pt10",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_after_tfcand_all_pt10 = histos_.book1D("h_eta_after_tfcand_all_pt10","h_eta_after_tfcand_all_pt10",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_after_tfcand_my_st1 = histos_.book1D("h_eta_after_tfcand_my_st1","h_eta_after_tfcand_my_st1",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_after_tfcand_org_st1 = histos_.book1D("h_eta_after_tfcand_org_st1","h_eta_after_tfcand_org_st1",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_after_tfcand_comm_st1 = histos_.book1D("h_eta_after_tfcand_comm_st1","h_eta_after_tfcand_comm_st1",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_after_tfcand_my_st1_pt10 = histos_.book1D("h_eta_after_tfcand_my_st1_pt10","h_eta_after_tfcand_my_st1_pt10",N_ETA_BINS, ETA_START, ETA_END);
   
-  h_eta_after_gmtreg = fs->make<TH1D>("h_eta_after_gmtreg","h_eta_after_gmtreg",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_after_gmtreg_all = fs->make<TH1D>("h_eta_after_gmtreg_all","h_eta_after_gmtreg_all",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_after_gmtreg_dr = fs->make<TH1D>("h_eta_after_gmtreg_dr","h_eta_after_gmtreg_dr",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_after_gmt = fs->make<TH1D>("h_eta_after_gmt","h_eta_after_gmt",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_after_gmt_all = fs->make<TH1D>("h_eta_after_gmt_all","h_eta_after_gmt_all",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_after_gmt_dr = fs->make<TH1D>("h_eta_after_gmt_dr","h_eta_after_gmt_dr",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_after_gmt_dr_nocsc = fs->make<TH1D>("h_eta_after_gmt_dr_nocsc","h_eta_after_gmt_dr_nocsc",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_after_gmtreg_pt10 = fs->make<TH1D>("h_eta_after_gmtreg_pt10","h_eta_after_gmtreg_pt10",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_after_gmtreg_all_pt10 = fs->make<TH1D>("h_eta_after_gmtreg_all_pt10","h_eta_after_gmtreg_all_pt10",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_after_gmtreg_dr_pt10 = fs->make<TH1D>("h_eta_after_gmtreg_dr_pt10","h_eta_after_gmtreg_dr_pt10",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_after_gmt_pt10 = fs->make<TH1D>("h_eta_after_gmt_pt10","h_eta_after_gmt_pt10",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_after_gmt_all_pt10 = fs->make<TH1D>("h_eta_after_gmt_all_pt10","h_eta_after_gmt_all_pt10",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_after_gmt_dr_pt10 = fs->make<TH1D>("h_eta_after_gmt_dr_pt10","h_eta_after_gmt_dr_pt10",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_after_gmt_dr_nocsc_pt10 = fs->make<TH1D>("h_eta_after_gmt_dr_nocsc_pt10","h_eta_after_gmt_dr_nocsc_pt10",N_ETA_BINS, ETA_START, ETA_END);
-
-  h_eta_vs_bx_after_alct = fs->make<TH2D>("h_eta_vs_bx_after_alct","h_eta_vs_bx_after_alct",N_ETA_BINS, ETA_START, ETA_END,13,-6.5, 6.5);
-  h_eta_vs_bx_after_mpc = fs->make<TH2D>("h_eta_vs_bx_after_mpc","h_eta_vs_bx_after_mpc",N_ETA_BINS, ETA_START, ETA_END,13,-6.5, 6.5);
-
-  h_eta_me1_after_alct = fs->make<TH1D>("h_eta_me1_after_alct","h_eta_me1_after_alct",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_me1_after_alct_okAlct = fs->make<TH1D>("h_eta_me1_after_alct_okAlct","h_eta_me1_after_alct_okAlct",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_me1_after_clct = fs->make<TH1D>("h_eta_me1_after_clct","h_eta_me1_after_clct",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_me1_after_clct_okClct = fs->make<TH1D>("h_eta_me1_after_clct_okClct","h_eta_me1_after_clct_okClct",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_me1_after_alctclct = fs->make<TH1D>("h_eta_me1_after_alctclct","h_eta_me1_after_alctclct",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_me1_after_alctclct_okAlct = fs->make<TH1D>("h_eta_me1_after_alctclct_okAlct","h_eta_me1_after_alctclct_okAlct",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_me1_after_alctclct_okClct = fs->make<TH1D>("h_eta_me1_after_alctclct_okClct","h_eta_me1_after_alctclct_okClct",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_me1_after_alctclct_okAlctClct = fs->make<TH1D>("h_eta_me1_after_alctclct_okAlctClct","h_eta_me1_after_alctclct_okAlctClct",N_ETA_BINS, ETA_START, ETA_END);
-
-  h_eta_me1_after_lct = fs->make<TH1D>("h_eta_me1_after_lct","h_eta_me1_after_lct",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_me1_after_lct_okAlct = fs->make<TH1D>("h_eta_me1_after_lct_okAlct","h_eta_me1_after_lct_okAlct",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_me1_after_lct_okAlctClct = fs->make<TH1D>("h_eta_me1_after_lct_okAlctClct","h_eta_me1_after_lct_okAlctClct",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_me1_after_lct_okClct = fs->make<TH1D>("h_eta_me1_after_lct_okClct","h_eta_me1_after_lct_okClct",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_me1_after_lct_okClctAlct = fs->make<TH1D>("h_eta_me1_after_lct_okClctAlct","h_eta_me1_after_lct_okClctAlct",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_me1_after_mplct_okAlctClct = fs->make<TH1D>("h_eta_me1_after_mplct_okAlctClct","h_eta_me1_after_mplct_okAlctClct",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_me1_after_mplct_okAlctClct_plus = fs->make<TH1D>("h_eta_me1_after_mplct_okAlctClct_plus","h_eta_me1_after_mplct_okAlctClct_plus",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_me1_after_tf_ok = fs->make<TH1D>("h_eta_me1_after_tf_ok","h_eta_me1_after_tf_ok",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_me1_after_tf_ok_pt10 = fs->make<TH1D>("h_eta_me1_after_tf_ok_pt10","h_eta_me1_after_tf_ok_pt10",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_me1_after_tf_ok_plus = fs->make<TH1D>("h_eta_me1_after_tf_ok_plus","h_eta_me1_after_tf_ok_plus",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_me1_after_tf_ok_plus_pt10 = fs->make<TH1D>("h_eta_me1_after_tf_ok_plus_pt10","h_eta_me1_after_tf_ok_plus_pt10",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_me1_after_tf_ok_plus_q[0] = fs->make<TH1D>("h_eta_me1_after_tf_ok_plus_q1","h_eta_me1_after_tf_ok_plus_q1",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_me1_after_tf_ok_plus_q[1] = fs->make<TH1D>("h_eta_me1_after_tf_ok_plus_q2","h_eta_me1_after_tf_ok_plus_q2",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_me1_after_tf_ok_plus_q[2] = fs->make<TH1D>("h_eta_me1_after_tf_ok_plus_q3","h_eta_me1_after_tf_ok_plus_q3",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_me1_after_tf_ok_plus_pt10_q[0] = fs->make<TH1D>("h_eta_me1_after_tf_ok_plus_pt10_q1","h_eta_me1_after_tf_ok_plus_pt10_q1",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_me1_after_tf_ok_plus_pt10_q[1] = fs->make<TH1D>("h_eta_me1_after_tf_ok_plus_pt10_q2","h_eta_me1_after_tf_ok_plus_pt10_q2",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_me1_after_tf_ok_plus_pt10_q[2] = fs->make<TH1D>("h_eta_me1_after_tf_ok_plus_pt10_q3","h_eta_me1_after_tf_ok_plus_pt10_q3",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_after_gmtreg = histos_.book1D("h_eta_after_gmtreg","h_eta_after_gmtreg",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_after_gmtreg_all = histos_.book1D("h_eta_after_gmtreg_all","h_eta_after_gmtreg_all",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_after_gmtreg_dr = histos_.book1D("h_eta_after_gmtreg_dr","h_eta_after_gmtreg_dr",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_after_gmt = histos_.book1D("h_eta_after_gmt","h_eta_after_gmt",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_after_gmt_all = histos_.book1D("h_eta_after_gmt_all","h_eta_after_gmt_all",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_after_gmt_dr = histos_.book1D("h_eta_after_gmt_dr","h_eta_after_gmt_dr",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_after_gmt_dr_nocsc = histos_.book1D("h_eta_after_gmt_dr_nocsc","h_eta_after_gmt_dr_nocsc",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_after_gmtreg_pt10 = histos_.book1D("h_eta_after_gmtreg_pt10","h_eta_after_gmtreg_pt10",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_after_gmtreg_all_pt10 = histos_.book1D("h_eta_after_gmtreg_all_pt10","h_eta_after_gmtreg_all_pt10",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_after_gmtreg_dr_pt10 = histos_.book1D("h_eta_after_gmtreg_dr_pt10","h_eta_after_gmtreg_dr_pt10",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_after_gmt_pt10 = histos_.book1D("h_eta_after_gmt_pt10","h_eta_after_gmt_pt10",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_after_gmt_all_pt10 = histos_.book1D("h_eta_after_gmt_all_pt10","h_eta_after_gmt_all_pt10",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_after_gmt_dr_pt10 = histos_.book1D("h_eta_after_gmt_dr_pt10","h_eta_after_gmt_dr_pt10",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_after_gmt_dr_nocsc_pt10 = histos_.book1D("h_eta_after_gmt_dr_nocsc_pt10","h_eta_after_gmt_dr_nocsc_pt10",N_ETA_BINS, ETA_START, ETA_END);
+
+  h_eta_vs_bx_after_alct = histos_.book2D("h_eta_vs_bx_after_alct","h_eta_vs_bx_after_alct",N_ETA_BINS, ETA_START, ETA_END,13,-6.5, 6.5);
+  h_eta_vs_bx_after_mpc = histos_.book2D("h_eta_vs_bx_after_mpc","h_eta_vs_bx_after_mpc",N_ETA_BINS, ETA_START, ETA_END,13,-6.5, 6.5);
+
+  h_eta_me1_after_alct = histos_.book1D("h_eta_me1_after_alct","h_eta_me1_after_alct",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_me1_after_alct_okAlct = histos_.book1D("h_eta_me1_after_alct_okAlct","h_eta_me1_after_alct_okAlct",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_me1_after_clct = histos_.book1D("h_eta_me1_after_clct","h_eta_me1_after_clct",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_me1_after_clct_okClct = histos_.book1D("h_eta_me1_after_clct_okClct","h_eta_me1_after_clct_okClct",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_me1_after_alctclct = histos_.book1D("h_eta_me1_after_alctclct","h_eta_me1_after_alctclct",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_me1_after_alctclct_okAlct = histos_.book1D("h_eta_me1_after_alctclct_okAlct","h_eta_me1_after_alctclct_okAlct",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_me1_after_alctclct_okClct = histos_.book1D("h_eta_me1_after_alctclct_okClct","h_eta_me1_after_alctclct_okClct",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_me1_after_alctclct_okAlctClct = histos_.book1D("h_eta_me1_after_alctclct_okAlctClct","h_eta_me1_after_alctclct_okAlctClct",N_ETA_BINS, ETA_START, ETA_END);
+
+  h_eta_me1_after_lct = histos_.book1D("h_eta_me1_after_lct","h_eta_me1_after_lct",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_me1_after_lct_okAlct = histos_.book1D("h_eta_me1_after_lct_okAlct","h_eta_me1_after_lct_okAlct",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_me1_after_lct_okAlctClct = histos_.book1D("h_eta_me1_after_lct_okAlctClct","h_eta_me1_after_lct_okAlctClct",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_me1_after_lct_okClct = histos_.book1D("h_eta_me1_after_lct_okClct","h_eta_me1_after_lct_okClct",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_me1_after_lct_okClctAlct = histos_.book1D("h_eta_me1_after_lct_okClctAlct","h_eta_me1_after_lct_okClctAlct",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_me1_after_mplct_okAlctClct = histos_.book1D("h_eta_me1_after_mplct_okAlctClct","h_eta_me1_after_mplct_okAlctClct",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_me1_after_mplct_okAlctClct_plus = histos_.book1D("h_eta_me1_after_mplct_okAlctClct_plus","h_eta_me1_after_mplct_okAlctClct_plus",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_me1_after_tf_ok = histos_.book1D("h_eta_me1_after_tf_ok","h_eta_me1_after_tf_ok",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_me1_after_tf_ok_pt10 = histos_.book1D("h_eta_me1_after_tf_ok_pt10","h_eta_me1_after_tf_ok_pt10",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_me1_after_tf_ok_plus = histos_.book1D("h_eta_me1_after_tf_ok_plus","h_eta_me1_after_tf_ok_plus",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_me1_after_tf_ok_plus_pt10 = histos_.book1D("h_eta_me1_after_tf_ok_plus_pt10","h_eta_me1_after_tf_ok_plus_pt10",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_me1_after_tf_ok_plus_q[0] = histos_.book1D("h_eta_me1_after_tf_ok_plus_q1","h_eta_me1_after_tf_ok_plus_q1",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_me1_after_tf_ok_plus_q[1] = histos_.book1D("h_eta_me1_after_tf_ok_plus_q2","h_eta_me1_after_tf_ok_plus_q2",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_me1_after_tf_ok_plus_q[2] = histos_.book1D("h_eta_me1_after_tf_ok_plus_q3","h_eta_me1_after_tf_ok_plus_q3",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_me1_after_tf_ok_plus_pt10_q[0] = histos_.book1D("h_eta_me1_after_tf_ok_plus_pt10_q1","h_eta_me1_after_tf_ok_plus_pt10_q1",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_me1_after_tf_ok_plus_pt10_q[1] = histos_.book1D("h_eta_me1_after_tf_ok_plus_pt10_q2","h_eta_me1_after_tf_ok_plus_pt10_q2",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_me1_after_tf_ok_plus_pt10_q[2] = histos_.book1D("h_eta_me1_after_tf_ok_plus_pt10_q3","h_eta_me1_after_tf_ok_plus_pt10_q3",N_ETA_BINS, ETA_START, ETA_END);
   //h_eta_me1_after_tf_all = fs->make<TH1D>("h_eta_me1_after_tf_all","h_eta_me1_after_tf_all",N_ETA_BINS, ETA_START, ETA_END);
   //h_eta_me1_after_tf_all_pt10 = fs->make<TH1D>("h_eta_me1_after_tf_all_pt10","h_eta_me1_after_tf_all_pt10",N_ETA_BINS, ETA_START, ETA_END);
 
 
-  h_eta_me1_after_mplct_ok = fs->make<TH1D>("h_eta_me1_after_mplct_ok","h_eta_me1_after_mplct_ok",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_me2_after_mplct_ok = fs->make<TH1D>("h_eta_me2_after_mplct_ok","h_eta_me2_after_mplct_ok",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_me3_after_mplct_ok = fs->make<TH1D>("h_eta_me3_after_mplct_ok","h_eta_me3_after_mplct_ok",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_me4_after_mplct_ok = fs->make<TH1D>("h_eta_me4_after_mplct_ok","h_eta_me4_after_mplct_ok",N_ETA_BINS, ETA_START, ETA_END);
-
-
-  h_eta_after_mpc_ok_plus_3st1a = fs->make<TH1D>("h_eta_after_mpc_ok_plus_3st1a","h_eta_after_mpc_ok_plus_3st1a",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_after_tfcand_ok_plus_3st1a= fs->make<TH1D>("h_eta_after_tfcand_ok_plus_3st1a","h_eta_after_tfcand_ok_plus_3st1a",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_after_tfcand_ok_plus_pt10_3st1a = fs->make<TH1D>("h_eta_after_tfcand_ok_plus_pt10_3st1a","h_eta_after_tfcand_ok_plus_pt10_3st1a",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_me1_after_tf_ok_plus_3st1a= fs->make<TH1D>("h_eta_me1_after_tf_ok_plus_3st1a","h_eta_me1_after_tf_ok_plus_3st1a",N_ETA_BINS, ETA_START, ETA_END);
-  h_eta_me1_after_tf_ok_plus_pt10_3st1a = fs->make<TH1D>("h_eta_me1_after_tf_ok_plus_pt10_3st1a","h_eta_me1_after_tf_ok_plus_pt10_3st1a",N_ETA_BINS, ETA_START, ETA_END);
-
-
-  h_bx_after_alct = fs->make<TH1D>("h_bx_after_alct","h_bx_after_alct",13,-6.5, 6.5);
-  h_bx_after_mpc = fs->make<TH1D>("h_bx_after_mpc","h_bx_after_mpc",13,-6.5, 6.5);
-
-
-  h_wg_me11_initial = fs->make<TH1D>("h_wg_me11_initial","h_wg_me11_initial",50, -1,49);
-  h_wg_me11_after_alct_okAlct = fs->make<TH1D>("h_wg_me11_after_alct_okAlct","h_wg_me11_after_alct_okAlct",50, -1,49);
-  h_wg_me11_after_alctclct_okAlctClct = fs->make<TH1D>("h_wg_me11_after_alctclct_okAlctClct","h_wg_me11_after_alctclct_okAlctClct",50, -1,49);
-  h_wg_me11_after_lct_okAlctClct = fs->make<TH1D>("h_wg_me11_after_lct_okAlctClct","h_wg_me11_after_lct_okAlctClct",50, -1,49);
-
-  h_phi_initial  = fs->make<TH1D>("h_phi_initial","h_phi_initial",128, -M_PI,M_PI);
-  h_phi_after_alct  = fs->make<TH1D>("h_phi_after_alct","h_phi_after_alct",128, -M_PI,M_PI);
-  h_phi_after_clct  = fs->make<TH1D>("h_phi_after_clct","h_phi_after_clct",128, -M_PI,M_PI);
-  h_phi_after_lct  = fs->make<TH1D>("h_phi_after_lct","h_phi_after_lct",128, -M_PI,M_PI);
-  h_phi_after_mpc  = fs->make<TH1D>("h_phi_after_mpc","h_phi_after_mpc",128, -M_PI,M_PI);
-  h_phi_after_tftrack  = fs->make<TH1D>("h_phi_after_tftrack","h_phi_after_tftrack",128, -M_PI,M_PI);
-  h_phi_after_tfcand  = fs->make<TH1D>("h_phi_after_tfcand","h_phi_after_tfcand",128, -M_PI,M_PI);
-  h_phi_after_tfcand_all = fs->make<TH1D>("h_phi_after_tfcand_all","h_phi_after_tfcand_all",128, -M_PI,M_PI);
-  h_phi_after_gmtreg = fs->make<TH1D>("h_phi_after_gmtreg","h_phi_after_gmtreg",128, -M_PI,M_PI);
-  h_phi_after_gmtreg_all = fs->make<TH1D>("h_phi_after_gmtreg_all","h_phi_after_gmtreg_all",128, -M_PI,M_PI);
-  h_phi_after_gmtreg_dr = fs->make<TH1D>("h_phi_after_gmtreg_dr","h_phi_after_gmtreg_dr",128, -M_PI,M_PI);
-  h_phi_after_gmt = fs->make<TH1D>("h_phi_after_gmt","h_phi_after_gmt",128, -M_PI,M_PI);
-  h_phi_after_gmt_all = fs->make<TH1D>("h_phi_after_gmt_all","h_phi_after_gmt_all",128, -M_PI,M_PI);
-  h_phi_after_gmt_dr = fs->make<TH1D>("h_phi_after_gmt_dr","h_phi_after_gmt_dr",128, -M_PI,M_PI);
-  h_phi_after_gmt_dr_nocsc = fs->make<TH1D>("h_phi_after_gmt_dr_nocsc","h_phi_after_gmt_dr_nocsc",128, -M_PI,M_PI);
-
-  h_phi_me1_after_alct = fs->make<TH1D>("h_phi_me1_after_alct","h_phi_me1_after_alct",128, -M_PI, M_PI);
-  h_phi_me1_after_alct_okAlct = fs->make<TH1D>("h_phi_me1_after_alct_okAlct","h_phi_me1_after_alct_okAlct",128, -M_PI, M_PI);
-  h_phi_me1_after_clct = fs->make<TH1D>("h_phi_me1_after_clct","h_phi_me1_after_clct",128, -M_PI, M_PI);
-  h_phi_me1_after_clct_okClct = fs->make<TH1D>("h_phi_me1_after_clct_okClct","h_phi_me1_after_clct_okClct",128, -M_PI, M_PI);
-  h_phi_me1_after_alctclct = fs->make<TH1D>("h_phi_me1_after_alctclct","h_phi_me1_after_alctclct",128, -M_PI, M_PI);
-  h_phi_me1_after_alctclct_okAlct = fs->make<TH1D>("h_phi_me1_after_alctclct_okAlct","h_phi_me1_after_alctclct_okAlct",128, -M_PI, M_PI);
-  h_phi_me1_after_alctclct_okClct = fs->make<TH1D>("h_phi_me1_after_alctclct_okClct","h_phi_me1_after_alctclct_okClct",128, -M_PI, M_PI);
-  h_phi_me1_after_alctclct_okAlctClct = fs->make<TH1D>("h_phi_me1_after_alctclct_okAlctClct","h_phi_me1_after_alctclct_okAlctClct",128, -M_PI, M_PI);
-
-  h_phi_me1_after_lct = fs->make<TH1D>("h_phi_me1_after_lct","h_phi_me1_after_lct",128, -M_PI, M_PI);
-  h_phi_me1_after_lct_okAlct = fs->make<TH1D>("h_phi_me1_after_lct_okAlct","h_phi_me1_after_lct_okAlct",128, -M_PI, M_PI);
-  h_phi_me1_after_lct_okAlctClct = fs->make<TH1D>("h_phi_me1_after_lct_okAlctClct","h_phi_me1_after_lct_okAlctClct",128, -M_PI, M_PI);
-  h_phi_me1_after_lct_okClct = fs->make<TH1D>("h_phi_me1_after_lct_okClct","h_phi_me1_after_lct_okClct",128, -M_PI, M_PI);
-  h_phi_me1_after_lct_okClctAlct = fs->make<TH1D>("h_phi_me1_after_lct_okClctAlct","h_phi_me1_after_lct_okClctAlct",128, -M_PI, M_PI);
-  h_phi_me1_after_mplct_ok = fs->make<TH1D>("h_phi_me1_after_mplct_ok","h_phi_me1_after_mplct_ok",128, -M_PI, M_PI);
-  h_phi_me1_after_mplct_okAlctClct = fs->make<TH1D>("h_phi_me1_after_mplct_okAlctClct","h_phi_me1_after_mplct_okAlctClct",128, -M_PI, M_PI);
-  h_phi_me1_after_mplct_okAlctClct_plus = fs->make<TH1D>("h_phi_me1_after_mplct_okAlctClct_plus","h_phi_me1_after_mplct_okAlctClct_plus",128, -M_PI, M_PI);
-  h_phi_me1_after_tf_ok = fs->make<TH1D>("h_phi_me1_after_tf_ok","h_phi_me1_after_tf_ok",128, -M_PI, M_PI);
-
-  h_qu_alct = fs->make<TH1D>("h_qu_alct","h_qu_alct",17,-0.5, 16.5);
-  h_qu_mplct = fs->make<TH1D>("h_qu_mplct","h_qu_mplct",17,-0.5, 16.5);
-  h_qu_vs_bx__alct = fs->make<TH2D>("h_qu_vs_bx__alct","h_qu_vs_bx__alct",17,-0.5, 16.5, 15,-7.5, 7.5);
-  h_qu_vs_bx__mplct = fs->make<TH2D>("h_qu_vs_bx__mplct","h_qu_vs_bx__mplct",17,-0.5, 16.5, 15,-7.5, 7.5);
-
-  h_tf_n_stubs = fs->make<TH1D>("h_tf_n_stubs","h_tf_n_stubs",16, 0.,16.);
-  h_tf_n_matchstubs = fs->make<TH1D>("h_tf_n_matchstubs","h_tf_n_matchstubs",16, 0.,16.);
-  h_tf_n_stubs_vs_matchstubs = fs->make<TH2D>("h_tf_n_stubs_vs_matchstubs","h_tf_n_stubs_vs_matchstubs",16, 0.,16.,16, 0.,16.);
-
-  h_tfpt = fs->make<TH1D>("h_tfpt","h_tfpt",300, 0.,150.);
-  h_tfeta = fs->make<TH1D>("h_tfeta","h_tfeta",500,-2.5, 2.5);
-  h_tfphi = fs->make<TH1D>("h_tfphi","h_tfphi",128*5, -M_PI,M_PI);
-  h_tfbx = fs->make<TH1D>("h_tfbx","h_tfbx",13,-6.5, 6.5);
-  h_tfqu = fs->make<TH1D>("h_tfqu","h_tfqu",5,-0.5, 4.5);
-  h_tfdr = fs->make<TH1D>("h_tfdr","h_tfdr",120,0., 0.6);
-  h_tfpt_vs_qu = fs->make<TH2D>("h_tfpt_vs_qu","h_tfpt_vs_qu",N_PT_BINS*2, 0.,150.,5,-0.5, 4.5);
-
-  h_tf_mode = fs->make<TH1D>("h_tf_mode","TF Track Mode", 16, -0.5, 15.5);
-  setupTFModeHisto(h_tf_mode);
-  h_tf_mode->SetTitle("TF Track Mode (SimTrack match)");
-
-  h_tf_pt_h42_2st = fs->make<TH1D>("h_tf_pt_h42_2st","h_tf_pt_h42_2st",300, 0.,150.);
-  h_tf_pt_h42_3st = fs->make<TH1D>("h_tf_pt_h42_3st","h_tf_pt_h42_3st",300, 0.,150.);
-  h_tf_pt_h42_2st_w = fs->make<TH1D>("h_tf_pt_h42_2st_w","h_tf_pt_h42_2st_w",300, 0.,150.);
-  h_tf_pt_h42_3st_w = fs->make<TH1D>("h_tf_pt_h42_3st_w","h_tf_pt_h42_3st_w",300, 0.,150.);
+  h_eta_me1_after_mplct_ok = histos_.book1D("h_eta_me1_after_mplct_ok","h_eta_me1_after_mplct_ok",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_me2_after_mplct_ok = histos_.book1D("h_eta_me2_after_mplct_ok","h_eta_me2_after_mplct_ok",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_me3_after_mplct_ok = histos_.book1D("h_eta_me3_after_mplct_ok","h_eta_me3_after_mplct_ok",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_me4_after_mplct_ok = histos_.book1D("h_eta_me4_after_mplct_ok","h_eta_me4_after_mplct_ok",N_ETA_BINS, ETA_START, ETA_END);
+
+
+  h_eta_after_mpc_ok_plus_3st1a = histos_.book1D("h_eta_after_mpc_ok_plus_3st1a","h_eta_after_mpc_ok_plus_3st1a",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_after_tfcand_ok_plus_3st1a= histos_.book1D("h_eta_after_tfcand_ok_plus_3st1a","h_eta_after_tfcand_ok_plus_3st1a",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_after_tfcand_ok_plus_pt10_3st1a = histos_.book1D("h_eta_after_tfcand_ok_plus_pt10_3st1a","h_eta_after_tfcand_ok_plus_pt10_3st1a",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_me1_after_tf_ok_plus_3st1a= histos_.book1D("h_eta_me1_after_tf_ok_plus_3st1a","h_eta_me1_after_tf_ok_plus_3st1a",N_ETA_BINS, ETA_START, ETA_END);
+  h_eta_me1_after_tf_ok_plus_pt10_3st1a = histos_.book1D("h_eta_me1_after_tf_ok_plus_pt10_3st1a","h_eta_me1_after_tf_ok_plus_pt10_3st1a",N_ETA_BINS, ETA_START, ETA_END);
+
+
+  h_bx_after_alct = histos_.book1D("h_bx_after_alct","h_bx_after_alct",13,-6.5, 6.5);
+  h_bx_after_mpc = histos_.book1D("h_bx_after_mpc","h_bx_after_mpc",13,-6.5, 6.5);
+
+
+  h_wg_me11_initial = histos_.book1D("h_wg_me11_initial","h_wg_me11_initial",50, -1,49);
+  h_wg_me11_after_alct_okAlct = histos_.book1D("h_wg_me11_after_alct_okAlct","h_wg_me11_after_alct_okAlct",50, -1,49);
+  h_wg_me11_after_alctclct_okAlctClct = histos_.book1D("h_wg_me11_after_alctclct_okAlctClct","h_wg_me11_after_alctclct_okAlctClct",50, -1,49);
+  h_wg_me11_after_lct_okAlctClct = histos_.book1D("h_wg_me11_after_lct_okAlctClct","h_wg_me11_after_lct_okAlctClct",50, -1,49);
+
+  h_phi_initial  = histos_.book1D("h_phi_initial","h_phi_initial",128, -M_PI,M_PI);
+  h_phi_after_alct  = histos_.book1D("h_phi_after_alct","h_phi_after_alct",128, -M_PI,M_PI);
+  h_phi_after_clct  = histos_.book1D("h_phi_after_clct","h_phi_after_clct",128, -M_PI,M_PI);
+  h_phi_after_lct  = histos_.book1D("h_phi_after_lct","h_phi_after_lct",128, -M_PI,M_PI);
+  h_phi_after_mpc  = histos_.book1D("h_phi_after_mpc","h_phi_after_mpc",128, -M_PI,M_PI);
+  h_phi_after_tftrack  = histos_.book1D("h_phi_after_tftrack","h_phi_after_tftrack",128, -M_PI,M_PI);
+  h_phi_after_tfcand  = histos_.book1D("h_phi_after_tfcand","h_phi_after_tfcand",128, -M_PI,M_PI);
+  h_phi_after_tfcand_all = histos_.book1D("h_phi_after_tfcand_all","h_phi_after_tfcand_all",128, -M_PI,M_PI);
+  h_phi_after_gmtreg = histos_.book1D("h_phi_after_gmtreg","h_phi_after_gmtreg",128, -M_PI,M_PI);
+  h_phi_after_gmtreg_all = histos_.book1D("h_phi_after_gmtreg_all","h_phi_after_gmtreg_all",128, -M_PI,M_PI);
+  h_phi_after_gmtreg_dr = histos_.book1D("h_phi_after_gmtreg_dr","h_phi_after_gmtreg_dr",128, -M_PI,M_PI);
+  h_phi_after_gmt = histos_.book1D("h_phi_after_gmt","h_phi_after_gmt",128, -M_PI,M_PI);
+  h_phi_after_gmt_all = histos_.book1D("h_phi_after_gmt_all","h_phi_after_gmt_all",128, -M_PI,M_PI);
+  h_phi_after_gmt_dr = histos_.book1D("h_phi_after_gmt_dr","h_phi_after_gmt_dr",128, -M_PI,M_PI);
+  h_phi_after_gmt_dr_nocsc = histos_.book1D("h_phi_after_gmt_dr_nocsc","h_phi_after_gmt_dr_nocsc",128, -M_PI,M_PI);
+
+  h_phi_me1_after_alct = histos_.book1D("h_phi_me1_after_alct","h_phi_me1_after_alct",128, -M_PI, M_PI);
+  h_phi_me1_after_alct_okAlct = histos_.book1D("h_phi_me1_after_alct_okAlct","h_phi_me1_after_alct_okAlct",128, -M_PI, M_PI);
+  h_phi_me1_after_clct = histos_.book1D("h_phi_me1_after_clct","h_phi_me1_after_clct",128, -M_PI, M_PI);
+  h_phi_me1_after_clct_okClct = histos_.book1D("h_phi_me1_after_clct_okClct","h_phi_me1_after_clct_okClct",128, -M_PI, M_PI);
+  h_phi_me1_after_alctclct = histos_.book1D("h_phi_me1_after_alctclct","h_phi_me1_after_alctclct",128, -M_PI, M_PI);
+  h_phi_me1_after_alctclct_okAlct = histos_.book1D("h_phi_me1_after_alctclct_okAlct","h_phi_me1_after_alctclct_okAlct",128, -M_PI, M_PI);
+  h_phi_me1_after_alctclct_okClct = histos_.book1D("h_phi_me1_after_alctclct_okClct","h_phi_me1_after_alctclct_okClct",128, -M_PI, M_PI);
+  h_phi_me1_after_alctclct_okAlctClct = histos_.book1D("h_phi_me1_after_alctclct_okAlctClct","h_phi_me1_after_alctclct_okAlctClct",128, -M_PI, M_PI);
+
+  h_phi_me1_after_lct = histos_.book1D("h_phi_me1_after_lct","h_phi_me1_after_lct",128, -M_PI, M_PI);
+  h_phi_me1_after_lct_okAlct = histos_.book1D("h_phi_me1_after_lct_okAlct","h_phi_me1_after_lct_okAlct",128, -M_PI, M_PI);
+  h_phi_me1_after_lct_okAlctClct = histos_.book1D("h_phi_me1_after_lct_okAlctClct","h_phi_me1_after_lct_okAlctClct",128, -M_PI, M_PI);
+  h_phi_me1_after_lct_okClct = histos_.book1D("h_phi_me1_after_lct_okClct","h_phi_me1_after_lct_okClct",128, -M_PI, M_PI);
+  h_phi_me1_after_lct_okClctAlct = histos_.book1D("h_phi_me1_after_lct_okClctAlct","h_phi_me1_after_lct_okClctAlct",128, -M_PI, M_PI);
+  h_phi_me1_after_mplct_ok = histos_.book1D("h_phi_me1_after_mplct_ok","h_phi_me1_after_mplct_ok",128, -M_PI, M_PI);
+  h_phi_me1_after_mplct_okAlctClct = histos_.book1D("h_phi_me1_after_mplct_okAlctClct","h_phi_me1_after_mplct_okAlctClct",128, -M_PI, M_PI);
+  h_phi_me1_after_mplct_okAlctClct_plus = histos_.book1D("h_phi_me1_after_mplct_okAlctClct_plus","h_phi_me1_after_mplct_okAlctClct_plus",128, -M_PI, M_PI);
+  h_phi_me1_after_tf_ok = histos_.book1D("h_phi_me1_after_tf_ok","h_phi_me1_after_tf_ok",128, -M_PI, M_PI);
+
+  h_qu_alct = histos_.book1D("h_qu_alct","h_qu_alct",17,-0.5, 16.5);
+  h_qu_mplct = histos_.book1D("h_qu_mplct","h_qu_mplct",17,-0.5, 16.5);
+  h_qu_vs_bx__alct = histos_.book2D("h_qu_vs_bx__alct","h_qu_vs_bx__alct",17,-0.5, 16.5, 15,-7.5, 7.5);
+  h_qu_vs_bx__mplct = histos_.book2D("h_qu_vs_bx__mplct","h_qu_vs_bx__mplct",17,-0.5, 16.5, 15,-7.5, 7.5);
+
+  h_tf_n_stubs = histos_.book1D("h_tf_n_stubs","h_tf_n_stubs",16, 0.,16.);
+  h_tf_n_matchstubs = histos_.book1D("h_tf_n_matchstubs","h_tf_n_matchstubs",16, 0.,16.);
+  h_tf_n_stubs_vs_matchstubs = histos_.book2D("h_tf_n_stubs_vs_matchstubs","h_tf_n_stubs_vs_matchstubs",16, 0.,16.,16, 0.,16.);
+
+  h_tfpt = histos_.book1D("h_tfpt","h_tfpt",300, 0.,150.);
+  h_tfeta = histos_.book1D("h_tfeta","h_tfeta",500,-2.5, 2.5);
+  h_tfphi = histos_.book1D("h_tfphi","h_tfphi",128*5, -M_PI,M_PI);
+  h_tfbx = histos_.book1D("h_tfbx","h_tfbx",13,-6.5, 6.5);
+  h_tfqu = histos_.book1D("h_tfqu","h_tfqu",5,-0.5, 4.5);
+  h_tfdr = histos_.book1D("h_tfdr","h_tfdr",120,0., 0.6);
+  h_tfpt_vs_qu = histos_.book2D("h_tfpt_vs_qu","h_tfpt_vs_qu",N_PT_BINS*2, 0.,150.,5,-0.5, 4.5);
+
+  h_tf_mode = histos_.book1D("h_tf_mode","TF Track Mode", 16, -0.5, 15.5);
+  setupTFModeHisto(h_tf_mode->get());
+  h_tf_mode->get()->SetTitle("TF Track Mode (SimTrack match)");
+
+  h_tf_pt_h42_2st = histos_.book1D("h_tf_pt_h42_2st","h_tf_pt_h42_2st",300, 0.,150.);
+  h_tf_pt_h42_3st = histos_.book1D("h_tf_pt_h42_3st","h_tf_pt_h42_3st",300, 0.,150.);
+  h_tf_pt_h42_2st_w = histos_.book1D("h_tf_pt_h42_2st_w","h_tf_pt_h42_2st_w",300, 0.,150.);
+  h_tf_pt_h42_3st_w = histos_.book1D("h_tf_pt_h42_3st_w","h_tf_pt_h42_3st_w",300, 0.,150.);
 
   
-  h_gmtpt = fs->make<TH1D>("h_gmtpt","h_gmtpt",300, 0.,150.);
-  h_gmteta = fs->make<TH1D>("h_gmteta","h_gmteta",500,-2.5, 2.5);
-  h_gmtphi = fs->make<TH1D>("h_gmtphi","h_gmtphi",128*5, -M_PI,M_PI);
-  h_gmtbx = fs->make<TH1D>("h_gmtbx","h_gmtbx",13,-6.5, 6.5);
-  h_gmtrank = fs->make<TH1D>("h_gmtrank","h_gmtrank",250,-0.001, 250-0.001);
-  h_gmtqu = fs->make<TH1D>("h_gmtqu","h_gmtqu",11,-0.5, 10.5);
-  h_gmtisrpc = fs->make<TH1D>("h_gmtisrpc","h_gmtisrpc",4,-0.5, 3.5);
-  h_gmtdr = fs->make<TH1D>("h_gmtdr","h_gmtdr",120,0., 0.6);
-
-  h_gmtxpt = fs->make<TH1D>("h_gmtxpt","h_gmtxpt",300, 0.,150.);
-  h_gmtxeta = fs->make<TH1D>("h_gmtxeta","h_gmtxeta",500,-2.5, 2.5);
-  h_gmtxphi = fs->make<TH1D>("h_gmtxphi","h_gmtxphi",128*5, -M_PI,M_PI);
-  h_gmtxbx = fs->make<TH1D>("h_gmtxbx","h_gmtxbx",13,-6.5, 6.5);
-  h_gmtxrank = fs->make<TH1D>("h_gmtxrank","h_gmtxrank",250,-0.001, 250-0.001);
-  h_gmtxqu = fs->make<TH1D>("h_gmtxqu","h_gmtxqu",11,-0.5, 10.5);
-  h_gmtxisrpc = fs->make<TH1D>("h_gmtxisrpc","h_gmtxisrpc",4,-0.5, 3.5);
-  h_gmtxdr = fs->make<TH1D>("h_gmtxdr","h_gmtxdr",120,0., 0.6);
-
-  h_gmtxpt_nocsc = fs->make<TH1D>("h_gmtxpt_nocsc","h_gmtxpt_nocsc",300, 0.,150.);
-  h_gmtxeta_nocsc = fs->make<TH1D>("h_gmtxeta_nocsc","h_gmtxeta_nocsc",500,-2.5, 2.5);
-  h_gmtxphi_nocsc = fs->make<TH1D>("h_gmtxphi_nocsc","h_gmtxphi_nocsc",128*5, -M_PI,M_PI);
-  h_gmtxbx_nocsc = fs->make<TH1D>("h_gmtxbx_nocsc","h_gmtxbx_nocsc",13,-6.5, 6.5);
-  h_gmtxrank_nocsc = fs->make<TH1D>("h_gmtxrank_nocsc","h_gmtxrank_nocsc",250,0, 250);
-  h_gmtxqu_nocsc = fs->make<TH1D>("h_gmtxqu_nocsc","h_gmtxqu_nocsc",11,-0.5, 10.5);
-  h_gmtxisrpc_nocsc = fs->make<TH1D>("h_gmtxisrpc_nocsc","h_gmtxisrpc_nocsc",4,-0.5, 3.5);
-  h_gmtxdr_nocsc = fs->make<TH1D>("h_gmtxdr_nocsc","h_gmtxdr_nocsc",120,0., 0.6);
-
-  h_gmtxqu_nogmtreg = fs->make<TH1D>("h_gmtxqu_nogmtreg","h_gmtxqu_nogmtreg",11,-0.5, 10.5);
-  h_gmtxisrpc_nogmtreg = fs->make<TH1D>("h_gmtxisrpc_nogmtreg","h_gmtxisrpc_nogmtreg",4,-0.5, 3.5);
-  h_gmtxqu_notfcand = fs->make<TH1D>("h_gmtxqu_notfcand","h_gmtxqu_notfcand",11,-0.5, 10.5);
-  h_gmtxisrpc_notfcand = fs->make<TH1D>("h_gmtxisrpc_notfcand","h_gmtxisrpc_notfcand",4,-0.5, 3.5);
-  h_gmtxqu_nompc = fs->make<TH1D>("h_gmtxqu_nompc","h_gmtxqu_nompc",11,-0.5, 10.5);
-  h_gmtxisrpc_nompc = fs->make<TH1D>("h_gmtxisrpc_nompc","h_gmtxisrpc_nompc",4,-0.5, 3.5);
-
-  h_n_alct = fs->make<TH1D>("h_n_alct", "h_n_alct", 9,-0.5,8.5);
-  h_n_clct = fs->make<TH1D>("h_n_clct", "h_n_clct", 9,-0.5,8.5);
-  h_n_lct = fs->make<TH1D>("h_n_lct", "h_n_lct", 9,-0.5,8.5);
-  h_n_mplct = fs->make<TH1D>("h_n_mplct", "h_n_mplct", 9,-0.5,8.5);
-  h_n_tftrack = fs->make<TH1D>("h_n_tftrack", "h_n_tftrack", 6,-0.5,5.5);
-  h_n_tftrack_all = fs->make<TH1D>("h_n_tftrack_all", "h_n_tftrack_all", 6,-0.5,5.5);
-  h_n_tfcand = fs->make<TH1D>("h_n_tfcand", "h_n_tfcand", 6,-0.5,5.5);
-  h_n_tfcand_all = fs->make<TH1D>("h_n_tfcand_all", "h_n_tfcand_all", 6,-0.5,5.5);
-  h_n_gmtregcand = fs->make<TH1D>("h_n_gmtregcand", "h_n_gmtregcand", 6,-0.5,5.5);
-  h_n_gmtregcand_all = fs->make<TH1D>("h_n_gmtregcand_all", "h_n_gmtregcand_all", 6,-0.5,5.5);
-  h_n_gmtcand = fs->make<TH1D>("h_n_gmtcand", "h_n_gmtcand", 6,-0.5,5.5);
-  h_n_gmtcand_all = fs->make<TH1D>("h_n_gmtcand_all", "h_n_gmtcand_all", 6,-0.5,5.5);
-
-  h_n_ch_w_alct = fs->make<TH1D>("h_n_ch_w_alct", "h_n_ch_w_alct", 9,-0.5,8.5);
-  h_n_ch_w_clct = fs->make<TH1D>("h_n_ch_w_clct", "h_n_ch_w_clct", 9,-0.5,8.5);
-  h_n_ch_w_lct = fs->make<TH1D>("h_n_ch_w_lct", "h_n_ch_w_lct", 9,-0.5,8.5);
-  h_n_ch_w_mplct = fs->make<TH1D>("h_n_ch_w_mplct", "h_n_ch_w_mplct", 9,-0.5,8.5);
-
-
-  h_pt_over_tfpt_resol = fs->make<TH1D>("h_pt_over_pttf_resol","h_pt_over_pttf_resol",300, -1.5,1.5);
-  h_pt_over_tfpt_resol_vs_pt = fs->make<TH2D>("h_pt_over_pttf_resol_vs_pt","h_pt_over_pttf_resol_vs_pt",150, -1.5,1.5,N_PT_BINS, PT_START, PT_END);
-
-  h_eta_minus_tfeta_resol = fs->make<TH1D>("h_eta_minus_tfeta_resol","h_eta_minus_tfeta_resol",N_ETA_BINS,-1., 1.);
-  h_phi_minus_tfphi_resol = fs->make<TH1D>("h_phi_minus_tfphi_resol","h_phi_minus_tfphi_resol",200,-1., 1.);
-
-  h_gmt_mindr = fs->make<TH1D>("h_gmt_mindr","h_gmt_mindr",500, 0, 2*M_PI);
-  h_gmt_dr_maxrank = fs->make<TH1D>("h_gmt_dr_maxrank","h_gmt_dr_maxrank",500, 0, 2*M_PI);
+  h_gmtpt = histos_.book1D("h_gmtpt","h_gmtpt",300, 0.,150.);
+  h_gmteta = histos_.book1D("h_gmteta","h_gmteta",500,-2.5, 2.5);
+  h_gmtphi = histos_.book1D("h_gmtphi","h_gmtphi",128*5, -M_PI,M_PI);
+  h_gmtbx = histos_.book1D("h_gmtbx","h_gmtbx",13,-6.5, 6.5);
+  h_gmtrank = histos_.book1D("h_gmtrank","h_gmtrank",250,-0.001, 250-0.001);
+  h_gmtqu = histos_.book1D("h_gmtqu","h_gmtqu",11,-0.5, 10.5);
+  h_gmtisrpc = histos_.book1D("h_gmtisrpc","h_gmtisrpc",4,-0.5, 3.5);
+  h_gmtdr = histos_.book1D("h_gmtdr","h_gmtdr",120,0., 0.6);
+
+  h_gmtxpt = histos_.book1D("h_gmtxpt","h_gmtxpt",300, 0.,150.);
+  h_gmtxeta = histos_.book1D("h_gmtxeta","h_gmtxeta",500,-2.5, 2.5);
+  h_gmtxphi = histos_.book1D("h_gmtxphi","h_gmtxphi",128*5, -M_PI,M_PI);
+  h_gmtxbx = histos_.book1D("h_gmtxbx","h_gmtxbx",13,-6.5, 6.5);
+  h_gmtxrank = histos_.book1D("h_gmtxrank","h_gmtxrank",250,-0.001, 250-0.001);
+  h_gmtxqu = histos_.book1D("h_gmtxqu","h_gmtxqu",11,-0.5, 10.5);
+  h_gmtxisrpc = histos_.book1D("h_gmtxisrpc","h_gmtxisrpc",4,-0.5, 3.5);
+  h_gmtxdr = histos_.book1D("h_gmtxdr","h_gmtxdr",120,0., 0.6);
+
+  h_gmtxpt_nocsc = histos_.book1D("h_gmtxpt_nocsc","h_gmtxpt_nocsc",300, 0.,150.);
+  h_gmtxeta_nocsc = histos_.book1D("h_gmtxeta_nocsc","h_gmtxeta_nocsc",500,-2.5, 2.5);
+  h_gmtxphi_nocsc = histos_.book1D("h_gmtxphi_nocsc","h_gmtxphi_nocsc",128*5, -M_PI,M_PI);
+  h_gmtxbx_nocsc = histos_.book1D("h_gmtxbx_nocsc","h_gmtxbx_nocsc",13,-6.5, 6.5);
+  h_gmtxrank_nocsc = histos_.book1D("h_gmtxrank_nocsc","h_gmtxrank_nocsc",250,0, 250);
+  h_gmtxqu_nocsc = histos_.book1D("h_gmtxqu_nocsc","h_gmtxqu_nocsc",11,-0.5, 10.5);
+  h_gmtxisrpc_nocsc = histos_.book1D("h_gmtxisrpc_nocsc","h_gmtxisrpc_nocsc",4,-0.5, 3.5);
+  h_gmtxdr_nocsc = histos_.book1D("h_gmtxdr_nocsc","h_gmtxdr_nocsc",120,0., 0.6);
+
+  h_gmtxqu_nogmtreg = histos_.book1D("h_gmtxqu_nogmtreg","h_gmtxqu_nogmtreg",11,-0.5, 10.5);
+  h_gmtxisrpc_nogmtreg = histos_.book1D("h_gmtxisrpc_nogmtreg","h_gmtxisrpc_nogmtreg",4,-0.5, 3.5);
+  h_gmtxqu_notfcand = histos_.book1D("h_gmtxqu_notfcand","h_gmtxqu_notfcand",11,-0.5, 10.5);
+  h_gmtxisrpc_notfcand = histos_.book1D("h_gmtxisrpc_notfcand","h_gmtxisrpc_notfcand",4,-0.5, 3.5);
+  h_gmtxqu_nompc = histos_.book1D("h_gmtxqu_nompc","h_gmtxqu_nompc",11,-0.5, 10.5);
+  h_gmtxisrpc_nompc = histos_.book1D("h_gmtxisrpc_nompc","h_gmtxisrpc_nompc",4,-0.5, 3.5);
+
+  h_n_alct = histos_.book1D("h_n_alct", "h_n_alct", 9,-0.5,8.5);
+  h_n_clct = histos_.book1D("h_n_clct", "h_n_clct", 9,-0.5,8.5);
+  h_n_lct = histos_.book1D("h_n_lct", "h_n_lct", 9,-0.5,8.5);
+  h_n_mplct = histos_.book1D("h_n_mplct", "h_n_mplct", 9,-0.5,8.5);
+  h_n_tftrack = histos_.book1D("h_n_tftrack", "h_n_tftrack", 6,-0.5,5.5);
+  h_n_tftrack_all = histos_.book1D("h_n_tftrack_all", "h_n_tftrack_all", 6,-0.5,5.5);
+  h_n_tfcand = histos_.book1D("h_n_tfcand", "h_n_tfcand", 6,-0.5,5.5);
+  h_n_tfcand_all = histos_.book1D("h_n_tfcand_all", "h_n_tfcand_all", 6,-0.5,5.5);
+  h_n_gmtregcand = histos_.book1D("h_n_gmtregcand", "h_n_gmtregcand", 6,-0.5,5.5);
+  h_n_gmtregcand_all = histos_.book1D("h_n_gmtregcand_all", "h_n_gmtregcand_all", 6,-0.5,5.5);
+  h_n_gmtcand = histos_.book1D("h_n_gmtcand", "h_n_gmtcand", 6,-0.5,5.5);
+  h_n_gmtcand_all = histos_.book1D("h_n_gmtcand_all", "h_n_gmtcand_all", 6,-0.5,5.5);
+
+  h_n_ch_w_alct = histos_.book1D("h_n_ch_w_alct", "h_n_ch_w_alct", 9,-0.5,8.5);
+  h_n_ch_w_clct = histos_.book1D("h_n_ch_w_clct", "h_n_ch_w_clct", 9,-0.5,8.5);
+  h_n_ch_w_lct = histos_.book1D("h_n_ch_w_lct", "h_n_ch_w_lct", 9,-0.5,8.5);
+  h_n_ch_w_mplct = histos_.book1D("h_n_ch_w_mplct", "h_n_ch_w_mplct", 9,-0.5,8.5);
+
+
+  h_pt_over_tfpt_resol = histos_.book1D("h_pt_over_pttf_resol","h_pt_over_pttf_resol",300, -1.5,1.5);
+  h_pt_over_tfpt_resol_vs_pt = histos_.book2D("h_pt_over_pttf_resol_vs_pt","h_pt_over_pttf_resol_vs_pt",150, -1.5,1.5,N_PT_BINS, PT_START, PT_END);
+
+  h_eta_minus_tfeta_resol = histos_.book1D("h_eta_minus_tfeta_resol","h_eta_minus_tfeta_resol",N_ETA_BINS,-1., 1.);
+  h_phi_minus_tfphi_resol = histos_.book1D("h_phi_minus_tfphi_resol","h_phi_minus_tfphi_resol",200,-1., 1.);
+
+  h_gmt_mindr = histos_.book1D("h_gmt_mindr","h_gmt_mindr",500, 0, 2*M_PI);
+  h_gmt_dr_maxrank = histos_.book1D("h_gmt_dr_maxrank","h_gmt_dr_maxrank",500, 0, 2*M_PI);
 }
 
 
@@ -928,7 +936,7 @@ GEMCSCTriggerEfficiency::analyze(const edm::Event& iEvent, const edm::EventSetup
   const edm::SimVertexContainer & simVertices = *(hSimVertices.product());
 
   // get SimHits
-  theCSCSimHitMap.fill(iEvent);
+  theCSCSimHitPool.fill(iEvent);
 
   edm::Handle< edm::PSimHitContainer > MuonCSCHits;
   iEvent.getByLabel("g4SimHits", "MuonCSCHits", MuonCSCHits);
@@ -1173,10 +1181,10 @@ GEMCSCTriggerEfficiency::analyze(const edm::Event& iEvent, const edm::EventSetup
   // debuggin' 
   if (debugALLEVENT) {
     std::cout<<"--- detIDs with hits: "<<std::endl;
-    std::vector<int> detIds = theCSCSimHitMap.detsWithHits();
+    std::vector<int> detIds = theCSCSimHitPool.detsWithHits();
     for (size_t di = 0; di < detIds.size(); di++) {
       CSCDetId layerId(detIds[di]);
-      edm::PSimHitContainer hits = theCSCSimHitMap.hits(detIds[di]);
+      SimHitAnalysis::PSimHitPool::IndexRange hits = theCSCSimHitPool.detHits(detIds[di]);
       std::cout<<"   "<< detIds[di]<<" "<<layerId<<"   no. of hits = "<<hits.size()<<std::endl;
 
       const CSCLayer* csclayer = cscGeometry->layer(layerId);
@@ -1184,12 +1192,13 @@ GEMCSCTriggerEfficiency::analyze(const edm::Event& iEvent, const edm::EventSetup
 
       for (unsigned j=0; j<hits.size(); j++) 
   	  {
-  	    LocalPoint hitLP = hits[j].localPosition();
+  	    const PSimHit & hit = theCSCSimHitPool[hits[j]];
+  	    LocalPoint hitLP = hit.localPosition();
   	    GlobalPoint hitGP = csclayer->toGlobal(hitLP);
   	    double hitEta = hitGP.eta();
   	    double hitPhi = hitGP.phi();
-  	    std::cout<<"     "<<hitEta<<" "<<hitPhi<<"  "<<hits[j].entryPoint()<<" "<<hits[j].exitPoint()
-                 <<" "<<hits[j].particleType()<<" "<<hits[j].trackId()<<std::endl;
+  	    std::cout<<"     "<<hitEta<<" "<<hitPhi<<"  "<<hit.entryPoint()<<" "<<hit.exitPoint()
+                 <<" "<<hit.particleType()<<" "<<hit.trackId()<<std::endl;
   	  }
 
       std::cout<<"     wire digis: etas"<<std::endl;
@@ -1309,7 +1318,7 @@ GEMCSCTriggerEfficiency::analyze(const edm::Event& iEvent, const edm::EventSetup
     if (debugALLEVENT) std::cout<<" *** Accepting mu SimTrack: pt = "<<stpt<<"  phi = "<<stphi<<" eta = "<<steta<<std::endl;
     
     // create a new matching object
-    MatchCSCMuL1 *match = new MatchCSCMuL1(&*istrk, &(simVertices[istrk->vertIndex()]), cscGeometry);
+    MatchCSCMuL1 *match = new MatchCSCMuL1(&*istrk, &(simVertices[istrk->vertIndex()]), cscGeometry, &theCSCSimHitPool);
     match->muOnly = doStrictSimHitToTrackMatch_;
     match->minBxALCT  = minBxALCT_;
     match->maxBxALCT  = maxBxALCT_;
@@ -1331,8 +1340,9 @@ GEMCSCTriggerEfficiency::analyze(const edm::Event& iEvent, const edm::EventSetup
     csc_particleType.clear();
     for (unsigned int i=0; i< match->simHits.size(); ++i)
     {
-      csc_detId.push_back((match->simHits)[i].detUnitId());
-      csc_particleType.push_back((match->simHits)[i].particleType());
+      const PSimHit & sh = match->simHit((match->simHits)[i]);
+      csc_detId.push_back(sh.detUnitId());
+      csc_particleType.push_back(sh.particleType());
     }
     
     // match ALCT digis and SimHits;
@@ -1640,6 +1650,13 @@ GEMCSCTriggerEfficiency::analyze(const edm::Event& iEvent, const edm::EventSetup
       if (eta_1b) h_pt_initial_1b->Fill(stpt);
       if (eta_gem_1b) h_pt_initial_gem_1b->Fill(stpt);
 
+      // trigger pt threshold scans: tracks without a TF candidate enter only the denominators
+      double tfc_pt_scan = match->TFCANDs.size() ? tfc->tftrack->pt : -1.;
+      if (eta_ok) eff_pt_tfcand_tfpt.fill(stpt, tfc_pt_scan);
+      if (eta_ok) eff_pt_tfcand_ok_tfpt.fill(stpt, tffid_ok ? tfc_pt_scan : -1.);
+      if (eta_ok) eff_pt_tfcand_all_ok_tfpt.fill(stpt, (match->TFCANDsAll.size() && tffidAll_ok) ? tfcAll->pt : -1.);
+      if (pt_ok) eff_eta_tfcand_tfpt.fill(steta, tfc_pt_scan);
+
       std::vector<int> chIds = match->chambersWithHits();
       std::vector<int> fillIds;
       if (pt_ok) 
@@ -2311,6 +2328,15 @@ GEMCSCTriggerEfficiency::analyze(const edm::Event& iEvent, const edm::EventSetup
 			if (ok_2s13) h_pt_after_tfcand_dphigem1b_2s13[i]->Fill(stpt);
 			if ( nTFstubsOk >= 3 )  h_pt_after_tfcand_dphigem1b_3s1b[i]->Fill(stpt);
 		      }
+
+		    unsigned wp_mask = gemDPhiPassMask(gem_dphi_odd, gem_dphi_even, tfc_pt_thr[i]);
+		    for (size_t w=0; w<gemDPhiWPs_.size(); ++w) if (wp_mask & (1u << w))
+		      {
+			h_pt_after_tfcand_dphigem1b_2s1b_wp[i][w]->Fill(stpt);
+			if (ok_2s123) h_pt_after_tfcand_dphigem1b_2s123_wp[i][w]->Fill(stpt);
+			if (ok_2s13) h_pt_after_tfcand_dphigem1b_2s13_wp[i][w]->Fill(stpt);
+			if ( nTFstubsOk >= 3 )  h_pt_after_tfcand_dphigem1b_3s1b_wp[i][w]->Fill(stpt);
+		      }
 		  }
       	    }
 	  
@@ -2501,6 +2527,8 @@ GEMCSCTriggerEfficiency::analyze(const edm::Event& iEvent, const edm::EventSetup
       	  }
       	}
 
+      if (pt_ok) eff_eta_tfcand_ok_plus_tfpt.fill(steta, (nTFstubsOk>1 && okNmplct>1) ? tfc->tftrack->pt : -1.);
+
       //============ TF All==================
  
       if (match->TFCANDsAll.size()) 
@@ -2606,6 +2634,12 @@ GEMCSCTriggerEfficiency::analyze(const edm::Event& iEvent, const edm::EventSetup
 		    {
 		      h_pt_after_gmt_dphigem1b_1mu[i]->Fill(stpt);
 		    }
+
+		  unsigned wp_mask = gemDPhiPassMask(gem_dphi_odd, gem_dphi_even, tfc_pt_thr[i]);
+		  for (size_t w=0; w<gemDPhiWPs_.size(); ++w) if (wp_mask & (1u << w))
+		    {
+		      h_pt_after_gmt_dphigem1b_1mu_wp[i][w]->Fill(stpt);
+		    }
 		}
 	      }
 	  }
@@ -2769,10 +2803,10 @@ GEMCSCTriggerEfficiency::matchSimTrack2SimHits( MatchCSCMuL1 * match,
   match->familyIds = fillSimTrackFamilyIds(match->strk->trackId(), simTracks, simVertices);
 
   // match SimHits to SimTracks
-  std::vector<PSimHit> matchingSimHits = hitsFromSimTrack(match->familyIds, theCSCSimHitMap);
+  MatchCSCMuL1::HitIndices matchingSimHits = hitIndicesFromSimTrack(match->familyIds, theCSCSimHitPool);
   for (unsigned i=0; i<matchingSimHits.size();i++) {
     if (goodChambersOnly_)
-      if ( theStripConditions->isInBadChamber( CSCDetId( matchingSimHits[i].detUnitId() ) ) ) continue; // skip 'bad' chamber
+      if ( theStripConditions->isInBadChamber( CSCDetId( theCSCSimHitPool[matchingSimHits[i]].detUnitId() ) ) ) continue; // skip 'bad' chamber
     match->addSimHit(matchingSimHits[i]);
   }
 
@@ -2799,7 +2833,7 @@ GEMCSCTriggerEfficiency::matchSimTrack2SimHits( MatchCSCMuL1 * match,
   if (debugALLEVENT) {
     std::cout<<"--- SimTrack hits: "<< match->simHits.size()<<std::endl;
     for (unsigned j=0; j<match->simHits.size(); j++) {
-      PSimHit & sh = (match->simHits)[j];
+      const PSimHit & sh = match->simHit((match->simHits)[j]);
       std::cout<<"   "<<sh<<" "<<sh.exitPoint()<<"  "<<sh.momentumAtEntry()<<" "<<sh.energyLoss()<<" "<<sh.particleType()<<" "<<sh.trackId()<<std::endl;
     }
   }
@@ -2844,8 +2878,8 @@ GEMCSCTriggerEfficiency::matchSimTrack2ALCTs(MatchCSCMuL1 *match,
 	  bool me1a_all = (defaultME1a && id.station()==1 && id.ring()==1 && (*digiIt).getKeyWG() <= 15);
 	  bool me1a_no_overlap = ( me1a_all && (*digiIt).getKeyWG() < 10 );
 
-	  std::vector<PSimHit> trackHitsInChamber = match->chamberHits(id.rawId());
-	  std::vector<PSimHit> trackHitsInChamber1a;
+	  MatchCSCMuL1::HitIndexRange trackHitsInChamber = match->chamberHits(id.rawId());
+	  MatchCSCMuL1::HitIndexRange trackHitsInChamber1a;
 	  if (me1a_all) trackHitsInChamber1a = match->chamberHits(id1a.rawId());
 
 	  if (trackHitsInChamber.size() + trackHitsInChamber1a.size() == 0 ) // no point to do any matching here
@@ -2862,7 +2896,7 @@ GEMCSCTriggerEfficiency::matchSimTrack2ALCTs(MatchCSCMuL1 *match,
 
 	  std::vector<CSCAnodeLayerInfo> alctInfo;
 	  //std::vector<CSCAnodeLayerInfo> alctInfo = alct_analyzer.getSimInfo(*digiIt, id, wiredc, allCSCSimHits);
-	  std::vector<PSimHit> matchedHits;
+	  MatchCSCMuL1::HitIndices matchedHits;
 	  unsigned nmhits = matchCSCAnodeHits(alctInfo, matchedHits);
 
 	  MatchCSCMuL1::ALCT malct(match);
@@ -2875,7 +2909,7 @@ GEMCSCTriggerEfficiency::matchSimTrack2ALCTs(MatchCSCMuL1 *match,
 	  malct.deltaOk = (minDeltaWire_ <= malct.deltaWire) & (malct.deltaWire <= maxDeltaWire_);
 
 	  std::vector<CSCAnodeLayerInfo> alctInfo1a;
-	  std::vector<PSimHit> matchedHits1a;
+	  MatchCSCMuL1::HitIndices matchedHits1a;
 	  unsigned nmhits1a = 0;
 
 	  MatchCSCMuL1::ALCT malct1a(match);
@@ -2908,8 +2942,7 @@ GEMCSCTriggerEfficiency::matchSimTrack2ALCTs(MatchCSCMuL1 *match,
 		  //                   <<matchedHits[i].momentumAtEntry()<<" "<<matchedHits[i].energyLoss()<<" "
 		  //                   <<matchedHits[i].particleType()<<" "<<matchedHits[i].trackId();
 		  //bool wasmatch = 0;
-		  for (unsigned j=0; j<trackHitsInChamber.size(); j++)
-		    if ( compareSimHits ( matchedHits[i], trackHitsInChamber[j] ) )
+		  if ( trackHitsInChamber.contains( matchedHits[i] ) )
 		      {
 			nHitsMatch++;
 			//wasmatch = 1;
@@ -2921,8 +2954,7 @@ GEMCSCTriggerEfficiency::matchSimTrack2ALCTs(MatchCSCMuL1 *match,
 		nHitsMatch = 0;
 		for (unsigned i=0; i<nmhits1a;i++) {
 		  //bool wasmatch = 0;
-		  for (unsigned j=0; j<trackHitsInChamber1a.size(); j++)
-		    if ( compareSimHits ( matchedHits1a[i], trackHitsInChamber1a[j] ) )
+		  if ( trackHitsInChamber1a.contains( matchedHits1a[i] ) )
 		      {
 			nHitsMatch++;
 			//wasmatch = 1;
@@ -2942,9 +2974,9 @@ GEMCSCTriggerEfficiency::matchSimTrack2ALCTs(MatchCSCMuL1 *match,
 	      if ( fabs(malct.deltaY)<= minDeltaYAnode_ )
 		{
 		  if (debugALCT)  for (unsigned i=0; i<trackHitsInChamber.size();i++)
-				    std::cout<<"   DY match: "<<trackHitsInChamber[i]<<" "<<trackHitsInChamber[i].exitPoint()<<"  "
-					<<trackHitsInChamber[i].momentumAtEntry()<<" "<<trackHitsInChamber[i].energyLoss()<<" "
-					<<trackHitsInChamber[i].particleType()<<" "<<trackHitsInChamber[i].trackId()<<std::endl;
+				    std::cout<<"   DY match: "<<theCSCSimHitPool[trackHitsInChamber[i]]<<" "<<theCSCSimHitPool[trackHitsInChamber[i]].exitPoint()<<"  "
+					<<theCSCSimHitPool[trackHitsInChamber[i]].momentumAtEntry()<<" "<<theCSCSimHitPool[trackHitsInChamber[i]].energyLoss()<<" "
+					<<theCSCSimHitPool[trackHitsInChamber[i]].particleType()<<" "<<theCSCSimHitPool[trackHitsInChamber[i]].trackId()<<std::endl;
   
 		  if (!me1a_no_overlap) match->ALCTs.push_back(malct);
 		  dymatch = true;
@@ -2959,9 +2991,9 @@ GEMCSCTriggerEfficiency::matchSimTrack2ALCTs(MatchCSCMuL1 *match,
 	      if ( minDeltaYAnode_ < 0  )
 		{
 		  if (debugALCT)  for (unsigned i=0; i<trackHitsInChamber.size();i++)
-				    std::cout<<"   chamber match: "<<trackHitsInChamber[i]<<" "<<trackHitsInChamber[i].exitPoint()<<"  "
-					<<trackHitsInChamber[i].momentumAtEntry()<<" "<<trackHitsInChamber[i].energyLoss()<<" "
-					<<trackHitsInChamber[i].particleType()<<" "<<trackHitsInChamber[i].trackId()<<std::endl;
+				    std::cout<<"   chamber match: "<<theCSCSimHitPool[trackHitsInChamber[i]]<<" "<<theCSCSimHitPool[trackHitsInChamber[i]].exitPoint()<<"  "
+					<<theCSCSimHitPool[trackHitsInChamber[i]].momentumAtEntry()<<" "<<theCSCSimHitPool[trackHitsInChamber[i]].energyLoss()<<" "
+					<<theCSCSimHitPool[trackHitsInChamber[i]].particleType()<<" "<<theCSCSimHitPool[trackHitsInChamber[i]].trackId()<<std::endl;
   
 		  if (!me1a_no_overlap) match->ALCTs.push_back(malct);
 		  if (me1a_all) match->ALCTs.push_back(malct1a);
@@ -3053,7 +3085,7 @@ GEMCSCTriggerEfficiency::matchSimTrack2CLCTs(MatchCSCMuL1 *match,
 	    cid = id1a;
 	  }
 
-	  std::vector<PSimHit> trackHitsInChamber = match->chamberHits(cid.rawId());
+	  MatchCSCMuL1::HitIndexRange trackHitsInChamber = match->chamberHits(cid.rawId());
 
 	  if (trackHitsInChamber.size()==0) // no point to do any matching here
 	    {
@@ -3071,7 +3103,7 @@ GEMCSCTriggerEfficiency::matchSimTrack2CLCTs(MatchCSCMuL1 *match,
 	  std::vector<CSCCathodeLayerInfo> clctInfo;
 	  //std::vector<CSCCathodeLayerInfo> clctInfo = clct_analyzer.getSimInfo(*digiIt, cid, compdc, allCSCSimHits);
 
-	  std::vector<PSimHit> matchedHits;
+	  MatchCSCMuL1::HitIndices matchedHits;
 	  unsigned nmhits = matchCSCCathodeHits(clctInfo, matchedHits);
 
 	  MatchCSCMuL1::CLCT mclct(match);
@@ -3099,8 +3131,7 @@ GEMCSCTriggerEfficiency::matchSimTrack2CLCTs(MatchCSCMuL1 *match,
 		  //                   <<matchedHits[i].momentumAtEntry()<<" "<<matchedHits[i].energyLoss()<<" "
 		  //                   <<matchedHits[i].particleType()<<" "<<matchedHits[i].trackId();
 		  //bool wasmatch = 0;
-		  for (unsigned j=0; j<trackHitsInChamber.size(); j++)
-		    if ( compareSimHits ( matchedHits[i], trackHitsInChamber[j] ) )
+		  if ( trackHitsInChamber.contains( matchedHits[i] ) )
 		      {
 			nHitsMatch++;
 			//wasmatch = 1;
@@ -3118,9 +3149,9 @@ GEMCSCTriggerEfficiency::matchSimTrack2CLCTs(MatchCSCMuL1 *match,
 	      if ( fabs(mclct.deltaY)<= minDeltaYCathode_)
 		{
 		  if (debugCLCT)  for (unsigned i=0; i<trackHitsInChamber.size();i++)
-				    std::cout<<"   DY match: "<<trackHitsInChamber[i]<<" "<<trackHitsInChamber[i].exitPoint()<<"  "
-					<<trackHitsInChamber[i].momentumAtEntry()<<" "<<trackHitsInChamber[i].energyLoss()<<" "
-					<<trackHitsInChamber[i].particleType()<<" "<<trackHitsInChamber[i].trackId()<<std::endl;
+				    std::cout<<"   DY match: "<<theCSCSimHitPool[trackHitsInChamber[i]]<<" "<<theCSCSimHitPool[trackHitsInChamber[i]].exitPoint()<<"  "
+					<<theCSCSimHitPool[trackHitsInChamber[i]].momentumAtEntry()<<" "<<theCSCSimHitPool[trackHitsInChamber[i]].energyLoss()<<" "
+					<<theCSCSimHitPool[trackHitsInChamber[i]].particleType()<<" "<<theCSCSimHitPool[trackHitsInChamber[i]].trackId()<<std::endl;
   
 		  match->CLCTs.push_back(mclct);
 		  continue;
@@ -3128,9 +3159,9 @@ GEMCSCTriggerEfficiency::matchSimTrack2CLCTs(MatchCSCMuL1 *match,
 	      if ( minDeltaYCathode_ < 0  )
 		{
 		  if (debugCLCT)  for (unsigned i=0; i<trackHitsInChamber.size();i++)
-				    std::cout<<"   chamber match: "<<trackHitsInChamber[i]<<" "<<trackHitsInChamber[i].exitPoint()<<"  "
-					<<trackHitsInChamber[i].momentumAtEntry()<<" "<<trackHitsInChamber[i].energyLoss()<<" "
-					<<trackHitsInChamber[i].particleType()<<" "<<trackHitsInChamber[i].trackId()<<std::endl;
+				    std::cout<<"   chamber match: "<<theCSCSimHitPool[trackHitsInChamber[i]]<<" "<<theCSCSimHitPool[trackHitsInChamber[i]].exitPoint()<<"  "
+					<<theCSCSimHitPool[trackHitsInChamber[i]].momentumAtEntry()<<" "<<theCSCSimHitPool[trackHitsInChamber[i]].energyLoss()<<" "
+					<<theCSCSimHitPool[trackHitsInChamber[i]].particleType()<<" "<<theCSCSimHitPool[trackHitsInChamber[i]].trackId()<<std::endl;
   
 		  match->CLCTs.push_back(mclct);
 		  continue;
@@ -3925,67 +3956,22 @@ GEMCSCTriggerEfficiency::fillSimTrackFamilyIds(unsigned  id,
 
 
 // ================================================================================================
-std::vector<PSimHit> 
-GEMCSCTriggerEfficiency::hitsFromSimTrack(std::vector<unsigned> ids, SimHitAnalysis::PSimHitMap &hitMap)
+MatchCSCMuL1::HitIndices
+GEMCSCTriggerEfficiency::hitIndicesFromSimTrack(const std::vector<unsigned> & ids, const SimHitAnalysis::PSimHitPool &hitPool)
 {
-  int fdebug = 0;
-  
-  std::vector<PSimHit> result;
-
-  if (fdebug)  std::cout<<"--- hitsFromSimTrack std::vector size "<<ids.size()<<std::endl;
+  // hits ordered by family id, then by detId, then as in the event
+  MatchCSCMuL1::HitIndices result;
+  SimHitAnalysis::PSimHitPool::IndexRange all = hitPool.all();
 
   for (size_t id = 0; id < ids.size(); id++)
-    {
-      std::vector<PSimHit> resultd = hitsFromSimTrack(ids[id], hitMap);
-      result.insert(result.end(), resultd.begin(), resultd.end());
-      if (fdebug)  std::cout<<"  --- n "<<id<<" id "<<ids[id]<<" size "<<resultd.size()<<std::endl;
-    }
-  return result;
-}
-
-
-
-// ================================================================================================
-std::vector<PSimHit> 
-GEMCSCTriggerEfficiency::hitsFromSimTrack(unsigned id, SimHitAnalysis::PSimHitMap &hitMap)
-{
-  int fdebug = 0;
-  
-  std::vector<PSimHit> result;
-  std::vector<int> detIds = hitMap.detsWithHits();
-
-  if (fdebug)  std::cout<<"---- hitsFromSimTrack id "<<id<<std::endl;
-  
-  for (size_t di = 0; di < detIds.size(); di++)
-    {
-      std::vector<PSimHit> resultd = hitsFromSimTrack(id, detIds[di], hitMap);
-      result.insert(result.end(), resultd.begin(), resultd.end());
-      if (fdebug)  std::cout<<"  ---- det "<<detIds[di]<<" size "<<resultd.size()<<std::endl;
-    }
-  return result;
-}
-
-
-// ================================================================================================
-std::vector<PSimHit> 
-GEMCSCTriggerEfficiency::hitsFromSimTrack(unsigned id, int detId, SimHitAnalysis::PSimHitMap &hitMap)
-{
-  int fdebug = 0;
-
-  std::vector<PSimHit> result;
-
-  CSCDetId chId(detId);
-  if ( chId.station() == 1 && chId.ring() == 4 && !doME1a_) return result;
-
-  edm::PSimHitContainer hits = hitMap.hits(detId);
-  
-  for(size_t h = 0; h< hits.size(); h++) if(hits[h].trackId() == id)
-					   {
-					     result.push_back(hits[h]);
-
-					     if (fdebug)  std::cout<<"   --- "<<detId<<" -> "<< hits[h] <<" "<<hits[h].exitPoint()<<" "<<hits[h].momentumAtEntry()<<" "<<hits[h].energyLoss()<<" "<<hits[h].particleType()<<" "<<hits[h].trackId()<<std::endl;
-					   }
-
+    for (SimHitAnalysis::PSimHitPool::IndexRange::const_iterator h = all.begin(); h != all.end(); ++h)
+      {
+	const PSimHit & hit = hitPool[*h];
+	if (hit.trackId() != ids[id]) continue;
+	CSCDetId chId(hit.detUnitId());
+	if ( chId.station() == 1 && chId.ring() == 4 && !doME1a_) continue;
+	result.push_back(*h);
+      }
   return result;
 }
 
@@ -3995,10 +3981,10 @@ int
 GEMCSCTriggerEfficiency::particleType(int simTrack) 
 {
   int result = 0;
-  std::vector<PSimHit> hits = hitsFromSimTrack(simTrack,theCSCSimHitMap);
+  MatchCSCMuL1::HitIndices hits = hitIndicesFromSimTrack(std::vector<unsigned>(1, simTrack), theCSCSimHitPool);
   //if(hits.empty())  hits = dtHitsFromSimTrack(simTrack);
   //if(hits.empty())  hits = rpcHitsFromSimTrack(simTrack);
-  if(!hits.empty())  result = hits[0].particleType();
+  if(!hits.empty())  result = theCSCSimHitPool[hits[0]].particleType();
   return result;
 }
 
@@ -4072,8 +4058,11 @@ GEMCSCTriggerEfficiency::matchCSCAnodeHits(const std::vector<CSCAnodeLayerInfo>&
 		  for (unsigned i = 0; i < thisLayerHits.size(); i++) 
 		    std::cout<<"      SimHit # " << i <<": "<< thisLayerHits[i] << "\n";
 		}
-	      matchedHit.push_back(thisLayerHits[0]);
-	      nhits++;
+	      MatchCSCMuL1::HitIndex idx = theCSCSimHitPool.find(thisLayerHits[0]);
+	      if (idx != SimHitAnalysis::PSimHitPool::invalidIndex) {
+		matchedHit.push_back(idx);
+		nhits++;
+	      }
 	      break;
 	    }
 	}
@@ -4097,8 +4086,12 @@ GEMCSCTriggerEfficiency::matchCSCAnodeHits(const std::vector<CSCAnodeLayerInfo>&
 	  //    std::cout<<"   "<<thisLayerHits[i]<<" "<<thisLayerHits[i].exitPoint()<<"  "<<thisLayerHits[i].momentumAtEntry()
 	  //        <<" "<<thisLayerHits[i].energyLoss()<<" "<<thisLayerHits[i].particleType()<<" "<<thisLayerHits[i].trackId()<<std::endl;
 	  //}
-	  matchedHit.insert(matchedHit.end(), thisLayerHits.begin(), thisLayerHits.end());
-	  nhits += thisLayerHits.size();
+	  for (unsigned i = 0; i < thisLayerHits.size(); i++) {
+	    MatchCSCMuL1::HitIndex idx = theCSCSimHitPool.find(thisLayerHits[i]);
+	    if (idx == SimHitAnalysis::PSimHitPool::invalidIndex) continue;
+	    matchedHit.push_back(idx);
+	    nhits++;
+	  }
 	}
     }
   
@@ -4142,8 +4135,11 @@ GEMCSCTriggerEfficiency::matchCSCCathodeHits(const std::vector<CSCCathodeLayerIn
 		  for (unsigned i = 0; i < thisLayerHits.size(); i++) 
 		    std::cout<<"      SimHit # " << i <<": "<< thisLayerHits[i] << "\n";
 		}
-	      matchedHit.push_back(thisLayerHits[0]);
-	      nhits++;
+	      MatchCSCMuL1::HitIndex idx = theCSCSimHitPool.find(thisLayerHits[0]);
+	      if (idx != SimHitAnalysis::PSimHitPool::invalidIndex) {
+		matchedHit.push_back(idx);
+		nhits++;
+	      }
 	      break;
 	    }
 	}
@@ -4167,8 +4163,12 @@ GEMCSCTriggerEfficiency::matchCSCCathodeHits(const std::vector<CSCCathodeLayerIn
 	  //    std::cout<<"   "<<thisLayerHits[i]<<" "<<thisLayerHits[i].exitPoint()<<"  "<<thisLayerHits[i].momentumAtEntry()
 	  //        <<" "<<thisLayerHits[i].energyLoss()<<" "<<thisLayerHits[i].particleType()<<" "<<thisLayerHits[i].trackId()<<std::endl;
 	  //}
-	  matchedHit.insert(matchedHit.end(), thisLayerHits.begin(), thisLayerHits.end());
-	  nhits += thisLayerHits.size();
+	  for (unsigned i = 0; i < thisLayerHits.size(); i++) {
+	    MatchCSCMuL1::HitIndex idx = theCSCSimHitPool.find(thisLayerHits[i]);
+	    if (idx == SimHitAnalysis::PSimHitPool::invalidIndex) continue;
+	    matchedHit.push_back(idx);
+	    nhits++;
+	  }
 	}
     }
   
@@ -4568,21 +4568,20 @@ GEMCSCTriggerEfficiency::buildTrackStub(const CSCCorrelatedLCTDigi &d, CSCDetId
 bool 
 GEMCSCTriggerEfficiency::isGEMDPhiGood(double dphi, double tfpt, int is_odd)
 {
-  // ignore the default/don't-care value of -99
-  if (dphi < 9.) return true;
-
-  // the no-matching-gem case value of +99
-  if (dphi > 9.) return false;
-
-  // find the first gemPTs_ element that is LARGER then tfpt
-  auto ub = upper_bound(gemPTs_.begin(), gemPTs_.end(), tfpt);
-  // adjust to get the largest gemPTs_ element that is smaller or equal to tfpt
-  if (ub != gemPTs_.begin()) --ub;
+  return gemDPhiCuts_.isGood(dphi, tfpt, is_odd);
+}
 
-  // the index in the vector
-  size_t n = ub - gemPTs_.begin();
 
-  return is_odd ? (dphi <= gemDPhisOdd_[n]) : (dphi <= gemDPhisEven_[n]);
+// ================================================================================================
+unsigned
+GEMCSCTriggerEfficiency::gemDPhiPassMask(double dphi_odd, double dphi_even, double tfpt)
+{
+  // same logic as for the main cut, for all the working points at once
+  if (dphi_odd < -99. && dphi_even < 99.) return GEMDPhiCuts::allMask(gemDPhiWPs_);
+  unsigned mask = 0;
+  if (dphi_odd  > -9.) mask |= GEMDPhiCuts::passMask(gemDPhiWPs_, dphi_odd, tfpt, true);
+  if (dphi_even > -9.) mask |= GEMDPhiCuts::passMask(gemDPhiWPs_, dphi_even, tfpt, false);
+  return mask;
 }
 
 
@@ -4593,7 +4592,18 @@ GEMCSCTriggerEfficiency::beginJob() {}
 
 // ================================================================================================
 void 
-GEMCSCTriggerEfficiency::endJob() {}
+GEMCSCTriggerEfficiency::endJob()
+{
+  if (!lazyHistogramBooking_) histos_.bookAll();
+  std::cout<<"GEMCSCTriggerEfficiency: booked "<<histos_.nBooked()<<" out of "<<histos_.nDeclared()<<" declared histograms"<<std::endl;
+
+  edm::Service<TFileService> fs;
+  eff_pt_tfcand_tfpt.book(*fs);
+  eff_pt_tfcand_ok_tfpt.book(*fs);
+  eff_pt_tfcand_all_ok_tfpt.book(*fs);
+  eff_eta_tfcand_tfpt.book(*fs);
+  eff_eta_tfcand_ok_plus_tfpt.book(*fs);
+}
 
 
 //define this as a plug-in
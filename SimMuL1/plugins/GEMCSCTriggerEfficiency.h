@@ -64,6 +64,10 @@
 
 //#include "SimMuon/MCTruth/interface/PSimHitMap.h"
 #include "GEMCode/SimMuL1/interface/PSimHitMap.h"
+#include "GEMCode/SimMuL1/interface/PSimHitPool.h"
+#include "GEMCode/SimMuL1/interface/ThresholdEfficiency.h"
+#include "GEMCode/SimMuL1/interface/HistoRegistry.h"
+#include "GEMCode/SimMuL1/interface/GEMDPhiCuts.h"
 
 #include "GEMCode/SimMuL1/interface/MatchCSCMuL1.h"
 
@@ -111,9 +115,7 @@ public:
   std::vector<unsigned> fillSimTrackFamilyIds(unsigned  index,
              const edm::SimTrackContainer & simTracks, const edm::SimVertexContainer & simVertices);
 
-  std::vector<PSimHit> hitsFromSimTrack(std::vector<unsigned> ids, SimHitAnalysis::PSimHitMap &hitMap);
-  std::vector<PSimHit> hitsFromSimTrack(unsigned  id, SimHitAnalysis::PSimHitMap &hitMap);
-  std::vector<PSimHit> hitsFromSimTrack(unsigned  id, int detId, SimHitAnalysis::PSimHitMap &hitMap);
+  MatchCSCMuL1::HitIndices hitIndicesFromSimTrack(const std::vector<unsigned> & ids, const SimHitAnalysis::PSimHitPool &hitPool);
 
   int particleType(int simTrack);
     
@@ -128,11 +130,11 @@ public:
 
   unsigned matchCSCAnodeHits(
              const std::vector<CSCAnodeLayerInfo>& allLayerInfo, 
-             std::vector<PSimHit> &matchedHit) ;
+             MatchCSCMuL1::HitIndices &matchedHit) ;
 
   unsigned matchCSCCathodeHits(
              const std::vector<CSCCathodeLayerInfo>& allLayerInfo, 
-             std::vector<PSimHit> &matchedHit) ;
+             MatchCSCMuL1::HitIndices &matchedHit) ;
 
   void matchSimTrack2ALCTs( MatchCSCMuL1 *match, 
              const edm::PSimHitContainer* allCSCSimHits, 
@@ -230,10 +232,13 @@ private:
   edm::ESHandle< L1MuTriggerScales > muScales;
   edm::ESHandle< L1MuTriggerPtScale > muPtScale;
 
+  HistoRegistry histos_;
+
 // config parameters:
 
   bool lightRun;
   bool defaultME1a;
+  bool lazyHistogramBooking_;
 
   bool doStrictSimHitToTrackMatch_;
   bool matchAllTrigPrimitivesInChamber_;
@@ -311,16 +316,23 @@ private:
   const GEMGeometry* gemGeometry;
 
   edm::ParameterSet gemMatchCfg_;
-  std::vector<double> gemPTs_, gemDPhisOdd_, gemDPhisEven_;
+  GEMDPhiCuts gemDPhiCuts_;
 
   bool isGEMDPhiGood(double dphi, double tfpt, int is_odd);
 
+  // additional GEM dphi working points, each with its own set of the dphigem1b histograms
+  std::vector<GEMDPhiCuts> gemDPhiWPs_;
+
+  // bits of the working points passed by the best odd and even ME1/b dphi's of a track
+  unsigned gemDPhiPassMask(double dphi_odd, double dphi_even, double tfpt);
+
 // simhits for matching to simtracks:
   bool simHitsFromCrossingFrame_;
   std::string simHitsModuleName_;
   std::string simHitsCollectionName_;
 
-  SimHitAnalysis::PSimHitMap theCSCSimHitMap;
+  // event-level pool that MatchCSCMuL1 objects index into
+  SimHitAnalysis::PSimHitPool theCSCSimHitPool;
   //SimHitAnalysis::PSimHitMap theDTSimHitMap;
   //SimHitAnalysis::PSimHitMap theRPCSimHitMap;
 
@@ -336,53 +348,53 @@ private:
 
   int nevt;
 
-  TH1D * h_N_mctr;
-  TH1D * h_N_simtr;
+  LazyTH1D * h_N_mctr;
+  LazyTH1D * h_N_simtr;
 
-  TH1D * h_pt_mctr;
-  TH1D * h_eta_mctr;
-  TH1D * h_phi_mctr;
+  LazyTH1D * h_pt_mctr;
+  LazyTH1D * h_eta_mctr;
+  LazyTH1D * h_phi_mctr;
 
-  TH1D * h_DR_mctr_simtr; 
-  TH1D * h_MinDR_mctr_simtr; 
+  LazyTH1D * h_DR_mctr_simtr; 
+  LazyTH1D * h_MinDR_mctr_simtr; 
 
-  TH1D * h_DR_2SimTr;
-  TH1D * h_DR_2SimTr_looked;
-  TH1D * h_DR_2SimTr_after_mpc_ok_plus;
-  TH1D * h_DR_2SimTr_after_tfcand_ok_plus;
+  LazyTH1D * h_DR_2SimTr;
+  LazyTH1D * h_DR_2SimTr_looked;
+  LazyTH1D * h_DR_2SimTr_after_mpc_ok_plus;
+  LazyTH1D * h_DR_2SimTr_after_tfcand_ok_plus;
 
-  TH2D * h_csctype_vs_alct_occup;
-  TH2D * h_csctype_vs_clct_occup;
+  LazyTH2D * h_csctype_vs_alct_occup;
+  LazyTH2D * h_csctype_vs_clct_occup;
   
-  TH2D * h_eta_vs_nalct;
-  TH2D * h_eta_vs_nclct;
-  TH2D * h_eta_vs_nlct;
-  TH2D * h_eta_vs_nmplct;
+  LazyTH2D * h_eta_vs_nalct;
+  LazyTH2D * h_eta_vs_nclct;
+  LazyTH2D * h_eta_vs_nlct;
+  LazyTH2D * h_eta_vs_nmplct;
   
-  TH2D * h_pt_vs_nalct;
-  TH2D * h_pt_vs_nclct;
-  TH2D * h_pt_vs_nlct;
-  TH2D * h_pt_vs_nmplct;
+  LazyTH2D * h_pt_vs_nalct;
+  LazyTH2D * h_pt_vs_nclct;
+  LazyTH2D * h_pt_vs_nlct;
+  LazyTH2D * h_pt_vs_nmplct;
   
-  TH2D * h_csctype_vs_nlct;
-  TH2D * h_csctype_vs_nmplct;
+  LazyTH2D * h_csctype_vs_nlct;
+  LazyTH2D * h_csctype_vs_nmplct;
 
-  TH2D * h_eta_vs_nalct_cscstation[MAX_STATIONS];
-  TH2D * h_eta_vs_nclct_cscstation[MAX_STATIONS];
-  TH2D * h_eta_vs_nlct_cscstation[MAX_STATIONS];
+  LazyTH2D * h_eta_vs_nalct_cscstation[MAX_STATIONS];
+  LazyTH2D * h_eta_vs_nclct_cscstation[MAX_STATIONS];
+  LazyTH2D * h_eta_vs_nlct_cscstation[MAX_STATIONS];
 
-  TH2D * h_eta_vs_nalct_cscstation_ok[MAX_STATIONS];
-  TH2D * h_eta_vs_nclct_cscstation_ok[MAX_STATIONS];
-  TH2D * h_eta_vs_nlct_cscstation_ok[MAX_STATIONS];
+  LazyTH2D * h_eta_vs_nalct_cscstation_ok[MAX_STATIONS];
+  LazyTH2D * h_eta_vs_nclct_cscstation_ok[MAX_STATIONS];
+  LazyTH2D * h_eta_vs_nlct_cscstation_ok[MAX_STATIONS];
   
-  TH2D * h_nmusimhits_vs_nalct_cscdet[CSC_TYPES];
-  TH2D * h_nmusimhits_vs_nclct_cscdet[CSC_TYPES];
-  TH2D * h_nmusimhits_vs_nlct_cscdet[CSC_TYPES];
+  LazyTH2D * h_nmusimhits_vs_nalct_cscdet[CSC_TYPES];
+  LazyTH2D * h_nmusimhits_vs_nclct_cscdet[CSC_TYPES];
+  LazyTH2D * h_nmusimhits_vs_nlct_cscdet[CSC_TYPES];
 
-  TH1D * h_deltaY__alct_cscdet[CSC_TYPES];
-  TH1D * h_deltaY__clct_cscdet[CSC_TYPES];
-  TH1D * h_deltaPhi__alct_cscdet[CSC_TYPES];
-  TH1D * h_deltaPhi__clct_cscdet[CSC_TYPES];
+  LazyTH1D * h_deltaY__alct_cscdet[CSC_TYPES];
+  LazyTH1D * h_deltaY__clct_cscdet[CSC_TYPES];
+  LazyTH1D * h_deltaPhi__alct_cscdet[CSC_TYPES];
+  LazyTH1D * h_deltaPhi__clct_cscdet[CSC_TYPES];
 
 //  TH1D * h_deltaY__alct_cscdet_nl[CSC_TYPES][7];
 //  TH1D * h_deltaY__clct_cscdet_nl[CSC_TYPES][7];
@@ -390,610 +402,612 @@ private:
 //  TH1D * h_deltaPhi__clct_cscdet_nl[CSC_TYPES][7];
 
 
-  TH2D * h_ov_nmusimhits_vs_nalct_cscdet[CSC_TYPES];
-  TH2D * h_ov_nmusimhits_vs_nclct_cscdet[CSC_TYPES];
-  TH2D * h_ov_nmusimhits_vs_nlct_cscdet[CSC_TYPES];
+  LazyTH2D * h_ov_nmusimhits_vs_nalct_cscdet[CSC_TYPES];
+  LazyTH2D * h_ov_nmusimhits_vs_nclct_cscdet[CSC_TYPES];
+  LazyTH2D * h_ov_nmusimhits_vs_nlct_cscdet[CSC_TYPES];
 
-  TH1D * h_ov_deltaY__alct_cscdet[CSC_TYPES];
-  TH1D * h_ov_deltaY__clct_cscdet[CSC_TYPES];
-  TH1D * h_ov_deltaPhi__alct_cscdet[CSC_TYPES];
-  TH1D * h_ov_deltaPhi__clct_cscdet[CSC_TYPES];
+  LazyTH1D * h_ov_deltaY__alct_cscdet[CSC_TYPES];
+  LazyTH1D * h_ov_deltaY__clct_cscdet[CSC_TYPES];
+  LazyTH1D * h_ov_deltaPhi__alct_cscdet[CSC_TYPES];
+  LazyTH1D * h_ov_deltaPhi__clct_cscdet[CSC_TYPES];
 
 //  TH1D * h_ov_deltaY__alct_cscdet_nl[CSC_TYPES][7];
 //  TH1D * h_ov_deltaY__clct_cscdet_nl[CSC_TYPES][7];
 //  TH1D * h_ov_deltaPhi__alct_cscdet_nl[CSC_TYPES][7];
 //  TH1D * h_ov_deltaPhi__clct_cscdet_nl[CSC_TYPES][7];
 
-  TH1D * h_delta__wire_cscdet[CSC_TYPES];
-  TH1D * h_delta__strip_cscdet[CSC_TYPES];
+  LazyTH1D * h_delta__wire_cscdet[CSC_TYPES];
+  LazyTH1D * h_delta__strip_cscdet[CSC_TYPES];
 
-  TH1D * h_ov_delta__wire_cscdet[CSC_TYPES];
-  TH1D * h_ov_delta__strip_cscdet[CSC_TYPES];
+  LazyTH1D * h_ov_delta__wire_cscdet[CSC_TYPES];
+  LazyTH1D * h_ov_delta__strip_cscdet[CSC_TYPES];
 
-  TH1D * h_bx__alct_cscdet[CSC_TYPES];
-  TH1D * h_bx__clct_cscdet[CSC_TYPES];
-  TH1D * h_bx__lct_cscdet[CSC_TYPES];
-  TH1D * h_bx__mpc_cscdet[CSC_TYPES];
+  LazyTH1D * h_bx__alct_cscdet[CSC_TYPES];
+  LazyTH1D * h_bx__clct_cscdet[CSC_TYPES];
+  LazyTH1D * h_bx__lct_cscdet[CSC_TYPES];
+  LazyTH1D * h_bx__mpc_cscdet[CSC_TYPES];
 
-  TH2D * h_bx_lct__alct_vs_clct_cscdet[CSC_TYPES];
+  LazyTH2D * h_bx_lct__alct_vs_clct_cscdet[CSC_TYPES];
 
-  TH1D * h_bx_min__alct_cscdet[CSC_TYPES];
-  TH1D * h_bx_min__clct_cscdet[CSC_TYPES];
-  TH1D * h_bx_min__lct_cscdet[CSC_TYPES];
-  TH1D * h_bx_min__mpc_cscdet[CSC_TYPES];
+  LazyTH1D * h_bx_min__alct_cscdet[CSC_TYPES];
+  LazyTH1D * h_bx_min__clct_cscdet[CSC_TYPES];
+  LazyTH1D * h_bx_min__lct_cscdet[CSC_TYPES];
+  LazyTH1D * h_bx_min__mpc_cscdet[CSC_TYPES];
 
-  TH1D * h_bx__alctOk_cscdet[CSC_TYPES];
-  TH1D * h_bx__clctOk_cscdet[CSC_TYPES];
+  LazyTH1D * h_bx__alctOk_cscdet[CSC_TYPES];
+  LazyTH1D * h_bx__clctOk_cscdet[CSC_TYPES];
   
-  TH1D * h_bx__alctOkBest_cscdet[CSC_TYPES];
-  TH1D * h_bx__clctOkBest_cscdet[CSC_TYPES];
+  LazyTH1D * h_bx__alctOkBest_cscdet[CSC_TYPES];
+  LazyTH1D * h_bx__clctOkBest_cscdet[CSC_TYPES];
 
-  TH2D * h_wg_vs_bx__alctOkBest_cscdet[CSC_TYPES];
+  LazyTH2D * h_wg_vs_bx__alctOkBest_cscdet[CSC_TYPES];
 
-  TH1D * h_bxf__alct_cscdet[CSC_TYPES];
-  TH1D * h_bxf__clct_cscdet[CSC_TYPES];
-  TH1D * h_bxf__alctOk_cscdet[CSC_TYPES];
-  TH1D * h_bxf__clctOk_cscdet[CSC_TYPES];
+  LazyTH1D * h_bxf__alct_cscdet[CSC_TYPES];
+  LazyTH1D * h_bxf__clct_cscdet[CSC_TYPES];
+  LazyTH1D * h_bxf__alctOk_cscdet[CSC_TYPES];
+  LazyTH1D * h_bxf__clctOk_cscdet[CSC_TYPES];
 
-  TH1D * h_dbxbxf__alct_cscdet[CSC_TYPES];
-  TH1D * h_dbxbxf__clct_cscdet[CSC_TYPES];
+  LazyTH1D * h_dbxbxf__alct_cscdet[CSC_TYPES];
+  LazyTH1D * h_dbxbxf__clct_cscdet[CSC_TYPES];
 
-  TH2D * h_bx_me11nomatchclct_alct_vs_clct;
-  TH2D * h_bx_me11nomatchalct_alct_vs_clct;
+  LazyTH2D * h_bx_me11nomatchclct_alct_vs_clct;
+  LazyTH2D * h_bx_me11nomatchalct_alct_vs_clct;
 
-  TH2D * h_bx_me1_aclct_ok_lct_no__bx_alct_vs_dbx_ACLCT;
+  LazyTH2D * h_bx_me1_aclct_ok_lct_no__bx_alct_vs_dbx_ACLCT;
 
-  TH2D * h_nMplct_vs_nDigiMplct;
-  TH2D * h_qu_vs_nDigiMplct;
+  LazyTH2D * h_nMplct_vs_nDigiMplct;
+  LazyTH2D * h_qu_vs_nDigiMplct;
 
-  TH2D * h_ntftrackall_vs_ntftrack;
-  TH2D * h_ntfcandall_vs_ntfcand;
+  LazyTH2D * h_ntftrackall_vs_ntftrack;
+  LazyTH2D * h_ntfcandall_vs_ntfcand;
 
-  TH2D * h_eta_vs_ntfcand;
-  TH2D * h_pt_vs_ntfcand;
+  LazyTH2D * h_eta_vs_ntfcand;
+  LazyTH2D * h_pt_vs_ntfcand;
 
-  TH2D * h_pt_vs_qu;
-  TH2D * h_eta_vs_qu;
+  LazyTH2D * h_pt_vs_qu;
+  LazyTH2D * h_eta_vs_qu;
   
-  TH1D * h_cscdet_of_chamber;
-  TH1D * h_cscdet_of_chamber_w_alct;
-  TH1D * h_cscdet_of_chamber_w_clct;
-  TH1D * h_cscdet_of_chamber_w_mplct;
+  LazyTH1D * h_cscdet_of_chamber;
+  LazyTH1D * h_cscdet_of_chamber_w_alct;
+  LazyTH1D * h_cscdet_of_chamber_w_clct;
+  LazyTH1D * h_cscdet_of_chamber_w_mplct;
 
 
 
-  TH1D * h_pt_initial0;
-  TH1D * h_pt_initial;
-  TH1D * h_pt_initial_1b;
-  TH1D * h_pt_initial_gem_1b;
+  LazyTH1D * h_pt_initial0;
+  LazyTH1D * h_pt_initial;
+  LazyTH1D * h_pt_initial_1b;
+  LazyTH1D * h_pt_initial_gem_1b;
   
-  TH1D * h_pt_me1_initial;
-  TH1D * h_pt_me2_initial;
-  TH1D * h_pt_me3_initial;
-  TH1D * h_pt_me4_initial;
-
-  TH1D * h_pt_initial_1st;
-  TH1D * h_pt_initial_2st;
-  TH1D * h_pt_initial_3st;
-
-  TH1D * h_pt_me1_initial_2st;
-  TH1D * h_pt_me1_initial_3st;
-
-
-  TH1D * h_pt_gem_1b;
-  TH1D * h_pt_lctgem_1b;
-
-  TH1D * h_pt_me1_mpc;
-  TH1D * h_pt_me2_mpc;
-  TH1D * h_pt_me3_mpc;
-  TH1D * h_pt_me4_mpc;
-
-  TH1D * h_pt_mpc_1st;
-  TH1D * h_pt_mpc_2st;
-  TH1D * h_pt_mpc_3st;
-
-  TH1D * h_pt_me1_mpc_2st;
-  TH1D * h_pt_me1_mpc_3st;
-
-  TH1D * h_pt_tf_initial0_tfpt[N_PT_THRESHOLDS];
-  TH1D * h_pt_tf_initial_tfpt[N_PT_THRESHOLDS];
-  TH1D * h_pt_tf_stubs222_tfpt[N_PT_THRESHOLDS];
-  TH1D * h_pt_tf_stubs223_tfpt[N_PT_THRESHOLDS];
-  TH1D * h_pt_tf_stubs233_tfpt[N_PT_THRESHOLDS];
-
-
-  TH1D * h_pt_after_alct;
-  TH1D * h_pt_after_clct;
-  TH1D * h_pt_after_lct;
-  TH1D * h_pt_after_mpc;
-  TH1D * h_pt_after_mpc_ok_plus;
-  TH1D * h_pt_after_tftrack;
-  TH1D * h_pt_after_tfcand;
-  TH1D * h_pt_after_tfcand_pt10;
-  TH1D * h_pt_after_tfcand_pt20;
-  TH1D * h_pt_after_tfcand_pt40;
-  TH1D * h_pt_after_tfcand_pt60;
-
-  TH1D * h_pt_after_tfcand_ok;
-  TH1D * h_pt_after_tfcand_pt10_ok;
-  TH1D * h_pt_after_tfcand_pt20_ok;
-  TH1D * h_pt_after_tfcand_pt40_ok;
-  TH1D * h_pt_after_tfcand_pt60_ok;
-
-  TH1D * h_pt_after_tfcand_ok_plus;
-  TH1D * h_pt_after_tfcand_ok_plus_pt10;
-  TH1D * h_pt_after_tfcand_ok_plus_q[3];
-  TH1D * h_pt_after_tfcand_ok_plus_pt10_q[3];
-
-  TH1D * h_pt_after_tfcand_all;
-  TH1D * h_pt_after_tfcand_all_ok;
-  TH1D * h_pt_after_tfcand_all_pt10_ok;
-  TH1D * h_pt_after_tfcand_all_pt20_ok;
-  TH1D * h_pt_after_tfcand_all_pt40_ok;
-  TH1D * h_pt_after_tfcand_all_pt60_ok;
-
-
-  TH1D * h_pt_after_tfcand_eta1b_2s[7];
-  TH1D * h_pt_after_tfcand_eta1b_2s1b[7];
-  TH1D * h_pt_after_tfcand_eta1b_2s123[7];
-  TH1D * h_pt_after_tfcand_eta1b_2s13[7];
-  TH1D * h_pt_after_tfcand_eta1b_3s[7];
-  TH1D * h_pt_after_tfcand_eta1b_3s1b[7];
-  TH1D * h_pt_after_tfcand_gem1b_2s1b[7];
-  TH1D * h_pt_after_tfcand_gem1b_2s123[7];
-  TH1D * h_pt_after_tfcand_gem1b_2s13[7];
-  TH1D * h_pt_after_tfcand_gem1b_3s1b[7];
-  TH1D * h_pt_after_tfcand_dphigem1b_2s1b[7];
-  TH1D * h_pt_after_tfcand_dphigem1b_2s123[7];
-  TH1D * h_pt_after_tfcand_dphigem1b_2s13[7];
-  TH1D * h_pt_after_tfcand_dphigem1b_3s1b[7];
-
-  TH1D * h_mode_tfcand_gem1b_2s1b_1b[7];
-
-
-  TH1D * h_pt_after_gmtreg;
-  TH1D * h_pt_after_gmtreg_all;
-  TH1D * h_pt_after_gmtreg_dr;
-  TH1D * h_pt_after_gmt;
-  TH1D * h_pt_after_gmt_all;
-  TH1D * h_pt_after_gmt_dr;
-  TH1D * h_pt_after_gmt_dr_nocsc;
-  TH1D * h_pt_after_gmtreg_pt10;
-  TH1D * h_pt_after_gmtreg_all_pt10;
-  TH1D * h_pt_after_gmtreg_dr_pt10;
-  TH1D * h_pt_after_gmt_pt10;
-  TH1D * h_pt_after_gmt_all_pt10;
-  TH1D * h_pt_after_gmt_dr_pt10;
-  TH1D * h_pt_after_gmt_dr_nocsc_pt10;
-
-  TH1D * h_pt_after_gmt_eta1b_1mu[7];
-  TH1D * h_pt_after_gmt_gem1b_1mu[7];
-  TH1D * h_pt_after_gmt_dphigem1b_1mu[7];
-
-  TH1D * h_pt_after_xtra;
-  TH1D * h_pt_after_xtra_all;
-  TH1D * h_pt_after_xtra_dr;
-  TH1D * h_pt_after_xtra_pt10;
-  TH1D * h_pt_after_xtra_all_pt10;
-  TH1D * h_pt_after_xtra_dr_pt10;
-
-  TH1D * h_pt_me1_after_mpc_ok_plus;
-  TH1D * h_pt_me1_after_tf_ok_plus;
-  TH1D * h_pt_me1_after_tf_ok_plus_pt10;
-  TH1D * h_pt_me1_after_tf_ok_plus_q[3];
-  TH1D * h_pt_me1_after_tf_ok_plus_pt10_q[3];
+  LazyTH1D * h_pt_me1_initial;
+  LazyTH1D * h_pt_me2_initial;
+  LazyTH1D * h_pt_me3_initial;
+  LazyTH1D * h_pt_me4_initial;
+
+  LazyTH1D * h_pt_initial_1st;
+  LazyTH1D * h_pt_initial_2st;
+  LazyTH1D * h_pt_initial_3st;
+
+  LazyTH1D * h_pt_me1_initial_2st;
+  LazyTH1D * h_pt_me1_initial_3st;
+
+
+  LazyTH1D * h_pt_gem_1b;
+  LazyTH1D * h_pt_lctgem_1b;
+
+  LazyTH1D * h_pt_me1_mpc;
+  LazyTH1D * h_pt_me2_mpc;
+  LazyTH1D * h_pt_me3_mpc;
+  LazyTH1D * h_pt_me4_mpc;
+
+  LazyTH1D * h_pt_mpc_1st;
+  LazyTH1D * h_pt_mpc_2st;
+  LazyTH1D * h_pt_mpc_3st;
+
+  LazyTH1D * h_pt_me1_mpc_2st;
+  LazyTH1D * h_pt_me1_mpc_3st;
+
+  // efficiencies vs. pt for all PT_THRESHOLDS trigger pt thresholds
+  ThresholdEfficiency eff_pt_tfcand_tfpt;
+  ThresholdEfficiency eff_pt_tfcand_ok_tfpt;
+  ThresholdEfficiency eff_pt_tfcand_all_ok_tfpt;
+
+
+  LazyTH1D * h_pt_after_alct;
+  LazyTH1D * h_pt_after_clct;
+  LazyTH1D * h_pt_after_lct;
+  LazyTH1D * h_pt_after_mpc;
+  LazyTH1D * h_pt_after_mpc_ok_plus;
+  LazyTH1D * h_pt_after_tftrack;
+  LazyTH1D * h_pt_after_tfcand;
+  LazyTH1D * h_pt_after_tfcand_pt10;
+  LazyTH1D * h_pt_after_tfcand_pt20;
+  LazyTH1D * h_pt_after_tfcand_pt40;
+  LazyTH1D * h_pt_after_tfcand_pt60;
+
+  LazyTH1D * h_pt_after_tfcand_ok;
+  LazyTH1D * h_pt_after_tfcand_pt10_ok;
+  LazyTH1D * h_pt_after_tfcand_pt20_ok;
+  LazyTH1D * h_pt_after_tfcand_pt40_ok;
+  LazyTH1D * h_pt_after_tfcand_pt60_ok;
+
+  LazyTH1D * h_pt_after_tfcand_ok_plus;
+  LazyTH1D * h_pt_after_tfcand_ok_plus_pt10;
+  LazyTH1D * h_pt_after_tfcand_ok_plus_q[3];
+  LazyTH1D * h_pt_after_tfcand_ok_plus_pt10_q[3];
+
+  LazyTH1D * h_pt_after_tfcand_all;
+  LazyTH1D * h_pt_after_tfcand_all_ok;
+  LazyTH1D * h_pt_after_tfcand_all_pt10_ok;
+  LazyTH1D * h_pt_after_tfcand_all_pt20_ok;
+  LazyTH1D * h_pt_after_tfcand_all_pt40_ok;
+  LazyTH1D * h_pt_after_tfcand_all_pt60_ok;
+
+
+  LazyTH1D * h_pt_after_tfcand_eta1b_2s[7];
+  LazyTH1D * h_pt_after_tfcand_eta1b_2s1b[7];
+  LazyTH1D * h_pt_after_tfcand_eta1b_2s123[7];
+  LazyTH1D * h_pt_after_tfcand_eta1b_2s13[7];
+  LazyTH1D * h_pt_after_tfcand_eta1b_3s[7];
+  LazyTH1D * h_pt_after_tfcand_eta1b_3s1b[7];
+  LazyTH1D * h_pt_after_tfcand_gem1b_2s1b[7];
+  LazyTH1D * h_pt_after_tfcand_gem1b_2s123[7];
+  LazyTH1D * h_pt_after_tfcand_gem1b_2s13[7];
+  LazyTH1D * h_pt_after_tfcand_gem1b_3s1b[7];
+  LazyTH1D * h_pt_after_tfcand_dphigem1b_2s1b[7];
+  LazyTH1D * h_pt_after_tfcand_dphigem1b_2s123[7];
+  LazyTH1D * h_pt_after_tfcand_dphigem1b_2s13[7];
+  LazyTH1D * h_pt_after_tfcand_dphigem1b_3s1b[7];
+  std::vector<LazyTH1D *> h_pt_after_tfcand_dphigem1b_2s1b_wp[7];
+  std::vector<LazyTH1D *> h_pt_after_tfcand_dphigem1b_2s123_wp[7];
+  std::vector<LazyTH1D *> h_pt_after_tfcand_dphigem1b_2s13_wp[7];
+  std::vector<LazyTH1D *> h_pt_after_tfcand_dphigem1b_3s1b_wp[7];
+
+  LazyTH1D * h_mode_tfcand_gem1b_2s1b_1b[7];
+
+
+  LazyTH1D * h_pt_after_gmtreg;
+  LazyTH1D * h_pt_after_gmtreg_all;
+  LazyTH1D * h_pt_after_gmtreg_dr;
+  LazyTH1D * h_pt_after_gmt;
+  LazyTH1D * h_pt_after_gmt_all;
+  LazyTH1D * h_pt_after_gmt_dr;
+  LazyTH1D * h_pt_after_gmt_dr_nocsc;
+  LazyTH1D * h_pt_after_gmtreg_pt10;
+  LazyTH1D * h_pt_after_gmtreg_all_pt10;
+  LazyTH1D * h_pt_after_gmtreg_dr_pt10;
+  LazyTH1D * h_pt_after_gmt_pt10;
+  LazyTH1D * h_pt_after_gmt_all_pt10;
+  LazyTH1D * h_pt_after_gmt_dr_pt10;
+  LazyTH1D * h_pt_after_gmt_dr_nocsc_pt10;
+
+  LazyTH1D * h_pt_after_gmt_eta1b_1mu[7];
+  LazyTH1D * h_pt_after_gmt_gem1b_1mu[7];
+  LazyTH1D * h_pt_after_gmt_dphigem1b_1mu[7];
+  std::vector<LazyTH1D *> h_pt_after_gmt_dphigem1b_1mu_wp[7];
+
+  LazyTH1D * h_pt_after_xtra;
+  LazyTH1D * h_pt_after_xtra_all;
+  LazyTH1D * h_pt_after_xtra_dr;
+  LazyTH1D * h_pt_after_xtra_pt10;
+  LazyTH1D * h_pt_after_xtra_all_pt10;
+  LazyTH1D * h_pt_after_xtra_dr_pt10;
+
+  LazyTH1D * h_pt_me1_after_mpc_ok_plus;
+  LazyTH1D * h_pt_me1_after_tf_ok_plus;
+  LazyTH1D * h_pt_me1_after_tf_ok_plus_pt10;
+  LazyTH1D * h_pt_me1_after_tf_ok_plus_q[3];
+  LazyTH1D * h_pt_me1_after_tf_ok_plus_pt10_q[3];
 
 
   // high eta pt distros
-  TH1D * h_pth_initial;
-  TH1D * h_pth_after_mpc;
-  TH1D * h_pth_after_mpc_ok_plus;
+  LazyTH1D * h_pth_initial;
+  LazyTH1D * h_pth_after_mpc;
+  LazyTH1D * h_pth_after_mpc_ok_plus;
  
-  TH1D * h_pth_after_tfcand;
-  TH1D * h_pth_after_tfcand_pt10;
+  LazyTH1D * h_pth_after_tfcand;
+  LazyTH1D * h_pth_after_tfcand_pt10;
 
-  TH1D * h_pth_after_tfcand_ok;
-  TH1D * h_pth_after_tfcand_pt10_ok;
+  LazyTH1D * h_pth_after_tfcand_ok;
+  LazyTH1D * h_pth_after_tfcand_pt10_ok;
 
-  TH1D * h_pth_after_tfcand_ok_plus;
-  TH1D * h_pth_after_tfcand_ok_plus_pt10;
-  TH1D * h_pth_after_tfcand_ok_plus_q[3];
-  TH1D * h_pth_after_tfcand_ok_plus_pt10_q[3];
+  LazyTH1D * h_pth_after_tfcand_ok_plus;
+  LazyTH1D * h_pth_after_tfcand_ok_plus_pt10;
+  LazyTH1D * h_pth_after_tfcand_ok_plus_q[3];
+  LazyTH1D * h_pth_after_tfcand_ok_plus_pt10_q[3];
 
-  TH1D * h_pth_me1_after_mpc_ok_plus;
-  TH1D * h_pth_me1_after_tf_ok_plus;
-  TH1D * h_pth_me1_after_tf_ok_plus_pt10;
-  TH1D * h_pth_me1_after_tf_ok_plus_q[3];
-  TH1D * h_pth_me1_after_tf_ok_plus_pt10_q[3];
+  LazyTH1D * h_pth_me1_after_mpc_ok_plus;
+  LazyTH1D * h_pth_me1_after_tf_ok_plus;
+  LazyTH1D * h_pth_me1_after_tf_ok_plus_pt10;
+  LazyTH1D * h_pth_me1_after_tf_ok_plus_q[3];
+  LazyTH1D * h_pth_me1_after_tf_ok_plus_pt10_q[3];
 
-  TH1D * h_pth_over_tfpt_resol;
-  TH2D * h_pth_over_tfpt_resol_vs_pt;
+  LazyTH1D * h_pth_over_tfpt_resol;
+  LazyTH2D * h_pth_over_tfpt_resol_vs_pt;
 
 
-  TH1D * h_pth_after_tfcand_ok_plus_3st1a;
-  TH1D * h_pth_after_tfcand_ok_plus_pt10_3st1a;
-  TH1D * h_pth_me1_after_tf_ok_plus_3st1a;
-  TH1D * h_pth_me1_after_tf_ok_plus_pt10_3st1a;
+  LazyTH1D * h_pth_after_tfcand_ok_plus_3st1a;
+  LazyTH1D * h_pth_after_tfcand_ok_plus_pt10_3st1a;
+  LazyTH1D * h_pth_me1_after_tf_ok_plus_3st1a;
+  LazyTH1D * h_pth_me1_after_tf_ok_plus_pt10_3st1a;
 
 
   // 
-  TH1D * h_eta_initial0;
-  TH1D * h_eta_initial;
+  LazyTH1D * h_eta_initial0;
+  LazyTH1D * h_eta_initial;
   
-  TH1D * h_eta_me1_initial;
-  TH1D * h_eta_me2_initial;
-  TH1D * h_eta_me3_initial;
-  TH1D * h_eta_me4_initial;
-
-  TH1D * h_eta_initial_1st;
-  TH1D * h_eta_initial_2st;
-  TH1D * h_eta_initial_3st;
-
-  TH1D * h_eta_me1_initial_2st;
-  TH1D * h_eta_me1_initial_3st;
-
-
-  TH1D * h_eta_me1_mpc;
-  TH1D * h_eta_me2_mpc;
-  TH1D * h_eta_me3_mpc;
-  TH1D * h_eta_me4_mpc;
-
-  TH1D * h_eta_mpc_1st;
-  TH1D * h_eta_mpc_2st;
-  TH1D * h_eta_mpc_3st;
-
-  TH1D * h_eta_me1_mpc_2st;
-  TH1D * h_eta_me1_mpc_3st;
-
-
-  TH1D * h_eta_tf_initial0_tfpt[N_PT_THRESHOLDS];
-  TH1D * h_eta_tf_initial_tfpt[N_PT_THRESHOLDS];
-  TH1D * h_eta_tf_stubs222_tfpt[N_PT_THRESHOLDS];
-  TH1D * h_eta_tf_stubs223_tfpt[N_PT_THRESHOLDS];
-  TH1D * h_eta_tf_stubs233_tfpt[N_PT_THRESHOLDS];
-
-
-  TH1D * h_eta_after_alct;
-  TH1D * h_eta_after_clct;
-  TH1D * h_eta_after_lct;
-  TH1D * h_eta_after_mpc;
-  TH1D * h_eta_after_mpc_ok;
-  TH1D * h_eta_after_mpc_ok_plus;
-  TH1D * h_eta_after_mpc_ok_plus_3st;
-  TH1D * h_eta_after_mpc_st1;
-  TH1D * h_eta_after_mpc_st1_good;
-  TH1D * h_eta_after_tftrack;
-  TH1D * h_eta_after_tftrack_q[3];
-  TH1D * h_eta_after_tfcand;
-  TH1D * h_eta_after_tfcand_q[3];
-  TH1D * h_eta_after_tfcand_ok;
-  TH1D * h_eta_after_tfcand_ok_plus;
-  TH1D * h_eta_after_tfcand_ok_pt10;
-  TH1D * h_eta_after_tfcand_ok_plus_pt10;
-  TH1D * h_eta_after_tfcand_ok_plus_q[3];
-  TH1D * h_eta_after_tfcand_ok_plus_pt10_q[3];
-  TH1D * h_eta_after_tfcand_pt10;
-  TH1D * h_eta_after_tfcand_all;
-  TH1D * h_eta_after_tfcand_all_pt10;
-  TH1D * h_eta_after_tfcand_my_st1;
-  TH1D * h_eta_after_tfcand_org_st1;
-  TH1D * h_eta_after_tfcand_comm_st1;
-  TH1D * h_eta_after_tfcand_my_st1_pt10;
+  LazyTH1D * h_eta_me1_initial;
+  LazyTH1D * h_eta_me2_initial;
+  LazyTH1D * h_eta_me3_initial;
+  LazyTH1D * h_eta_me4_initial;
+
+  LazyTH1D * h_eta_initial_1st;
+  LazyTH1D * h_eta_initial_2st;
+  LazyTH1D * h_eta_initial_3st;
+
+  LazyTH1D * h_eta_me1_initial_2st;
+  LazyTH1D * h_eta_me1_initial_3st;
+
+
+  LazyTH1D * h_eta_me1_mpc;
+  LazyTH1D * h_eta_me2_mpc;
+  LazyTH1D * h_eta_me3_mpc;
+  LazyTH1D * h_eta_me4_mpc;
+
+  LazyTH1D * h_eta_mpc_1st;
+  LazyTH1D * h_eta_mpc_2st;
+  LazyTH1D * h_eta_mpc_3st;
+
+  LazyTH1D * h_eta_me1_mpc_2st;
+  LazyTH1D * h_eta_me1_mpc_3st;
+
+
+  // efficiencies vs. eta for all PT_THRESHOLDS_FOR_ETA trigger pt thresholds
+  ThresholdEfficiency eff_eta_tfcand_tfpt;
+  ThresholdEfficiency eff_eta_tfcand_ok_plus_tfpt;
+
+
+  LazyTH1D * h_eta_after_alct;
+  LazyTH1D * h_eta_after_clct;
+  LazyTH1D * h_eta_after_lct;
+  LazyTH1D * h_eta_after_mpc;
+  LazyTH1D * h_eta_after_mpc_ok;
+  LazyTH1D * h_eta_after_mpc_ok_plus;
+  LazyTH1D * h_eta_after_mpc_ok_plus_3st;
+  LazyTH1D * h_eta_after_mpc_st1;
+  LazyTH1D * h_eta_after_mpc_st1_good;
+  LazyTH1D * h_eta_after_tftrack;
+  LazyTH1D * h_eta_after_tftrack_q[3];
+  LazyTH1D * h_eta_after_tfcand;
+  LazyTH1D * h_eta_after_tfcand_q[3];
+  LazyTH1D * h_eta_after_tfcand_ok;
+  LazyTH1D * h_eta_after_tfcand_ok_plus;
+  LazyTH1D * h_eta_after_tfcand_ok_pt10;
+  LazyTH1D * h_eta_after_tfcand_ok_plus_pt10;
+  LazyTH1D * h_eta_after_tfcand_ok_plus_q[3];
+  LazyTH1D * h_eta_after_tfcand_ok_plus_pt10_q[3];
+  LazyTH1D * h_eta_after_tfcand_pt10;
+  LazyTH1D * h_eta_after_tfcand_all;
+  LazyTH1D * h_eta_after_tfcand_all_pt10;
+  LazyTH1D * h_eta_after_tfcand_my_st1;
+  LazyTH1D * h_eta_after_tfcand_org_st1;
+  LazyTH1D * h_eta_after_tfcand_comm_st1;
+  LazyTH1D * h_eta_after_tfcand_my_st1_pt10;
   
-  TH1D * h_eta_after_gmtreg;
-  TH1D * h_eta_after_gmtreg_all;
-  TH1D * h_eta_after_gmtreg_dr;
-  TH1D * h_eta_after_gmt;
-  TH1D * h_eta_after_gmt_all;
-  TH1D * h_eta_after_gmt_dr;
-  TH1D * h_eta_after_gmt_dr_nocsc;
-  TH1D * h_eta_after_gmtreg_pt10;
-  TH1D * h_eta_after_gmtreg_all_pt10;
-  TH1D * h_eta_after_gmtreg_dr_pt10;
-  TH1D * h_eta_after_gmt_pt10;
-  TH1D * h_eta_after_gmt_all_pt10;
-  TH1D * h_eta_after_gmt_dr_pt10;
-  TH1D * h_eta_after_gmt_dr_nocsc_pt10;
-
-  TH1D * h_eta_after_xtra;
-  TH1D * h_eta_after_xtra_all;
-  TH1D * h_eta_after_xtra_dr;
-  TH1D * h_eta_after_xtra_pt10;
-  TH1D * h_eta_after_xtra_all_pt10;
-  TH1D * h_eta_after_xtra_dr_pt10;
-
-  TH2D * h_eta_vs_bx_after_alct;
-  TH2D * h_eta_vs_bx_after_clct;
-  TH2D * h_eta_vs_bx_after_lct;
-  TH2D * h_eta_vs_bx_after_mpc;
-
-  TH1D * h_eta_me1_after_alct;
-  TH1D * h_eta_me1_after_alct_okAlct;
-  TH1D * h_eta_me1_after_clct;
-  TH1D * h_eta_me1_after_clct_okClct;
-  TH1D * h_eta_me1_after_alctclct;
-  TH1D * h_eta_me1_after_alctclct_okAlct;
-  TH1D * h_eta_me1_after_alctclct_okClct;
-  TH1D * h_eta_me1_after_alctclct_okAlctClct;
-
-  TH1D * h_eta_me1_after_lct;
-  TH1D * h_eta_me1_after_lct_okAlct;
-  TH1D * h_eta_me1_after_lct_okAlctClct;
-  TH1D * h_eta_me1_after_lct_okClct;
-  TH1D * h_eta_me1_after_lct_okClctAlct;
-  TH1D * h_eta_me1_after_mplct_okAlctClct;
-  TH1D * h_eta_me1_after_mplct_okAlctClct_plus;
-  TH1D * h_eta_me1_after_tf_ok;
-  TH1D * h_eta_me1_after_tf_ok_pt10;
-  TH1D * h_eta_me1_after_tf_ok_plus;
-  TH1D * h_eta_me1_after_tf_ok_plus_pt10;
-  TH1D * h_eta_me1_after_tf_ok_plus_q[3];
-  TH1D * h_eta_me1_after_tf_ok_plus_pt10_q[3];
+  LazyTH1D * h_eta_after_gmtreg;
+  LazyTH1D * h_eta_after_gmtreg_all;
+  LazyTH1D * h_eta_after_gmtreg_dr;
+  LazyTH1D * h_eta_after_gmt;
+  LazyTH1D * h_eta_after_gmt_all;
+  LazyTH1D * h_eta_after_gmt_dr;
+  LazyTH1D * h_eta_after_gmt_dr_nocsc;
+  LazyTH1D * h_eta_after_gmtreg_pt10;
+  LazyTH1D * h_eta_after_gmtreg_all_pt10;
+  LazyTH1D * h_eta_after_gmtreg_dr_pt10;
+  LazyTH1D * h_eta_after_gmt_pt10;
+  LazyTH1D * h_eta_after_gmt_all_pt10;
+  LazyTH1D * h_eta_after_gmt_dr_pt10;
+  LazyTH1D * h_eta_after_gmt_dr_nocsc_pt10;
+
+  LazyTH1D * h_eta_after_xtra;
+  LazyTH1D * h_eta_after_xtra_all;
+  LazyTH1D * h_eta_after_xtra_dr;
+  LazyTH1D * h_eta_after_xtra_pt10;
+  LazyTH1D * h_eta_after_xtra_all_pt10;
+  LazyTH1D * h_eta_after_xtra_dr_pt10;
+
+  LazyTH2D * h_eta_vs_bx_after_alct;
+  LazyTH2D * h_eta_vs_bx_after_clct;
+  LazyTH2D * h_eta_vs_bx_after_lct;
+  LazyTH2D * h_eta_vs_bx_after_mpc;
+
+  LazyTH1D * h_eta_me1_after_alct;
+  LazyTH1D * h_eta_me1_after_alct_okAlct;
+  LazyTH1D * h_eta_me1_after_clct;
+  LazyTH1D * h_eta_me1_after_clct_okClct;
+  LazyTH1D * h_eta_me1_after_alctclct;
+  LazyTH1D * h_eta_me1_after_alctclct_okAlct;
+  LazyTH1D * h_eta_me1_after_alctclct_okClct;
+  LazyTH1D * h_eta_me1_after_alctclct_okAlctClct;
+
+  LazyTH1D * h_eta_me1_after_lct;
+  LazyTH1D * h_eta_me1_after_lct_okAlct;
+  LazyTH1D * h_eta_me1_after_lct_okAlctClct;
+  LazyTH1D * h_eta_me1_after_lct_okClct;
+  LazyTH1D * h_eta_me1_after_lct_okClctAlct;
+  LazyTH1D * h_eta_me1_after_mplct_okAlctClct;
+  LazyTH1D * h_eta_me1_after_mplct_okAlctClct_plus;
+  LazyTH1D * h_eta_me1_after_tf_ok;
+  LazyTH1D * h_eta_me1_after_tf_ok_pt10;
+  LazyTH1D * h_eta_me1_after_tf_ok_plus;
+  LazyTH1D * h_eta_me1_after_tf_ok_plus_pt10;
+  LazyTH1D * h_eta_me1_after_tf_ok_plus_q[3];
+  LazyTH1D * h_eta_me1_after_tf_ok_plus_pt10_q[3];
   //TH1D * h_eta_me1_after_tf_all;
   //TH1D * h_eta_me1_after_tf_all_pt10;
 
 
-  TH1D * h_eta_me1_after_mplct_ok;
-  TH1D * h_eta_me2_after_mplct_ok;
-  TH1D * h_eta_me3_after_mplct_ok;
-  TH1D * h_eta_me4_after_mplct_ok;
+  LazyTH1D * h_eta_me1_after_mplct_ok;
+  LazyTH1D * h_eta_me2_after_mplct_ok;
+  LazyTH1D * h_eta_me3_after_mplct_ok;
+  LazyTH1D * h_eta_me4_after_mplct_ok;
 
 
 
-  TH1D * h_eta_after_mpc_ok_plus_3st1a;
-  TH1D * h_eta_after_tfcand_ok_plus_3st1a;
-  TH1D * h_eta_after_tfcand_ok_plus_pt10_3st1a;
-  TH1D * h_eta_me1_after_tf_ok_plus_3st1a;
-  TH1D * h_eta_me1_after_tf_ok_plus_pt10_3st1a;
+  LazyTH1D * h_eta_after_mpc_ok_plus_3st1a;
+  LazyTH1D * h_eta_after_tfcand_ok_plus_3st1a;
+  LazyTH1D * h_eta_after_tfcand_ok_plus_pt10_3st1a;
+  LazyTH1D * h_eta_me1_after_tf_ok_plus_3st1a;
+  LazyTH1D * h_eta_me1_after_tf_ok_plus_pt10_3st1a;
 
 
-  TH1D * h_wg_me11_initial;
-  TH1D * h_wg_me11_after_alct_okAlct;
-  TH1D * h_wg_me11_after_alctclct_okAlctClct;
-  TH1D * h_wg_me11_after_lct_okAlctClct;
+  LazyTH1D * h_wg_me11_initial;
+  LazyTH1D * h_wg_me11_after_alct_okAlct;
+  LazyTH1D * h_wg_me11_after_alctclct_okAlctClct;
+  LazyTH1D * h_wg_me11_after_lct_okAlctClct;
 
-  TH1D * h_bx_after_alct;
-  TH1D * h_bx_after_clct;
-  TH1D * h_bx_after_lct;
-  TH1D * h_bx_after_mpc;
+  LazyTH1D * h_bx_after_alct;
+  LazyTH1D * h_bx_after_clct;
+  LazyTH1D * h_bx_after_lct;
+  LazyTH1D * h_bx_after_mpc;
   
-  TH1D * h_phi_initial;
-  TH1D * h_phi_after_alct;
-  TH1D * h_phi_after_clct;
-  TH1D * h_phi_after_lct;
-  TH1D * h_phi_after_mpc;
-  TH1D * h_phi_after_tftrack;
-  TH1D * h_phi_after_tfcand;
-  TH1D * h_phi_after_tfcand_all;
-  TH1D * h_phi_after_gmtreg;
-  TH1D * h_phi_after_gmtreg_all;
-  TH1D * h_phi_after_gmtreg_dr;
-  TH1D * h_phi_after_gmt;
-  TH1D * h_phi_after_gmt_all;
-  TH1D * h_phi_after_gmt_dr;
-  TH1D * h_phi_after_gmt_dr_nocsc;
-  TH1D * h_phi_after_xtra;
-  TH1D * h_phi_after_xtra_all;
-  TH1D * h_phi_after_xtra_dr;
-
-  TH1D * h_phi_me1_after_alct;
-  TH1D * h_phi_me1_after_alct_okAlct;
-  TH1D * h_phi_me1_after_clct;
-  TH1D * h_phi_me1_after_clct_okClct;
-  TH1D * h_phi_me1_after_alctclct;
-  TH1D * h_phi_me1_after_alctclct_okAlct;
-  TH1D * h_phi_me1_after_alctclct_okClct;
-  TH1D * h_phi_me1_after_alctclct_okAlctClct;
-  TH1D * h_phi_me1_after_lct;
-  TH1D * h_phi_me1_after_lct_okAlct;
-  TH1D * h_phi_me1_after_lct_okAlctClct;
-  TH1D * h_phi_me1_after_lct_okClct;
-  TH1D * h_phi_me1_after_lct_okClctAlct;
-  TH1D * h_phi_me1_after_mplct_ok;
-  TH1D * h_phi_me1_after_mplct_okAlctClct;
-  TH1D * h_phi_me1_after_mplct_okAlctClct_plus;
-  TH1D * h_phi_me1_after_tf_ok;
-
-  TH1D * h_qu_alct;
-  TH1D * h_qu_clct;
-  TH1D * h_qu_lct;
-  TH1D * h_qu_mplct;
-  TH2D * h_qu_vs_bx__alct;
-  TH2D * h_qu_vs_bx__clct;
-  TH2D * h_qu_vs_bx__lct;
-  TH2D * h_qu_vs_bx__mplct;
-
-  TH2D * h_qu_vs_bxclct__lct;
-
-  TH2D * h_pt_vs_bend__clct_cscdet[CSC_TYPES];
-  TH2D * h_pt_vs_bend__clctOk_cscdet[CSC_TYPES];
-  TH1D * h_bend__clctOk_cscdet[CSC_TYPES];
-
-  TH1D * h_pattern_mplct;
-  TH1D * h_pattern_mplct_cscdet[CSC_TYPES];
-
-  TH1D * h_type_lct;
-  TH1D * h_type_lct_cscdet[CSC_TYPES];
-
-  TH2D * h_bxdbx_alct_a1_da2;
-  TH2D * h_bxdbx_alct_a1_da2_cscdet[CSC_TYPES];
-  TH2D * h_bxdbx_clct_c1_dc2;
-  TH2D * h_bxdbx_clct_c1_dc2_cscdet[CSC_TYPES];
-
-  TH2D * h_dbx_lct_a1_a2;
-  TH2D * h_dbx_lct_a1_a2_cscdet[CSC_TYPES];
-  TH2D * h_bx_lct_a1_a2;
-  TH2D * h_bx_lct_a1_a2_cscdet[CSC_TYPES];
-
-  TH1D * h_tf_stub_bx;
-  TH1D * h_tf_stub_bx_cscdet[CSC_TYPES];
-  TH1D * h_tf_stub_qu;
-  TH1D * h_tf_stub_qu_cscdet[CSC_TYPES];
-  TH2D * h_tf_stub_qu_vs_bx;
-  TH2D * h_tf_stub_qu_vs_bx_cscdet[CSC_TYPES];
-  TH1D * h_tf_stub_csctype;
-  TH1D * h_tf_stub_csctype_org;
-  TH1D * h_tf_stub_csctype_org_unmatch;
+  LazyTH1D * h_phi_initial;
+  LazyTH1D * h_phi_after_alct;
+  LazyTH1D * h_phi_after_clct;
+  LazyTH1D * h_phi_after_lct;
+  LazyTH1D * h_phi_after_mpc;
+  LazyTH1D * h_phi_after_tftrack;
+  LazyTH1D * h_phi_after_tfcand;
+  LazyTH1D * h_phi_after_tfcand_all;
+  LazyTH1D * h_phi_after_gmtreg;
+  LazyTH1D * h_phi_after_gmtreg_all;
+  LazyTH1D * h_phi_after_gmtreg_dr;
+  LazyTH1D * h_phi_after_gmt;
+  LazyTH1D * h_phi_after_gmt_all;
+  LazyTH1D * h_phi_after_gmt_dr;
+  LazyTH1D * h_phi_after_gmt_dr_nocsc;
+  LazyTH1D * h_phi_after_xtra;
+  LazyTH1D * h_phi_after_xtra_all;
+  LazyTH1D * h_phi_after_xtra_dr;
+
+  LazyTH1D * h_phi_me1_after_alct;
+  LazyTH1D * h_phi_me1_after_alct_okAlct;
+  LazyTH1D * h_phi_me1_after_clct;
+  LazyTH1D * h_phi_me1_after_clct_okClct;
+  LazyTH1D * h_phi_me1_after_alctclct;
+  LazyTH1D * h_phi_me1_after_alctclct_okAlct;
+  LazyTH1D * h_phi_me1_after_alctclct_okClct;
+  LazyTH1D * h_phi_me1_after_alctclct_okAlctClct;
+  LazyTH1D * h_phi_me1_after_lct;
+  LazyTH1D * h_phi_me1_after_lct_okAlct;
+  LazyTH1D * h_phi_me1_after_lct_okAlctClct;
+  LazyTH1D * h_phi_me1_after_lct_okClct;
+  LazyTH1D * h_phi_me1_after_lct_okClctAlct;
+  LazyTH1D * h_phi_me1_after_mplct_ok;
+  LazyTH1D * h_phi_me1_after_mplct_okAlctClct;
+  LazyTH1D * h_phi_me1_after_mplct_okAlctClct_plus;
+  LazyTH1D * h_phi_me1_after_tf_ok;
+
+  LazyTH1D * h_qu_alct;
+  LazyTH1D * h_qu_clct;
+  LazyTH1D * h_qu_lct;
+  LazyTH1D * h_qu_mplct;
+  LazyTH2D * h_qu_vs_bx__alct;
+  LazyTH2D * h_qu_vs_bx__clct;
+  LazyTH2D * h_qu_vs_bx__lct;
+  LazyTH2D * h_qu_vs_bx__mplct;
+
+  LazyTH2D * h_qu_vs_bxclct__lct;
+
+  LazyTH2D * h_pt_vs_bend__clct_cscdet[CSC_TYPES];
+  LazyTH2D * h_pt_vs_bend__clctOk_cscdet[CSC_TYPES];
+  LazyTH1D * h_bend__clctOk_cscdet[CSC_TYPES];
+
+  LazyTH1D * h_pattern_mplct;
+  LazyTH1D * h_pattern_mplct_cscdet[CSC_TYPES];
+
+  LazyTH1D * h_type_lct;
+  LazyTH1D * h_type_lct_cscdet[CSC_TYPES];
+
+  LazyTH2D * h_bxdbx_alct_a1_da2;
+  LazyTH2D * h_bxdbx_alct_a1_da2_cscdet[CSC_TYPES];
+  LazyTH2D * h_bxdbx_clct_c1_dc2;
+  LazyTH2D * h_bxdbx_clct_c1_dc2_cscdet[CSC_TYPES];
+
+  LazyTH2D * h_dbx_lct_a1_a2;
+  LazyTH2D * h_dbx_lct_a1_a2_cscdet[CSC_TYPES];
+  LazyTH2D * h_bx_lct_a1_a2;
+  LazyTH2D * h_bx_lct_a1_a2_cscdet[CSC_TYPES];
+
+  LazyTH1D * h_tf_stub_bx;
+  LazyTH1D * h_tf_stub_bx_cscdet[CSC_TYPES];
+  LazyTH1D * h_tf_stub_qu;
+  LazyTH1D * h_tf_stub_qu_cscdet[CSC_TYPES];
+  LazyTH2D * h_tf_stub_qu_vs_bx;
+  LazyTH2D * h_tf_stub_qu_vs_bx_cscdet[CSC_TYPES];
+  LazyTH1D * h_tf_stub_csctype;
+  LazyTH1D * h_tf_stub_csctype_org;
+  LazyTH1D * h_tf_stub_csctype_org_unmatch;
   
-  TH1D * h_tf_stub_bxclct;
-  TH1D * h_tf_stub_bxclct_cscdet[CSC_TYPES];
+  LazyTH1D * h_tf_stub_bxclct;
+  LazyTH1D * h_tf_stub_bxclct_cscdet[CSC_TYPES];
   
-  TH1D * h_tf_stub_pattern;
-  TH1D * h_tf_stub_pattern_cscdet[CSC_TYPES];
+  LazyTH1D * h_tf_stub_pattern;
+  LazyTH1D * h_tf_stub_pattern_cscdet[CSC_TYPES];
   
-  TH1D * h_tf_n_uncommon_stubs;
-  TH1D * h_tf_n_stubs;
-  TH1D * h_tf_n_matchstubs;
-  TH2D * h_tf_n_stubs_vs_matchstubs;
-
-  TH1D * h_tfpt;
-  TH2D * h_tfpt_vs_qu;
-  TH1D * h_tfeta;
-  TH1D * h_tfphi;
-  TH1D * h_tfbx;
-  TH1D * h_tfqu;
-  TH1D * h_tfdr;
-  TH1D * h_tf_mode;
-
-  TH1D * h_tf_pt_h42_2st;
-  TH1D * h_tf_pt_h42_3st;
-  TH1D * h_tf_pt_h42_2st_w;
-  TH1D * h_tf_pt_h42_3st_w;
-
-  TH1D * h_tf_check_mode;
-  TH1D * h_tf_check_bx;
-  TH2D * h_tf_check_n_stubs_vs_matched;
-  TH2D * h_tf_check_st1_mcStrip_vs_ptbin;
-  TH2D * h_tf_check_st1_mcStrip_vs_ptbin_all;
-  TH2D * h_tf_check_st1_mcWG_vs_ptbin_all;
-  TH1D * h_tf_check_st1_wg;
-  TH1D * h_tf_check_st1_strip;
-  TH1D * h_tf_check_st1_mcStrip;
-  TH1D * h_tf_check_st1_chamber;
+  LazyTH1D * h_tf_n_uncommon_stubs;
+  LazyTH1D * h_tf_n_stubs;
+  LazyTH1D * h_tf_n_matchstubs;
+  LazyTH2D * h_tf_n_stubs_vs_matchstubs;
+
+  LazyTH1D * h_tfpt;
+  LazyTH2D * h_tfpt_vs_qu;
+  LazyTH1D * h_tfeta;
+  LazyTH1D * h_tfphi;
+  LazyTH1D * h_tfbx;
+  LazyTH1D * h_tfqu;
+  LazyTH1D * h_tfdr;
+  LazyTH1D * h_tf_mode;
+
+  LazyTH1D * h_tf_pt_h42_2st;
+  LazyTH1D * h_tf_pt_h42_3st;
+  LazyTH1D * h_tf_pt_h42_2st_w;
+  LazyTH1D * h_tf_pt_h42_3st_w;
+
+  LazyTH1D * h_tf_check_mode;
+  LazyTH1D * h_tf_check_bx;
+  LazyTH2D * h_tf_check_n_stubs_vs_matched;
+  LazyTH2D * h_tf_check_st1_mcStrip_vs_ptbin;
+  LazyTH2D * h_tf_check_st1_mcStrip_vs_ptbin_all;
+  LazyTH2D * h_tf_check_st1_mcWG_vs_ptbin_all;
+  LazyTH1D * h_tf_check_st1_wg;
+  LazyTH1D * h_tf_check_st1_strip;
+  LazyTH1D * h_tf_check_st1_mcStrip;
+  LazyTH1D * h_tf_check_st1_chamber;
   //TH2D * h_tf_check_st1_scaledDPhi12_vs_ptbin;
   //TH2D * h_tf_check_st1_scaledDPhi12_vs_ptbin_ok;
   //TH2D * h_tf_check_st1_scaledDPhi23_vs_ptbin;
   //TH2D * h_tf_check_st1_scaledDPhi23_vs_ptbin_ok;
 
-  TH1D * h_gmtpt;
-  TH1D * h_gmteta;
-  TH1D * h_gmtphi;
-  TH1D * h_gmtbx;
-  TH1D * h_gmtrank;
-  TH1D * h_gmtqu;
-  TH1D * h_gmtisrpc;
-  TH1D * h_gmtdr;
-
-  TH1D * h_gmtxpt;
-  TH1D * h_gmtxeta;
-  TH1D * h_gmtxphi;
-  TH1D * h_gmtxbx;
-  TH1D * h_gmtxrank;
-  TH1D * h_gmtxqu;
-  TH1D * h_gmtxisrpc;
-  TH1D * h_gmtxdr;
-
-  TH1D * h_gmtxpt_nocsc;
-  TH1D * h_gmtxeta_nocsc;
-  TH1D * h_gmtxphi_nocsc;
-  TH1D * h_gmtxbx_nocsc;
-  TH1D * h_gmtxrank_nocsc;
-  TH1D * h_gmtxqu_nocsc;
-  TH1D * h_gmtxisrpc_nocsc;
-  TH1D * h_gmtxdr_nocsc;
-
-  TH1D * h_gmtxqu_nogmtreg;
-  TH1D * h_gmtxisrpc_nogmtreg;
-  TH1D * h_gmtxqu_notfcand;
-  TH1D * h_gmtxisrpc_notfcand;
-  TH1D * h_gmtxqu_nompc;
-  TH1D * h_gmtxisrpc_nompc;
-
-  TH1D * h_xtrapt;
-  TH1D * h_xtraeta;
-  TH1D * h_xtraphi;
-  TH1D * h_xtrabx;
-  TH1D * h_xtradr;
-
-  TH1D * h_n_alct;
-  TH1D * h_n_clct;
-  TH1D * h_n_lct;
-  TH1D * h_n_mplct;
-  TH1D * h_n_tftrack;
-  TH1D * h_n_tftrack_all;
-  TH1D * h_n_tfcand;
-  TH1D * h_n_tfcand_all;
-  TH1D * h_n_gmtregcand;
-  TH1D * h_n_gmtregcand_all;
-  TH1D * h_n_gmtcand;
-  TH1D * h_n_gmtcand_all;
-  TH1D * h_n_xtra;
-  TH1D * h_n_xtra_all;
-
-  TH1D * h_n_ch_w_alct;
-  TH1D * h_n_ch_w_clct;
-  TH1D * h_n_ch_w_lct;
-  TH1D * h_n_ch_w_mplct;
-
-  TH1D * h_n_bx_per_ch_alct;
-  TH1D * h_n_bx_per_ch_clct;
-  TH1D * h_n_bx_per_ch_lct;
-
-  TH1D * h_n_per_ch_alct;
-  TH1D * h_n_per_ch_clct;
-  TH1D * h_n_per_ch_lct;
-  TH1D * h_n_per_ch_mplct;
-  TH1D * h_n_per_ch_alct_cscdet[CSC_TYPES];
-  TH2D * h_n_per_ch_alct_vs_bx_cscdet[CSC_TYPES];
-  TH1D * h_n_per_ch_clct_cscdet[CSC_TYPES];
-  TH1D * h_n_per_ch_lct_cscdet[CSC_TYPES];
-  TH1D * h_n_per_ch_mplct_cscdet[CSC_TYPES];
-
-  TH2D * h_n_per_ch_me1nomatchclct_alct_vs_bx_cscdet[CSC_TYPES];
-  TH2D * h_n_per_ch_me1nomatchclct_clct_vs_bx_cscdet[CSC_TYPES];
-  TH1D * h_n_per_ch_me1nomatchclct_clct_cscdet[CSC_TYPES];
-
-  TH2D * h_n_per_ch_me1nomatchalct_alct_vs_bx_cscdet[CSC_TYPES];
-  TH2D * h_n_per_ch_me1nomatchalct_clct_vs_bx_cscdet[CSC_TYPES];
-  TH1D * h_n_per_ch_me1nomatchalct_clct_cscdet[CSC_TYPES];
-
-  TH2D * h_n_per_ch_me1nomatch_alct_vs_bx_cscdet[CSC_TYPES];
-  TH1D * h_n_per_ch_me1nomatch_clct_cscdet[CSC_TYPES];
-
-
-  TH1D * h_station_tf_pu_ok;
-  TH1D * h_station_tf_pu_no;
-  TH1D * h_station_tf_pu_ok_once;
-  TH1D * h_station_tf_pu_no_once;
-  TH1D * h_station_tforg_pu_ok;
-  TH1D * h_station_tforg_pu_no;
-  TH1D * h_station_tforg_pu_ok_once;
-  TH1D * h_station_tforg_pu_no_once;
-  TH1D * h_tfqu_pt10;
-  TH1D * h_tfqu_pt10_no;
+  LazyTH1D * h_gmtpt;
+  LazyTH1D * h_gmteta;
+  LazyTH1D * h_gmtphi;
+  LazyTH1D * h_gmtbx;
+  LazyTH1D * h_gmtrank;
+  LazyTH1D * h_gmtqu;
+  LazyTH1D * h_gmtisrpc;
+  LazyTH1D * h_gmtdr;
+
+  LazyTH1D * h_gmtxpt;
+  LazyTH1D * h_gmtxeta;
+  LazyTH1D * h_gmtxphi;
+  LazyTH1D * h_gmtxbx;
+  LazyTH1D * h_gmtxrank;
+  LazyTH1D * h_gmtxqu;
+  LazyTH1D * h_gmtxisrpc;
+  LazyTH1D * h_gmtxdr;
+
+  LazyTH1D * h_gmtxpt_nocsc;
+  LazyTH1D * h_gmtxeta_nocsc;
+  LazyTH1D * h_gmtxphi_nocsc;
+  LazyTH1D * h_gmtxbx_nocsc;
+  LazyTH1D * h_gmtxrank_nocsc;
+  LazyTH1D * h_gmtxqu_nocsc;
+  LazyTH1D * h_gmtxisrpc_nocsc;
+  LazyTH1D * h_gmtxdr_nocsc;
+
+  LazyTH1D * h_gmtxqu_nogmtreg;
+  LazyTH1D * h_gmtxisrpc_nogmtreg;
+  LazyTH1D * h_gmtxqu_notfcand;
+  LazyTH1D * h_gmtxisrpc_notfcand;
+  LazyTH1D * h_gmtxqu_nompc;
+  LazyTH1D * h_gmtxisrpc_nompc;
+
+  LazyTH1D * h_xtrapt;
+  LazyTH1D * h_xtraeta;
+  LazyTH1D * h_xtraphi;
+  LazyTH1D * h_xtrabx;
+  LazyTH1D * h_xtradr;
+
+  LazyTH1D * h_n_alct;
+  LazyTH1D * h_n_clct;
+  LazyTH1D * h_n_lct;
+  LazyTH1D * h_n_mplct;
+  LazyTH1D * h_n_tftrack;
+  LazyTH1D * h_n_tftrack_all;
+  LazyTH1D * h_n_tfcand;
+  LazyTH1D * h_n_tfcand_all;
+  LazyTH1D * h_n_gmtregcand;
+  LazyTH1D * h_n_gmtregcand_all;
+  LazyTH1D * h_n_gmtcand;
+  LazyTH1D * h_n_gmtcand_all;
+  LazyTH1D * h_n_xtra;
+  LazyTH1D * h_n_xtra_all;
+
+  LazyTH1D * h_n_ch_w_alct;
+  LazyTH1D * h_n_ch_w_clct;
+  LazyTH1D * h_n_ch_w_lct;
+  LazyTH1D * h_n_ch_w_mplct;
+
+  LazyTH1D * h_n_bx_per_ch_alct;
+  LazyTH1D * h_n_bx_per_ch_clct;
+  LazyTH1D * h_n_bx_per_ch_lct;
+
+  LazyTH1D * h_n_per_ch_alct;
+  LazyTH1D * h_n_per_ch_clct;
+  LazyTH1D * h_n_per_ch_lct;
+  LazyTH1D * h_n_per_ch_mplct;
+  LazyTH1D * h_n_per_ch_alct_cscdet[CSC_TYPES];
+  LazyTH2D * h_n_per_ch_alct_vs_bx_cscdet[CSC_TYPES];
+  LazyTH1D * h_n_per_ch_clct_cscdet[CSC_TYPES];
+  LazyTH1D * h_n_per_ch_lct_cscdet[CSC_TYPES];
+  LazyTH1D * h_n_per_ch_mplct_cscdet[CSC_TYPES];
+
+  LazyTH2D * h_n_per_ch_me1nomatchclct_alct_vs_bx_cscdet[CSC_TYPES];
+  LazyTH2D * h_n_per_ch_me1nomatchclct_clct_vs_bx_cscdet[CSC_TYPES];
+  LazyTH1D * h_n_per_ch_me1nomatchclct_clct_cscdet[CSC_TYPES];
+
+  LazyTH2D * h_n_per_ch_me1nomatchalct_alct_vs_bx_cscdet[CSC_TYPES];
+  LazyTH2D * h_n_per_ch_me1nomatchalct_clct_vs_bx_cscdet[CSC_TYPES];
+  LazyTH1D * h_n_per_ch_me1nomatchalct_clct_cscdet[CSC_TYPES];
+
+  LazyTH2D * h_n_per_ch_me1nomatch_alct_vs_bx_cscdet[CSC_TYPES];
+  LazyTH1D * h_n_per_ch_me1nomatch_clct_cscdet[CSC_TYPES];
+
+
+  LazyTH1D * h_station_tf_pu_ok;
+  LazyTH1D * h_station_tf_pu_no;
+  LazyTH1D * h_station_tf_pu_ok_once;
+  LazyTH1D * h_station_tf_pu_no_once;
+  LazyTH1D * h_station_tforg_pu_ok;
+  LazyTH1D * h_station_tforg_pu_no;
+  LazyTH1D * h_station_tforg_pu_ok_once;
+  LazyTH1D * h_station_tforg_pu_no_once;
+  LazyTH1D * h_tfqu_pt10;
+  LazyTH1D * h_tfqu_pt10_no;
   
-  TH1D * h_dBx_LctAlct;
-  TH1D * h_dBx_LctClct;
-  TH1D * h_dBx_1inCh_LctClct;
-  TH1D * h_dBx_2inCh_LctClct;
-  TH2D * h_dBx_2inCh_LctClct2;
+  LazyTH1D * h_dBx_LctAlct;
+  LazyTH1D * h_dBx_LctClct;
+  LazyTH1D * h_dBx_1inCh_LctClct;
+  LazyTH1D * h_dBx_2inCh_LctClct;
+  LazyTH2D * h_dBx_2inCh_LctClct2;
 
-  TH1D * h_dBx_LctClct_cscdet[CSC_TYPES];
-  TH1D * h_dBx_1inCh_LctClct_cscdet[CSC_TYPES];
-  TH1D * h_dBx_2inCh_LctClct_cscdet[CSC_TYPES];
-  TH2D * h_dBx_2inCh_LctClct2_cscdet[CSC_TYPES];
+  LazyTH1D * h_dBx_LctClct_cscdet[CSC_TYPES];
+  LazyTH1D * h_dBx_1inCh_LctClct_cscdet[CSC_TYPES];
+  LazyTH1D * h_dBx_2inCh_LctClct_cscdet[CSC_TYPES];
+  LazyTH2D * h_dBx_2inCh_LctClct2_cscdet[CSC_TYPES];
 
-  TH1D * h_pt_over_tfpt_resol;
-  TH2D * h_pt_over_tfpt_resol_vs_pt;
+  LazyTH1D * h_pt_over_tfpt_resol;
+  LazyTH2D * h_pt_over_tfpt_resol_vs_pt;
 
-  TH1D * h_eta_minus_tfeta_resol;
-  TH1D * h_phi_minus_tfphi_resol;
+  LazyTH1D * h_eta_minus_tfeta_resol;
+  LazyTH1D * h_phi_minus_tfphi_resol;
 
-  TH2D * h_strip_v_wireg_me1a;
-  TH2D * h_strip_v_wireg_me1b;
+  LazyTH2D * h_strip_v_wireg_me1a;
+  LazyTH2D * h_strip_v_wireg_me1b;
 
-  TH1D * h_gmt_mindr; 
-  TH1D * h_gmt_dr_maxrank; 
+  LazyTH1D * h_gmt_mindr; 
+  LazyTH1D * h_gmt_dr_maxrank; 
   bool fill_debug_tree_;
   TTree* dbg_tree;
   void bookDbgTTree();
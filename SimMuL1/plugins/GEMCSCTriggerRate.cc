@@ -4,6 +4,8 @@ const int GEMCSCTriggerRate::pbend[CSCConstants::NUM_CLCT_PATTERNS]=
    { -999,  -5,  4, -4,  3, -3,  2, -2,  1, -1,  0}; // "signed" pattern (== phiBend)
 const double GEMCSCTriggerRate::PT_THRESHOLDS[N_PT_THRESHOLDS] = {0,10,20,30,40,50};
 const double GEMCSCTriggerRate::PT_THRESHOLDS_FOR_ETA[N_PT_THRESHOLDS] = {10,15,30,40,55,70};
+const std::string GEMCSCTriggerRate::WP_RATE_NAMES[N_WP_RATES] =
+  {"3s_2s1b_1b", "3s_2s123_1b", "3s_2s13_1b", "3s_3s1b", "3s_3s1b_1b", "3s_3s1b_no1a"};
 
 // ================================================================================================
 GEMCSCTriggerRate::GEMCSCTriggerRate(const edm::ParameterSet& iConfig):
@@ -61,6 +63,8 @@ GEMCSCTriggerRate::GEMCSCTriggerRate(const edm::ParameterSet& iConfig):
   muScalesCacheID_ = 0ULL ;
   muPtScaleCacheID_ = 0ULL ;
 
+  gemDPhiWPs_ = GEMDPhiCuts::workingPoints(iConfig);
+
 //   bookALCTTree();
 //   bookCLCTTree();
 //   bookLCTTree();
@@ -214,6 +218,11 @@ GEMCSCTriggerRate::beginJob()
   h_rt_gmt_csc_ptmax_3s_3s1b = fs->make<TH1D>("h_rt_gmt_csc_ptmax_3s_3s1b","h_rt_gmt_csc_ptmax_3s_3s1b",600, 0.,150.);
   h_rt_gmt_csc_ptmax_3s_3s1b_1b = fs->make<TH1D>("h_rt_gmt_csc_ptmax_3s_3s1b_1b","h_rt_gmt_csc_ptmax_3s_3s1b_1b",600, 0.,150.);
   h_rt_gmt_csc_ptmax_3s_3s1b_no1a = fs->make<TH1D>("h_rt_gmt_csc_ptmax_3s_3s1b_no1a","h_rt_gmt_csc_ptmax_3s_3s1b_no1a",600, 0.,150.);
+  for (int r=0; r<N_WP_RATES; ++r) for (auto &wp: gemDPhiWPs_)
+  {
+    std::string name = "h_rt_gmt_csc_ptmax_" + WP_RATE_NAMES[r] + "_" + wp.label();
+    h_rt_gmt_csc_ptmax_wp[r].push_back(fs->make<TH1D>(name.c_str(), name.c_str(), 600, 0.,150.));
+  }
   h_rt_gmt_csc_ptmax_2q = fs->make<TH1D>("h_rt_gmt_csc_ptmax_2q","h_rt_gmt_csc_ptmax_2q",600, 0.,150.);
   h_rt_gmt_csc_ptmax_3q = fs->make<TH1D>("h_rt_gmt_csc_ptmax_3q","h_rt_gmt_csc_ptmax_3q",600, 0.,150.);
   h_rt_gmt_csc_pt_2s42 = fs->make<TH1D>("h_rt_gmt_csc_pt_2s42","h_rt_gmt_csc_pt_2s42",600, 0.,150.);
@@ -1310,6 +1319,8 @@ GEMCSCTriggerRate::analyze(const edm::Event& iEvent, const edm::EventSetup& iSet
   MatchCSCMuL1::TFTRACK *trk__max_pt_3s_3s1b_eta = nullptr;
   //  MatchCSCMuL1::TFTRACK *trk__max_pt_3s_3s1ab_eta = nullptr;
   MatchCSCMuL1::TFTRACK *trk__max_pt_2s1b_1b = nullptr;
+  std::vector<float> max_pt_wp[N_WP_RATES];
+  for (int r=0; r<N_WP_RATES; ++r) max_pt_wp[r].assign(gemDPhiWPs_.size(), -1.);
   const CSCCorrelatedLCTDigi * the_me1_stub = nullptr;
   CSCDetId the_me1_id;
   std::map<int,int> bx2n;
@@ -1457,6 +1468,30 @@ GEMCSCTriggerRate::analyze(const edm::Event& iEvent, const edm::EventSetup& iSet
   	      if (eta_no1a && gpt > max_pt_3s_3s1b_no1a ) { max_pt_3s_3s1b_no1a = gpt; max_pt_3s_3s1b_eta_no1a = geta; }
   	    }
 
+  	  if (!gemDPhiWPs_.empty())
+  	    {
+  	      // GEM dphi of this track's ME1/b stub; every ME1/b stub has to pass, tracks without one are not affected by the working points
+  	      unsigned wp_mask = GEMDPhiCuts::allMask(gemDPhiWPs_);
+  	      for (size_t i=0; i<stub_ids.size(); ++i)
+  		{
+  		  if (stub_ids[i].iChamberType() != 2) continue;
+  		  bool is_odd = stub_ids[i].chamber() & 1;
+  		  wp_mask &= GEMDPhiCuts::passMask(gemDPhiWPs_, (myGMTREGCand.tfcand->tftrack->trgdigis)[i]->getGEMDPhi(), gpt, is_odd);
+  		}
+
+  	      bool ok_2s1b = (has_1b_stub && n_stubs >=2) || ( !has_1b_stub && !eta_me1b_whole && n_stubs >=3 );
+  	      bool ok_3s1b = (has_1b_stub && n_stubs >=3) || ( !has_1b_stub && !eta_me1b_whole && n_stubs >=3 );
+  	      bool pass[N_WP_RATES];
+  	      pass[WP_3S_2S1B_1B] = ok_2s1b && eta_me1b;
+  	      pass[WP_3S_2S123_1B] = ok_2s1b && eta_me1b && ok_2s123;
+  	      pass[WP_3S_2S13_1B] = ok_2s1b && eta_me1b && ok_2s13;
+  	      pass[WP_3S_3S1B] = ok_3s1b;
+  	      pass[WP_3S_3S1B_1B] = ok_3s1b && eta_me1b;
+  	      pass[WP_3S_3S1B_NO1A] = ok_3s1b && eta_no1a;
+  	      for (size_t w=0; w<gemDPhiWPs_.size(); ++w) if (wp_mask & (1u << w))
+  		for (int r=0; r<N_WP_RATES; ++r) if (pass[r] && gpt > max_pt_wp[r][w]) max_pt_wp[r][w] = gpt;
+  	    }
+
   	  if (n_stubs >=3 && ( (eta_me1a && has_1a_stub) || (eta_me1b && has_1b_stub) || (!has_1a_stub && !has_1b_stub && !eta_me1ab) ) )
   	    {
   	      if (            gpt > max_pt_3s_3s1ab      ) { max_pt_3s_3s1ab = gpt; max_pt_3s_3s1ab_eta = geta;
@@ -1544,6 +1579,8 @@ GEMCSCTriggerRate::analyze(const edm::Event& iEvent, const edm::EventSetup& iSet
   if (max_pt_3s_3s1b>0) h_rt_gmt_csc_ptmax_3s_3s1b->Fill(max_pt_3s_3s1b);
   if (max_pt_3s_3s1b_1b>0) h_rt_gmt_csc_ptmax_3s_3s1b_1b->Fill(max_pt_3s_3s1b_1b);
   if (max_pt_3s_3s1b_no1a>0) h_rt_gmt_csc_ptmax_3s_3s1b_no1a->Fill(max_pt_3s_3s1b_no1a);
+  for (int r=0; r<N_WP_RATES; ++r) for (size_t w=0; w<gemDPhiWPs_.size(); ++w)
+    if (max_pt_wp[r][w]>0) h_rt_gmt_csc_ptmax_wp[r][w]->Fill(max_pt_wp[r][w]);
 
   if (max_pt_2q>0) h_rt_gmt_csc_ptmax_2q->Fill(max_pt_2q);
   if (max_pt_3q>0) h_rt_gmt_csc_ptmax_3q->Fill(max_pt_3q);
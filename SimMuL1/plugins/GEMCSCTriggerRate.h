@@ -48,6 +48,7 @@
 
 #include "GEMCode/SimMuL1/interface/MuGeometryHelpers.h"
 #include "GEMCode/SimMuL1/interface/MatchCSCMuL1.h"
+#include "GEMCode/SimMuL1/interface/GEMDPhiCuts.h"
 
 // ROOT
 #include "TH1.h"
@@ -143,6 +144,10 @@ class GEMCSCTriggerRate : public edm::EDAnalyzer
   enum pt_thresh {N_PT_THRESHOLDS = 6};
   static const double PT_THRESHOLDS[N_PT_THRESHOLDS];
   static const double PT_THRESHOLDS_FOR_ETA[N_PT_THRESHOLDS];
+
+  // ptmax rates that are also made for each GEM dphi working point
+  enum wp_rates {WP_3S_2S1B_1B = 0, WP_3S_2S123_1B, WP_3S_2S13_1B, WP_3S_3S1B, WP_3S_3S1B_1B, WP_3S_3S1B_NO1A, N_WP_RATES};
+  static const std::string WP_RATE_NAMES[N_WP_RATES];
   
  private:
   
@@ -219,6 +224,10 @@ class GEMCSCTriggerRate : public edm::EDAnalyzer
   bool doME1a_;
   bool defaultME1a;
 
+  // GEM dphi working points: a GMT CSC candidate with an ME1/b stub enters the rates of a working point
+  // if the stub's GEM dphi passes the working point's cut at the candidate's pt
+  std::vector<GEMDPhiCuts> gemDPhiWPs_;
+
   const CSCGeometry* cscGeometry;
 
   TTree* alct_tree_;
@@ -371,6 +380,7 @@ class GEMCSCTriggerRate : public edm::EDAnalyzer
   TH1D * h_rt_gmt_csc_ptmax_3s_3s1b;
   TH1D * h_rt_gmt_csc_ptmax_3s_3s1b_1b;
   TH1D * h_rt_gmt_csc_ptmax_3s_3s1b_no1a;
+  std::vector<TH1D *> h_rt_gmt_csc_ptmax_wp[N_WP_RATES];
   TH1D * h_rt_gmt_csc_ptmax_2q;
   TH1D * h_rt_gmt_csc_ptmax_3q;
   TH1D * h_rt_gmt_csc_pt_2s42;
@@ -5,10 +5,14 @@
 // 
 /**\class MESimHitFilter
 
- Description: [one line class summary]
+ Description: accepts events with CSC SimHits in at least minNLayers layers
+              of a chamber of one of the selected ME types
 
  Implementation:
-     [Notes on implementation]
+     One streaming pass over the SimHits: hits in unselected chamber types are skipped
+     right away, the other ones set their layer bit in the 6-bit mask of their chamber
+     (kept in a small flat table), and the event is accepted as soon as some mask
+     has enough bits set.
 */
 //
 // Original Author:  Vadim Khotilovich
@@ -31,10 +35,12 @@
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 
 #include "DataFormats/MuonDetId/interface/CSCDetId.h"
-#include "GEMCode/SimMuL1/interface/PSimHitMapCSC.h"
+#include "DataFormats/Common/interface/Handle.h"
+#include "SimDataFormats/TrackingHit/interface/PSimHitContainer.h"
 
 #include <vector>
 #include <set>
+#include <utility>
 
 //
 // class declaration
@@ -53,9 +59,17 @@ private:
   virtual bool filter(edm::Event&, const edm::EventSetup&);
   virtual void endJob() ;
 
-  SimHitAnalysis::PSimHitMapCSC simhit_map_csc_;
+  edm::InputTag input_tag_;
 
   std::set<int> me_types_;
+
+  // selection flags indexed by CSCDetId::iChamberType()
+  std::vector<char> selected_type_;
+
+  unsigned min_n_layers_;
+
+  // (chamber rawId, layer mask) of the chambers of selected types seen in the event
+  std::vector<std::pair<unsigned, unsigned char> > chamber_masks_;
 };
 
 
@@ -65,10 +79,14 @@ MESimHitFilter::MESimHitFilter(const edm::ParameterSet& cfg)
   const std::vector<int> def_types {1,4,5}; // ME1/a ME1/b ME2/1
   std::vector<int> types_cfg = cfg.getUntrackedParameter<std::vector<int> >("me_types", def_types);
   std::copy(types_cfg.begin(), types_cfg.end(), inserter(me_types_, me_types_.begin()));
-  
-  edm::InputTag def_input("g4SimHits","MuonCSCHits");
-  simhit_map_csc_.setInputTag(def_input);
 
+  selected_type_.assign(11, 0);
+  for (auto t: me_types_) if (t > 0 && t < 11) selected_type_[t] = 1;
+
+  min_n_layers_ = cfg.getUntrackedParameter<unsigned>("minNLayers", 4);
+
+  edm::InputTag def_input("g4SimHits","MuonCSCHits");
+  input_tag_ = cfg.getUntrackedParameter<edm::InputTag>("inputTag", def_input);
 }
 
 
@@ -82,22 +100,30 @@ bool MESimHitFilter::filter(edm::Event& iEvent, const edm::EventSetup& iSetup)
   using namespace edm;
   using namespace std;
   
-  simhit_map_csc_.fill(iEvent);
-
-  vector<int> ch_ids = simhit_map_csc_.chambersWithHits();
-  if (ch_ids.empty()) return false;
+  Handle<PSimHitContainer> hits;
+  iEvent.getByLabel(input_tag_, hits);
 
-  for(auto d: ch_ids)
+  chamber_masks_.clear();
+  for (PSimHitContainer::const_iterator h = hits->begin(); h != hits->end(); ++h)
   {
-    CSCDetId ch_id(d);
+    CSCDetId id(h->detUnitId());
 
     // is it a chamber type of interest?
-    if (me_types_.count(ch_id.iChamberType()) == 0) continue;
+    if (!selected_type_[id.iChamberType()]) continue;
+
+    // hits of a chamber mostly come together, so look from the back
+    unsigned ch_id = id.chamberId().rawId();
+    auto m = chamber_masks_.rbegin();
+    for (; m != chamber_masks_.rend(); ++m) if (m->first == ch_id) break;
+    if (m == chamber_masks_.rend())
+    {
+      chamber_masks_.push_back(make_pair(ch_id, 0));
+      m = chamber_masks_.rbegin();
+    }
 
     // count number of layers with hits
-    vector<int> layer_ids = simhit_map_csc_.chamberLayersWithHits(d);
-    //cout<<ch_id<<" #L "<<layer_ids.size()<<endl;
-    if (layer_ids.size() >= 4) return true;
+    m->second |= 1 << (id.layer() - 1);
+    if ((unsigned)__builtin_popcount(m->second) >= min_n_layers_) return true;
   }
 
   return false;
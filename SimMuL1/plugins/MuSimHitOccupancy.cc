@@ -16,6 +16,7 @@
 #include "FWCore/Framework/interface/MakerMacros.h"
 
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Utilities/interface/Exception.h"
 #include "FWCore/ServiceRegistry/interface/Service.h"
 #include "CommonTools/UtilAlgos/interface/TFileService.h"
 
@@ -46,6 +47,7 @@
 #include "GEMCode/SimMuL1/interface/PSimHitMapCSC.h"
 #include "GEMCode/SimMuL1/interface/MuGeometryHelpers.h"
 #include "GEMCode/SimMuL1/interface/MuNtupleClasses.h"
+#include "GEMCode/SimMuL1/interface/HitClustering.h"
 
 #include <iomanip>
 
@@ -72,6 +74,30 @@ void scaleOneBin(H *h, int bin, double scale)
   h->SetBinError(bin, er);
 }
 
+// keys and adjacency criteria of the simhits clustering
+int cscHitKey(const MyCSCSimHit &h) {return h.w;}
+int gemHitKey(const MyGEMSimHit &h) {return h.s;}
+int rpcHitKey(const MyRPCSimHit &h) {return h.s;}
+
+// dWG<2 && dS<4 && dTOF<=2ns
+bool cscHitsAdjacent(const MyCSCSimHit &a, const MyCSCSimHit &b)
+{
+  return fabs(a.t - b.t) <= 2 && abs(a.w - b.w) <= 1 && abs(a.s - b.s) <= 3;
+}
+// dS<4 && dTOF<=4ns
+bool gemHitsAdjacent(const MyGEMSimHit &a, const MyGEMSimHit &b)
+{
+  return fabs(a.t - b.t) <= 4. && abs(a.s - b.s) <= 3;
+}
+// dS<3 && dTOF<=2ns
+bool rpcHitsAdjacent(const MyRPCSimHit &a, const MyRPCSimHit &b)
+{
+  return fabs(a.t - b.t) <= 2 && abs(a.s - b.s) <= 2;
+}
+
+enum EClusteringDet {CLU_CSC = 0, CLU_GEM, CLU_RPC, CLU_DETS};
+const std::string clustering_det_names[CLU_DETS] = {"CSC", "GEM", "RPC"};
+
 } // local namespace
 
 
@@ -88,6 +114,10 @@ public:
   virtual void analyze(const edm::Event&, const edm::EventSetup&);
   virtual void endJob() ;
 
+  // sensitive areas of the used detectors, from the cache file if it matches the geometry;
+  // redone only when the MuonGeometryRecord changes
+  void calculateAreas(const edm::EventSetup&);
+
   void analyzeCSC();
   void analyzeGEM();
   void analyzeDT();
@@ -98,6 +128,13 @@ public:
   std::vector<std::vector<MyRPCSimHit> > clusterRPCHitsInRoll(std::vector<MyRPCSimHit> &hits);
   std::vector<std::vector<MyDTSimHit> > clusterDTHitsInLayer(std::vector<MyDTSimHit> &hits);
 
+  // clustering with the sort-and-sweep kernel;
+  // if requested, the result is cross-checked with the recursive clustering
+  template <class Hit>
+  std::vector<std::vector<Hit> > clusterHits(EClusteringDet det, std::vector<Hit> &hits,
+      int (*key)(const Hit &), int max_dkey, bool (*adjacent)(const Hit &, const Hit &),
+      std::vector<std::vector<Hit> > (MuSimHitOccupancy::*recursive)(std::vector<Hit> &));
+
 private:
 
   // configuration parameters:
@@ -119,6 +156,12 @@ private:
   bool fill_rpc_sh_tree_;
   bool fill_dt_sh_tree_;
 
+  // no trees and no per-object structures, only the histograms
+  bool histograms_only_;
+
+  hitclustering::Mode clustering_mode_;
+  bool cross_check_clustering_;
+
   // misc. utilities
 
   const CSCGeometry* csc_geometry;
@@ -135,6 +178,8 @@ private:
 
   // sensitive areas
   mugeo::MuGeometryAreas areas_;
+  std::string areas_cache_file_;
+  unsigned long long areas_geom_cache_id_;
 
   // some counters:
 
@@ -156,6 +201,10 @@ private:
   int nevt_with_dtsh;
   int n_dtsh;
 
+  // clustering cross-check: #compared layers, #layers with different clusters
+  int n_clu_checks_[CLU_DETS];
+  int n_clu_mismatches_[CLU_DETS];
+
   // some histos:
 
   TH2D * h_csc_rz_sh_xray;
@@ -168,6 +217,8 @@ private:
   TH1D * h_csc_clu_flux_per_layer;
   TH1D * h_csc_clu_rate_per_ch;
   TH1D * h_csc_total_area;
+  TH1D * h_csc_hit_flux_vs_r[CSC_TYPES+1];
+  TH1D * h_csc_clu_flux_vs_r[CSC_TYPES+1];
 
   std::map<int,int> pdg2idx;
   TH2D * h_csc_tof_vs_ekin[CSC_TYPES+1][N_PDGIDS];
@@ -305,6 +356,24 @@ MuSimHitOccupancy::MuSimHitOccupancy(const edm::ParameterSet& iConfig)
   simhit_map_gem.setInputTag(input_tag_gem_);
   simhit_map_rpc.setInputTag(input_tag_rpc_);
   simhit_map_dt.setInputTag(input_tag_dt_);
+  simhit_map_csc.setZeroCopy(true);
+  simhit_map_gem.setZeroCopy(true);
+  simhit_map_rpc.setZeroCopy(true);
+  simhit_map_dt.setZeroCopy(true);
+
+  // signal and pileup hits from the CrossingFrames within a BX window;
+  // the input tags then have to point to the CrossingFrames, e.g., ("mix","g4SimHitsMuonCSCHits")
+  if (iConfig.getUntrackedParameter< bool >("simHitsFromCrossingFrame", false))
+  {
+    int min_bx = iConfig.getUntrackedParameter< int >("minBX", -9999);
+    int max_bx = iConfig.getUntrackedParameter< int >("maxBX", 9999);
+    SimHitAnalysis::PSimHitMap * maps[4] = {&simhit_map_csc, &simhit_map_gem, &simhit_map_rpc, &simhit_map_dt};
+    for (int i = 0; i < 4; ++i)
+    {
+      maps[i]->setUseCrossingFrame(true);
+      maps[i]->setBXWindow(min_bx, max_bx);
+    }
+  }
 
 
   do_csc_ = iConfig.getUntrackedParameter< bool >("doCSC", true);
@@ -313,18 +382,32 @@ MuSimHitOccupancy::MuSimHitOccupancy(const edm::ParameterSet& iConfig)
   do_dt_  = iConfig.getUntrackedParameter< bool >("doDT",  true);
 
 
-  fill_csc_sh_tree_ = do_csc_ && iConfig.getUntrackedParameter< bool >("fillCSCSimHitsTrees",true);
+  histograms_only_ = iConfig.getUntrackedParameter< bool >("histogramsOnly", false);
+
+  areas_cache_file_ = iConfig.getUntrackedParameter< std::string >("areasCacheFile", "");
+  areas_geom_cache_id_ = 0;
+
+  fill_csc_sh_tree_ = do_csc_ && !histograms_only_ && iConfig.getUntrackedParameter< bool >("fillCSCSimHitsTrees",true);
   if (fill_csc_sh_tree_) bookCSCSimHitsTrees();
 
-  fill_gem_sh_tree_ = do_gem_ && iConfig.getUntrackedParameter< bool >("fillGEMSimHitsTrees",true);
+  fill_gem_sh_tree_ = do_gem_ && !histograms_only_ && iConfig.getUntrackedParameter< bool >("fillGEMSimHitsTrees",true);
   if (fill_gem_sh_tree_) bookGEMSimHitsTrees();
 
-  fill_rpc_sh_tree_ = do_rpc_ && iConfig.getUntrackedParameter< bool >("fillRPCSimHitsTree",true);
+  fill_rpc_sh_tree_ = do_rpc_ && !histograms_only_ && iConfig.getUntrackedParameter< bool >("fillRPCSimHitsTree",true);
   if (fill_rpc_sh_tree_) bookRPCSimHitsTrees();
 
-  fill_dt_sh_tree_  = do_dt_ && iConfig.getUntrackedParameter< bool >("fillDTSimHitsTree",true);
+  fill_dt_sh_tree_  = do_dt_ && !histograms_only_ && iConfig.getUntrackedParameter< bool >("fillDTSimHitsTree",true);
   if (fill_dt_sh_tree_) bookDTSimHitsTrees();
 
+  // "seeded" reproduces the recursive clustering, "connected" merges chains of adjacent hits
+  std::string clustering = iConfig.getUntrackedParameter< std::string >("simHitClustering", "seeded");
+  if (clustering == "seeded") clustering_mode_ = hitclustering::SEEDED;
+  else if (clustering == "connected") clustering_mode_ = hitclustering::CONNECTED;
+  else throw cms::Exception("Configuration")
+    << "MuSimHitOccupancy: unknown simHitClustering '" << clustering << "', should be seeded or connected\n";
+  cross_check_clustering_ = iConfig.getUntrackedParameter< bool >("crossCheckClustering", false);
+  for (int d = 0; d < CLU_DETS; ++d) n_clu_checks_[d] = n_clu_mismatches_[d] = 0;
+
 
   evtn = 0;
   nevt_with_cscsh = nevt_with_cscsh_in_rpc = n_cscsh = n_cscsh_in_rpc = 0;
@@ -368,6 +451,19 @@ MuSimHitOccupancy::MuSimHitOccupancy(const edm::ParameterSet& iConfig)
   for (int i=1; i<=h_csc_hit_rate_per_ch->GetXaxis()->GetNbins();i++)
     h_csc_hit_rate_per_ch->GetXaxis()->SetBinLabel(i,csc_type[i].c_str());
 
+  // flux vs radius over the span of each chamber type
+  for (int me=1; me<=CSC_TYPES; me++)
+  {
+    double rmin = MuGeometryAreas::csc_ch_radius[me] - MuGeometryAreas::csc_ch_halfheight[me];
+    double rmax = MuGeometryAreas::csc_ch_radius[me] + MuGeometryAreas::csc_ch_halfheight[me];
+    sprintf(label,"h_csc_hit_flux_vs_r_%s",csc_type_[me].c_str());
+    sprintf(nlabel,"%s Flux per layer in %s at L=10^{34};#rho, cm;Hz/cm^{2}", n_simhits.c_str(), csc_type[me].c_str());
+    h_csc_hit_flux_vs_r[me] = fs->make<TH1D>(label, nlabel, 20, rmin, rmax);
+    sprintf(label,"h_csc_clu_flux_vs_r_%s",csc_type_[me].c_str());
+    sprintf(nlabel,"%s Flux per layer in %s at L=10^{34};#rho, cm;Hz/cm^{2}", n_clusters.c_str(), csc_type[me].c_str());
+    h_csc_clu_flux_vs_r[me] = fs->make<TH1D>(label, nlabel, 20, rmin, rmax);
+  }
+
   h_csc_clu_flux_per_layer = fs->make<TH1D>("h_csc_clu_flux_per_layer",
       (n_clusters+" Flux per CSC layer at L=10^{34};ME station/ring;Hz/cm^{2}").c_str(), CSC_TYPES, 0.5,  CSC_TYPES+0.5);
   for (int i=1; i<=h_csc_clu_flux_per_layer->GetXaxis()->GetNbins();i++)
@@ -720,14 +816,14 @@ MuSimHitOccupancy::analyze(const edm::Event& iEvent, const edm::EventSetup& iSet
   iSetup.getData(pdt_h);
   pdt_ = &*pdt_h;
 
+  calculateAreas(iSetup);
+
   if (do_csc_)
   {
     ESHandle< CSCGeometry > csc_geom;
     iSetup.get< MuonGeometryRecord >().get(csc_geom);
     csc_geometry = &*csc_geom;
 
-    if (evtn==1) areas_.calculateCSCDetectorAreas(csc_geometry);
-
     // get SimHits
     simhit_map_csc.fill(iEvent);
    
@@ -740,8 +836,6 @@ MuSimHitOccupancy::analyze(const edm::Event& iEvent, const edm::EventSetup& iSet
     iSetup.get< MuonGeometryRecord >().get(gem_geom);
     gem_geometry = &*gem_geom;
 
-    if (evtn==1) areas_.calculateGEMDetectorAreas(gem_geometry);
-
     // get SimHits
     simhit_map_gem.fill(iEvent);
    
@@ -754,8 +848,6 @@ MuSimHitOccupancy::analyze(const edm::Event& iEvent, const edm::EventSetup& iSet
     iSetup.get< MuonGeometryRecord >().get(rpc_geom);
     rpc_geometry = &*rpc_geom;
 
-    if (evtn==1) areas_.calculateRPCDetectorAreas(rpc_geometry);
-
     // get SimHits
     simhit_map_rpc.fill(iEvent);
 
@@ -768,8 +860,6 @@ MuSimHitOccupancy::analyze(const edm::Event& iEvent, const edm::EventSetup& iSet
     iSetup.get< MuonGeometryRecord >().get(dt_geom);
     dt_geometry = &*dt_geom;
 
-    if (evtn==1) areas_.calculateDTDetectorAreas(dt_geometry);
-
     // get SimHits
     simhit_map_dt.fill(iEvent);
 
@@ -778,6 +868,51 @@ MuSimHitOccupancy::analyze(const edm::Event& iEvent, const edm::EventSetup& iSet
 
 }
 
+// ================================================================================================
+void
+MuSimHitOccupancy::calculateAreas(const edm::EventSetup& iSetup)
+{
+  using namespace edm;
+  using namespace std;
+
+  // the areas depend only on the geometries of the used detectors
+  unsigned long long geom_cache_id = iSetup.get< MuonGeometryRecord >().cacheIdentifier();
+  if (geom_cache_id == areas_geom_cache_id_) return;
+  areas_geom_cache_id_ = geom_cache_id;
+
+  ESHandle< CSCGeometry > csc_geom;
+  ESHandle< GEMGeometry > gem_geom;
+  ESHandle< RPCGeometry > rpc_geom;
+  ESHandle< DTGeometry > dt_geom;
+
+  // the cache file is shared between jobs, where the record's cacheIdentifier has no meaning,
+  // so it is labeled with the geometry contents
+  string fingerprint;
+  if (do_csc_) { iSetup.get< MuonGeometryRecord >().get(csc_geom); fingerprint += " " + MuGeometryAreas::fingerprint(&*csc_geom); }
+  if (do_gem_) { iSetup.get< MuonGeometryRecord >().get(gem_geom); fingerprint += " " + MuGeometryAreas::fingerprint(&*gem_geom); }
+  if (do_rpc_) { iSetup.get< MuonGeometryRecord >().get(rpc_geom); fingerprint += " " + MuGeometryAreas::fingerprint(&*rpc_geom); }
+  if (do_dt_)  { iSetup.get< MuonGeometryRecord >().get(dt_geom);  fingerprint += " " + MuGeometryAreas::fingerprint(&*dt_geom); }
+
+  if (!areas_cache_file_.empty() && areas_.load(areas_cache_file_, fingerprint))
+  {
+    cout<<"MuSimHitOccupancy: sensitive areas are taken from "<<areas_cache_file_<<endl;
+    areas_.print(cout);
+    return;
+  }
+
+  if (do_csc_) areas_.calculateCSCDetectorAreas(&*csc_geom);
+  if (do_gem_) areas_.calculateGEMDetectorAreas(&*gem_geom);
+  if (do_rpc_) areas_.calculateRPCDetectorAreas(&*rpc_geom);
+  if (do_dt_)  areas_.calculateDTDetectorAreas(&*dt_geom);
+
+  if (!areas_cache_file_.empty())
+  {
+    areas_.save(areas_cache_file_, fingerprint);
+    cout<<"MuSimHitOccupancy: sensitive areas are stored in "<<areas_cache_file_<<endl;
+  }
+}
+
+
 // ================================================================================================
 void
 MuSimHitOccupancy::analyzeCSC()
@@ -788,7 +923,7 @@ MuSimHitOccupancy::analyzeCSC()
   bool ev_has_csc_type[CSC_TYPES+1]={0,0,0,0,0,0,0,0,0,0,0};
   bool has_cscsh_in_rpc = false;
 
-  vector<int> chIds = simhit_map_csc.chambersWithHits();
+  const vector<int> & chIds = simhit_map_csc.chambersWithHits();
   if (chIds.size()) {
     //cout<<"--- CSC chambers with hits: "<<chIds.size()<<endl;
     nevt_with_cscsh++;
@@ -800,7 +935,7 @@ MuSimHitOccupancy::analyzeCSC()
     CSCDetId chId(chIds[ch]);
     c_cid.init(chId);
 
-    std::vector<int> layer_ids = simhit_map_csc.chamberLayersWithHits(chIds[ch]);
+    const std::vector<int> & layer_ids = simhit_map_csc.chamberLayersWithHits(chIds[ch]);
     //if (layer_ids.size()) cout<<"------ layers with hits: "<<layer_ids.size()<<endl;
 
     vector<MyCSCLayer> chamber_mylayers;
@@ -809,7 +944,7 @@ MuSimHitOccupancy::analyzeCSC()
       CSCDetId layerId(layer_ids[la]);
       c_id.init(layerId);
 
-      PSimHitContainer hits = simhit_map_csc.hits(layer_ids[la]);
+      const SimHitAnalysis::PSimHitMap::HitRange hits = simhit_map_csc.detHits(layer_ids[la]);
       vector<MyCSCSimHit> layer_mysimhits;
       for (unsigned j = 0; j < hits.size(); j++)
       {
@@ -833,6 +968,7 @@ MuSimHitOccupancy::analyzeCSC()
 
         h_csc_hit_flux_per_layer->Fill(c_cid.t);
         h_csc_hit_rate_per_ch->Fill(c_cid.t);
+        h_csc_hit_flux_vs_r[c_cid.t]->Fill(c_h.r);
 
         int sh_pdg = abs(c_h.pdg);
         if (sh_pdg > 100000) sh_pdg = 1000000000;
@@ -846,8 +982,8 @@ MuSimHitOccupancy::analyzeCSC()
         else cout << " *** non-registered pdgid: " << sh_pdg << endl;
       }
 
-      cout<<" calling recursive clustering:"<<endl;
-      vector<vector<MyCSCSimHit> > clusters = clusterCSCHitsInLayer(layer_mysimhits);
+      vector<vector<MyCSCSimHit> > clusters = clusterHits(CLU_CSC, layer_mysimhits,
+          cscHitKey, 1, cscHitsAdjacent, &MuSimHitOccupancy::clusterCSCHitsInLayer);
       //cout<<"      "<< layer_ids[la]<<" "<<layerId<<"   # hits = "<<hits.size()<<"  # clusters = "<<clusters.size()<<endl;
 
       vector<MyCSCCluster> layer_myclusters;
@@ -864,6 +1000,7 @@ MuSimHitOccupancy::analyzeCSC()
 
         h_csc_clu_flux_per_layer->Fill(c_cid.t);
         h_csc_clu_rate_per_ch->Fill(c_cid.t);
+        h_csc_clu_flux_vs_r[c_cid.t]->Fill(c_cl.r);
       }
 
       c_la.init(layerId.layer(),layer_myclusters);
@@ -871,7 +1008,7 @@ MuSimHitOccupancy::analyzeCSC()
       if (fill_csc_sh_tree_) csc_la_tree->Fill();
     }
     c_ch.init(chamber_mylayers);
-    evt_mychambers.push_back(c_ch);
+    if (fill_csc_sh_tree_) evt_mychambers.push_back(c_ch);
     if (fill_csc_sh_tree_) csc_ch_tree->Fill();
 
     // this chamber type has hits:
@@ -885,8 +1022,11 @@ MuSimHitOccupancy::analyzeCSC()
     h_csc_nlayers_in_ch[c_cid.t]->Fill(c_ch.nl);
     h_csc_nlayers_in_ch[0]->Fill(c_ch.nl);
   }
-  c_ev.init(evt_mychambers);
-  if (fill_csc_sh_tree_) csc_ev_tree->Fill();
+  if (fill_csc_sh_tree_)
+  {
+    c_ev.init(evt_mychambers);
+    csc_ev_tree->Fill();
+  }
 
   // fill events with CSC hits by CSC type:
   for (int t=0; t<=CSC_TYPES; t++)
@@ -907,7 +1047,7 @@ MuSimHitOccupancy::analyzeGEM()
   bool ev_has_gem_type[GEM_TYPES+1]={0,0};
   bool has_gemsh = false;
 
-  vector<int> gem_ids = simhit_map_gem.detsWithHits();
+  const vector<int> & gem_ids = simhit_map_gem.detsWithHits();
   if (gem_ids.size()) nevt_with_gemsh++;
 
   map<int, vector<MyGEMPart> > mapChamberParts;
@@ -921,14 +1061,14 @@ MuSimHitOccupancy::analyzeGEM()
     GEMDetId shid(gem_ids[id]);
     g_id.init(shid);
 
-    PSimHitContainer hits = simhit_map_gem.hits(gem_ids[id]);
+    const SimHitAnalysis::PSimHitMap::HitRange hits = simhit_map_gem.detHits(gem_ids[id]);
 
     // hits in a partition
     vector<MyGEMSimHit> part_mysimhits;
     for (size_t ih=0; ih<hits.size(); ih++)
     {
       gem_shn += 1;
-      PSimHit &sh = hits[ih];
+      const PSimHit &sh = hits[ih];
 
       g_h.init(sh, gem_geometry, pdt_);
       if (fill_gem_sh_tree_) gem_sh_tree->Fill();
@@ -961,8 +1101,8 @@ MuSimHitOccupancy::analyzeGEM()
       if (idx > 0) h_gem_tof_vs_ekin[idx]->Fill( log10(g_h.eKin() * 1000.), log10(g_h.t) );
     }
 
-    cout<<" calling GEM recursive clustering:"<<endl;
-    vector<vector<MyGEMSimHit> > clusters = clusterGEMHitsInPart(part_mysimhits);
+    vector<vector<MyGEMSimHit> > clusters = clusterHits(CLU_GEM, part_mysimhits,
+        gemHitKey, 3, gemHitsAdjacent, &MuSimHitOccupancy::clusterGEMHitsInPart);
 
     vector<MyGEMCluster> part_myclusters;
     for (unsigned cl = 0; cl < clusters.size(); cl++)
@@ -978,8 +1118,11 @@ MuSimHitOccupancy::analyzeGEM()
       h_gem_clu_rate_per_ch->Fill(g_id.t);
     }
 
+    // the rest only makes the ntuple structures
+    if (!fill_gem_sh_tree_) continue;
+
     g_part.init(g_id.part, g_id.layer, part_myclusters);
-    if (fill_gem_sh_tree_) gem_part_tree->Fill();
+    gem_part_tree->Fill();
 
     GEMDetId chid(shid.region(), shid.station(), shid.ring(), 1, shid.chamber(), 0);
     int ch_id = chid.rawId();
@@ -1003,10 +1146,13 @@ MuSimHitOccupancy::analyzeGEM()
 
     g_ch.init(itr->second);
     evt_mychambers.push_back(g_ch);
-    if (fill_gem_sh_tree_) gem_ch_tree->Fill();
+    gem_ch_tree->Fill();
+  }
+  if (fill_gem_sh_tree_)
+  {
+    g_ev.init(evt_mychambers);
+    gem_ev_tree->Fill();
   }
-  g_ev.init(evt_mychambers);
-  if (fill_gem_sh_tree_) gem_ev_tree->Fill();
 
 
   // fill events with GEM hits by GEM type:
@@ -1028,7 +1174,7 @@ MuSimHitOccupancy::analyzeRPC()
   bool ev_has_rpcb_type[RPCB_TYPES+1]={0,0,0,0,0,0,0,0,0,0,0,0,0};
   bool has_rpcsh_e = false, has_rpcsh_b = false;
 
-  vector<int> rpc_ids = simhit_map_rpc.detsWithHits();
+  const vector<int> & rpc_ids = simhit_map_rpc.detsWithHits();
   if (rpc_ids.size()) nevt_with_rpcsh++;
 
   map<int, vector<MyRPCRoll> > mapChamberRolls;
@@ -1044,14 +1190,14 @@ MuSimHitOccupancy::analyzeRPC()
     //RPCGeomServ rpcsrv(shid);
     //cout<<"   "<<rpcsrv.name()<<"  "<<rpcsrv.shortname()<<endl;
 
-    PSimHitContainer hits = simhit_map_rpc.hits(rpc_ids[id]);
+    const SimHitAnalysis::PSimHitMap::HitRange hits = simhit_map_rpc.detHits(rpc_ids[id]);
 
     // hits in a roll
     vector<MyRPCSimHit> roll_mysimhits;
     for (size_t ih=0; ih<hits.size(); ih++)
     {
       rpc_shn += 1;
-      PSimHit &sh = hits[ih];
+      const PSimHit &sh = hits[ih];
 
       r_h.init(sh, rpc_geometry, pdt_);
       if (fill_rpc_sh_tree_) rpc_sh_tree->Fill();
@@ -1094,8 +1240,8 @@ MuSimHitOccupancy::analyzeRPC()
       }
     }
 
-    cout<<" calling recursive clustering:"<<endl;
-    vector<vector<MyRPCSimHit> > clusters = clusterRPCHitsInRoll(roll_mysimhits);
+    vector<vector<MyRPCSimHit> > clusters = clusterHits(CLU_RPC, roll_mysimhits,
+        rpcHitKey, 2, rpcHitsAdjacent, &MuSimHitOccupancy::clusterRPCHitsInRoll);
 
     vector<MyRPCCluster> roll_myclusters;
     for (unsigned cl = 0; cl < clusters.size(); cl++)
@@ -1119,8 +1265,11 @@ MuSimHitOccupancy::analyzeRPC()
       }
     }
 
+    // the rest only makes the ntuple structures
+    if (!fill_rpc_sh_tree_) continue;
+
     r_rl.init(r_id.roll, r_id.layer, roll_myclusters);
-    if (fill_rpc_sh_tree_) rpc_rl_tree->Fill();
+    rpc_rl_tree->Fill();
 
     int ch_id = shid.chamberId().rawId();
     map<int, vector<MyRPCRoll> >::const_iterator is_there = mapChamberRolls.find(ch_id);
@@ -1143,10 +1292,13 @@ MuSimHitOccupancy::analyzeRPC()
 
     r_ch.init(itr->second);
     evt_mychambers.push_back(r_ch);
-    if (fill_rpc_sh_tree_) rpc_ch_tree->Fill();
+    rpc_ch_tree->Fill();
+  }
+  if (fill_rpc_sh_tree_)
+  {
+    r_ev.init(evt_mychambers);
+    rpc_ev_tree->Fill();
   }
-  r_ev.init(evt_mychambers);
-  if (fill_rpc_sh_tree_) rpc_ev_tree->Fill();
 
 
   // fill events with RPCf hits by RPCf type:
@@ -1171,7 +1323,7 @@ MuSimHitOccupancy::analyzeDT()
 
   bool ev_has_dt_type[DT_TYPES+1]={0,0,0,0,0,0,0,0,0,0,0,0,0};
 
-  vector<int> dt_ids = simhit_map_dt.detsWithHits();
+  const vector<int> & dt_ids = simhit_map_dt.detsWithHits();
   if (dt_ids.size()) nevt_with_dtsh++;
 
   map<int, vector<MyRPCRoll> > mapChamberRolls;
@@ -1182,12 +1334,12 @@ MuSimHitOccupancy::analyzeDT()
     DTWireId shid(dt_ids[id]);
     d_id.init(shid);
 
-    PSimHitContainer hits = simhit_map_dt.hits(dt_ids[id]);
+    const SimHitAnalysis::PSimHitMap::HitRange hits = simhit_map_dt.detHits(dt_ids[id]);
 
     for (size_t ih=0; ih<hits.size(); ih++)
     {
       dt_shn += 1;
-      PSimHit &sh = hits[ih];
+      const PSimHit &sh = hits[ih];
 
       d_h.init(sh, dt_geometry, pdt_);
       if (fill_dt_sh_tree_) dt_sh_tree->Fill();
@@ -1248,6 +1400,12 @@ void MuSimHitOccupancy::endJob()
   cout<<"*   RPC endcaps:             "<<n_rpcsh_e<<" (~"<<(double)n_rpcsh_e/nevt_with_rpcsh_e<<" sh/evt with hits)"<<endl;
   cout<<"*   RPC barrel:              "<<n_rpcsh_b<<" (~"<< ( (nevt_with_rpcsh_b>0) ? (double)n_rpcsh_b/nevt_with_rpcsh_b : 0 )<<" sh/evt with hits)"<<endl;
   cout<<"*   DT:                      "<<n_dtsh<<" (~"<<(double)n_dtsh/nevt_with_dtsh<<" sh/evt with hits)"<<endl;
+  if (cross_check_clustering_)
+  {
+    cout<<"* clustering cross-check, #layers with different clusters:"<<endl;
+    for (int d = 0; d < CLU_DETS; ++d)
+      cout<<"*   "<<clustering_det_names[d]<<":                     "<<n_clu_mismatches_[d]<<" out of "<<n_clu_checks_[d]<<endl;
+  }
   cout<<"************************************************"<<endl;
 
   edm::Service<TFileService> fs;
@@ -1296,6 +1454,20 @@ void MuSimHitOccupancy::endJob()
     scale = bxrate * n_pu * f_full_bx /csc_radial_segm[t]/2./evtn/1000.;
     scaleOneBin(h_csc_hit_rate_per_ch, t, scale);
     scaleOneBin(h_csc_clu_rate_per_ch, t, scale);
+
+    // per radial bin: the part of the chamber type area in that bin
+    TH1D *h_hit = h_csc_hit_flux_vs_r[t], *h_clu = h_csc_clu_flux_vs_r[t];
+    h_hit->Sumw2();
+    h_clu->Sumw2();
+    for (int b=1; b <= h_hit->GetNbinsX(); b++)
+    {
+      double area = areas_.csc_total_areas_cm2[t] *
+          MuGeometryAreas::cscAreaFractionInRadius(t, h_hit->GetXaxis()->GetBinLowEdge(b), h_hit->GetXaxis()->GetBinUpEdge(b));
+      if (area <= 0.) continue;
+      scale = bxrate * n_pu * f_full_bx /area/evtn;
+      scaleOneBin(h_hit, b, scale);
+      scaleOneBin(h_clu, b, scale);
+    }
   }
   if (do_csc_) for (int i=0; i<4; i++)
   {
@@ -1428,6 +1600,43 @@ void MuSimHitOccupancy::endJob()
 }
 
 
+// ================================================================================================
+template <class Hit>
+std::vector<std::vector<Hit> > MuSimHitOccupancy::clusterHits(EClusteringDet det, std::vector<Hit> &hits,
+    int (*key)(const Hit &), int max_dkey, bool (*adjacent)(const Hit &, const Hit &),
+    std::vector<std::vector<Hit> > (MuSimHitOccupancy::*recursive)(std::vector<Hit> &))
+{
+  using namespace std;
+
+  hitclustering::Clusters spans;
+  hitclustering::cluster(hits, key, max_dkey, adjacent, clustering_mode_, spans);
+  vector<vector<Hit> > result = hitclustering::clusterHits(hits, spans);
+
+  if (cross_check_clustering_)
+  {
+    vector<Hit> hits_copy(hits);
+    vector<vector<Hit> > expected = (this->*recursive)(hits_copy);
+
+    // the hits of each cluster and the clusters are in the sorted hits order in both cases
+    bool same = expected.size() == result.size();
+    for (size_t c = 0; same && c < result.size(); ++c)
+    {
+      same = expected[c].size() == result[c].size();
+      for (size_t i = 0; same && i < result[c].size(); ++i)
+        same = !(expected[c][i] < result[c][i]) && !(result[c][i] < expected[c][i]);
+    }
+    ++n_clu_checks_[det];
+    if (!same)
+    {
+      ++n_clu_mismatches_[det];
+      cout<<" clustering cross-check "<<clustering_det_names[det]<<": #hits="<<hits.size()
+          <<" #clusters="<<result.size()<<" vs recursive "<<expected.size()<<endl;
+    }
+  }
+  return result;
+}
+
+
 // ================================================================================================
 std::vector<std::vector<MyCSCSimHit> > MuSimHitOccupancy::clusterCSCHitsInLayer(std::vector<MyCSCSimHit> &hits)
 {
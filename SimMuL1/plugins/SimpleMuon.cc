@@ -44,7 +44,8 @@
 
 #include "GEMCode/SimMuL1/interface/MatchCSCMuL1.h"
 #include "GEMCode/SimMuL1/interface/MuGeometryHelpers.h"
-#include "GEMCode/SimMuL1/interface/PSimHitMap.h"
+#include "GEMCode/SimMuL1/interface/PSimHitMapCSC.h"
+#include "GEMCode/SimMuL1/interface/PSimHitPool.h"
 #include "GEMCode/SimMuL1/plugins/Ntuple.h"
 
 #include "Geometry/CSCGeometry/interface/CSCChamberSpecs.h"
@@ -91,13 +92,11 @@ private:
 			     const edm::SimVertexContainer&, const edm::PSimHitContainer*);
   std::vector<unsigned> fillSimTrackFamilyIds(unsigned, const edm::SimTrackContainer &, 
 					      const edm::SimVertexContainer &);
-  std::vector<PSimHit> hitsFromSimTrack(std::vector<unsigned>, SimHitAnalysis::PSimHitMap &);
-  std::vector<PSimHit> hitsFromSimTrack(unsigned, SimHitAnalysis::PSimHitMap &);
-  std::vector<PSimHit> hitsFromSimTrack(unsigned, int, SimHitAnalysis::PSimHitMap &);
+  MatchCSCMuL1::HitIndices hitIndicesFromSimTrack(const std::vector<unsigned> &, const SimHitAnalysis::PSimHitPool &);
   void matchSimTrack2ALCTs(MatchCSCMuL1 *, const edm::PSimHitContainer*, 
 			   const CSCALCTDigiCollection*, const CSCWireDigiCollection*);
   unsigned matchCSCAnodeHits(const std::vector<CSCAnodeLayerInfo>& , 
-			     std::vector<PSimHit> &); 
+			     MatchCSCMuL1::HitIndices &); 
   bool compareSimHits(PSimHit &, PSimHit &);
   void matchSimTrack2CLCTs( MatchCSCMuL1 *, 
              const edm::PSimHitContainer* , 
@@ -107,7 +106,7 @@ private:
              const CSCCorrelatedLCTDigiCollection* lcts );
   unsigned
   matchCSCCathodeHits(const std::vector<CSCCathodeLayerInfo>& allLayerInfo, 
-		      std::vector<PSimHit> &matchedHit); 
+		      MatchCSCMuL1::HitIndices &matchedHit); 
 
   // fit muon's hits to a 2D linear stub in a chamber :
   //   wires:   work in 2D plane going through z axis :
@@ -177,7 +176,7 @@ private:
   int minDeltaYCathode_;
   bool addGhostLCTs_;
   
-  SimHitAnalysis::PSimHitMap theCSCSimHitMap;
+  SimHitAnalysis::PSimHitMapCSC theCSCSimHitMap;
 
   CSCStripConditions * theStripConditions;
 
@@ -249,6 +248,8 @@ const double SimpleMuon::PT_THRESHOLDS_FOR_ETA[N_PT_THRESHOLDS] = {10,15,30,40,5
 //
 SimpleMuon::SimpleMuon(const edm::ParameterSet& iConfig)
 {
+  theCSCSimHitMap.setZeroCopy(true);
+
   doStrictSimHitToTrackMatch_ = iConfig.getUntrackedParameter<bool>("doStrictSimHitToTrackMatch", false);
 
   minBxALCT_ = iConfig.getUntrackedParameter< int >("minBxALCT",5);
@@ -670,7 +671,7 @@ SimpleMuon::analyze(const edm::Event& iEvent, const edm::EventSetup& iSetup)
     etrk_.st_phi.push_back(track_phi);
 
     // create a new matching object for this simtrack 
-    MatchCSCMuL1 * match = new MatchCSCMuL1(&*track, &(simVertices[track->vertIndex()]), cscGeometry);
+    MatchCSCMuL1 * match = new MatchCSCMuL1(&*track, &(simVertices[track->vertIndex()]), cscGeometry, &theCSCSimHitMap.pool());
     
     match->muOnly = doStrictSimHitToTrackMatch_;
     match->minBxALCT  = minBxALCT_;
@@ -1062,7 +1063,7 @@ SimpleMuon::matchSimTrack2SimHits(MatchCSCMuL1 * match,
   match->familyIds = fillSimTrackFamilyIds(match->strk->trackId(), simTracks, simVertices);
 
   // match SimHits to SimTracks
-  std::vector<PSimHit> matchingSimHits(hitsFromSimTrack(match->familyIds, theCSCSimHitMap));
+  const MatchCSCMuL1::HitIndices matchingSimHits(hitIndicesFromSimTrack(match->familyIds, theCSCSimHitMap.pool()));
 
   std::cout << "number of matching simhits: " << matchingSimHits.size() << std::endl;
 
@@ -1073,23 +1074,30 @@ SimpleMuon::matchSimTrack2SimHits(MatchCSCMuL1 * match,
     if (goodChambersOnly_) 
     {
       // skip the bad chambers
-      if (theStripConditions->isInBadChamber(CSCDetId(matchingSimHits[i].detUnitId()))) continue;
+      if (theStripConditions->isInBadChamber(CSCDetId(theCSCSimHitMap.pool()[matchingSimHits[i]].detUnitId()))) continue;
     }
     match->addSimHit(matchingSimHits[i]);
   }
 
   // checks
   unsigned stNhist = 0;
-  for (edm::PSimHitContainer::const_iterator hit = allCSCSimHits->begin(); hit != allCSCSimHits->end(); ++hit) 
+  const std::vector<int> & chIds = theCSCSimHitMap.chambersWithHits();
+  for (std::vector<int>::const_iterator ch = chIds.begin(); ch != chIds.end(); ++ch)
   {
-    // track id has to match
-    if (hit->trackId() != match->strk->trackId()) continue;
-
     // select only certain regions of CSC
-    const CSCDetId chId(hit->detUnitId());
+    const CSCDetId chId(*ch);
     if ( chId.station() == 1 && chId.ring() == 4 && !doME1a_) continue;
-    
-    stNhist++;
+
+    const std::vector<int> & layerIds = theCSCSimHitMap.chamberLayersWithHits(*ch);
+    for (std::vector<int>::const_iterator la = layerIds.begin(); la != layerIds.end(); ++la)
+    {
+      const SimHitAnalysis::PSimHitMap::HitRange hits = theCSCSimHitMap.detHits(*la);
+      for (SimHitAnalysis::PSimHitMap::HitRange::const_iterator hit = hits.begin(); hit != hits.end(); ++hit)
+      {
+        // track id has to match
+        if (hit->trackId() == match->strk->trackId()) stNhist++;
+      }
+    }
   }
   if (doStrictSimHitToTrackMatch_ && stNhist != match->simHits.size()) 
   {
@@ -1170,53 +1178,24 @@ SimpleMuon::fillSimTrackFamilyIds(unsigned id, const edm::SimTrackContainer & si
 
 
 // ================================================================================================
-std::vector<PSimHit> 
-SimpleMuon::hitsFromSimTrack(std::vector<unsigned> ids, SimHitAnalysis::PSimHitMap &hitMap)
-{
-  std::vector<PSimHit> result;
-  for (size_t id = 0; id < ids.size(); ++id)
-  {
-    const std::vector<PSimHit> resultd(hitsFromSimTrack(ids[id], hitMap));
-    result.insert(result.end(), resultd.begin(), resultd.end());
-  }
-  return result;
-}
-
-
-// ================================================================================================
-std::vector<PSimHit> 
-SimpleMuon::hitsFromSimTrack(unsigned id, SimHitAnalysis::PSimHitMap &hitMap)
+MatchCSCMuL1::HitIndices
+SimpleMuon::hitIndicesFromSimTrack(const std::vector<unsigned> & ids, const SimHitAnalysis::PSimHitPool &hitPool)
 {
-  std::vector<PSimHit> result;
-  const std::vector<int> detIds(hitMap.detsWithHits());
+  MatchCSCMuL1::HitIndices result;
+  const SimHitAnalysis::PSimHitPool::IndexRange all(hitPool.all());
 
-  for (size_t di = 0; di < detIds.size(); ++di)
-  {
-    const std::vector<PSimHit> resultd(hitsFromSimTrack(id, detIds[di], hitMap));
-    result.insert(result.end(), resultd.begin(), resultd.end());
-  }
-  return result;
-}
-
-
-// ================================================================================================
-std::vector<PSimHit> 
-SimpleMuon::hitsFromSimTrack(unsigned id, int detId, SimHitAnalysis::PSimHitMap &hitMap)
-{
-  std::vector<PSimHit> result;
-
-  const CSCDetId chId(detId);
-  if ( chId.station() == 1 && chId.ring() == 4 && !doME1a_) return result;
-
-  // get the simhits for this detId
-  const edm::PSimHitContainer hits(hitMap.hits(detId));
-  
-  for(size_t h = 0; h< hits.size(); ++h) 
+  for (size_t id = 0; id < ids.size(); ++id)
   {
-    // add all simhits for which the track id corresponds to the required track id
-    if(hits[h].trackId() == id)
+    // pool is sorted by detId, so the hits come out ordered by detId for every family member
+    for (SimHitAnalysis::PSimHitPool::IndexRange::const_iterator h = all.begin(); h != all.end(); ++h)
     {
-      result.push_back(hits[h]);
+      const PSimHit & hit(hitPool[*h]);
+      // add all simhits for which the track id corresponds to the required track id
+      if (hit.trackId() != ids[id]) continue;
+
+      const CSCDetId chId(hit.detUnitId());
+      if ( chId.station() == 1 && chId.ring() == 4 && !doME1a_) continue;
+      result.push_back(*h);
     }
   }
   return result;
@@ -1264,8 +1243,8 @@ SimpleMuon::matchSimTrack2ALCTs(MatchCSCMuL1 *match,
      const bool me1a_all(defaultME1a && id.station()==1 && id.ring()==1 && (*digiIt).getKeyWG() <= 15);
      const bool me1a_no_overlap(me1a_all && (*digiIt).getKeyWG() < 10);
      
-     std::vector<PSimHit> trackHitsInChamber = match->chamberHits(id.rawId());
-     std::vector<PSimHit> trackHitsInChamber1a;
+     MatchCSCMuL1::HitIndexRange trackHitsInChamber = match->chamberHits(id.rawId());
+     MatchCSCMuL1::HitIndexRange trackHitsInChamber1a;
      if (me1a_all) trackHitsInChamber1a = match->chamberHits(id1a.rawId());
      
      // no point to do any matching here
@@ -1284,7 +1263,7 @@ SimpleMuon::matchSimTrack2ALCTs(MatchCSCMuL1 *match,
      
      std::vector<CSCAnodeLayerInfo> alctInfo;
      //std::vector<CSCAnodeLayerInfo> alctInfo = alct_analyzer.getSimInfo(*digiIt, id, wiredc, allCSCSimHits);
-     std::vector<PSimHit> matchedHits;
+     MatchCSCMuL1::HitIndices matchedHits;
      unsigned nmhits = matchCSCAnodeHits(alctInfo, matchedHits);
      
      MatchCSCMuL1::ALCT malct(match);
@@ -1297,7 +1276,7 @@ SimpleMuon::matchSimTrack2ALCTs(MatchCSCMuL1 *match,
      malct.deltaOk = (minDeltaWire_ <= malct.deltaWire) & (malct.deltaWire <= maxDeltaWire_);
      
      std::vector<CSCAnodeLayerInfo> alctInfo1a;
-     std::vector<PSimHit> matchedHits1a;
+     MatchCSCMuL1::HitIndices matchedHits1a;
      unsigned nmhits1a = 0;
      
      MatchCSCMuL1::ALCT malct1a(match);
@@ -1330,8 +1309,7 @@ SimpleMuon::matchSimTrack2ALCTs(MatchCSCMuL1 *match,
 	   //                   <<matchedHits[i].momentumAtEntry()<<" "<<matchedHits[i].energyLoss()<<" "
 	   //                   <<matchedHits[i].particleType()<<" "<<matchedHits[i].trackId();
 	   //bool wasmatch = 0;
-	   for (unsigned j=0; j<trackHitsInChamber.size(); j++)
-	     if ( compareSimHits ( matchedHits[i], trackHitsInChamber[j] ) )
+	   if ( trackHitsInChamber.contains( matchedHits[i] ) )
 	       {
 		 nHitsMatch++;
 		 //wasmatch = 1;
@@ -1343,8 +1321,7 @@ SimpleMuon::matchSimTrack2ALCTs(MatchCSCMuL1 *match,
 	 nHitsMatch = 0;
 	 for (unsigned i=0; i<nmhits1a;i++) {
 	   //bool wasmatch = 0;
-	   for (unsigned j=0; j<trackHitsInChamber1a.size(); j++)
-	     if ( compareSimHits ( matchedHits1a[i], trackHitsInChamber1a[j] ) )
+	   if ( trackHitsInChamber1a.contains( matchedHits1a[i] ) )
 	       {
 		 nHitsMatch++;
 		 //wasmatch = 1;
@@ -1364,9 +1341,9 @@ SimpleMuon::matchSimTrack2ALCTs(MatchCSCMuL1 *match,
 	 if ( fabs(malct.deltaY)<= minDeltaYAnode_ )
 	   {
 	     if (debugALCT)  for (unsigned i=0; i<trackHitsInChamber.size();i++)
-	       std::cout<<"   DY match: "<<trackHitsInChamber[i]<<" "<<trackHitsInChamber[i].exitPoint()<<"  "
-			<<trackHitsInChamber[i].momentumAtEntry()<<" "<<trackHitsInChamber[i].energyLoss()<<" "
-			<<trackHitsInChamber[i].particleType()<<" "<<trackHitsInChamber[i].trackId()<<std::endl;
+	       std::cout<<"   DY match: "<<theCSCSimHitMap.pool()[trackHitsInChamber[i]]<<" "<<theCSCSimHitMap.pool()[trackHitsInChamber[i]].exitPoint()<<"  "
+			<<theCSCSimHitMap.pool()[trackHitsInChamber[i]].momentumAtEntry()<<" "<<theCSCSimHitMap.pool()[trackHitsInChamber[i]].energyLoss()<<" "
+			<<theCSCSimHitMap.pool()[trackHitsInChamber[i]].particleType()<<" "<<theCSCSimHitMap.pool()[trackHitsInChamber[i]].trackId()<<std::endl;
 	     
 	     if (!me1a_no_overlap) match->ALCTs.push_back(malct);
 	     dymatch = true;
@@ -1381,9 +1358,9 @@ SimpleMuon::matchSimTrack2ALCTs(MatchCSCMuL1 *match,
 	 if ( minDeltaYAnode_ < 0  )
 	   {
 	     if (debugALCT)  for (unsigned i=0; i<trackHitsInChamber.size();i++)
-	       std::cout<<"   chamber match: "<<trackHitsInChamber[i]<<" "<<trackHitsInChamber[i].exitPoint()<<"  "
-			<<trackHitsInChamber[i].momentumAtEntry()<<" "<<trackHitsInChamber[i].energyLoss()<<" "
-			<<trackHitsInChamber[i].particleType()<<" "<<trackHitsInChamber[i].trackId()<<std::endl;
+	       std::cout<<"   chamber match: "<<theCSCSimHitMap.pool()[trackHitsInChamber[i]]<<" "<<theCSCSimHitMap.pool()[trackHitsInChamber[i]].exitPoint()<<"  "
+			<<theCSCSimHitMap.pool()[trackHitsInChamber[i]].momentumAtEntry()<<" "<<theCSCSimHitMap.pool()[trackHitsInChamber[i]].energyLoss()<<" "
+			<<theCSCSimHitMap.pool()[trackHitsInChamber[i]].particleType()<<" "<<theCSCSimHitMap.pool()[trackHitsInChamber[i]].trackId()<<std::endl;
 	     
 	     if (!me1a_no_overlap) match->ALCTs.push_back(malct);
 	     if (me1a_all) match->ALCTs.push_back(malct1a);
@@ -1466,8 +1443,11 @@ SimpleMuon::matchCSCAnodeHits(const std::vector<CSCAnodeLayerInfo>& allLayerInfo
 	  for (unsigned i = 0; i < thisLayerHits.size(); i++) 
 	    std::cout<<"      SimHit # " << i <<": "<< thisLayerHits[i] << "\n";
 	}
-	matchedHit.push_back(thisLayerHits[0]);
-	nhits++;
+	MatchCSCMuL1::HitIndex idx = theCSCSimHitMap.pool().find(thisLayerHits[0]);
+	if (idx != SimHitAnalysis::PSimHitPool::invalidIndex) {
+	  matchedHit.push_back(idx);
+	  nhits++;
+	}
 	break;
       }
     }
@@ -1491,8 +1471,12 @@ SimpleMuon::matchCSCAnodeHits(const std::vector<CSCAnodeLayerInfo>& allLayerInfo
 	  //    std::cout<<"   "<<thisLayerHits[i]<<" "<<thisLayerHits[i].exitPoint()<<"  "<<thisLayerHits[i].momentumAtEntry()
 	  //        <<" "<<thisLayerHits[i].energyLoss()<<" "<<thisLayerHits[i].particleType()<<" "<<thisLayerHits[i].trackId()<<std::endl;
 	  //}
-	  matchedHit.insert(matchedHit.end(), thisLayerHits.begin(), thisLayerHits.end());
-	  nhits += thisLayerHits.size();
+	  for (unsigned i = 0; i < thisLayerHits.size(); i++) {
+	    MatchCSCMuL1::HitIndex idx = theCSCSimHitMap.pool().find(thisLayerHits[i]);
+	    if (idx == SimHitAnalysis::PSimHitPool::invalidIndex) continue;
+	    matchedHit.push_back(idx);
+	    nhits++;
+	  }
 	}
     }
   
@@ -1645,7 +1629,7 @@ SimpleMuon::matchSimTrack2CLCTs(MatchCSCMuL1 *match,
 	    cid = id1a;
 	  }
 
-	  std::vector<PSimHit> trackHitsInChamber = match->chamberHits(cid.rawId());
+	  MatchCSCMuL1::HitIndexRange trackHitsInChamber = match->chamberHits(cid.rawId());
 
 	  if (trackHitsInChamber.size()==0) // no point to do any matching here
 	    {
@@ -1663,7 +1647,7 @@ SimpleMuon::matchSimTrack2CLCTs(MatchCSCMuL1 *match,
 	  std::vector<CSCCathodeLayerInfo> clctInfo;
 	  //std::vector<CSCCathodeLayerInfo> clctInfo = clct_analyzer.getSimInfo(*digiIt, cid, compdc, allCSCSimHits);
 
-	  std::vector<PSimHit> matchedHits;
+	  MatchCSCMuL1::HitIndices matchedHits;
 	  unsigned nmhits = matchCSCCathodeHits(clctInfo, matchedHits);
 
 	  MatchCSCMuL1::CLCT mclct(match);
@@ -1691,8 +1675,7 @@ SimpleMuon::matchSimTrack2CLCTs(MatchCSCMuL1 *match,
 		  //                   <<matchedHits[i].momentumAtEntry()<<" "<<matchedHits[i].energyLoss()<<" "
 		  //                   <<matchedHits[i].particleType()<<" "<<matchedHits[i].trackId();
 		  //bool wasmatch = 0;
-		  for (unsigned j=0; j<trackHitsInChamber.size(); j++)
-		    if ( compareSimHits ( matchedHits[i], trackHitsInChamber[j] ) )
+		  if ( trackHitsInChamber.contains( matchedHits[i] ) )
 		      {
 			nHitsMatch++;
 			//wasmatch = 1;
@@ -1710,9 +1693,9 @@ SimpleMuon::matchSimTrack2CLCTs(MatchCSCMuL1 *match,
 	      if ( fabs(mclct.deltaY)<= minDeltaYCathode_)
 		{
 		  if (debugCLCT)  for (unsigned i=0; i<trackHitsInChamber.size();i++)
-				    std::cout<<"   DY match: "<<trackHitsInChamber[i]<<" "<<trackHitsInChamber[i].exitPoint()<<"  "
-					<<trackHitsInChamber[i].momentumAtEntry()<<" "<<trackHitsInChamber[i].energyLoss()<<" "
-					<<trackHitsInChamber[i].particleType()<<" "<<trackHitsInChamber[i].trackId()<<std::endl;
+				    std::cout<<"   DY match: "<<theCSCSimHitMap.pool()[trackHitsInChamber[i]]<<" "<<theCSCSimHitMap.pool()[trackHitsInChamber[i]].exitPoint()<<"  "
+					<<theCSCSimHitMap.pool()[trackHitsInChamber[i]].momentumAtEntry()<<" "<<theCSCSimHitMap.pool()[trackHitsInChamber[i]].energyLoss()<<" "
+					<<theCSCSimHitMap.pool()[trackHitsInChamber[i]].particleType()<<" "<<theCSCSimHitMap.pool()[trackHitsInChamber[i]].trackId()<<std::endl;
   
 		  match->CLCTs.push_back(mclct);
 		  continue;
@@ -1720,9 +1703,9 @@ SimpleMuon::matchSimTrack2CLCTs(MatchCSCMuL1 *match,
 	      if ( minDeltaYCathode_ < 0  )
 		{
 		  if (debugCLCT)  for (unsigned i=0; i<trackHitsInChamber.size();i++)
-				    std::cout<<"   chamber match: "<<trackHitsInChamber[i]<<" "<<trackHitsInChamber[i].exitPoint()<<"  "
-					<<trackHitsInChamber[i].momentumAtEntry()<<" "<<trackHitsInChamber[i].energyLoss()<<" "
-					<<trackHitsInChamber[i].particleType()<<" "<<trackHitsInChamber[i].trackId()<<std::endl;
+				    std::cout<<"   chamber match: "<<theCSCSimHitMap.pool()[trackHitsInChamber[i]]<<" "<<theCSCSimHitMap.pool()[trackHitsInChamber[i]].exitPoint()<<"  "
+					<<theCSCSimHitMap.pool()[trackHitsInChamber[i]].momentumAtEntry()<<" "<<theCSCSimHitMap.pool()[trackHitsInChamber[i]].energyLoss()<<" "
+					<<theCSCSimHitMap.pool()[trackHitsInChamber[i]].particleType()<<" "<<theCSCSimHitMap.pool()[trackHitsInChamber[i]].trackId()<<std::endl;
   
 		  match->CLCTs.push_back(mclct);
 		  continue;
@@ -1801,8 +1784,11 @@ SimpleMuon::matchCSCCathodeHits(const std::vector<CSCCathodeLayerInfo>& allLayer
 		  for (unsigned i = 0; i < thisLayerHits.size(); i++) 
 		    std::cout<<"      SimHit # " << i <<": "<< thisLayerHits[i] << "\n";
 		}
-	      matchedHit.push_back(thisLayerHits[0]);
-	      nhits++;
+	      MatchCSCMuL1::HitIndex idx = theCSCSimHitMap.pool().find(thisLayerHits[0]);
+	      if (idx != SimHitAnalysis::PSimHitPool::invalidIndex) {
+		matchedHit.push_back(idx);
+		nhits++;
+	      }
 	      break;
 	    }
 	}
@@ -1826,8 +1812,12 @@ SimpleMuon::matchCSCCathodeHits(const std::vector<CSCCathodeLayerInfo>& allLayer
 	  //    std::cout<<"   "<<thisLayerHits[i]<<" "<<thisLayerHits[i].exitPoint()<<"  "<<thisLayerHits[i].momentumAtEntry()
 	  //        <<" "<<thisLayerHits[i].energyLoss()<<" "<<thisLayerHits[i].particleType()<<" "<<thisLayerHits[i].trackId()<<std::endl;
 	  //}
-	  matchedHit.insert(matchedHit.end(), thisLayerHits.begin(), thisLayerHits.end());
-	  nhits += thisLayerHits.size();
+	  for (unsigned i = 0; i < thisLayerHits.size(); i++) {
+	    MatchCSCMuL1::HitIndex idx = theCSCSimHitMap.pool().find(thisLayerHits[i]);
+	    if (idx == SimHitAnalysis::PSimHitPool::invalidIndex) continue;
+	    matchedHit.push_back(idx);
+	    nhits++;
+	  }
 	}
     }
   
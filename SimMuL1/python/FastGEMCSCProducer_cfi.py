@@ -32,6 +32,22 @@ FastGEMCSCProducer = cms.EDProducer("FastGEMCSCProducer",
     maxEta = cms.untracked.double(2.4),
     usePropagatedDPhi = cms.bool(True),
     useLCTPosition = cms.bool(True),
+    # reseed the smearing in every event from (seed, run, lumi, event, label): independent of the event order
+    eventSeededSmearing = cms.untracked.bool(True),
+    # stub line fits: "closedForm", "TLinearFitter", or "validate" (closed-form checked against TLinearFitter)
+    stubFitter = cms.untracked.string("closedForm"),
+    # compute the sums of squared residuals of the stub fits
+    stubFitChi2 = cms.untracked.bool(False),
+    # propagated GEM dphi from a table: "off", "lut" (propagate only for the empty bins),
+    # "validate" (propagate and report the table residuals), "calibrate" (propagate and write the table)
+    dphiLUTMode = cms.untracked.string("off"),
+    dphiLUTFile = cms.untracked.string(""),
+    # table binning (has to be the same in the calibration and in the usage);
+    # the dphi is interpolated linearly in q/pt between the centres of the q/pt bins
+    dphiLUTHalfStripsPerBin = cms.untracked.int32(8),
+    dphiLUTWireGroupsPerBin = cms.untracked.int32(4),
+    dphiLUTQPtBins = cms.untracked.int32(40),
+    dphiLUTMaxQPt = cms.untracked.double(0.5),
     # index-to-chamber-type: 0:dummy, 1:ME1/a, 2:ME1/b, 3:ME1/2, 4:ME1/3, 5: ME2/1, ...
     #zOddGEM = cms.vdouble(-1., -1., 569.7, -1., -1., 798.3, -1., -1., -1., -1., -1.), # comparable to ME11
     #zEvenGEM = cms.vdouble(-1., -1., 567.6, -1., -1., 796.2, -1., -1., -1., -1., -1.),# comparable to ME11
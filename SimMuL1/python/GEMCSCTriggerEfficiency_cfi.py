@@ -24,6 +24,11 @@ GEMCSCTriggerEfficiency = cms.EDAnalyzer("GEMCSCTriggerEfficiency",
     maxDeltaWire = cms.untracked.int32(2),
     minDeltaStrip = cms.untracked.int32(2),
     lightRun = cms.untracked.bool(False),
+    ## histograms: all booked and written (True: booked at first fill, never filled ones are not written),
+    ## selected by wildcard name patterns
+    lazyHistogramBooking = cms.untracked.bool(False),
+    histogramsInclude = cms.untracked.vstring("*"),
+    histogramsExclude = cms.untracked.vstring(),
     minNStWith4Hits = cms.untracked.int32(0),
     ## looser requirement on the number of chamber hits
     minNHitsChamber = cms.untracked.int32(3),
@@ -32,6 +37,10 @@ GEMCSCTriggerEfficiency = cms.EDAnalyzer("GEMCSCTriggerEfficiency",
     gemPTs = cms.vdouble(0., 5., 6., 10., 15., 20., 30., 40.),
     gemDPhisOdd = cms.vdouble(1., 0.02203511, 0.0182579,   0.01066 , 0.00722795 , 0.00562598 , 0.00416544 , 0.00342827),
     gemDPhisEven = cms.vdouble(1., 0.00930056, 0.00790009, 0.00483286, 0.0036323, 0.00304879, 0.00253782, 0.00230833),
+    ## more bending angle working points, each with its own "<name>_<label>" dphigem1b histograms, e.g.,
+    ## cms.PSet(label = cms.untracked.string("pt10"), gemPTs = cms.vdouble(0.),
+    ##          gemDPhisOdd = cms.vdouble(0.01066), gemDPhisEven = cms.vdouble(0.00483286))
+    gemDPhiWorkingPoints = cms.untracked.VPSet(),
     ## simtrack cuts
     minSimTrPt = cms.untracked.double(2.),
     minSimTrPhi = cms.untracked.double(-3.15),
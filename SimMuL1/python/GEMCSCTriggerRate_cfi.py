@@ -11,6 +11,11 @@ GEMCSCTriggerRate = cms.EDAnalyzer("GEMCSCTriggerRate",
     maxBxLCT = cms.untracked.int32(7),
     minBxMPLCT = cms.untracked.int32(5),
     maxBxMPLCT = cms.untracked.int32(7),
+    ## GEM bending angle working points, each with its own "h_rt_gmt_csc_ptmax_*_<label>" rate histograms
+    ## for the candidates whose ME1/b stub passes the cut, e.g.,
+    ## cms.PSet(label = cms.untracked.string("pt10"), gemPTs = cms.vdouble(0.),
+    ##          gemDPhisOdd = cms.vdouble(0.01066), gemDPhisEven = cms.vdouble(0.00483286))
+    gemDPhiWorkingPoints = cms.untracked.VPSet(),
     sectorProcessor = cms.untracked.PSet(),
     strips = cms.untracked.PSet()
 )
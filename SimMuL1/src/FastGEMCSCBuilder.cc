@@ -11,6 +11,11 @@
 
 #include "GEMCode/GEMValidation/src/SimTrackMatchManager.h"
 
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <algorithm>
+#include <cmath>
+
 using namespace std;
 using namespace matching;
 
@@ -20,12 +25,52 @@ FastGEMCSCBuilder::FastGEMCSCBuilder(const edm::ParameterSet& ps, CLHEP::HepRand
 , zEvenGEM_(ps.getParameter<vector<double> >("zEvenGEM"))
 , phiSmearCSC_(ps.getParameter<vector<double> >("phiSmearCSC"))
 , phiSmearGEM_(ps.getParameter<vector<double> >("phiSmearGEM"))
-, fitterXZ_(new TLinearFitter(1, "pol1"))
-, fitterYZ_(new TLinearFitter(1, "pol1"))
+, fit_mode_(FIT_CLOSED_FORM)
+, fit_chi2_(ps.getUntrackedParameter<bool>("stubFitChi2", false))
 , flat_(new CLHEP::RandFlat(eng))
+, n_fit_checks_(0)
+, n_fit_mismatches_(0)
+, n_fit_failures_(0)
+, lut_mode_(LUT_OFF)
+, lut_file_(ps.getUntrackedParameter<string>("dphiLUTFile", ""))
+, n_lut_found_(0)
+, n_lut_missing_(0)
+, lut_res_sum_(0.)
+, lut_res_sum2_(0.)
+, lut_res_max_(0.)
 {
-  fitterXZ_->StoreData(1);
-  fitterYZ_->StoreData(1);
+  string fitter = ps.getUntrackedParameter<string>("stubFitter", "closedForm");
+  if (fitter == "closedForm") fit_mode_ = FIT_CLOSED_FORM;
+  else if (fitter == "TLinearFitter") fit_mode_ = FIT_TLINEARFITTER;
+  else if (fitter == "validate") fit_mode_ = FIT_VALIDATE;
+  else throw cms::Exception("Configuration") << "FastGEMCSCBuilder: unknown stubFitter "<< fitter
+    <<"; use closedForm, TLinearFitter or validate\n";
+
+  string lut_mode = ps.getUntrackedParameter<string>("dphiLUTMode", "off");
+  if (lut_mode == "off") lut_mode_ = LUT_OFF;
+  else if (lut_mode == "lut") lut_mode_ = LUT_USE;
+  else if (lut_mode == "validate") lut_mode_ = LUT_VALIDATE;
+  else if (lut_mode == "calibrate") lut_mode_ = LUT_CALIBRATE;
+  else throw cms::Exception("Configuration") << "FastGEMCSCBuilder: unknown dphiLUTMode "<< lut_mode
+    <<"; use off, lut, validate or calibrate\n";
+
+  if (lut_mode_ != LUT_OFF)
+  {
+    if (lut_file_.empty()) throw cms::Exception("Configuration") << "FastGEMCSCBuilder: dphiLUTFile is needed for dphiLUTMode "<< lut_mode <<"\n";
+    dphi_lut_.reset(new GEMCSCDPhiLUT(
+        ps.getUntrackedParameter<int>("dphiLUTHalfStripsPerBin", 8),
+        ps.getUntrackedParameter<int>("dphiLUTWireGroupsPerBin", 4),
+        ps.getUntrackedParameter<int>("dphiLUTQPtBins", 40),
+        ps.getUntrackedParameter<double>("dphiLUTMaxQPt", 0.5) ));
+  }
+
+  if (fit_mode_ != FIT_CLOSED_FORM)
+  {
+    fitterXZ_.reset(new TLinearFitter(1, "pol1"));
+    fitterYZ_.reset(new TLinearFitter(1, "pol1"));
+    fitterXZ_->StoreData(1);
+    fitterYZ_->StoreData(1);
+  }
 
   // these configuration vectors have to have 1+10 elements corresponding to 10 chamber types
   assert(zOddGEM_.size() == 11);
@@ -44,6 +89,47 @@ FastGEMCSCBuilder::FastGEMCSCBuilder(const edm::ParameterSet& ps, CLHEP::HepRand
 }
 
 
+FastGEMCSCBuilder::~FastGEMCSCBuilder()
+{
+  if (n_fit_failures_ > 0)
+  {
+    cout<<"FastGEMCSCBuilder: "<<n_fit_failures_<<" chambers without a stub, their hits did not define a line"<<endl;
+  }
+  if (fit_mode_ == FIT_VALIDATE)
+  {
+    cout<<"FastGEMCSCBuilder: closed-form stub fits validated with TLinearFitter: "
+        <<n_fit_mismatches_<<" mismatches in "<<n_fit_checks_<<" fits"<<endl;
+  }
+}
+
+
+void FastGEMCSCBuilder::beginJob()
+{
+  if (lut_mode_ == LUT_USE || lut_mode_ == LUT_VALIDATE) dphi_lut_->read(lut_file_);
+}
+
+
+void FastGEMCSCBuilder::endJob()
+{
+  if (lut_mode_ == LUT_CALIBRATE)
+  {
+    dphi_lut_->write(lut_file_);
+    cout<<"FastGEMCSCBuilder: bending angle table is written to "<<lut_file_<<endl;
+  }
+  if (lut_mode_ == LUT_USE)
+  {
+    cout<<"FastGEMCSCBuilder: bending angles from the table for "<<n_lut_found_<<" stubs, propagated for "<<n_lut_missing_<<" stubs"<<endl;
+  }
+  if (lut_mode_ == LUT_VALIDATE)
+  {
+    double mean = n_lut_found_ ? lut_res_sum_ / n_lut_found_ : 0.;
+    double rms = n_lut_found_ ? sqrt(std::max(0., lut_res_sum2_ / n_lut_found_ - mean * mean)) : 0.;
+    cout<<"FastGEMCSCBuilder: table - propagation dphi residuals for "<<n_lut_found_<<" stubs (not in the table: "<<n_lut_missing_<<"): "
+        <<" mean "<<mean<<" rms "<<rms<<" max |res| "<<lut_res_max_<<endl;
+  }
+}
+
+
 std::vector<unsigned int> FastGEMCSCBuilder::getChamberIds()
 {
   std::vector<unsigned int> result;
@@ -101,6 +187,9 @@ void FastGEMCSCBuilder::build(const SimHitMatcher& match_sh)
     // we find xz0, xz1, yz0, yz1 from linear fits
 
     //cout<<" hitXZ ";
+    fitXZ_.clear();
+    fitYZ_.clear();
+    fit_points_.clear();
     const auto& hits = match_sh.hitsInChamber(d);
     for (auto& h: hits)
     {
@@ -111,26 +200,80 @@ void FastGEMCSCBuilder::build(const SimHitMatcher& match_sh)
       //LocalPoint lp = csc_geo_->idToDet(id.chamberId())->surface().toLocal(gp);
       //cout<< lp.x() <<" "<<gp.z()<<"  ";
 
-      double z[1] = {gp.z()};
-      fitterXZ_->AddPoint(z, gp.x()); // x(z)
-      fitterYZ_->AddPoint(z, gp.y()); // y(z)
+      fitXZ_.addPoint(gp.z(), gp.x()); // x(z)
+      fitYZ_.addPoint(gp.z(), gp.y()); // y(z)
+      if (fit_chi2_ || fit_mode_ != FIT_CLOSED_FORM) fit_points_.push_back(gp);
     }
     //cout<<endl;
-    fitterXZ_->Eval();
-    fitterYZ_->Eval();
+    // no line through hits without distinct z's: no stub from such a chamber
+    if (!fitXZ_.eval() || !fitYZ_.eval())
+    {
+      ++n_fit_failures_;
+      continue;
+    }
 
-    stub.setFitParameters(
-        fitterXZ_->GetParameter(0), fitterXZ_->GetParameter(1),
-        fitterYZ_->GetParameter(0), fitterYZ_->GetParameter(1) );
+    double xz0 = fitXZ_.p0(), xz1 = fitXZ_.p1();
+    double yz0 = fitYZ_.p0(), yz1 = fitYZ_.p1();
 
-    //double xz0e = fitterXZ_->GetParError(0);
-    //double xz1e = fitterXZ_->GetParError(1);
-    //double yz0e = fitterYZ_->GetParError(0);
-    //double yz1e = fitterYZ_->GetParError(1);
+    if (fit_mode_ != FIT_CLOSED_FORM)
+    {
+      for (auto& gp: fit_points_)
+      {
+        double z[1] = {gp.z()};
+        fitterXZ_->AddPoint(z, gp.x());
+        fitterYZ_->AddPoint(z, gp.y());
+      }
+      fitterXZ_->Eval();
+      fitterYZ_->Eval();
+
+      double fxz0 = fitterXZ_->GetParameter(0), fxz1 = fitterXZ_->GetParameter(1);
+      double fyz0 = fitterYZ_->GetParameter(0), fyz1 = fitterYZ_->GetParameter(1);
 
-    // clean-up the fitters
-    fitterXZ_->ClearPoints();
-    fitterYZ_->ClearPoints();
+      //double xz0e = fitterXZ_->GetParError(0);
+      //double xz1e = fitterXZ_->GetParError(1);
+      //double yz0e = fitterYZ_->GetParError(0);
+      //double yz1e = fitterYZ_->GetParError(1);
+
+      // clean-up the fitters
+      fitterXZ_->ClearPoints();
+      fitterYZ_->ClearPoints();
+
+      if (fit_mode_ == FIT_TLINEARFITTER)
+      {
+        xz0 = fxz0; xz1 = fxz1;
+        yz0 = fyz0; yz1 = fyz1;
+      }
+      else
+      {
+        // compare the lines at the chamber's z, where the intercepts are well defined
+        double zc = fit_points_.front().z();
+        double dx = std::abs((xz0 + xz1*zc) - (fxz0 + fxz1*zc));
+        double dy = std::abs((yz0 + yz1*zc) - (fyz0 + fyz1*zc));
+        ++n_fit_checks_;
+        if (dx > 1.e-4 || dy > 1.e-4 || std::abs(xz1 - fxz1) > 1.e-6 || std::abs(yz1 - fyz1) > 1.e-6)
+        {
+          ++n_fit_mismatches_;
+          cout<<"FastGEMCSCBuilder fit mismatch in "<<id<<": closed-form ("<<xz0<<", "<<xz1<<", "<<yz0<<", "<<yz1
+              <<") TLinearFitter ("<<fxz0<<", "<<fxz1<<", "<<fyz0<<", "<<fyz1<<")"<<endl;
+        }
+      }
+    }
+
+    stub.setFitParameters(xz0, xz1, yz0, yz1);
+
+    // second pass for the residuals
+    if (fit_chi2_)
+    {
+      double chi2x = 0., chi2y = 0.;
+      for (auto& gp: fit_points_)
+      {
+        double rx = gp.x() - xz0 - xz1 * gp.z();
+        double ry = gp.y() - yz0 - yz1 * gp.z();
+        chi2x += rx*rx;
+        chi2y += ry*ry;
+      }
+      stub.setFitChi2(chi2x, chi2y);
+    }
 
     // --- find stub global position at CSC chamber key layer
     CSCDetId key_id(id.endcap(), id.station(), id.ring(), id.chamber(), CSCConstants::KEY_CLCT_LAYER);
@@ -162,9 +305,48 @@ void FastGEMCSCBuilder::build(const SimHitMatcher& match_sh)
     }
     stub.setGEMLinear( gp_gem_lin );
 
-    // propagate to z_gem
-    GlobalVector inner_vector = match_sh.trk().momentum().P() * stub.direction();
-    GlobalPoint gp_gem_prop = match_sh.propagateToZ(gp_csc, inner_vector, z_gem);
+    // table bin of the stub at the key layer
+    int lut_index = -1;
+    const double qpt = t.charge() / t.momentum().pt();
+    if (lut_mode_ != LUT_OFF)
+    {
+      const CSCLayerGeometry* key_geo = csc_geo_->layer(key_id)->geometry();
+      LocalPoint lp_key = csc_geo_->idToDet(key_id)->surface().toLocal(gp_csc);
+      int hs = 1 + int(2. * key_geo->strip(lp_key));
+      int wg = key_geo->wireGroup(key_geo->nearestWire(lp_key));
+      lut_index = dphi_lut_->index(ch_type, odd, hs, wg, qpt);
+    }
+    double lut_dphi = 0.;
+    bool in_lut = (lut_mode_ == LUT_USE || lut_mode_ == LUT_VALIDATE) && dphi_lut_->get(lut_index, qpt, lut_dphi);
+    if (lut_mode_ == LUT_USE || lut_mode_ == LUT_VALIDATE)
+    {
+      if (in_lut) ++n_lut_found_;
+      else ++n_lut_missing_;
+    }
+
+    GlobalPoint gp_gem_prop;
+    if (lut_mode_ == LUT_USE && in_lut)
+    {
+      // the propagated point is rotated in phi by the tabulated bending angle w.r.t. the CSC stub
+      GlobalPoint gp_lin = stub.globalPointAtZ( z_gem );
+      gp_gem_prop = GlobalPoint(GlobalPoint::Cylindrical(gp_lin.perp(), gp_csc.phi().value() - lut_dphi, z_gem));
+    }
+    else
+    {
+      // propagate to z_gem
+      GlobalVector inner_vector = match_sh.trk().momentum().P() * stub.direction();
+      gp_gem_prop = match_sh.propagateToZ(gp_csc, inner_vector, z_gem);
+
+      double dphi = deltaPhi(gp_csc.phi(), gp_gem_prop.phi());
+      if (lut_mode_ == LUT_CALIBRATE) dphi_lut_->fill(lut_index, dphi);
+      if (lut_mode_ == LUT_VALIDATE && in_lut)
+      {
+        double res = lut_dphi - dphi;
+        lut_res_sum_ += res;
+        lut_res_sum2_ += res * res;
+        lut_res_max_ = std::max(lut_res_max_, std::abs(res));
+      }
+    }
     if (smear_gem > 0.)
     {
       auto theta = gp_gem_prop.theta(); // Geom::Theta<> object
@@ -206,7 +388,9 @@ void FastGEMCSCBuilder::build(const SimHitMatcher& match_sh)
 
 
 SimStub::SimStub(double z_gem)
-: z_gem_(z_gem)
+: chi2_x_(-1.)
+, chi2_y_(-1.)
+, z_gem_(z_gem)
 , min_hs_(999)
 , max_hs_(-1)
 , min_wg_(999)
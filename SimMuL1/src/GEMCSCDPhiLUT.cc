@@ -0,0 +1,122 @@
+#include "GEMCode/SimMuL1/interface/GEMCSCDPhiLUT.h"
+
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <fstream>
+#include <iomanip>
+#include <cmath>
+#include <algorithm>
+
+//_____________________________________________________________________________
+GEMCSCDPhiLUT::GEMCSCDPhiLUT(int half_strips_per_bin, int wire_groups_per_bin, int qpt_bins, double max_qpt):
+  hs_per_bin_(half_strips_per_bin), wg_per_bin_(wire_groups_per_bin), qpt_bins_(qpt_bins), max_qpt_(max_qpt)
+{
+  if (hs_per_bin_ < 1 || wg_per_bin_ < 1 || qpt_bins_ < 1 || max_qpt_ <= 0.)
+    throw cms::Exception("Configuration") << "GEMCSCDPhiLUT: bad binning "
+      << hs_per_bin_ <<" "<< wg_per_bin_ <<" "<< qpt_bins_ <<" "<< max_qpt_ <<"\n";
+
+  hs_bins_ = (MAX_HALF_STRIPS + hs_per_bin_ - 1) / hs_per_bin_;
+  wg_bins_ = (MAX_WIRE_GROUPS + wg_per_bin_ - 1) / wg_per_bin_;
+  sum_.assign(CH_TYPES * 2 * hs_bins_ * wg_bins_ * qpt_bins_, 0.);
+  n_.assign(sum_.size(), 0);
+}
+
+
+//_____________________________________________________________________________
+int
+GEMCSCDPhiLUT::index(int ch_type, bool odd, int hs, int wg, double qpt) const
+{
+  if (ch_type < 1 || ch_type >= CH_TYPES) return -1;
+  if (hs < 1 || hs > MAX_HALF_STRIPS || wg < 1 || wg > MAX_WIRE_GROUPS) return -1;
+  if (std::abs(qpt) >= max_qpt_) return -1;
+
+  int hs_bin = (hs - 1) / hs_per_bin_;
+  int wg_bin = (wg - 1) / wg_per_bin_;
+  // rounding can push |qpt| just below max_qpt_ into the next wiregroup bin
+  int qpt_bin = std::min(int(qpt_bins_ * (qpt + max_qpt_) / (2. * max_qpt_)), qpt_bins_ - 1);
+  return (((ch_type * 2 + odd) * hs_bins_ + hs_bin) * wg_bins_ + wg_bin) * qpt_bins_ + qpt_bin;
+}
+
+
+//_____________________________________________________________________________
+bool
+GEMCSCDPhiLUT::get(int index, double qpt, double &dphi) const
+{
+  if (index < 0 || n_[index] == 0) return false;
+  dphi = sum_[index] / n_[index];
+
+  // interpolate with the neighbouring q/pt bin on the side of qpt, if it is filled
+  const int qpt_bin = index % qpt_bins_;
+  const double width = 2. * max_qpt_ / qpt_bins_;
+  const double centre = -max_qpt_ + (qpt_bin + 0.5) * width;
+  const int next_bin = (qpt < centre) ? qpt_bin - 1 : qpt_bin + 1;
+  if (next_bin < 0 || next_bin >= qpt_bins_) return true;
+  const int next = index - qpt_bin + next_bin;
+  if (n_[next] == 0) return true;
+  dphi += std::abs(qpt - centre) / width * (sum_[next] / n_[next] - dphi);
+  return true;
+}
+
+
+//_____________________________________________________________________________
+void
+GEMCSCDPhiLUT::fill(int index, double dphi)
+{
+  if (index < 0) return;
+  sum_[index] += dphi;
+  n_[index] += 1;
+}
+
+
+//_____________________________________________________________________________
+void
+GEMCSCDPhiLUT::read(const std::string &file_name)
+{
+  std::ifstream f(file_name.c_str());
+  if (!f) throw cms::Exception("Configuration") << "GEMCSCDPhiLUT: cannot read "<< file_name <<"\n";
+
+  std::string tag;
+  int hs_per_bin, wg_per_bin, qpt_bins;
+  double max_qpt;
+  f >> tag >> hs_per_bin >> wg_per_bin >> qpt_bins >> max_qpt;
+  if (!f || tag != "GEMCSCDPhiLUT" || hs_per_bin != hs_per_bin_ || wg_per_bin != wg_per_bin_ ||
+      qpt_bins != qpt_bins_ || std::abs(max_qpt - max_qpt_) > 1.e-6)
+    throw cms::Exception("Configuration") << "GEMCSCDPhiLUT: "<< file_name <<" was made with a different binning\n";
+
+  sum_.assign(sum_.size(), 0.);
+  n_.assign(n_.size(), 0);
+  int ch_type, odd, hs_bin, wg_bin, qpt_bin;
+  double dphi;
+  unsigned n;
+  while (f >> ch_type >> odd >> hs_bin >> wg_bin >> qpt_bin >> dphi >> n)
+  {
+    if (ch_type < 1 || ch_type >= CH_TYPES || odd < 0 || odd > 1 || hs_bin < 0 || hs_bin >= hs_bins_ ||
+        wg_bin < 0 || wg_bin >= wg_bins_ || qpt_bin < 0 || qpt_bin >= qpt_bins_ || n == 0)
+      throw cms::Exception("Configuration") << "GEMCSCDPhiLUT: bad bin in "<< file_name <<"\n";
+    int i = (((ch_type * 2 + odd) * hs_bins_ + hs_bin) * wg_bins_ + wg_bin) * qpt_bins_ + qpt_bin;
+    sum_[i] = dphi * n;
+    n_[i] = n;
+  }
+}
+
+
+//_____________________________________________________________________________
+void
+GEMCSCDPhiLUT::write(const std::string &file_name) const
+{
+  std::ofstream f(file_name.c_str());
+  if (!f) throw cms::Exception("Configuration") << "GEMCSCDPhiLUT: cannot write "<< file_name <<"\n";
+
+  f << "GEMCSCDPhiLUT " << hs_per_bin_ <<" "<< wg_per_bin_ <<" "<< qpt_bins_ <<" "<< max_qpt_ << std::endl;
+  f << std::setprecision(8);
+  size_t i = 0;
+  for (int t = 0; t < CH_TYPES; ++t)
+    for (int odd = 0; odd < 2; ++odd)
+      for (int h = 0; h < hs_bins_; ++h)
+        for (int w = 0; w < wg_bins_; ++w)
+          for (int q = 0; q < qpt_bins_; ++q, ++i)
+          {
+            if (n_[i] == 0) continue;
+            f << t <<" "<< odd <<" "<< h <<" "<< w <<" "<< q <<" "<< sum_[i] / n_[i] <<" "<< n_[i] << std::endl;
+          }
+}
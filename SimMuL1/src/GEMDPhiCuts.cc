@@ -0,0 +1,74 @@
+#include "GEMCode/SimMuL1/interface/GEMDPhiCuts.h"
+
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <algorithm>
+#include <cstdio>
+
+//_____________________________________________________________________________
+GEMDPhiCuts::GEMDPhiCuts(const edm::ParameterSet & ps, const std::string & default_label):
+  label_(ps.getUntrackedParameter<std::string>("label", default_label)),
+  pts_(ps.getParameter<std::vector<double> >("gemPTs")),
+  dphis_odd_(ps.getParameter<std::vector<double> >("gemDPhisOdd")),
+  dphis_even_(ps.getParameter<std::vector<double> >("gemDPhisEven"))
+{
+  if (pts_.empty() || !std::is_sorted(pts_.begin(), pts_.end()) ||
+      pts_.size() != dphis_odd_.size() || pts_.size() != dphis_even_.size())
+  {
+    throw cms::Exception("Configuration") << "GEMDPhiCuts "<< label_
+      <<": gemPTs has to be sorted and of the same non-zero size as gemDPhisOdd and gemDPhisEven\n";
+  }
+}
+
+
+//_____________________________________________________________________________
+std::vector<GEMDPhiCuts>
+GEMDPhiCuts::workingPoints(const edm::ParameterSet & ps)
+{
+  std::vector<edm::ParameterSet> wp_psets =
+    ps.getUntrackedParameter<std::vector<edm::ParameterSet> >("gemDPhiWorkingPoints", std::vector<edm::ParameterSet>());
+
+  // the pass masks are unsigned
+  if (wp_psets.size() > 8 * sizeof(unsigned) - 1)
+    throw cms::Exception("Configuration") << "too many gemDPhiWorkingPoints: "<< wp_psets.size() <<"\n";
+
+  std::vector<GEMDPhiCuts> result;
+  for (size_t i = 0; i < wp_psets.size(); ++i)
+  {
+    char label[20];
+    sprintf(label, "wp%d", (int)i);
+    result.push_back(GEMDPhiCuts(wp_psets[i], label));
+    for (size_t j = 0; j < i; ++j) if (result[j].label() == result[i].label())
+      throw cms::Exception("Configuration") << "duplicate gemDPhiWorkingPoints label "<< result[i].label() <<"\n";
+  }
+  return result;
+}
+
+
+//_____________________________________________________________________________
+bool
+GEMDPhiCuts::isGood(double dphi, double tfpt, bool is_odd) const
+{
+  // ignore the default/don't-care value of -99
+  if (dphi < -9.) return true;
+
+  // the no-matching-gem case value of +99
+  if (dphi > 9.) return false;
+
+  // the largest pts_ element that is smaller or equal to tfpt
+  auto ub = std::upper_bound(pts_.begin(), pts_.end(), tfpt);
+  if (ub != pts_.begin()) --ub;
+  size_t n = ub - pts_.begin();
+
+  return is_odd ? (dphi <= dphis_odd_[n]) : (dphi <= dphis_even_[n]);
+}
+
+
+//_____________________________________________________________________________
+unsigned
+GEMDPhiCuts::passMask(const std::vector<GEMDPhiCuts> & wps, double dphi, double tfpt, bool is_odd)
+{
+  unsigned mask = 0;
+  for (size_t i = 0; i < wps.size(); ++i) if (wps[i].isGood(dphi, tfpt, is_odd)) mask |= (1u << i);
+  return mask;
+}
@@ -0,0 +1,126 @@
+
+#include "GEMCode/SimMuL1/interface/HistoRegistry.h"
+
+#include "FWCore/ServiceRegistry/interface/Service.h"
+#include "CommonTools/UtilAlgos/interface/TFileService.h"
+
+#include "TRegexp.h"
+#include "TString.h"
+
+namespace {
+
+bool matchesAny(const std::string & name, const std::vector<std::string> & patterns)
+{
+  TString s(name.c_str());
+  for (size_t i = 0; i < patterns.size(); ++i)
+  {
+    // wildcard mode: '*' and '?' as in the shell; the whole name has to match
+    TRegexp re(patterns[i].c_str(), kTRUE);
+    Ssiz_t len = 0;
+    if (re.Index(s, &len) == 0 && len == s.Length()) return true;
+  }
+  return false;
+}
+
+}
+
+
+//_____________________________________________________________________________
+TH1D * makeHisto(const HistoSpec & spec, TH1D *, bool detached)
+{
+  if (detached)
+  {
+    TH1D * h = new TH1D(spec.name.c_str(), spec.title.c_str(), spec.nx, spec.xlo, spec.xhi);
+    h->SetDirectory(0);
+    return h;
+  }
+  edm::Service<TFileService> fs;
+  return fs->make<TH1D>(spec.name.c_str(), spec.title.c_str(), spec.nx, spec.xlo, spec.xhi);
+}
+
+
+//_____________________________________________________________________________
+TH2D * makeHisto(const HistoSpec & spec, TH2D *, bool detached)
+{
+  if (detached)
+  {
+    TH2D * h = new TH2D(spec.name.c_str(), spec.title.c_str(), spec.nx, spec.xlo, spec.xhi, spec.ny, spec.ylo, spec.yhi);
+    h->SetDirectory(0);
+    return h;
+  }
+  edm::Service<TFileService> fs;
+  return fs->make<TH2D>(spec.name.c_str(), spec.title.c_str(), spec.nx, spec.xlo, spec.xhi, spec.ny, spec.ylo, spec.yhi);
+}
+
+
+//_____________________________________________________________________________
+HistoRegistry::HistoRegistry():
+  include_(1, "*")
+{}
+
+
+//_____________________________________________________________________________
+HistoRegistry::~HistoRegistry()
+{
+  // booked enabled histograms are owned by the TFileService
+  for (size_t i = 0; i < h1_.size(); ++i) delete h1_[i];
+  for (size_t i = 0; i < h2_.size(); ++i) delete h2_[i];
+}
+
+
+//_____________________________________________________________________________
+void
+HistoRegistry::configure(const edm::ParameterSet & cfg)
+{
+  include_ = cfg.getUntrackedParameter<std::vector<std::string> >("histogramsInclude", std::vector<std::string>(1, "*"));
+  exclude_ = cfg.getUntrackedParameter<std::vector<std::string> >("histogramsExclude", std::vector<std::string>());
+}
+
+
+//_____________________________________________________________________________
+bool
+HistoRegistry::selected(const std::string & name) const
+{
+  return matchesAny(name, include_) && !matchesAny(name, exclude_);
+}
+
+
+//_____________________________________________________________________________
+LazyTH1D *
+HistoRegistry::book1D(const std::string & name, const std::string & title, int nx, double xlo, double xhi)
+{
+  HistoSpec spec = {name, title, nx, xlo, xhi, 0, 0., 0.};
+  h1_.push_back(new LazyTH1D(spec, selected(name)));
+  return h1_.back();
+}
+
+
+//_____________________________________________________________________________
+LazyTH2D *
+HistoRegistry::book2D(const std::string & name, const std::string & title,
+                      int nx, double xlo, double xhi, int ny, double ylo, double yhi)
+{
+  HistoSpec spec = {name, title, nx, xlo, xhi, ny, ylo, yhi};
+  h2_.push_back(new LazyTH2D(spec, selected(name)));
+  return h2_.back();
+}
+
+
+//_____________________________________________________________________________
+void
+HistoRegistry::bookAll()
+{
+  for (size_t i = 0; i < h1_.size(); ++i) if (h1_[i]->enabled()) h1_[i]->get();
+  for (size_t i = 0; i < h2_.size(); ++i) if (h2_[i]->enabled()) h2_[i]->get();
+}
+
+
+//_____________________________________________________________________________
+unsigned
+HistoRegistry::nBooked() const
+{
+  unsigned n = 0;
+  for (size_t i = 0; i < h1_.size(); ++i) if (h1_[i]->enabled() && h1_[i]->booked()) ++n;
+  for (size_t i = 0; i < h2_.size(); ++i) if (h2_[i]->enabled() && h2_[i]->booked()) ++n;
+  return n;
+}
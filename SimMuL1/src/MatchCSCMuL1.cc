@@ -49,8 +49,8 @@ double ptscale[33] = {
 
 //_____________________________________________________________________________
 // Constructor
-MatchCSCMuL1::MatchCSCMuL1(const SimTrack  *s, const SimVertex *v, const CSCGeometry* g):
-    strk(s), svtx(v), cscGeometry(g)
+MatchCSCMuL1::MatchCSCMuL1(const SimTrack  *s, const SimVertex *v, const CSCGeometry* g, const SimHitAnalysis::PSimHitPool *p):
+    strk(s), svtx(v), cscGeometry(g), hitPool(p), muOnly(false)
 {
   double endcap = (strk->momentum().eta() >= 0) ? 1. : -1.;
   math::XYZVectorD v0(0.000001,0.,endcap);
@@ -60,11 +60,13 @@ MatchCSCMuL1::MatchCSCMuL1(const SimTrack  *s, const SimVertex *v, const CSCGeom
 
 //_____________________________________________________________________________
 void 
-MatchCSCMuL1::addSimHit(PSimHit & h)
+MatchCSCMuL1::addSimHit(HitIndex h)
 {
   simHits.push_back(h);
-  hitsMapLayer[h.detUnitId()].push_back(h);
-  CSCDetId layerId( h.detUnitId() );
+  const PSimHit & hit = simHit(h);
+  if ( muOnly && abs(hit.particleType())!=13 ) return;
+  hitsMapLayer[hit.detUnitId()].push_back(h);
+  CSCDetId layerId( hit.detUnitId() );
   hitsMapChamber[layerId.chamberId().rawId()].push_back(h);
 }
 
@@ -131,7 +133,7 @@ MatchCSCMuL1::nSimHits()
 {
   if (!muOnly) return simHits.size();
   int n=0;
-  for (unsigned j=0; j<simHits.size(); j++) if (abs(simHits[j].particleType())==13 ) n++;
+  for (unsigned j=0; j<simHits.size(); j++) if (abs(simHit(simHits[j]).particleType())==13 ) n++;
   return n;
 }
 
@@ -140,12 +142,12 @@ MatchCSCMuL1::nSimHits()
 std::vector<int> 
 MatchCSCMuL1::detsWithHits()
 {
-  std::set<int> dets;
-  std::map<int, std::vector<PSimHit> >::const_iterator mapItr = hitsMapLayer.begin();
-  for( ; mapItr != hitsMapLayer.end(); ++mapItr) 
-    if ( !muOnly || abs((mapItr->second)[0].particleType())==13 ) 
-      dets.insert(mapItr->first);
-  return std::vector<int>(dets.begin(), dets.end()); 
+  // layer map only holds hits that pass the muOnly selection
+  std::vector<int> dets;
+  dets.reserve(hitsMapLayer.size());
+  std::map<int, HitIndices >::const_iterator mapItr = hitsMapLayer.begin();
+  for( ; mapItr != hitsMapLayer.end(); ++mapItr) dets.push_back(mapItr->first);
+  return dets;
 }
 
 
@@ -153,68 +155,51 @@ MatchCSCMuL1::detsWithHits()
 std::vector<int> 
 MatchCSCMuL1::chambersWithHits(int station, int ring, unsigned minNHits)
 {
-  std::set<int> chambers;
-  std::set<int> layersWithHits;
+  std::vector<int> result;
   
-  std::map<int, std::vector<PSimHit> >::const_iterator mapItr = hitsMapChamber.begin();
+  std::map<int, HitIndices >::const_iterator mapItr = hitsMapChamber.begin();
   for( ; mapItr != hitsMapChamber.end(); ++mapItr){
     CSCDetId cid(mapItr->first);
     if (station && cid.station() != station) continue;
     if (ring && cid.ring() != ring) continue;
-    layersWithHits.clear();
-    for (unsigned i=0; i<(mapItr->second).size(); i++)
-      if ( !muOnly || abs((mapItr->second)[i].particleType())==13 ) {
-        CSCDetId hid((mapItr->second)[i].detUnitId());
-        layersWithHits.insert(hid.layer());
-      }
-    if (layersWithHits.size()>=minNHits) chambers.insert( mapItr->first );
+    if ((unsigned)numberOfLayersWithHitsInChamber(mapItr->first) >= minNHits) result.push_back( mapItr->first );
   }
-  std::vector<int> result( chambers.begin() , chambers.end() );
   return result;
 }
 
 
 //_____________________________________________________________________________
-std::vector<PSimHit>
+MatchCSCMuL1::HitIndexRange
 MatchCSCMuL1::layerHits(int detId)
 {
-  std::vector<PSimHit> result;
-  std::map<int, std::vector<PSimHit> >::const_iterator mapItr = hitsMapLayer.find(detId);
-  if (mapItr == hitsMapLayer.end()) return result;
-  for (unsigned i=0; i<(mapItr->second).size(); i++)
-    if ( !muOnly || abs((mapItr->second)[i].particleType())==13 ) 
-      result.push_back((mapItr->second)[i]);
-  return result;
+  std::map<int, HitIndices >::const_iterator mapItr = hitsMapLayer.find(detId);
+  if (mapItr == hitsMapLayer.end()) return HitIndexRange(noHits.begin(), noHits.end());
+  return HitIndexRange((mapItr->second).begin(), (mapItr->second).end());
 }
 
 
 //_____________________________________________________________________________
-std::vector<PSimHit>
+MatchCSCMuL1::HitIndexRange
 MatchCSCMuL1::chamberHits(int detId)
 {
   // foolproof chamber id
   CSCDetId dId(detId);
   CSCDetId chamberId = dId.chamberId();
 
-  std::vector<PSimHit> result;
-  std::map<int, std::vector<PSimHit> >::const_iterator mapItr = hitsMapChamber.find(chamberId);
-  if (mapItr == hitsMapChamber.end()) return result;
-  for (unsigned i=0; i<(mapItr->second).size(); i++)
-    if ( !muOnly || abs((mapItr->second)[i].particleType())==13 ) 
-      result.push_back((mapItr->second)[i]);
-
-  return result;
+  std::map<int, HitIndices >::const_iterator mapItr = hitsMapChamber.find(chamberId.rawId());
+  if (mapItr == hitsMapChamber.end()) return HitIndexRange(noHits.begin(), noHits.end());
+  return HitIndexRange((mapItr->second).begin(), (mapItr->second).end());
 }
 
 
 //_____________________________________________________________________________
-std::vector<PSimHit> 
+MatchCSCMuL1::HitIndices
 MatchCSCMuL1::allSimHits()
 {
   if (!muOnly) return simHits;
-  std::vector<PSimHit> result;
+  HitIndices result;
   for (unsigned j=0; j<simHits.size(); j++) 
-    if (abs(simHits[j].particleType())==13 ) 
+    if (abs(simHit(simHits[j]).particleType())==13 ) 
       result.push_back(simHits[j]);
   return result;
 }
@@ -224,16 +209,18 @@ MatchCSCMuL1::allSimHits()
 int
 MatchCSCMuL1::numberOfLayersWithHitsInChamber(int detId)
 {
-  std::set<int> layersWithHits;
+  // 6-bit mask of layers with hits
+  unsigned layersWithHits = 0;
 
-  std::vector<PSimHit> chHits = chamberHits(detId);
-  for (unsigned i = 0; i < chHits.size(); i++) 
+  HitIndexRange chHits = chamberHits(detId);
+  for (HitIndices::const_iterator h = chHits.begin(); h != chHits.end(); ++h)
   {
-    CSCDetId hid(chHits[i].detUnitId());
-    if ( !muOnly || abs(chHits[i].particleType())==13 ) 
-      layersWithHits.insert(hid.layer());
+    CSCDetId hid(simHit(*h).detUnitId());
+    layersWithHits |= 1u << hid.layer();
   }
-  return layersWithHits.size();
+  int n = 0;
+  for ( ; layersWithHits; layersWithHits &= layersWithHits - 1) n++;
+  return n;
 }
 
 
@@ -243,9 +230,8 @@ MatchCSCMuL1::wireGroupAndStripInChamber( int detId )
 {
   std::pair<int,int> err_pair(-1,-1);
   
-  std::vector<PSimHit> hits = chamberHits( detId );
-  unsigned n = hits.size();
-  if ( n == 0 ) return err_pair;
+  HitIndexRange hits = chamberHits( detId );
+  if ( hits.empty() ) return err_pair;
 
   if (CSCConstants::KEY_CLCT_LAYER != CSCConstants::KEY_ALCT_LAYER)  std::cout<<"ALARM: KEY_CLCT_LAYER != KEY_ALCT_LAYER"<<std::endl;
 
@@ -253,17 +239,18 @@ MatchCSCMuL1::wireGroupAndStripInChamber( int detId )
   // if no hit in key layer, take the highest energy muon simhit local position
   LocalPoint lpkey(0.,0.,0.), lphe(0.,0.,0.);
   double elosskey=-1., eloss=-1.;
-  for (unsigned i = 0; i < n; i++)
+  for (HitIndices::const_iterator h = hits.begin(); h != hits.end(); ++h)
   {
-    CSCDetId lid(hits[i].detUnitId());
-    double el = hits[i].energyLoss();
+    const PSimHit & hit = simHit(*h);
+    CSCDetId lid(hit.detUnitId());
+    double el = hit.energyLoss();
     if ( el > eloss ) {
-      lphe = hits[i].localPosition();
+      lphe = hit.localPosition();
       eloss = el;
     }
     if (lid.layer() != CSCConstants::KEY_ALCT_LAYER) continue;
     if ( el > elosskey ) {
-      lpkey = hits[i].localPosition();
+      lpkey = hit.localPosition();
       elosskey = el;
     }
   }
@@ -646,11 +633,11 @@ MatchCSCMuL1::print (const char msg[300], bool psimtr, bool psimh,
 
     //self check 
     unsigned ntot=0;
-    std::map<int, std::vector<PSimHit> >::const_iterator mapItr = hitsMapChamber.begin();
+    std::map<int, HitIndices >::const_iterator mapItr = hitsMapChamber.begin();
     for (; mapItr != hitsMapChamber.end(); mapItr++) 
     {
       unsigned nltot=0;
-      std::map<int, std::vector<PSimHit> >::const_iterator lmapItr = hitsMapLayer.begin();
+      std::map<int, HitIndices >::const_iterator lmapItr = hitsMapLayer.begin();
       for (; lmapItr != hitsMapLayer.end(); lmapItr++) 
       {
         CSCDetId lId(lmapItr->first);
@@ -660,8 +647,8 @@ MatchCSCMuL1::print (const char msg[300], bool psimtr, bool psimh,
         std::cout<<" SELF CHACK ALARM!!! : chamber "<<mapItr->first<<" sum of hits in layers = "<<nltot<<" != # of hits in chamber "<<hitsMapChamber[mapItr->first].size()<<std::endl;
       ntot += nltot;
     }
-    if (ntot != simHits.size()) 
-      std::cout<<" SELF CHACK ALARM!!! : ntot hits in chambers = "<<ntot<<"!= simHits.size()"<<std::endl;
+    if (ntot != (unsigned)nSimHits()) 
+      std::cout<<" SELF CHACK ALARM!!! : ntot hits in chambers = "<<ntot<<"!= nSimHits()"<<std::endl;
     
 
     std::vector<int> chIds = chambersWithHits(0,0,1);
@@ -669,13 +656,14 @@ MatchCSCMuL1::print (const char msg[300], bool psimtr, bool psimh,
       CSCDetId chid(chIds[ch]);
       std::pair<int,int> ws = wireGroupAndStripInChamber(chIds[ch]);
       std::cout<<"  chamber "<<chIds[ch]<<"   "<<chid<<"    #layers with hits = "<<numberOfLayersWithHitsInChamber(chIds[ch])<<"  w="<<ws.first<<"  s="<<ws.second<<std::endl;
-      std::vector<PSimHit> chHits;
-      if(DETAILED_HIT_LAYERS) chHits = chamberHits(chIds[ch]);
-      for (unsigned i = 0; i < chHits.size(); i++) 
+      if(!DETAILED_HIT_LAYERS) continue;
+      HitIndexRange chHits = chamberHits(chIds[ch]);
+      for (HitIndices::const_iterator h = chHits.begin(); h != chHits.end(); ++h) 
       {
-        CSCDetId hid(chHits[i].detUnitId());
-        std::cout<<"    L:"<<hid.layer()<<" "<<chHits[i]<<" "<<hid<<"  "<<chHits[i].momentumAtEntry()
-	    <<" "<<chHits[i].energyLoss()<<" "<<chHits[i].particleType()<<" "<<chHits[i].trackId()<<std::endl;
+        const PSimHit & hit = simHit(*h);
+        CSCDetId hid(hit.detUnitId());
+        std::cout<<"    L:"<<hid.layer()<<" "<<hit<<" "<<hid<<"  "<<hit.momentumAtEntry()
+	    <<" "<<hit.energyLoss()<<" "<<hit.particleType()<<" "<<hit.trackId()<<std::endl;
       }
     }
 //    for (unsigned j=0; j<simHits.size(); j++) {
@@ -703,10 +691,12 @@ MatchCSCMuL1::print (const char msg[300], bool psimtr, bool psimh,
 	  std::cout<<"     * ALCT: "<<*(stubs[i].trgdigi)<<std::endl;
 	  std::cout<<"       inReadOut="<<stubs[i].inReadOut()<<"  eta="<<stubs[i].eta<<"  deltaWire="<<stubs[i].deltaWire<<" deltaOk="<<stubs[i].deltaOk<<std::endl;
 	  std::cout<<"       matched simhits to ALCT n="<<stubs[i].simHits.size()<<" nHitsShared="<<stubs[i].nHitsShared<<std::endl;
-	  if (psimh) for (unsigned h=0; h<stubs[i].simHits.size();h++) 
-	    std::cout<<"     "<<(stubs[i].simHits)[h]<<" "<<(stubs[i].simHits)[h].exitPoint()
-		<<"  "<<(stubs[i].simHits)[h].momentumAtEntry()<<" "<<(stubs[i].simHits)[h].energyLoss()
-		<<" "<<(stubs[i].simHits)[h].particleType()<<" "<<(stubs[i].simHits)[h].trackId()<<std::endl;
+	  if (psimh) for (unsigned h=0; h<stubs[i].simHits.size();h++) {
+	    const PSimHit & hit = simHit((stubs[i].simHits)[h]);
+	    std::cout<<"     "<<hit<<" "<<hit.exitPoint()
+		<<"  "<<hit.momentumAtEntry()<<" "<<hit.energyLoss()
+		<<" "<<hit.particleType()<<" "<<hit.trackId()<<std::endl;
+	  }
 	}
       }
     }
@@ -730,10 +720,12 @@ MatchCSCMuL1::print (const char msg[300], bool psimtr, bool psimh,
 	  std::cout<<"     * CLCT: "<<*(stubs[i].trgdigi)<<std::endl;
           std::cout<<"       inReadOut="<<stubs[i].inReadOut()<<"  phi="<<stubs[i].phi<<"  deltaStrip="<<stubs[i].deltaStrip<<" deltaOk="<<stubs[i].deltaOk<<std::endl;
 	  std::cout<<"       matched simhits to CLCT n="<<stubs[i].simHits.size()<<" nHitsShared="<<stubs[i].nHitsShared<<std::endl;
-	  if (psimh) for (unsigned h=0; h<stubs[i].simHits.size();h++) 
-	    std::cout<<"     "<<(stubs[i].simHits)[h]<<" "<<(stubs[i].simHits)[h].exitPoint()
-		<<"  "<<(stubs[i].simHits)[h].momentumAtEntry()<<" "<<(stubs[i].simHits)[h].energyLoss()
-		<<" "<<(stubs[i].simHits)[h].particleType()<<" "<<(stubs[i].simHits)[h].trackId()<<std::endl;
+	  if (psimh) for (unsigned h=0; h<stubs[i].simHits.size();h++) {
+	    const PSimHit & hit = simHit((stubs[i].simHits)[h]);
+	    std::cout<<"     "<<hit<<" "<<hit.exitPoint()
+		<<"  "<<hit.momentumAtEntry()<<" "<<hit.energyLoss()
+		<<" "<<hit.particleType()<<" "<<hit.trackId()<<std::endl;
+	  }
 	}
       }
     }
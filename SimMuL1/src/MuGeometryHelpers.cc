@@ -7,6 +7,14 @@
 #include "Geometry/DTGeometry/interface/DTGeometry.h"
 #include "Geometry/CommonTopologies/interface/RectangularStripTopology.h"
 #include "Geometry/CommonTopologies/interface/TrapezoidalStripTopology.h"
+#include "FWCore/Utilities/interface/Digest.h"
+
+#include <fstream>
+#include <cstdio>
+#include <cstdlib>
+#include <stdint.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 using std::cout;
 using std::endl;
@@ -18,6 +26,154 @@ const float mugeo::MuGeometryAreas::dt_ch_z[DT_TYPES+1] = {0., 58.7, 273, 528, 5
 const float mugeo::MuGeometryAreas::dt_ch_halfspanz[DT_TYPES+1] = {0., 58.7, 117.4, 117.4, 58.7, 117.4, 117.4, 58.7, 117.4, 117.4, 58.7, 117.4, 117.4};
 
 
+namespace {
+
+// to be increased with any change of the area calculations
+const char * const AREAS_CACHE_VERSION = "MuGeometryAreas 1";
+
+// what the area of a detector is calculated from
+struct DetPosition
+{
+  uint32_t id;
+  float x, y, z;
+  float width, length, thickness;
+  float topology[4];
+};
+
+// the topology parameters used by the calculate*DetectorAreas
+void topologyParameters(const CSCLayer *l, float *t)
+{
+  const CSCWireTopology*  wire_topo  = l->geometry()->wireTopology();
+  const CSCStripTopology* strip_topo = l->geometry()->topology();
+  t[0] = wire_topo->narrowWidthOfPlane();
+  t[1] = wire_topo->wideWidthOfPlane();
+  t[2] = wire_topo->lengthOfPlane();
+  t[3] = strip_topo->yLimitsOfStripPlane().second - strip_topo->yLimitsOfStripPlane().first;
+}
+
+void topologyParameters(const DTLayer *l, float *t)
+{
+  const DTTopology& topo = l->specificTopology();
+  t[0] = topo.sensibleWidth();
+  t[1] = topo.cellLenght();
+  t[2] = topo.channels();
+  t[3] = 0.;
+}
+
+void stripTopologyParameters(const StripTopology &topo, int nstrips, float *t)
+{
+  t[0] = topo.stripLength();
+  t[1] = topo.localPosition(0.).x();
+  t[2] = topo.localPosition((float)nstrips).x();
+  t[3] = nstrips;
+}
+
+void topologyParameters(const GEMEtaPartition *p, float *t) { stripTopologyParameters(p->specificTopology(), p->nstrips(), t); }
+void topologyParameters(const RPCRoll *r, float *t) { stripTopologyParameters(r->specificTopology(), r->nstrips(), t); }
+
+template <class DETS>
+std::string detsFingerprint(const char *name, const DETS &dets)
+{
+  // IDs, positions, bounds and topologies of the detectors, hashed in one go
+  std::vector<DetPosition> table;
+  table.reserve(dets.size());
+  for (auto d: dets)
+  {
+    auto p = d->surface().position();
+    const Bounds &b = d->surface().bounds();
+    DetPosition dp = {d->geographicalId().rawId(), p.x(), p.y(), p.z(), b.width(), b.length(), b.thickness(), {0., 0., 0., 0.}};
+    topologyParameters(d, dp.topology);
+    table.push_back(dp);
+  }
+  cms::Digest md5(name);
+  if (!table.empty()) md5.append(std::string(reinterpret_cast<const char*>(&table[0]), table.size()*sizeof(DetPosition)));
+  return std::string(name) + ":" + md5.digest().toString();
+}
+
+// writes a file under a unique temporary name and renames it into place, so that
+// concurrent jobs sharing the file never see (or leave) a partly written or interleaved one
+template <class WRITE>
+bool writeAtomically(const std::string &file_name, std::ios::openmode mode, WRITE write)
+{
+  std::string tmp_name = file_name + ".XXXXXX";
+  int fd = mkstemp(&tmp_name[0]);
+  if (fd < 0) return false;
+  fchmod(fd, 0644);
+  close(fd);
+
+  std::ofstream o(tmp_name.c_str(), mode | std::ios::trunc);
+  write(o);
+  o.close();
+  if (!o || rename(tmp_name.c_str(), file_name.c_str()) != 0)
+  {
+    unlink(tmp_name.c_str());
+    return false;
+  }
+  return true;
+}
+
+template <class T>
+void writeArray(std::ostream &o, const T *a, unsigned n)
+{
+  o.write(reinterpret_cast<const char*>(&n), sizeof(n));
+  o.write(reinterpret_cast<const char*>(a), n*sizeof(T));
+}
+
+template <class T>
+bool readArray(std::istream &in, T *a, unsigned n)
+{
+  unsigned nn = 0;
+  in.read(reinterpret_cast<char*>(&nn), sizeof(nn));
+  if (!in || nn != n) return false;
+  in.read(reinterpret_cast<char*>(a), n*sizeof(T));
+  return bool(in);
+}
+
+template <class T>
+bool readVector(std::istream &in, std::vector<T> &v)
+{
+  unsigned n = 0;
+  in.read(reinterpret_cast<char*>(&n), sizeof(n));
+  if (!in || n > 10000) return false;
+  v.resize(n);
+  if (n) in.read(reinterpret_cast<char*>(&v[0]), n*sizeof(T));
+  return bool(in);
+}
+
+// the stored table has to be the same as the compiled one
+bool sameArray(std::istream &in, const double *a, unsigned n)
+{
+  std::vector<double> stored(n);
+  return readArray(in, &stored[0], n) && std::equal(stored.begin(), stored.end(), a);
+}
+
+} // local namespace
+
+
+// ================================================================================================
+mugeo::MuGeometryAreas::MuGeometryAreas()
+{
+  for (int i=0; i<=CSC_TYPES; i++) csc_total_areas_cm2[i]=0.;
+  for (int i=0; i<=GEM_TYPES; i++) gem_total_areas_cm2[i]=0.;
+  for (int i=0; i<=DT_TYPES; i++) dt_total_areas_cm2[i]=0.;
+  for (int i=0; i<=RPCB_TYPES; i++) rpcb_total_areas_cm2[i]=0.;
+  for (int i=0; i<=RPCF_TYPES; i++) rpcf_total_areas_cm2[i]=0.;
+}
+
+
+// ================================================================================================
+float mugeo::MuGeometryAreas::cscAreaFractionInRadius(int t, float r1, float r2)
+{
+  if (t < 1 || t > CSC_TYPES) return 0.;
+  float rmin = csc_ch_radius[t] - csc_ch_halfheight[t];
+  float rmax = csc_ch_radius[t] + csc_ch_halfheight[t];
+  r1 = std::max(r1, rmin);
+  r2 = std::min(r2, rmax);
+  if (r2 <= r1) return 0.;
+  return (r2*r2 - r1*r1)/(rmax*rmax - rmin*rmin);
+}
+
+
 // ================================================================================================
 void mugeo::MuGeometryAreas::calculateCSCDetectorAreas(const CSCGeometry* g)
 {
@@ -196,3 +352,105 @@ void mugeo::MuGeometryAreas::calculateRPCDetectorAreas(const RPCGeometry* g)
   for (int i=0; i<=RPCF_TYPES; i++) cout<<"= "<<rpcf_type[i]<<" "<<rpcf_total_areas_cm2[i]/2./rpcf_radial_segm[i]<<endl;
   cout<<"========================"<<endl;
 }
+
+
+// ================================================================================================
+std::string mugeo::MuGeometryAreas::fingerprint(const CSCGeometry* g) {return detsFingerprint("CSC", g->layers());}
+std::string mugeo::MuGeometryAreas::fingerprint(const GEMGeometry* g) {return detsFingerprint("GEM", g->etaPartitions());}
+std::string mugeo::MuGeometryAreas::fingerprint(const DTGeometry* g)  {return detsFingerprint("DT",  g->layers());}
+std::string mugeo::MuGeometryAreas::fingerprint(const RPCGeometry* g) {return detsFingerprint("RPC", g->rolls());}
+
+
+// ================================================================================================
+void mugeo::MuGeometryAreas::save(const std::string &file_name, const std::string &fingerprint) const
+{
+  std::string header = std::string(AREAS_CACHE_VERSION) + " " + fingerprint;
+  auto write = [&](std::ostream &o)
+  {
+    writeArray(o, header.c_str(), header.size());
+
+    writeArray(o, csc_radial_segm, CSC_TYPES+1);
+    writeArray(o, gem_radial_segm, GEM_TYPES+1);
+    writeArray(o, dt_radial_segm, DT_TYPES+1);
+    writeArray(o, rpcb_radial_segm, RPCB_TYPES+1);
+    writeArray(o, rpcf_radial_segm, RPCF_TYPES+1);
+
+    writeArray(o, csc_total_areas_cm2, CSC_TYPES+1);
+    writeArray(o, gem_total_areas_cm2, GEM_TYPES+1);
+    writeArray(o, dt_total_areas_cm2, DT_TYPES+1);
+    writeArray(o, rpcb_total_areas_cm2, RPCB_TYPES+1);
+    writeArray(o, rpcf_total_areas_cm2, RPCF_TYPES+1);
+    for (int t=0; t<=GEM_TYPES; t++)
+    {
+      writeArray(o, gem_total_part_areas_cm2[t].data(), gem_total_part_areas_cm2[t].size());
+      writeArray(o, gem_part_radius[t].data(), gem_part_radius[t].size());
+      writeArray(o, gem_part_halfheight[t].data(), gem_part_halfheight[t].size());
+    }
+  };
+  if (!writeAtomically(file_name, std::ios::binary, write))
+  {
+    cout<<"MuGeometryAreas: cannot write the areas cache "<<file_name<<endl;
+    return;
+  }
+
+  // human readable copy for cross-checks
+  writeAtomically(file_name + ".txt", std::ios::out, [&](std::ostream &txt)
+  {
+    txt<<header<<endl;
+    print(txt);
+  });
+}
+
+
+// ================================================================================================
+bool mugeo::MuGeometryAreas::load(const std::string &file_name, const std::string &fingerprint)
+{
+  std::ifstream in(file_name.c_str(), std::ios::binary);
+  if (!in) return false;
+
+  std::string header = std::string(AREAS_CACHE_VERSION) + " " + fingerprint;
+  std::string stored(header.size(), ' ');
+  if (!readArray(in, &stored[0], header.size()) || stored != header) return false;
+
+  if (!sameArray(in, csc_radial_segm, CSC_TYPES+1) ||
+      !sameArray(in, gem_radial_segm, GEM_TYPES+1) ||
+      !sameArray(in, dt_radial_segm, DT_TYPES+1) ||
+      !sameArray(in, rpcb_radial_segm, RPCB_TYPES+1) ||
+      !sameArray(in, rpcf_radial_segm, RPCF_TYPES+1)) return false;
+
+  // read into a copy, so that a truncated file leaves this object untouched
+  MuGeometryAreas a;
+  if (!readArray(in, a.csc_total_areas_cm2, CSC_TYPES+1) ||
+      !readArray(in, a.gem_total_areas_cm2, GEM_TYPES+1) ||
+      !readArray(in, a.dt_total_areas_cm2, DT_TYPES+1) ||
+      !readArray(in, a.rpcb_total_areas_cm2, RPCB_TYPES+1) ||
+      !readArray(in, a.rpcf_total_areas_cm2, RPCF_TYPES+1)) return false;
+  for (int t=0; t<=GEM_TYPES; t++)
+  {
+    if (!readVector(in, a.gem_total_part_areas_cm2[t]) ||
+        !readVector(in, a.gem_part_radius[t]) ||
+        !readVector(in, a.gem_part_halfheight[t])) return false;
+  }
+  *this = a;
+  return true;
+}
+
+
+// ================================================================================================
+void mugeo::MuGeometryAreas::print(std::ostream &o) const
+{
+  o<<"= CSC *total* sensitive areas (cm2), radial segmentation:"<<endl;
+  for (int i=0; i<=CSC_TYPES; i++) o<<"= "<<csc_type[i]<<" "<<csc_total_areas_cm2[i]<<" "<<csc_radial_segm[i]<<endl;
+  o<<"= GEM *total* sensitive areas (cm2), radial segmentation:"<<endl;
+  for (int i=0; i<=GEM_TYPES; i++) o<<"= "<<gem_type[i]<<" "<<gem_total_areas_cm2[i]<<" "<<gem_radial_segm[i]<<endl;
+  o<<"= GEM partitions: area (cm2), radius, half-height (cm):"<<endl;
+  for (int i=0; i<=GEM_TYPES; i++)
+    for (size_t p=0; p<gem_total_part_areas_cm2[i].size(); p++)
+      o<<"= "<<gem_type[i]<<" "<<p<<" "<<gem_total_part_areas_cm2[i][p]<<" "<<gem_part_radius[i][p]<<" "<<gem_part_halfheight[i][p]<<endl;
+  o<<"= DT *total* sensitive areas (cm2), radial segmentation:"<<endl;
+  for (int i=0; i<=DT_TYPES; i++) o<<"= "<<dt_type[i]<<" "<<dt_total_areas_cm2[i]<<" "<<dt_radial_segm[i]<<endl;
+  o<<"= RPCb *total* sensitive areas (cm2), radial segmentation:"<<endl;
+  for (int i=0; i<=RPCB_TYPES; i++) o<<"= "<<rpcb_type[i]<<" "<<rpcb_total_areas_cm2[i]<<" "<<rpcb_radial_segm[i]<<endl;
+  o<<"= RPCf *total* sensitive areas (cm2), radial segmentation:"<<endl;
+  for (int i=0; i<=RPCF_TYPES; i++) o<<"= "<<rpcf_type[i]<<" "<<rpcf_total_areas_cm2[i]<<" "<<rpcf_radial_segm[i]<<endl;
+}
@@ -25,7 +25,7 @@ MyCSCDetId::init(CSCDetId &id)
 
 // ================================================================================================
 void
-MyCSCSimHit::init(PSimHit &sh, const CSCGeometry* csc_g, const ParticleDataTable * pdt)
+MyCSCSimHit::init(const PSimHit &sh, const CSCGeometry* csc_g, const ParticleDataTable * pdt)
 {
   LocalPoint hitLP = sh.localPosition();
   pdg = sh.particleType();
@@ -220,7 +220,7 @@ MyGEMDetId::init(GEMDetId &id)
 
 // ================================================================================================
 void
-MyGEMSimHit::init(PSimHit &sh, const GEMGeometry* gem_g, const ParticleDataTable * pdt)
+MyGEMSimHit::init(const PSimHit &sh, const GEMGeometry* gem_g, const ParticleDataTable * pdt)
 {
   LocalPoint hitLP = sh.localPosition();
   pdg = sh.particleType();
@@ -393,7 +393,7 @@ MyRPCDetId::init(RPCDetId &id)
 
 // ================================================================================================
 void
-MyRPCSimHit::init(PSimHit &sh, const RPCGeometry* rpc_g, const ParticleDataTable * pdt)
+MyRPCSimHit::init(const PSimHit &sh, const RPCGeometry* rpc_g, const ParticleDataTable * pdt)
 {
   LocalPoint hitLP = sh.localPosition();
   pdg = sh.particleType();
@@ -565,7 +565,7 @@ MyDTDetId::init(DTWireId &id)
 
 // ================================================================================================
 void
-MyDTSimHit::init(PSimHit &sh, const DTGeometry* dt_g, const ParticleDataTable * pdt)
+MyDTSimHit::init(const PSimHit &sh, const DTGeometry* dt_g, const ParticleDataTable * pdt)
 {
   LocalPoint hitLP = sh.localPosition();
   pdg = sh.particleType();
@@ -7,6 +7,9 @@
 
 #include "SimDataFormats/CrossingFrame/interface/CrossingFrame.h"
 #include "SimDataFormats/CrossingFrame/interface/MixCollection.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <algorithm>
 
 namespace SimHitAnalysis {
 
@@ -16,28 +19,108 @@ PSimHitMap::fill(const edm::Event & e)
 {
   theMap.clear();
   theEmptyVector.clear();
+  theDetRanges.clear();
+  theDets.clear();
+  theCFHits.clear();
+  theCFOrigins.clear();
 
   if (useCrossingFrame)
   {
-// needs  update if ever it would be necessary to use simhits from CF
-/*
-    edm::Handle<CrossingFrame> cf;
-    e.getByType(cf);
-
-    MixCollection<PSimHit> simHits(cf.product(), theCollectionName);
-
-    // arrange the hits by detUnit
-    for(MixCollection<PSimHit>::MixItr hit = simHits.begin(); hit != simHits.end(); ++hit)
-      theMap[hit->detUnitId()].push_back(*hit);
-*/
-  } 
-  else
+    fillFromCrossingFrame(e);
+    return;
+  }
+
+  if (zeroCopy)
+  {
+    edm::InputTag tag(theModuleName, theCollectionName);
+    thePool.setInputTag(tag);
+    thePool.fill(e);
+
+    // runs of the same detId in the sorted permutation
+    PSimHitPool::IndexRange sorted = thePool.all();
+    for (Index i = 0; i < sorted.size(); ++i)
+    {
+      int detId = thePool[sorted[i]].detUnitId();
+      if (theDetRanges.empty() || theDetRanges.back().detId != detId)
+      {
+        DetRange r = {detId, i, i};
+        theDetRanges.push_back(r);
+        theDets.push_back(detId);
+      }
+      theDetRanges.back().end = i + 1;
+    }
+    return;
+  }
+
+  edm::Handle< edm::PSimHitContainer > hSimHits;
+  e.getByLabel(theModuleName, theCollectionName, hSimHits);
+  const edm::PSimHitContainer* simHits = hSimHits.product();
+  for (edm::PSimHitContainer::const_iterator hit = simHits->begin();  hit != simHits->end();  ++hit) 
+    theMap[hit->detUnitId()].push_back(*hit);
+
+  theDets.reserve(theMap.size());
+  for(std::map<int, edm::PSimHitContainer>::const_iterator mapItr = theMap.begin(); mapItr != theMap.end(); ++mapItr)
+    theDets.push_back(mapItr->first);
+}
+
+
+namespace {
+struct CFEntry
+{
+  const PSimHit * hit;
+  PSimHitMap::HitOrigin origin;
+  bool operator<(const CFEntry & o) const
   {
-    edm::Handle< edm::PSimHitContainer > hSimHits;
-    e.getByLabel(theModuleName, theCollectionName, hSimHits);
-    const edm::PSimHitContainer* simHits = hSimHits.product();
-    for (edm::PSimHitContainer::const_iterator hit = simHits->begin();  hit != simHits->end();  ++hit) 
-      theMap[hit->detUnitId()].push_back(*hit);
+    if (hit->detUnitId() != o.hit->detUnitId()) return (int)hit->detUnitId() < (int)o.hit->detUnitId();
+    return origin.bx < o.origin.bx;
+  }
+};
+
+bool lessBX(const PSimHitMap::HitOrigin & o, int bx) { return o.bx < bx; }
+bool lessBXr(int bx, const PSimHitMap::HitOrigin & o) { return bx < o.bx; }
+}
+
+
+//_____________________________________________________________________________
+void
+PSimHitMap::fillFromCrossingFrame(const edm::Event & e)
+{
+  edm::Handle< CrossingFrame<PSimHit> > cf;
+  e.getByLabel(theModuleName, theCollectionName, cf);
+  if (!cf.isValid()) return;
+
+  // MixCollection does not accept a window wider than the one of the CrossingFrame
+  std::pair<int,int> window(std::max(theBXMin, cf->getBunchRange().first), std::min(theBXMax, cf->getBunchRange().second));
+  if (window.first > window.second) return;
+
+  // single pass over the signal and the pileup, keeping only pointers to the hits
+  MixCollection<PSimHit> simHits(cf.product(), window);
+  std::vector<CFEntry> entries;
+  entries.reserve(simHits.size());
+  for (MixCollection<PSimHit>::MixItr hit = simHits.begin(); hit != simHits.end(); ++hit)
+  {
+    int bx = hit.getTrigger() ? 0 : hit.bunch();
+    if (bx < window.first || bx > window.second) continue;
+    CFEntry entry = {&(*hit), HitOrigin(bx, hit.getTrigger() ? (int)HitOrigin::SIGNAL : hit.getSourceType())};
+    entries.push_back(entry);
+  }
+  std::stable_sort(entries.begin(), entries.end());
+
+  theCFHits.reserve(entries.size());
+  theCFOrigins.reserve(entries.size());
+  for (Index i = 0; i < entries.size(); ++i)
+  {
+    theCFHits.push_back(entries[i].hit);
+    theCFOrigins.push_back(entries[i].origin);
+
+    int detId = entries[i].hit->detUnitId();
+    if (theDetRanges.empty() || theDetRanges.back().detId != detId)
+    {
+      DetRange r = {detId, i, i};
+      theDetRanges.push_back(r);
+      theDets.push_back(detId);
+    }
+    theDetRanges.back().end = i + 1;
   }
 }
 
@@ -46,6 +129,8 @@ PSimHitMap::fill(const edm::Event & e)
 const edm::PSimHitContainer & 
 PSimHitMap::hits(int detId) const
 {
+  if (zeroCopy || useCrossingFrame)
+    throw cms::Exception("LogicError") << "PSimHitMap::hits is only available in the map mode, use detHits\n";
   std::map<int, edm::PSimHitContainer>::const_iterator mapItr = theMap.find(detId);
   if(mapItr != theMap.end())    return mapItr->second;
   else  return theEmptyContainer;
@@ -53,17 +138,57 @@ PSimHitMap::hits(int detId) const
 
 
 //_____________________________________________________________________________
-std::vector<int> 
-PSimHitMap::detsWithHits() const
+PSimHitMap::HitRange
+PSimHitMap::detHits(int detId) const
 {
-  if (theMap.size()==0) return theEmptyVector;
-  std::vector<int> result;
-  result.reserve(theMap.size());
-  for(std::map<int, edm::PSimHitContainer>::const_iterator mapItr = theMap.begin(); mapItr != theMap.end(); ++mapItr)
+  HitRange::Span span;
+  if (zeroCopy || useCrossingFrame)
   {
-    result.push_back(mapItr->first);
+    std::vector<DetRange>::const_iterator r = std::lower_bound(theDetRanges.begin(), theDetRanges.end(), detId);
+    if (r == theDetRanges.end() || r->detId != detId) return HitRange();
+    if (useCrossingFrame)
+    {
+      span.ptrs = &theCFHits[r->begin];
+      span.origins = &theCFOrigins[r->begin];
+    }
+    else
+    {
+      span.hits = &thePool[0];
+      span.index = &*(thePool.all().begin() + r->begin);
+    }
+    return HitRange(span, r->end - r->begin);
   }
-  return result;
+  std::map<int, edm::PSimHitContainer>::const_iterator mapItr = theMap.find(detId);
+  if (mapItr == theMap.end() || mapItr->second.empty()) return HitRange();
+  span.hits = &mapItr->second[0];
+  return HitRange(span, mapItr->second.size());
+}
+
+
+//_____________________________________________________________________________
+PSimHitMap::HitRange
+PSimHitMap::detHits(int detId, int bxMin, int bxMax) const
+{
+  if (!useCrossingFrame)
+  {
+    if (bxMin <= 0 && bxMax >= 0) return detHits(detId);
+    return HitRange();
+  }
+
+  std::vector<DetRange>::const_iterator r = std::lower_bound(theDetRanges.begin(), theDetRanges.end(), detId);
+  if (r == theDetRanges.end() || r->detId != detId || bxMin > bxMax) return HitRange();
+
+  // the hits of a detId are sorted by BX
+  const HitOrigin * begin = &theCFOrigins[0] + r->begin;
+  const HitOrigin * end = &theCFOrigins[0] + r->end;
+  const HitOrigin * first = std::lower_bound(begin, end, bxMin, lessBX);
+  const HitOrigin * last = std::upper_bound(first, end, bxMax, lessBXr);
+  if (first == last) return HitRange();
+
+  HitRange::Span span;
+  span.ptrs = &theCFHits[first - &theCFOrigins[0]];
+  span.origins = first;
+  return HitRange(span, last - first);
 }
 
 
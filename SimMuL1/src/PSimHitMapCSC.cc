@@ -3,7 +3,7 @@
 
 #include "DataFormats/MuonDetId/interface/CSCDetId.h"
 
-#include <set>
+#include <algorithm>
 
 namespace SimHitAnalysis {
 
@@ -11,53 +11,30 @@ namespace SimHitAnalysis {
 void 
 PSimHitMapCSC::fill(const edm::Event & e)
 {
-  theMap.clear();
-  theChLayers.clear();
-
-  std::map<int, std::set<int> > mapSetChLayers;
-
-  edm::Handle< edm::PSimHitContainer > hSimHits;
-  e.getByLabel(theModuleName, theCollectionName, hSimHits);
-  const edm::PSimHitContainer* simHits = hSimHits.product();
-  for (edm::PSimHitContainer::const_iterator hit = simHits->begin();  hit != simHits->end();  ++hit)
-  {
-    unsigned layerid = hit->detUnitId();
-    CSCDetId id(layerid);
-    CSCDetId chid = id.chamberId();
-    theMap[layerid].push_back(*hit);
-    mapSetChLayers[chid.rawId()].insert(layerid);
-  }
-
-  for(std::map<int, std::set<int> >::const_iterator itr = mapSetChLayers.begin(); itr != mapSetChLayers.end(); ++itr)
-  {
-    std::vector<int> layers(itr->second.begin(),itr->second.end());
-    theChLayers[itr->first] = layers;
-  }
-
-}
+  PSimHitMap::fill(e);
 
+  theChambers.clear();
+  theChLayers.clear();
 
-//_____________________________________________________________________________
-std::vector<int> 
-PSimHitMapCSC::chambersWithHits() const
-{
-  if (theChLayers.size()==0) return theEmptyVector;
-  std::vector<int> result;
-  result.reserve(theChLayers.size());
-  for(std::map<int, std::vector<int> >::const_iterator itr = theChLayers.begin(); itr != theChLayers.end(); ++itr)
+  for (std::vector<int>::const_iterator itr = theDets.begin(); itr != theDets.end(); ++itr)
   {
-    result.push_back(itr->first);
+    int chid = CSCDetId(*itr).chamberId().rawId();
+    if (theChambers.empty() || theChambers.back() != chid)
+    {
+      theChambers.push_back(chid);
+      theChLayers.push_back(theEmptyVector);
+    }
+    theChLayers.back().push_back(*itr);
   }
-  return result;
 }
 
 
 //_____________________________________________________________________________
-std::vector<int> 
+const std::vector<int> &
 PSimHitMapCSC::chamberLayersWithHits(int detId) const
 {
-  std::map<int, std::vector<int> >::const_iterator itr = theChLayers.find(detId);
-  if(itr != theChLayers.end()) return itr->second;
+  std::vector<int>::const_iterator itr = std::lower_bound(theChambers.begin(), theChambers.end(), detId);
+  if (itr != theChambers.end() && *itr == detId) return theChLayers[itr - theChambers.begin()];
   else return theEmptyVector;
 }
 
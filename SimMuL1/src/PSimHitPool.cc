@@ -0,0 +1,103 @@
+
+#include "GEMCode/SimMuL1/interface/PSimHitPool.h"
+
+#include "SimDataFormats/CrossingFrame/interface/CrossingFrame.h"
+#include "SimDataFormats/CrossingFrame/interface/MixCollection.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace SimHitAnalysis {
+
+//_____________________________________________________________________________
+void
+PSimHitPool::fill(const edm::Event & e)
+{
+  theSorted.clear();
+  theCFHits.clear();
+  theHits = 0;
+  theSize = 0;
+
+  if (useCrossingFrame)
+  {
+    edm::Handle< CrossingFrame<PSimHit> > cf;
+    e.getByLabel(theModuleName, theCollectionName, cf);
+    if (!cf.isValid()) return;
+
+    MixCollection<PSimHit> simHits(cf.product());
+    theCFHits.reserve(simHits.size());
+    for (MixCollection<PSimHit>::MixItr hit = simHits.begin(); hit != simHits.end(); ++hit)
+      theCFHits.push_back(&(*hit));
+    theSize = theCFHits.size();
+  }
+  else
+  {
+    e.getByLabel(theModuleName, theCollectionName, theHandle);
+    if (!theHandle.isValid()) return;
+    theHits = theHandle.product();
+    theSize = theHits->size();
+  }
+
+  theSorted.resize(theSize);
+  for (Index i = 0; i < theSorted.size(); ++i) theSorted[i] = i;
+  std::stable_sort(theSorted.begin(), theSorted.end(), LessDetId(this));
+}
+
+
+//_____________________________________________________________________________
+PSimHitPool::IndexRange
+PSimHitPool::detHits(int detId) const
+{
+  return std::equal_range(theSorted.begin(), theSorted.end(), detId, LessDetId(this));
+}
+
+
+//_____________________________________________________________________________
+std::vector<int>
+PSimHitPool::detsWithHits() const
+{
+  std::vector<int> result;
+  for (Indices::const_iterator i = theSorted.begin(); i != theSorted.end(); ++i)
+  {
+    int detId = hit(*i).detUnitId();
+    if (result.empty() || result.back() != detId) result.push_back(detId);
+  }
+  return result;
+}
+
+
+//_____________________________________________________________________________
+PSimHitPool::Index
+PSimHitPool::find(const PSimHit & h) const
+{
+  IndexRange range = detHits(h.detUnitId());
+  for (IndexRange::const_iterator i = range.begin(); i != range.end(); ++i)
+    if (sameHit(hit(*i), h)) return *i;
+  return invalidIndex;
+}
+
+
+//_____________________________________________________________________________
+bool
+PSimHitPool::sameHit(const PSimHit & sh1, const PSimHit & sh2)
+{
+  return ( sh1.detUnitId() == sh2.detUnitId() &&
+           sh1.trackId() == sh2.trackId() &&
+           sh1.particleType() == sh2.particleType() &&
+           sh1.entryPoint().mag() == sh2.entryPoint().mag() &&
+           sh1.exitPoint().mag() == sh2.exitPoint().mag() &&
+           fabs(sh1.momentumAtEntry().mag() - sh2.momentumAtEntry().mag()) < 0.0001 &&
+           sh1.tof() == sh2.tof() &&
+           sh1.energyLoss() == sh2.energyLoss() );
+}
+
+
+//_____________________________________________________________________________
+void
+PSimHitPool::setInputTag(edm::InputTag &t)
+{
+  theModuleName = t.label();
+  theCollectionName = t.instance();
+}
+
+} // namespace SimHitAnalysis
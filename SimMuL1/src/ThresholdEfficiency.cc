@@ -0,0 +1,125 @@
+
+#include "GEMCode/SimMuL1/interface/ThresholdEfficiency.h"
+
+#include "TEfficiency.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cmath>
+
+//_____________________________________________________________________________
+ThresholdEfficiency::ThresholdEfficiency():
+  nbins_(0), xmin_(0.), xmax_(0.)
+{}
+
+
+//_____________________________________________________________________________
+ThresholdEfficiency::ThresholdEfficiency(const std::string & name, const std::string & title,
+                                         int nbins, double xmin, double xmax,
+                                         const double * thresholds, int nthresholds)
+{
+  init(name, title, nbins, xmin, xmax, thresholds, nthresholds);
+}
+
+
+//_____________________________________________________________________________
+void
+ThresholdEfficiency::init(const std::string & name, const std::string & title,
+                          int nbins, double xmin, double xmax,
+                          const double * thresholds, int nthresholds)
+{
+  name_ = name;
+  title_ = title;
+  nbins_ = nbins;
+  xmin_ = xmin;
+  xmax_ = xmax;
+  thresholds_.assign(thresholds, thresholds + nthresholds);
+  std::sort(thresholds_.begin(), thresholds_.end());
+
+  total_.assign(nbins_ + 2, 0.);
+  counts_.assign((nbins_ + 2) * thresholds_.size(), 0.);
+}
+
+
+//_____________________________________________________________________________
+int
+ThresholdEfficiency::passIndex(double pt) const
+{
+  // thresholds are sorted: the number of thresholds <= pt is one past the highest passed
+  return (std::upper_bound(thresholds_.begin(), thresholds_.end(), pt) - thresholds_.begin()) - 1;
+}
+
+
+//_____________________________________________________________________________
+int
+ThresholdEfficiency::findBin(double x) const
+{
+  // same convention as TAxis::FindFixBin
+  if (x < xmin_) return 0;
+  if (x >= xmax_) return nbins_ + 1;
+  int bin = 1 + int(nbins_ * (x - xmin_) / (xmax_ - xmin_));
+  return std::min(bin, nbins_);
+}
+
+
+//_____________________________________________________________________________
+void
+ThresholdEfficiency::fillIndex(double x, int ipass)
+{
+  if (nbins_ == 0) return;
+  int bin = findBin(x);
+  total_[bin] += 1.;
+  if (ipass >= 0) counts_[bin * thresholds_.size() + ipass] += 1.;
+}
+
+
+//_____________________________________________________________________________
+double
+ThresholdEfficiency::passed(int bin, int i) const
+{
+  // a track passing threshold j passes all the lower thresholds as well
+  double n = 0.;
+  for (size_t j = i; j < thresholds_.size(); ++j) n += counts_[bin * thresholds_.size() + j];
+  return n;
+}
+
+
+//_____________________________________________________________________________
+std::vector<TEfficiency*>
+ThresholdEfficiency::book(TFileService & fs) const
+{
+  std::vector<TEfficiency*> result;
+  if (nbins_ == 0) return result;
+
+  const int nthr = thresholds_.size();
+  const int nb = nbins_ + 2;
+
+  // running sums from the highest threshold down give all the curves in a single pass
+  std::vector<double> cumulative(nb * nthr, 0.);
+  for (int bin = 0; bin < nb; ++bin)
+  {
+    double n = 0.;
+    for (int i = nthr - 1; i >= 0; --i)
+    {
+      n += counts_[bin * nthr + i];
+      cumulative[bin * nthr + i] = n;
+    }
+  }
+
+  char label[300], title[500];
+  for (int i = 0; i < nthr; ++i)
+  {
+    sprintf(label, "%s_pt%d", name_.c_str(), (int)std::floor(thresholds_[i] + 0.5));
+    sprintf(title, "%s, p_{T}^{trigger}#geq%g", title_.c_str(), thresholds_[i]);
+    TEfficiency *eff = fs.make<TEfficiency>(label, title, nbins_, xmin_, xmax_);
+    eff->SetStatisticOption(TEfficiency::kFCP);
+    for (int bin = 0; bin < nb; ++bin)
+    {
+      // totals first, so that passed never exceeds total
+      eff->SetTotalEvents(bin, (int)total_[bin]);
+      eff->SetPassedEvents(bin, (int)cumulative[bin * nthr + i]);
+    }
+    result.push_back(eff);
+  }
+  return result;
+}
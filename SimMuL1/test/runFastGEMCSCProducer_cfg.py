@@ -32,6 +32,13 @@ process.load('GEMCode.SimMuL1.FastGEMCSCProducer_cfi')
 #process.FastGEMCSCProducer.usePropagatedDPhi = False
 #process.FastGEMCSCProducer.useLCTPosition = False
 
+### cross-check the closed-form stub fits with TLinearFitter
+#process.FastGEMCSCProducer.stubFitter = "validate"
+
+### GEM dphi from a bending angle table: first make it with "calibrate", then use it with "lut"
+#process.FastGEMCSCProducer.dphiLUTMode = "calibrate"
+#process.FastGEMCSCProducer.dphiLUTFile = "gem_csc_dphi_lut.txt"
+
 ### uncomment those to turn off the detector smearing
 #process.FastGEMCSCProducer.phiSmearCSC = [-1.]*11
 #process.FastGEMCSCProducer.phiSmearGEM = [-1.]*11
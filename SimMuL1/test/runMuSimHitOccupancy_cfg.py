@@ -100,11 +100,26 @@ process.neutronAna = cms.EDAnalyzer("MuSimHitOccupancy",
     inputTagCSC = cms.untracked.InputTag("g4SimHits","MuonCSCHits"),
     inputTagGEM = cms.untracked.InputTag("g4SimHits","MuonGEMHits"),
     inputTagRPC = cms.untracked.InputTag("g4SimHits","MuonRPCHits"),
-    inputTagDT  = cms.untracked.InputTag("g4SimHits","MuonDTHits")
+    inputTagDT  = cms.untracked.InputTag("g4SimHits","MuonDTHits"),
+    ## "seeded" (as the old recursive clustering) or "connected" (chains of adjacent hits)
+    simHitClustering = cms.untracked.string("seeded"),
+    crossCheckClustering = cms.untracked.bool(False),
+    ## only the occupancy and rate histograms, no simhit/cluster/layer/chamber/event trees
+    histogramsOnly = cms.untracked.bool(False),
+    ## cache of the sensitive areas tables (reused if the geometry did not change); "" for no cache
+    areasCacheFile = cms.untracked.string("")
     #inputTagCSC = cms.untracked.InputTag("g4SimHitsNeutrons","MuonCSCHits"),
     #inputTagGEM = cms.untracked.InputTag("g4SimHitsNeutrons","MuonGEMHits"),
     #inputTagRPC = cms.untracked.InputTag("g4SimHitsNeutrons","MuonRPCHits"),
     #inputTagDT  = cms.untracked.InputTag("g4SimHitsNeutrons","MuonDTHits")
+    ## signal and pileup SimHits from the mixing module's CrossingFrames, within [minBX, maxBX]:
+    #simHitsFromCrossingFrame = cms.untracked.bool(True),
+    #minBX = cms.untracked.int32(-2),
+    #maxBX = cms.untracked.int32(2),
+    #inputTagCSC = cms.untracked.InputTag("mix","g4SimHitsMuonCSCHits"),
+    #inputTagGEM = cms.untracked.InputTag("mix","g4SimHitsMuonGEMHits"),
+    #inputTagRPC = cms.untracked.InputTag("mix","g4SimHitsMuonRPCHits"),
+    #inputTagDT  = cms.untracked.InputTag("mix","g4SimHitsMuonDTHits")
 )
 
 